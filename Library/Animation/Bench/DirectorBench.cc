@@ -0,0 +1,120 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/Director.h>
+#include <BenchmarkRunner/BenchmarkRunner.h>
+
+using Property = rl::entity::Entity::Property;
+
+/*
+ *  Interpolate one of the opacity, position, bounds or background color of
+ *  each entity.
+ */
+static void Animate(rl::animation::Director& director,
+                    std::vector<rl::entity::Entity>& entities,
+                    const rl::core::ClockPoint& start,
+                    const rl::animation::Action& action) {
+  using Key = rl::animation::Director::Key;
+
+  for (size_t i = 0; i < entities.size(); i++) {
+    auto& entity = entities[i];
+    const double value = i;
+    switch (i % 4) {
+      case 0:
+        director.setInterpolator(Key(entity.identifier(), Property::Opacity),
+                                 start, action, 0.0, 1.0, entity);
+        break;
+      case 1:
+        director.setInterpolator(Key(entity.identifier(), Property::Position),
+                                 start, action, rl::geom::Point{0.0, value},
+                                 rl::geom::Point{value, 0.0}, entity);
+        break;
+      case 2:
+        director.setInterpolator(
+            Key(entity.identifier(), Property::Bounds), start, action,
+            rl::geom::Rect{0.0, 0.0, value, value},
+            rl::geom::Rect{value, value, 10.0, 10.0}, entity);
+        break;
+      case 3:
+        director.setInterpolator(
+            Key(entity.identifier(), Property::BackgroundColor), start,
+            action, rl::entity::ColorHSB{0.0, 0.5, 0.5, 1.0},
+            rl::entity::ColorHSB{1.0, 0.5, 1.0, 0.0}, entity);
+        break;
+    }
+  }
+}
+
+static std::vector<rl::entity::Entity> Entities(rl::core::Namespace& ns,
+                                                size_t count) {
+  std::vector<rl::entity::Entity> entities;
+  entities.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    entities.emplace_back(rl::core::Name{ns});
+  }
+  return entities;
+}
+
+static void DirectorStepInterpolations(benchmark::State& state) {
+  rl::core::Namespace ns;
+  auto entities = Entities(ns, state.range(0));
+
+  rl::animation::Action action(1.0);
+  action.setRepeatCount(rl::animation::Action::RepeatCountInfinity);
+  action.setAutoReverses(true);
+  action.setTimingCurveType(rl::animation::TimingCurve::Type::EaseInEaseOut);
+
+  rl::animation::Director director;
+  rl::instrumentation::Stopwatch stopwatch;
+  const auto start = rl::core::Clock::now();
+  Animate(director, entities, start, action);
+
+  double time = 0.0;
+  while (state.KeepRunning()) {
+    time += 1.0 / 60.0;
+    auto stepped = director.stepInterpolations(
+        stopwatch, start + rl::core::ClockDuration(time));
+    benchmark::DoNotOptimize(stepped);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void DirectorStartAndRetireInterpolations(benchmark::State& state) {
+  rl::core::Namespace ns;
+  auto entities = Entities(ns, state.range(0));
+
+  rl::animation::Action action(0.25);
+  action.setTimingCurveType(rl::animation::TimingCurve::Type::EaseOut);
+
+  rl::animation::Director director;
+  rl::instrumentation::Stopwatch stopwatch;
+
+  while (state.KeepRunning()) {
+    const auto start = rl::core::Clock::now();
+    Animate(director, entities, start, action);
+    /*
+     *  One step in flight and one past the end that retires everything.
+     */
+    director.stepInterpolations(stopwatch,
+                                start + rl::core::ClockDuration(0.125));
+    director.stepInterpolations(stopwatch,
+                                start + rl::core::ClockDuration(0.5));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(DirectorStepInterpolations)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Complexity();
+
+BENCHMARK(DirectorStartAndRetireInterpolations)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Complexity();
@@ -0,0 +1,94 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/TimingCurve.h>
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <vector>
+
+static std::vector<double> UnitTimes(size_t count) {
+  std::vector<double> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    times.emplace_back(static_cast<double>(i) / count);
+  }
+  return times;
+}
+
+/*
+ *  The iterative solver with the tolerance curves used to be evaluated with.
+ */
+static void TimingCurveSolve(benchmark::State& state) {
+  auto curve = rl::animation::TimingCurve::SystemTimingCurve(
+      rl::animation::TimingCurve::Type::EaseInEaseOut);
+  const auto times = UnitTimes(state.range(0));
+  std::vector<double> values(times.size());
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < times.size(); i++) {
+      values[i] = curve.solve(times[i], 1e-3);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void TimingCurveSample(benchmark::State& state) {
+  auto curve = rl::animation::TimingCurve::SystemTimingCurve(
+      rl::animation::TimingCurve::Type::EaseInEaseOut);
+  const auto times = UnitTimes(state.range(0));
+  std::vector<double> values(times.size());
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < times.size(); i++) {
+      values[i] = curve.x(times[i]);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void TimingCurveEvaluateBatch(benchmark::State& state) {
+  auto curve = rl::animation::TimingCurve::SystemTimingCurve(
+      rl::animation::TimingCurve::Type::EaseInEaseOut);
+  const auto times = UnitTimes(state.range(0));
+  std::vector<double> values(times.size());
+
+  while (state.KeepRunning()) {
+    curve.evaluate(times.data(), values.data(), times.size());
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(TimingCurveSolve)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+
+BENCHMARK(TimingCurveSample)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+
+BENCHMARK(TimingCurveEvaluateBatch)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+
+/*
+ *  Creating a custom curve samples it and checks that the samples are
+ *  accurate enough to be used.
+ */
+static void TimingCurveCreateCustom(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    rl::animation::TimingCurve curve({0.3, -0.4}, {0.7, 1.4});
+    benchmark::DoNotOptimize(curve.isSampled());
+  }
+}
+
+BENCHMARK(TimingCurveCreateCustom)->Unit(benchmark::kMicrosecond);
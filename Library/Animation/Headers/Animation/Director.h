@@ -5,14 +5,34 @@
 
 #pragma once
 
-#include <Animation/Interpolator.h>
+#include <Animation/Action.h>
+#include <Animation/SimulationDescriptor.h>
 #include <Core/Macros.h>
 #include <Core/Stopwatch.h>
-#include <unordered_map>
+#include <Entity/Color.h>
+#include <Entity/Entity.h>
+#include <Geometry/Matrix.h>
+#include <Geometry/Rect.h>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace rl {
 namespace animation {
 
+template <class T>
+class InterpolationTrack;
+class SimulationTrack;
+
+/**
+ *  Interpolates entity properties over time. Interpolations of values of the
+ *  same type are stepped together in batches and their values are written
+ *  directly into the properties of the entities. Interpolations are retired
+ *  once their action (including all its repetitions) has finished.
+ *
+ *  The director also steps physics simulations. These are retired once the
+ *  simulation reports that it is done.
+ */
 class Director {
  public:
   struct Key {
@@ -20,63 +40,110 @@ class Director {
     entity::Entity::Property entityProperty;
     Key(core::Name ident, entity::Entity::Property prop)
         : entityIdentifier(ident), entityProperty(prop) {}
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        size_t seed = key.entityIdentifier.hash();
+        core::HashCombine(seed, static_cast<uint64_t>(key.entityProperty));
+        return seed;
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.entityIdentifier == rhs.entityIdentifier &&
+               lhs.entityProperty == rhs.entityProperty;
+      }
+    };
   };
 
-  Director();
+  using CompletionCallback = std::function<void(const Key& /* key */)>;
 
-  template <typename T, typename... InterpolatorArgs>
-  void setInterpolator(Key key,
+  /**
+   *  Create a director.
+   *
+   *  @param completionCallback invoked with the key of each interpolation
+   *                            or simulation that finished, after the step
+   *                            that applied its final value
+   */
+  Director(CompletionCallback completionCallback = nullptr);
+
+  ~Director();
+
+  /**
+   *  Interpolate the property of the entity from one value to the other. If
+   *  the property is already being interpolated, that interpolation is
+   *  replaced without publishing its completion. The entity must outlive the
+   *  interpolation.
+   *
+   *  @param key       the entity and property to interpolate
+   *  @param startTime the time at which the interpolation starts
+   *  @param action    the duration, repetitions and timing curve
+   *  @param from      the value at the start of each iteration
+   *  @param to        the value at the end of each iteration
+   *  @param entity    the entity whose property is updated on each step
+   */
+  template <typename T>
+  void setInterpolator(const Key& key,
                        const core::ClockPoint& startTime,
-                       InterpolatorArgs&&... args) {
-    /*
-     *  Create a fresh interpolator and attempt to insert it into the
-     *  collection. If one doesn't already exist, the emplace will succeed and
-     *  we can start the interpolation.
-     *
-     *  Note: This logic will be augmented once interpolation replacement
-     *  behavior is settled upon.
-     */
-    auto& interpolators = collection<T>();
-    auto interpolator = std::make_unique<Interpolator<T>>(
-        std::forward<InterpolatorArgs>(args)...);
-
-    auto result = interpolators.emplace(key, std::move(interpolator));
-    if (result.second) {
-      (*(result.first)).second->start(startTime);
-    }
-  }
-
-  size_t stepInterpolations(instrumentation::Stopwatch& stopwatch);
+                       const Action& action,
+                       const T& from,
+                       const T& to,
+                       entity::Entity& entity);
 
- private:
-  struct KeyHash {
-    std::size_t operator()(const Key& key) const {
-      size_t seed = key.entityIdentifier.hash();
-      core::HashCombine(seed, static_cast<uint64_t>(key.entityProperty));
-      return seed;
-    }
-  };
+  /**
+   *  Simulate one component of an entity property. If the same component is
+   *  already being simulated, that simulation is replaced without publishing
+   *  its completion. Simulations are stepped after interpolations and win
+   *  over an interpolation of the same property. The entity must outlive the
+   *  simulation.
+   *
+   *  @param startTime  the time at which the simulation starts
+   *  @param descriptor the simulation and the entity property it drives
+   *  @param entity     the entity whose property is updated on each step
+   *
+   *  @return if the simulation was started
+   */
+  bool setSimulation(const core::ClockPoint& startTime,
+                     const SimulationDescriptor& descriptor,
+                     entity::Entity& entity);
 
-  struct KeyEqual {
-    bool operator()(const Key& lhs, const Key& rhs) const {
-      return lhs.entityIdentifier == rhs.entityIdentifier &&
-             lhs.entityProperty == rhs.entityProperty;
-    }
-  };
+  /**
+   *  Step all interpolations and simulations to the given time. This is
+   *  usually the time at which the frame being prepared will be presented.
+   *
+   *  @param stopwatch the stopwatch that times the interpolations
+   *  @param time      the time to step the interpolations to
+   *
+   *  @return the number of interpolations and simulations stepped. This
+   *          includes the ones that finished and were retired in this step.
+   */
+  size_t stepInterpolations(instrumentation::Stopwatch& stopwatch,
+                            const core::ClockPoint& time);
 
-  template <typename T>
-  using Interpolators = std::
-      unordered_map<Key, std::unique_ptr<Interpolator<T>>, KeyHash, KeyEqual>;
+  /**
+   *  @return the number of interpolations still running
+   */
+  size_t interpolationsCount() const;
+
+  /**
+   *  @return the number of simulations still running
+   */
+  size_t simulationsCount() const;
 
-  Interpolators<double> _numberInterpolators;
-  Interpolators<geom::Point> _pointInterpolators;
-  Interpolators<geom::Size> _sizeInterpolators;
-  Interpolators<geom::Rect> _rectInterpolators;
-  Interpolators<geom::Matrix::Decomposition> _matrixInterpolators;
-  Interpolators<entity::ColorHSB> _colorInterpolators;
+ private:
+  CompletionCallback _completionCallback;
+  std::unique_ptr<InterpolationTrack<double>> _numberTrack;
+  std::unique_ptr<InterpolationTrack<geom::Point>> _pointTrack;
+  std::unique_ptr<InterpolationTrack<geom::Rect>> _rectTrack;
+  std::unique_ptr<InterpolationTrack<geom::Matrix::Decomposition>>
+      _matrixTrack;
+  std::unique_ptr<InterpolationTrack<entity::ColorHSB>> _colorTrack;
+  std::unique_ptr<SimulationTrack> _simulationTrack;
+  std::vector<Key> _finished;
 
   template <typename T>
-  Interpolators<T>& collection();
+  InterpolationTrack<T>& track();
 
   RL_DISALLOW_COPY_AND_ASSIGN(Director);
 };
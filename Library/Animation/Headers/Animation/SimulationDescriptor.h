@@ -0,0 +1,139 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Animation/Simulation.h>
+#include <Animation/SpringSolution.h>
+#include <Core/Macros.h>
+#include <Entity/Entity.h>
+#include <memory>
+
+namespace rl {
+namespace animation {
+
+/**
+ *  Describes a physics simulation and the entity property it drives. Unlike
+ *  the simulations themselves, descriptors can be sent to the coordinator
+ *  along with a transaction so that the simulation is stepped there on every
+ *  frame.
+ */
+class SimulationDescriptor final : public core::ArchiveSerializable,
+                                   public core::MessageSerializable {
+ public:
+  enum class Type : uint8_t {
+    Spring,
+    Friction,
+    Gravity,
+    Scroll,
+  };
+
+  /**
+   *  The component of a point or rect property driven by the simulation.
+   *  Ignored for properties that are numbers.
+   */
+  enum class Axis : uint8_t {
+    X,
+    Y,
+  };
+
+  SimulationDescriptor();
+
+  /**
+   *  Describe a `SpringSimulation`.
+   */
+  static SimulationDescriptor Spring(const SpringDescription& spring,
+                                     double start,
+                                     double end,
+                                     double velocity);
+
+  /**
+   *  Describe a `FrictionSimulation`.
+   */
+  static SimulationDescriptor Friction(double drag,
+                                       double position,
+                                       double velocity);
+
+  /**
+   *  Describe a `GravitySimulation`.
+   */
+  static SimulationDescriptor Gravity(double acceleration,
+                                      double distance,
+                                      double endDistance,
+                                      double velocity);
+
+  /**
+   *  Describe a `ScrollSimulation`.
+   */
+  static SimulationDescriptor Scroll(double position,
+                                     double velocity,
+                                     double leading,
+                                     double trailing,
+                                     const SpringDescription& spring,
+                                     double drag);
+
+  Type type() const;
+
+  const core::Name& identifier() const;
+
+  entity::Entity::Property property() const;
+
+  Axis axis() const;
+
+  /**
+   *  Set the entity property driven by the simulation. Only the position,
+   *  anchor point, bounds origin, opacity and stroke size may be simulated.
+   *
+   *  @param identifier the identifier of the entity
+   *  @param property   the property of the entity
+   *  @param axis       the component of the property if it is not a number
+   */
+  void setTarget(const core::Name& identifier,
+                 entity::Entity::Property property,
+                 Axis axis = Axis::X);
+
+  /**
+   *  @return if the type is known and the target is a property that can be
+   *          simulated
+   */
+  bool isValid() const;
+
+  /**
+   *  @return a new simulation as described
+   */
+  std::unique_ptr<Simulation> createSimulation() const;
+
+  bool serialize(core::Message& message) const override;
+
+  bool deserialize(core::Message& message, core::Namespace* ns) override;
+
+  static const core::ArchiveDef ArchiveDefinition;
+
+  ArchiveName archiveName() const override;
+
+  bool serialize(core::ArchiveItem& item) const override;
+
+  bool deserialize(core::ArchiveItem& item, core::Namespace* ns) override;
+
+ private:
+  Type _type;
+  core::Name _identifier;
+  entity::Entity::Property _property;
+  Axis _axis;
+  double _position;
+  double _velocity;
+  double _end;
+  double _leading;
+  double _drag;
+  double _acceleration;
+  double _mass;
+  double _springConstant;
+  double _damping;
+
+  SimulationDescriptor(Type type);
+};
+
+}  // namespace animation
+}  // namespace rl
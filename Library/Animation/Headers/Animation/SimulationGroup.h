@@ -19,6 +19,10 @@ namespace animation {
  */
 class SimulationGroup {
  public:
+  SimulationGroup();
+
+  virtual ~SimulationGroup();
+
   /**
    *  The currently active simulation
    *
@@ -6,10 +6,20 @@
 #pragma once
 
 #include <Geometry/Point.h>
+#include <memory>
 
 namespace rl {
 namespace animation {
 
+/**
+ *  A cubic bezier curve from (0, 0) to (1, 1) mapping the unit time of an
+ *  animation to its progress.
+ *
+ *  Curves are evaluated using a table of progress values and slopes sampled at
+ *  uniform intervals along the time axis. Evaluation is a table lookup
+ *  followed by cubic Hermite interpolation between the two nearest samples.
+ *  The tables of the system curves are computed at compile time.
+ */
 class TimingCurve {
  public:
   using Data = uint8_t;
@@ -20,10 +30,63 @@ class TimingCurve {
     EaseInEaseOut,
   };
 
+  /**
+   *  The number of intervals in the sample table of each curve.
+   */
+  static const size_t SampleCount = 64;
+
+  /**
+   *  The maximum difference between the sampled and the exact progress of a
+   *  curve. Curves whose samples stray further from points on the curve are
+   *  solved iteratively instead.
+   */
+  static const double MaximumSampleError;
+
   static TimingCurve SystemTimingCurve(Type type);
 
+  /**
+   *  Create a curve with the given control points and sample it. Curves that
+   *  fold back along the time axis, that are vertical somewhere, or whose
+   *  sample intervals have tangents outside the Fritsch-Carlson bounds for
+   *  monotone splines are not sampled.
+   *
+   *  @param c1 the first control point
+   *  @param c2 the second control point
+   */
+  TimingCurve(const geom::Point& c1, const geom::Point& c2);
+
+  /**
+   *  @return the progress of the curve at the given unit time
+   */
   double x(double t) const;
 
+  /**
+   *  Evaluate the curve at many unit times at once.
+   *
+   *  @param t   the unit times
+   *  @param out the progress at each unit time. May be the same as `t`.
+   *  @param n   the number of unit times
+   */
+  void evaluate(const double* t, double* out, size_t n) const;
+
+  /**
+   *  Find the progress of the curve at the given unit time iteratively
+   *  without consulting the samples. This is much slower than `x`.
+   *
+   *  @param t       the unit time
+   *  @param epsilon the tolerance of the solution along the time axis
+   *
+   *  @return the progress of the curve at the given unit time
+   */
+  double solve(double t, double epsilon) const;
+
+  /**
+   *  @return if the curve is evaluated using its samples
+   */
+  bool isSampled() const;
+
+  struct Samples;
+
  private:
   double _ax;
   double _bx;
@@ -31,8 +94,12 @@ class TimingCurve {
   double _ay;
   double _by;
   double _cy;
+  std::shared_ptr<const Samples> _ownedSamples;
+  const Samples* _samples;
 
-  TimingCurve(const geom::Point& c1, const geom::Point& c2);
+  TimingCurve(const geom::Point& c1,
+              const geom::Point& c2,
+              const Samples* samples);
 };
 
 }  // namespace animation
@@ -4,80 +4,141 @@
  */
 
 #include <Animation/Director.h>
+#include "InterpolationTrack.h"
+#include "SimulationTrack.h"
 
 namespace rl {
 namespace animation {
 
-Director::Director() = default;
+Director::Director(CompletionCallback completionCallback)
+    : _completionCallback(completionCallback),
+      _numberTrack(std::make_unique<InterpolationTrack<double>>()),
+      _pointTrack(std::make_unique<InterpolationTrack<geom::Point>>()),
+      _rectTrack(std::make_unique<InterpolationTrack<geom::Rect>>()),
+      _matrixTrack(std::make_unique<
+                   InterpolationTrack<geom::Matrix::Decomposition>>()),
+      _colorTrack(std::make_unique<InterpolationTrack<entity::ColorHSB>>()),
+      _simulationTrack(std::make_unique<SimulationTrack>()) {}
+
+Director::~Director() = default;
+
+template <typename T>
+void Director::setInterpolator(const Key& key,
+                               const core::ClockPoint& startTime,
+                               const Action& action,
+                               const T& from,
+                               const T& to,
+                               entity::Entity& entity) {
+  track<T>().set(key, startTime, action, from, to, entity);
+}
 
-size_t Director::stepInterpolations(instrumentation::Stopwatch& stopwatch) {
-  instrumentation::AutoStopwatchLap lap(stopwatch);
+bool Director::setSimulation(const core::ClockPoint& startTime,
+                             const SimulationDescriptor& descriptor,
+                             entity::Entity& entity) {
+  return _simulationTrack->set(startTime, descriptor, entity);
+}
 
-  const core::ClockPoint time = core::Clock::now();
+size_t Director::stepInterpolations(instrumentation::Stopwatch& stopwatch,
+                                    const core::ClockPoint& time) {
   size_t count = 0;
 
-  for (const auto& i : _numberInterpolators) {
-    i.second->step(time);
-  }
-  count += _numberInterpolators.size();
-
-  for (const auto& i : _pointInterpolators) {
-    i.second->step(time);
-  }
-  count += _pointInterpolators.size();
-
-  for (const auto& i : _sizeInterpolators) {
-    i.second->step(time);
-  }
-  count += _sizeInterpolators.size();
+  {
+    instrumentation::AutoStopwatchLap lap(stopwatch);
 
-  for (const auto& i : _rectInterpolators) {
-    i.second->step(time);
+    count += _numberTrack->step(time, _finished);
+    count += _pointTrack->step(time, _finished);
+    count += _rectTrack->step(time, _finished);
+    count += _matrixTrack->step(time, _finished);
+    count += _colorTrack->step(time, _finished);
+    count += _simulationTrack->step(time, _finished);
   }
-  count += _rectInterpolators.size();
 
-  for (const auto& i : _matrixInterpolators) {
-    i.second->step(time);
+  /*
+   *  Completions are published once all tracks have been stepped so that the
+   *  callback may start new interpolations.
+   */
+  if (_finished.size() > 0) {
+    std::vector<Key> finished;
+    finished.swap(_finished);
+    if (_completionCallback) {
+      for (const auto& key : finished) {
+        _completionCallback(key);
+      }
+    }
+    finished.clear();
+    _finished.swap(finished);
   }
-  count += _matrixInterpolators.size();
-
-  for (const auto& i : _colorInterpolators) {
-    i.second->step(time);
-  }
-  count += _colorInterpolators.size();
 
   return count;
 }
 
-template <>
-Director::Interpolators<double>& Director::collection() {
-  return _numberInterpolators;
+size_t Director::interpolationsCount() const {
+  return _numberTrack->size() + _pointTrack->size() + _rectTrack->size() +
+         _matrixTrack->size() + _colorTrack->size();
+}
+
+size_t Director::simulationsCount() const {
+  return _simulationTrack->size();
 }
 
 template <>
-Director::Interpolators<geom::Size>& Director::collection() {
-  return _sizeInterpolators;
+InterpolationTrack<double>& Director::track() {
+  return *_numberTrack;
 }
 
 template <>
-Director::Interpolators<geom::Point>& Director::collection() {
-  return _pointInterpolators;
+InterpolationTrack<geom::Point>& Director::track() {
+  return *_pointTrack;
 }
 
 template <>
-Director::Interpolators<geom::Rect>& Director::collection() {
-  return _rectInterpolators;
+InterpolationTrack<geom::Rect>& Director::track() {
+  return *_rectTrack;
 }
 
 template <>
-Director::Interpolators<entity::ColorHSB>& Director::collection() {
-  return _colorInterpolators;
+InterpolationTrack<entity::ColorHSB>& Director::track() {
+  return *_colorTrack;
 }
 
 template <>
-Director::Interpolators<geom::Matrix::Decomposition>& Director::collection() {
-  return _matrixInterpolators;
+InterpolationTrack<geom::Matrix::Decomposition>& Director::track() {
+  return *_matrixTrack;
 }
 
+/*
+ *  Explicit Template Specializations.
+ */
+template void Director::setInterpolator(const Key&,
+                                        const core::ClockPoint&,
+                                        const Action&,
+                                        const double&,
+                                        const double&,
+                                        entity::Entity&);
+template void Director::setInterpolator(const Key&,
+                                        const core::ClockPoint&,
+                                        const Action&,
+                                        const geom::Point&,
+                                        const geom::Point&,
+                                        entity::Entity&);
+template void Director::setInterpolator(const Key&,
+                                        const core::ClockPoint&,
+                                        const Action&,
+                                        const geom::Rect&,
+                                        const geom::Rect&,
+                                        entity::Entity&);
+template void Director::setInterpolator(const Key&,
+                                        const core::ClockPoint&,
+                                        const Action&,
+                                        const geom::Matrix::Decomposition&,
+                                        const geom::Matrix::Decomposition&,
+                                        entity::Entity&);
+template void Director::setInterpolator(const Key&,
+                                        const core::ClockPoint&,
+                                        const Action&,
+                                        const entity::ColorHSB&,
+                                        const entity::ColorHSB&,
+                                        entity::Entity&);
+
 }  // namespace animation
 }  // namespace rl
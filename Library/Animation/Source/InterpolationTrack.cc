@@ -0,0 +1,289 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <cmath>
+#include <limits>
+#include "InterpolationTrack.h"
+#include "Lerp.h"
+
+namespace rl {
+namespace animation {
+
+using Property = entity::Entity::Property;
+
+/*
+ *  ============================================================================
+ *  Applying values to entity properties.
+ *  ============================================================================
+ */
+
+template <class T>
+static void ApplyValue(entity::Entity& entity,
+                       Property property,
+                       const T& value);
+
+template <>
+void ApplyValue(entity::Entity& entity,
+                Property property,
+                const double& value) {
+  switch (property) {
+    case Property::Opacity:
+      entity.setOpacity(value);
+      break;
+    case Property::StrokeSize:
+      entity.setStrokeSize(value);
+      break;
+    default:
+      RL_ASSERT_MSG(false, "Property cannot be interpolated as a number");
+      break;
+  }
+}
+
+template <>
+void ApplyValue(entity::Entity& entity,
+                Property property,
+                const geom::Point& value) {
+  switch (property) {
+    case Property::Position:
+      entity.setPosition(value);
+      break;
+    case Property::AnchorPoint:
+      entity.setAnchorPoint(value);
+      break;
+    default:
+      RL_ASSERT_MSG(false, "Property cannot be interpolated as a point");
+      break;
+  }
+}
+
+template <>
+void ApplyValue(entity::Entity& entity,
+                Property property,
+                const geom::Rect& value) {
+  RL_ASSERT(property == Property::Bounds);
+  entity.setBounds(value);
+}
+
+template <>
+void ApplyValue(entity::Entity& entity,
+                Property property,
+                const geom::Matrix::Decomposition& value) {
+  RL_ASSERT(property == Property::Transformation);
+  entity.setTransformation(value);
+}
+
+template <>
+void ApplyValue(entity::Entity& entity,
+                Property property,
+                const entity::ColorHSB& value) {
+  RL_ASSERT(property == Property::BackgroundColor);
+  entity.setBackgroundColor(value);
+}
+
+/*
+ *  ============================================================================
+ *  Interpolation tracks.
+ *  ============================================================================
+ */
+
+template <class T>
+InterpolationTrack<T>::InterpolationTrack() = default;
+
+template <class T>
+size_t InterpolationTrack<T>::size() const {
+  return _keys.size();
+}
+
+template <class T>
+void InterpolationTrack<T>::set(const Key& key,
+                                const core::ClockPoint& startTime,
+                                const Action& action,
+                                const T& from,
+                                const T& to,
+                                entity::Entity& entity) {
+  const double iterations =
+      action.repeatCount() == Action::RepeatCountInfinity
+          ? std::numeric_limits<double>::infinity()
+          : std::max<double>(action.repeatCount(), 1.0);
+
+  auto found = _index.find(key);
+  if (found == _index.end()) {
+    _index.emplace(key, _keys.size());
+    _keys.emplace_back(key);
+    _entities.emplace_back(&entity);
+    _from.emplace_back(from);
+    _to.emplace_back(to);
+    _start.emplace_back(startTime.time_since_epoch().count());
+    _duration.emplace_back(action.duration().count());
+    _iterations.emplace_back(iterations);
+    _autoReverses.emplace_back(action.autoReverses());
+    _curves.emplace_back(action.timingCurveType());
+    return;
+  }
+
+  const auto slot = found->second;
+  _entities[slot] = &entity;
+  _from[slot] = from;
+  _to[slot] = to;
+  _start[slot] = startTime.time_since_epoch().count();
+  _duration[slot] = action.duration().count();
+  _iterations[slot] = iterations;
+  _autoReverses[slot] = action.autoReverses();
+  _curves[slot] = action.timingCurveType();
+}
+
+template <class T>
+size_t InterpolationTrack<T>::step(const core::ClockPoint& time,
+                                   std::vector<Key>& finished) {
+  const auto count = size();
+
+  if (count == 0) {
+    return 0;
+  }
+
+  resolveUnitTimes(time.time_since_epoch().count());
+  resolveTimingCurves();
+
+  if (_values.size() < count) {
+    _values.resize(count, _from.front());
+  }
+  LerpBatch(_from.data(), _to.data(), _unit.data(), _values.data(), count);
+
+  apply();
+  retire(finished);
+
+  return count;
+}
+
+template <class T>
+void InterpolationTrack<T>::resolveUnitTimes(double time) {
+  const auto count = size();
+  _unit.resize(count);
+  _finished.clear();
+
+  for (size_t i = 0; i < count; i++) {
+    const auto iterations = _iterations[i];
+    auto elapsed = _duration[i] > 0.0 ? (time - _start[i]) / _duration[i]
+                                      : iterations;
+
+    if (elapsed < 0.0) {
+      elapsed = 0.0;
+    }
+
+    double iteration = 0.0;
+    double unit = 0.0;
+
+    if (elapsed >= iterations) {
+      /*
+       *  The interpolation has finished. Settle on the end of the last
+       *  iteration exactly.
+       */
+      _finished.emplace_back(i);
+      iteration = std::ceil(iterations) - 1.0;
+      unit = 1.0;
+    } else {
+      iteration = std::floor(elapsed);
+      unit = elapsed - iteration;
+    }
+
+    if (_autoReverses[i] && (static_cast<uint64_t>(iteration) & 1) == 1) {
+      unit = 1.0 - unit;
+    }
+
+    _unit[i] = unit;
+  }
+}
+
+template <class T>
+void InterpolationTrack<T>::resolveTimingCurves() {
+  static const TimingCurve Curves[] = {
+      TimingCurve::SystemTimingCurve(TimingCurve::Type::Linear),
+      TimingCurve::SystemTimingCurve(TimingCurve::Type::EaseIn),
+      TimingCurve::SystemTimingCurve(TimingCurve::Type::EaseOut),
+      TimingCurve::SystemTimingCurve(TimingCurve::Type::EaseInEaseOut),
+  };
+
+  /*
+   *  Interpolations started by the same action are usually adjacent. Evaluate
+   *  each run of interpolations with the same curve in one batch. The linear
+   *  curve is the identity and needs no evaluation.
+   */
+  const auto count = size();
+  size_t run = 0;
+  while (run < count) {
+    const auto curve = _curves[run];
+    size_t end = run + 1;
+    while (end < count && _curves[end] == curve) {
+      end++;
+    }
+
+    if (curve != TimingCurve::Type::Linear) {
+      Curves[static_cast<TimingCurve::Data>(curve)].evaluate(
+          _unit.data() + run, _unit.data() + run, end - run);
+    }
+
+    run = end;
+  }
+}
+
+template <class T>
+void InterpolationTrack<T>::apply() {
+  const auto count = size();
+  for (size_t i = 0; i < count; i++) {
+    ApplyValue(*_entities[i], _keys[i].entityProperty, _values[i]);
+  }
+}
+
+template <class T>
+void InterpolationTrack<T>::retire(std::vector<Key>& finished) {
+  /*
+   *  Retire from the back so that the interpolations moved into the vacated
+   *  slots have already been stepped and are not finished.
+   */
+  for (auto i = _finished.rbegin(); i != _finished.rend(); ++i) {
+    const auto slot = *i;
+    const auto last = size() - 1;
+
+    _index.erase(_keys[slot]);
+    finished.emplace_back(_keys[slot]);
+
+    if (slot != last) {
+      _keys[slot] = _keys[last];
+      _entities[slot] = _entities[last];
+      _from[slot] = _from[last];
+      _to[slot] = _to[last];
+      _start[slot] = _start[last];
+      _duration[slot] = _duration[last];
+      _iterations[slot] = _iterations[last];
+      _autoReverses[slot] = _autoReverses[last];
+      _curves[slot] = _curves[last];
+      _index[_keys[slot]] = slot;
+    }
+
+    _keys.pop_back();
+    _entities.pop_back();
+    _from.pop_back();
+    _to.pop_back();
+    _start.pop_back();
+    _duration.pop_back();
+    _iterations.pop_back();
+    _autoReverses.pop_back();
+    _curves.pop_back();
+  }
+
+  _finished.clear();
+}
+
+/*
+ *  Explicit Template Specializations.
+ */
+template class InterpolationTrack<double>;
+template class InterpolationTrack<geom::Point>;
+template class InterpolationTrack<geom::Rect>;
+template class InterpolationTrack<geom::Matrix::Decomposition>;
+template class InterpolationTrack<entity::ColorHSB>;
+
+}  // namespace animation
+}  // namespace rl
@@ -0,0 +1,92 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Animation/Director.h>
+#include <Core/Macros.h>
+#include <unordered_map>
+#include <vector>
+
+namespace rl {
+namespace animation {
+
+/**
+ *  All running interpolations of values of one type. Each attribute of the
+ *  interpolations is stored in its own contiguous array so that every stage of
+ *  a step runs over tightly packed data. Interpolations are addressed by their
+ *  slot in the arrays. Retiring an interpolation moves the last one into its
+ *  slot.
+ */
+template <class T>
+class InterpolationTrack {
+ public:
+  using Key = Director::Key;
+
+  InterpolationTrack();
+
+  size_t size() const;
+
+  /**
+   *  Start interpolating the property of the entity. Replaces the
+   *  interpolation already running for the same key.
+   */
+  void set(const Key& key,
+           const core::ClockPoint& startTime,
+           const Action& action,
+           const T& from,
+           const T& to,
+           entity::Entity& entity);
+
+  /**
+   *  Apply the values of all interpolations at the given time to the entity
+   *  properties and retire the interpolations that have finished.
+   *
+   *  @param time     the time to step the interpolations to
+   *  @param finished the keys of the interpolations retired in this step are
+   *                  appended here
+   *
+   *  @return the number of interpolations stepped
+   */
+  size_t step(const core::ClockPoint& time, std::vector<Key>& finished);
+
+ private:
+  using Index = std::unordered_map<Key, size_t, Key::Hash, Key::Equal>;
+
+  Index _index;
+
+  /*
+   *  Per interpolation attributes.
+   */
+  std::vector<Key> _keys;
+  std::vector<entity::Entity*> _entities;
+  std::vector<T> _from;
+  std::vector<T> _to;
+  std::vector<double> _start;
+  std::vector<double> _duration;
+  std::vector<double> _iterations;
+  std::vector<uint8_t> _autoReverses;
+  std::vector<TimingCurve::Type> _curves;
+
+  /*
+   *  Scratch space reused between steps.
+   */
+  std::vector<double> _unit;
+  std::vector<T> _values;
+  std::vector<size_t> _finished;
+
+  void resolveUnitTimes(double time);
+
+  void resolveTimingCurves();
+
+  void apply();
+
+  void retire(std::vector<Key>& finished);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(InterpolationTrack);
+};
+
+}  // namespace animation
+}  // namespace rl
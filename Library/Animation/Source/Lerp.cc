@@ -0,0 +1,257 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "Lerp.h"
+
+#if defined(__SSE2__)
+#define RL_LERP_SSE2 1
+#include <emmintrin.h>
+#else
+#define RL_LERP_SSE2 0
+#endif
+
+namespace rl {
+namespace animation {
+
+/*
+ *  ============================================================================
+ *  Interpolating individual types.
+ *  ============================================================================
+ */
+
+template <>
+double Lerp(const double& from, const double& to, double time) {
+  /*
+   *  Unlike `from + (to - from) * time`, this form yields the end values
+   *  exactly. The vectorized batch below uses the same form so both paths
+   *  agree to the bit.
+   */
+  return from * (1.0 - time) + to * time;
+}
+
+template <>
+geom::Point Lerp(const geom::Point& from, const geom::Point& to, double time) {
+  return {
+      Lerp(from.x, to.x, time),  // x
+      Lerp(from.y, to.y, time)   // y
+  };
+}
+
+template <>
+geom::Size Lerp(const geom::Size& from, const geom::Size& to, double time) {
+  return {
+      Lerp(from.width, to.width, time),   // width
+      Lerp(from.height, to.height, time)  // height
+  };
+}
+
+template <>
+geom::Rect Lerp(const geom::Rect& from, const geom::Rect& to, double time) {
+  return {
+      Lerp(from.origin, to.origin, time),  // origin
+      Lerp(from.size, to.size, time)       // size
+  };
+}
+
+template <>
+geom::Vector3 Lerp(const geom::Vector3& from,
+                   const geom::Vector3& to,
+                   double time) {
+  return {
+      Lerp(from.x, to.x, time),  // x
+      Lerp(from.y, to.y, time),  // y
+      Lerp(from.z, to.z, time),  // z
+  };
+}
+
+template <>
+geom::Vector4 Lerp(const geom::Vector4& from,
+                   const geom::Vector4& to,
+                   double time) {
+  return {
+      Lerp(from.x, to.x, time),  // x
+      Lerp(from.y, to.y, time),  // y
+      Lerp(from.z, to.z, time),  // z
+      Lerp(from.w, to.w, time),  // w
+  };
+}
+
+template <>
+geom::Shear Lerp(const geom::Shear& from, const geom::Shear& to, double time) {
+  return {
+      Lerp(from.xy, to.xy, time),  // xy
+      Lerp(from.xz, to.xz, time),  // xz
+      Lerp(from.yz, to.yz, time),  // yz
+  };
+}
+
+template <>
+geom::Matrix::Decomposition Lerp(const geom::Matrix::Decomposition& from,
+                                 const geom::Matrix::Decomposition& to,
+                                 double time) {
+  /*
+   *  Spherical interpolation of the rotation does not yield the end values
+   *  exactly.
+   */
+  if (time <= 0.0) {
+    return from;
+  }
+
+  if (time >= 1.0) {
+    return to;
+  }
+
+  return {
+      Lerp(from.translation, to.translation, time),  // translation
+      Lerp(from.scale, to.scale, time),              // scale
+      Lerp(from.shear, to.shear, time),              // shear
+      Lerp(from.perspective, to.perspective, time),  // perspective
+      from.rotation.slerp(to.rotation, time),        // rotation
+  };
+}
+
+template <>
+entity::ColorHSB Lerp(const entity::ColorHSB& from,
+                      const entity::ColorHSB& to,
+                      double time) {
+  return {
+      Lerp(from.hue, to.hue, time),                // hue
+      Lerp(from.saturation, to.saturation, time),  // saturation
+      Lerp(from.brightness, to.brightness, time),  // brightness
+      Lerp(from.alpha, to.alpha, time),            // alpha
+  };
+}
+
+/*
+ *  ============================================================================
+ *  Interpolating values in batches.
+ *  ============================================================================
+ */
+
+#if RL_LERP_SSE2
+static inline __m128d LerpPair(__m128d from, __m128d to, __m128d time) {
+  const auto inverse = _mm_sub_pd(_mm_set1_pd(1.0), time);
+  return _mm_add_pd(_mm_mul_pd(from, inverse), _mm_mul_pd(to, time));
+}
+#endif
+
+/**
+ *  Interpolate values made up of `Components` consecutive doubles.
+ */
+template <size_t Components>
+static void LerpComponents(const double* from,
+                           const double* to,
+                           const double* unit,
+                           double* values,
+                           size_t count) {
+  size_t i = 0;
+
+#if RL_LERP_SSE2
+  if (Components == 1) {
+    /*
+     *  Two values per register, each with its own unit time.
+     */
+    for (; i + 2 <= count; i += 2) {
+      _mm_storeu_pd(values + i,
+                    LerpPair(_mm_loadu_pd(from + i), _mm_loadu_pd(to + i),
+                             _mm_loadu_pd(unit + i)));
+    }
+  } else if (Components % 2 == 0) {
+    /*
+     *  Two components of the same value per register.
+     */
+    for (; i < count; i++) {
+      const auto time = _mm_set1_pd(unit[i]);
+      const auto offset = i * Components;
+      for (size_t c = 0; c < Components; c += 2) {
+        _mm_storeu_pd(values + offset + c,
+                      LerpPair(_mm_loadu_pd(from + offset + c),
+                               _mm_loadu_pd(to + offset + c), time));
+      }
+    }
+  }
+#endif
+
+  for (; i < count; i++) {
+    const auto offset = i * Components;
+    for (size_t c = 0; c < Components; c++) {
+      values[offset + c] =
+          Lerp(from[offset + c], to[offset + c], unit[i]);
+    }
+  }
+}
+
+template <class T>
+static void LerpFlat(const T* from,
+                     const T* to,
+                     const double* unit,
+                     T* values,
+                     size_t count) {
+  constexpr size_t Components = sizeof(T) / sizeof(double);
+  static_assert(sizeof(T) == Components * sizeof(double),
+                "Only values made up of doubles can be interpolated flat");
+  LerpComponents<Components>(reinterpret_cast<const double*>(from),
+                             reinterpret_cast<const double*>(to), unit,
+                             reinterpret_cast<double*>(values), count);
+}
+
+template <>
+void LerpBatch(const double* from,
+               const double* to,
+               const double* unit,
+               double* values,
+               size_t count) {
+  LerpComponents<1>(from, to, unit, values, count);
+}
+
+template <>
+void LerpBatch(const geom::Point* from,
+               const geom::Point* to,
+               const double* unit,
+               geom::Point* values,
+               size_t count) {
+  LerpFlat(from, to, unit, values, count);
+}
+
+template <>
+void LerpBatch(const geom::Size* from,
+               const geom::Size* to,
+               const double* unit,
+               geom::Size* values,
+               size_t count) {
+  LerpFlat(from, to, unit, values, count);
+}
+
+template <>
+void LerpBatch(const geom::Rect* from,
+               const geom::Rect* to,
+               const double* unit,
+               geom::Rect* values,
+               size_t count) {
+  LerpFlat(from, to, unit, values, count);
+}
+
+template <>
+void LerpBatch(const entity::ColorHSB* from,
+               const entity::ColorHSB* to,
+               const double* unit,
+               entity::ColorHSB* values,
+               size_t count) {
+  LerpFlat(from, to, unit, values, count);
+}
+
+template <>
+void LerpBatch(const geom::Matrix::Decomposition* from,
+               const geom::Matrix::Decomposition* to,
+               const double* unit,
+               geom::Matrix::Decomposition* values,
+               size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    values[i] = Lerp(from[i], to[i], unit[i]);
+  }
+}
+
+}  // namespace animation
+}  // namespace rl
@@ -0,0 +1,41 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Entity/Color.h>
+#include <Geometry/Matrix.h>
+#include <Geometry/Rect.h>
+
+namespace rl {
+namespace animation {
+
+/**
+ *  Interpolate between two values. A unit time of 0 yields `from` and 1
+ *  yields `to` exactly.
+ */
+template <class T>
+T Lerp(const T& from, const T& to, double time);
+
+/**
+ *  Interpolate many values at once. Value `i` is interpolated between `from[i]`
+ *  and `to[i]` at `unit[i]`. Values made up of doubles only are interpolated
+ *  component wise using vector instructions where available.
+ *
+ *  @param from   the values at unit time 0
+ *  @param to     the values at unit time 1
+ *  @param unit   the unit time of each value
+ *  @param values the interpolated values. Must have room for `count` values.
+ *  @param count  the number of values to interpolate
+ */
+template <class T>
+void LerpBatch(const T* from,
+               const T* to,
+               const double* unit,
+               T* values,
+               size_t count);
+
+}  // namespace animation
+}  // namespace rl
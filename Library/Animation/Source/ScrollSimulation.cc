@@ -43,12 +43,9 @@ bool ScrollSimulation::chooseSimulation(
     double position,
     double velocity,
     const core::ClockDuration& intervalOffset) {
-  if (position > _trailingExtent || position < _leadingExtent) {
-    return false;
-  }
-
   /*
-   *  This simulation can only step forward.
+   *  This simulation can only step forward. Once past either extent, it
+   *  springs back to that extent and stays springing.
    */
   if (!_isSpringing) {
     if (position > _trailingExtent) {
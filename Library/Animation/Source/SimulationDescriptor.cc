@@ -0,0 +1,299 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/FrictionSimulation.h>
+#include <Animation/GravitySimulation.h>
+#include <Animation/ScrollSimulation.h>
+#include <Animation/SimulationDescriptor.h>
+#include <Animation/SpringSimulation.h>
+#include <Core/Message.h>
+
+namespace rl {
+namespace animation {
+
+/**
+ *  Steps a simulation group as if it were a single simulation.
+ */
+class SimulationGroupAdapter : public Simulation {
+ public:
+  SimulationGroupAdapter(std::unique_ptr<SimulationGroup> group)
+      : _group(std::move(group)) {}
+
+  double x(const core::ClockDuration& time) const override {
+    return _group->x(time);
+  }
+
+  double dx(const core::ClockDuration& time) const override {
+    return _group->dx(time);
+  }
+
+  bool isDone(const core::ClockDuration& time) const override {
+    return _group->isDone(time);
+  }
+
+ private:
+  /*
+   *  Simulation groups switch simulations as they are queried.
+   */
+  mutable std::unique_ptr<SimulationGroup> _group;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SimulationGroupAdapter);
+};
+
+static bool CanSimulate(entity::Entity::Property property) {
+  using Property = entity::Entity::Property;
+  return property == Property::Position ||
+         property == Property::AnchorPoint || property == Property::Bounds ||
+         property == Property::Opacity || property == Property::StrokeSize;
+}
+
+SimulationDescriptor::SimulationDescriptor()
+    : SimulationDescriptor(Type::Friction) {}
+
+SimulationDescriptor::SimulationDescriptor(Type type)
+    : _type(type),
+      _property(entity::Entity::Property::None),
+      _axis(Axis::X),
+      _position(0.0),
+      _velocity(0.0),
+      _end(0.0),
+      _leading(0.0),
+      _drag(0.0),
+      _acceleration(0.0),
+      _mass(0.0),
+      _springConstant(0.0),
+      _damping(0.0) {}
+
+SimulationDescriptor SimulationDescriptor::Spring(
+    const SpringDescription& spring,
+    double start,
+    double end,
+    double velocity) {
+  SimulationDescriptor descriptor(Type::Spring);
+  descriptor._position = start;
+  descriptor._end = end;
+  descriptor._velocity = velocity;
+  descriptor._mass = spring.mass;
+  descriptor._springConstant = spring.springConstant;
+  descriptor._damping = spring.damping;
+  return descriptor;
+}
+
+SimulationDescriptor SimulationDescriptor::Friction(double drag,
+                                                    double position,
+                                                    double velocity) {
+  SimulationDescriptor descriptor(Type::Friction);
+  descriptor._drag = drag;
+  descriptor._position = position;
+  descriptor._velocity = velocity;
+  return descriptor;
+}
+
+SimulationDescriptor SimulationDescriptor::Gravity(double acceleration,
+                                                   double distance,
+                                                   double endDistance,
+                                                   double velocity) {
+  SimulationDescriptor descriptor(Type::Gravity);
+  descriptor._acceleration = acceleration;
+  descriptor._position = distance;
+  descriptor._end = endDistance;
+  descriptor._velocity = velocity;
+  return descriptor;
+}
+
+SimulationDescriptor SimulationDescriptor::Scroll(
+    double position,
+    double velocity,
+    double leading,
+    double trailing,
+    const SpringDescription& spring,
+    double drag) {
+  SimulationDescriptor descriptor(Type::Scroll);
+  descriptor._position = position;
+  descriptor._velocity = velocity;
+  descriptor._leading = leading;
+  descriptor._end = trailing;
+  descriptor._mass = spring.mass;
+  descriptor._springConstant = spring.springConstant;
+  descriptor._damping = spring.damping;
+  descriptor._drag = drag;
+  return descriptor;
+}
+
+SimulationDescriptor::Type SimulationDescriptor::type() const {
+  return _type;
+}
+
+const core::Name& SimulationDescriptor::identifier() const {
+  return _identifier;
+}
+
+entity::Entity::Property SimulationDescriptor::property() const {
+  return _property;
+}
+
+SimulationDescriptor::Axis SimulationDescriptor::axis() const {
+  return _axis;
+}
+
+void SimulationDescriptor::setTarget(const core::Name& identifier,
+                                     entity::Entity::Property property,
+                                     Axis axis) {
+  RL_ASSERT_MSG(CanSimulate(property), "Property cannot be simulated");
+  _identifier = identifier;
+  _property = property;
+  _axis = axis;
+}
+
+std::unique_ptr<Simulation> SimulationDescriptor::createSimulation() const {
+  switch (_type) {
+    case Type::Spring:
+      return std::make_unique<SpringSimulation>(
+          SpringDescription{_mass, _springConstant, _damping}, _position, _end,
+          _velocity);
+    case Type::Friction:
+      return std::make_unique<FrictionSimulation>(_drag, _position, _velocity);
+    case Type::Gravity:
+      return std::make_unique<GravitySimulation>(_acceleration, _position,
+                                                 _end, _velocity);
+    case Type::Scroll:
+      return std::make_unique<SimulationGroupAdapter>(
+          std::make_unique<ScrollSimulation>(
+              _position, _velocity, _leading, _end,
+              SpringDescription{_mass, _springConstant, _damping}, _drag));
+  }
+  return nullptr;
+}
+
+bool SimulationDescriptor::isValid() const {
+  /*
+   *  Descriptors arrive from other processes so nothing decoded from them can
+   *  be trusted to be in range.
+   */
+  if (static_cast<uint8_t>(_type) > static_cast<uint8_t>(Type::Scroll)) {
+    return false;
+  }
+
+  return CanSimulate(_property) && (_axis == Axis::X || _axis == Axis::Y);
+}
+
+bool SimulationDescriptor::serialize(core::Message& message) const {
+  RL_RETURN_IF_FALSE(message.encode(_type));
+  RL_RETURN_IF_FALSE(message.encode(_identifier));
+  RL_RETURN_IF_FALSE(message.encode(_property));
+  RL_RETURN_IF_FALSE(message.encode(_axis));
+  RL_RETURN_IF_FALSE(message.encode(_position));
+  RL_RETURN_IF_FALSE(message.encode(_velocity));
+  RL_RETURN_IF_FALSE(message.encode(_end));
+  RL_RETURN_IF_FALSE(message.encode(_leading));
+  RL_RETURN_IF_FALSE(message.encode(_drag));
+  RL_RETURN_IF_FALSE(message.encode(_acceleration));
+  RL_RETURN_IF_FALSE(message.encode(_mass));
+  RL_RETURN_IF_FALSE(message.encode(_springConstant));
+  RL_RETURN_IF_FALSE(message.encode(_damping));
+  return true;
+}
+
+bool SimulationDescriptor::deserialize(core::Message& message,
+                                       core::Namespace* ns) {
+  RL_RETURN_IF_FALSE(message.decode(_type, ns));
+  RL_RETURN_IF_FALSE(message.decode(_identifier, ns));
+  RL_RETURN_IF_FALSE(message.decode(_property, ns));
+  RL_RETURN_IF_FALSE(message.decode(_axis, ns));
+  RL_RETURN_IF_FALSE(message.decode(_position, ns));
+  RL_RETURN_IF_FALSE(message.decode(_velocity, ns));
+  RL_RETURN_IF_FALSE(message.decode(_end, ns));
+  RL_RETURN_IF_FALSE(message.decode(_leading, ns));
+  RL_RETURN_IF_FALSE(message.decode(_drag, ns));
+  RL_RETURN_IF_FALSE(message.decode(_acceleration, ns));
+  RL_RETURN_IF_FALSE(message.decode(_mass, ns));
+  RL_RETURN_IF_FALSE(message.decode(_springConstant, ns));
+  RL_RETURN_IF_FALSE(message.decode(_damping, ns));
+  return isValid();
+}
+
+enum ArchiveKey {
+  Type,
+  Identifier,
+  Property,
+  Axis,
+  Position,
+  Velocity,
+  End,
+  Leading,
+  Drag,
+  Acceleration,
+  Mass,
+  SpringConstant,
+  Damping,
+};
+
+const core::ArchiveDef SimulationDescriptor::ArchiveDefinition = {
+    /* .superClass = */ nullptr,
+    /* .className = */ "SimulationDescriptor",
+    /* .autoAssignName = */ true,
+    /* .members = */
+    {
+        ArchiveKey::Type,            //
+        ArchiveKey::Identifier,      //
+        ArchiveKey::Property,        //
+        ArchiveKey::Axis,            //
+        ArchiveKey::Position,        //
+        ArchiveKey::Velocity,        //
+        ArchiveKey::End,             //
+        ArchiveKey::Leading,         //
+        ArchiveKey::Drag,            //
+        ArchiveKey::Acceleration,    //
+        ArchiveKey::Mass,            //
+        ArchiveKey::SpringConstant,  //
+        ArchiveKey::Damping          //
+    },
+};
+
+SimulationDescriptor::ArchiveName SimulationDescriptor::archiveName() const {
+  return core::ArchiveNameAuto;
+}
+
+bool SimulationDescriptor::serialize(core::ArchiveItem& item) const {
+  RL_RETURN_IF_FALSE(item.encodeEnum(ArchiveKey::Type, _type));
+  RL_RETURN_IF_FALSE(
+      item.encode(ArchiveKey::Identifier, _identifier.toString()));
+  RL_RETURN_IF_FALSE(item.encodeEnum(ArchiveKey::Property, _property));
+  RL_RETURN_IF_FALSE(item.encodeEnum(ArchiveKey::Axis, _axis));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Position, _position));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Velocity, _velocity));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::End, _end));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Leading, _leading));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Drag, _drag));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Acceleration, _acceleration));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Mass, _mass));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::SpringConstant, _springConstant));
+  RL_RETURN_IF_FALSE(item.encode(ArchiveKey::Damping, _damping));
+  return true;
+}
+
+bool SimulationDescriptor::deserialize(core::ArchiveItem& item,
+                                       core::Namespace* ns) {
+  std::string identifier;
+  RL_RETURN_IF_FALSE(item.decodeEnum(ArchiveKey::Type, _type));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Identifier, identifier));
+  RL_RETURN_IF_FALSE(item.decodeEnum(ArchiveKey::Property, _property));
+  RL_RETURN_IF_FALSE(item.decodeEnum(ArchiveKey::Axis, _axis));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Position, _position));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Velocity, _velocity));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::End, _end));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Leading, _leading));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Drag, _drag));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Acceleration, _acceleration));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Mass, _mass));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::SpringConstant, _springConstant));
+  RL_RETURN_IF_FALSE(item.decode(ArchiveKey::Damping, _damping));
+  RL_RETURN_IF_FALSE(isValid());
+  _identifier.fromString(identifier, ns);
+  return true;
+}
+
+}  // namespace animation
+}  // namespace rl
@@ -9,6 +9,10 @@
 namespace rl {
 namespace animation {
 
+SimulationGroup::SimulationGroup() : _lastStep(core::ClockDuration::zero()) {}
+
+SimulationGroup::~SimulationGroup() = default;
+
 double SimulationGroup::x(const core::ClockDuration& time) {
   stepIfNecessary(time);
   return currentSimulation()->x(time - currentIntervalOffset());
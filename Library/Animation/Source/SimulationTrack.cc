@@ -0,0 +1,134 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "SimulationTrack.h"
+
+namespace rl {
+namespace animation {
+
+using Property = entity::Entity::Property;
+using Axis = SimulationDescriptor::Axis;
+
+static void ApplyComponent(entity::Entity& entity,
+                           Property property,
+                           Axis axis,
+                           double value) {
+  switch (property) {
+    case Property::Position: {
+      auto position = entity.position();
+      (axis == Axis::X ? position.x : position.y) = value;
+      entity.setPosition(position);
+    } break;
+    case Property::AnchorPoint: {
+      auto anchor = entity.anchorPoint();
+      (axis == Axis::X ? anchor.x : anchor.y) = value;
+      entity.setAnchorPoint(anchor);
+    } break;
+    case Property::Bounds: {
+      auto bounds = entity.bounds();
+      (axis == Axis::X ? bounds.origin.x : bounds.origin.y) = value;
+      entity.setBounds(bounds);
+    } break;
+    case Property::Opacity:
+      entity.setOpacity(value);
+      break;
+    case Property::StrokeSize:
+      entity.setStrokeSize(value);
+      break;
+    default:
+      RL_ASSERT_MSG(false, "Property cannot be simulated");
+      break;
+  }
+}
+
+SimulationTrack::SimulationTrack() = default;
+
+size_t SimulationTrack::size() const {
+  return _keys.size();
+}
+
+bool SimulationTrack::set(const core::ClockPoint& startTime,
+                          const SimulationDescriptor& descriptor,
+                          entity::Entity& entity) {
+  if (!descriptor.isValid()) {
+    return false;
+  }
+
+  auto simulation = descriptor.createSimulation();
+  if (!simulation) {
+    return false;
+  }
+
+  Key key(descriptor.identifier(), descriptor.property());
+
+  auto found = _index.find(Component(key, descriptor.axis()));
+  if (found != _index.end()) {
+    const auto slot = found->second;
+    _entities[slot] = &entity;
+    _start[slot] = startTime;
+    _simulations[slot] = std::move(simulation);
+    return true;
+  }
+
+  _index.emplace(Component(key, descriptor.axis()), _keys.size());
+  _keys.emplace_back(key);
+  _axes.emplace_back(descriptor.axis());
+  _entities.emplace_back(&entity);
+  _start.emplace_back(startTime);
+  _simulations.emplace_back(std::move(simulation));
+  return true;
+}
+
+size_t SimulationTrack::step(const core::ClockPoint& time,
+                             std::vector<Key>& finished) {
+  const auto count = size();
+
+  /*
+   *  Walk backwards so that the simulation moved into a retired slot has
+   *  already been stepped.
+   */
+  for (size_t i = count; i > 0; i--) {
+    const auto slot = i - 1;
+    auto elapsed = time - _start[slot];
+    if (elapsed < core::ClockDuration::zero()) {
+      elapsed = core::ClockDuration::zero();
+    }
+
+    const auto& simulation = *_simulations[slot];
+    ApplyComponent(*_entities[slot], _keys[slot].entityProperty, _axes[slot],
+                   simulation.x(elapsed));
+
+    if (simulation.isDone(elapsed)) {
+      retire(slot, finished);
+    }
+  }
+
+  return count;
+}
+
+void SimulationTrack::retire(size_t slot, std::vector<Key>& finished) {
+  const auto last = size() - 1;
+
+  _index.erase(Component(_keys[slot], _axes[slot]));
+  finished.emplace_back(_keys[slot]);
+
+  if (slot != last) {
+    _keys[slot] = _keys[last];
+    _axes[slot] = _axes[last];
+    _entities[slot] = _entities[last];
+    _start[slot] = _start[last];
+    _simulations[slot] = std::move(_simulations[last]);
+    _index[Component(_keys[slot], _axes[slot])] = slot;
+  }
+
+  _keys.pop_back();
+  _axes.pop_back();
+  _entities.pop_back();
+  _start.pop_back();
+  _simulations.pop_back();
+}
+
+}  // namespace animation
+}  // namespace rl
@@ -0,0 +1,96 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Animation/Director.h>
+#include <Animation/SimulationDescriptor.h>
+#include <Core/Macros.h>
+#include <unordered_map>
+#include <vector>
+
+namespace rl {
+namespace animation {
+
+/**
+ *  All running physics simulations. A simulation drives one component of an
+ *  entity property until it reports that it is done. Simulations are
+ *  addressed by their slot in the arrays. Retiring a simulation moves the
+ *  last one into its slot.
+ */
+class SimulationTrack {
+ public:
+  using Key = Director::Key;
+
+  SimulationTrack();
+
+  size_t size() const;
+
+  /**
+   *  Start simulating the component of the entity property targeted by the
+   *  descriptor. Replaces the simulation already running for the same
+   *  component.
+   *
+   *  @return if the descriptor was valid. Nothing is replaced if it was not.
+   */
+  bool set(const core::ClockPoint& startTime,
+           const SimulationDescriptor& descriptor,
+           entity::Entity& entity);
+
+  /**
+   *  Apply the positions of all simulations at the given time to the entity
+   *  properties and retire the simulations that are done.
+   *
+   *  @param time     the time to step the simulations to
+   *  @param finished the keys of the simulations retired in this step are
+   *                  appended here
+   *
+   *  @return the number of simulations stepped
+   */
+  size_t step(const core::ClockPoint& time, std::vector<Key>& finished);
+
+ private:
+  using Axis = SimulationDescriptor::Axis;
+
+  struct Component {
+    Key key;
+    Axis axis;
+    Component(Key k, Axis a) : key(k), axis(a) {}
+
+    struct Hash {
+      std::size_t operator()(const Component& component) const {
+        size_t seed = Key::Hash()(component.key);
+        core::HashCombine(seed, static_cast<uint64_t>(component.axis));
+        return seed;
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Component& lhs, const Component& rhs) const {
+        return Key::Equal()(lhs.key, rhs.key) && lhs.axis == rhs.axis;
+      }
+    };
+  };
+
+  using Index = std::unordered_map<Component,
+                                   size_t,
+                                   Component::Hash,
+                                   Component::Equal>;
+
+  Index _index;
+
+  std::vector<Key> _keys;
+  std::vector<Axis> _axes;
+  std::vector<entity::Entity*> _entities;
+  std::vector<core::ClockPoint> _start;
+  std::vector<std::unique_ptr<Simulation>> _simulations;
+
+  void retire(size_t slot, std::vector<Key>& finished);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SimulationTrack);
+};
+
+}  // namespace animation
+}  // namespace rl
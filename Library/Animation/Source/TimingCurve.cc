@@ -4,7 +4,16 @@
  */
 
 #include <Animation/TimingCurve.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#define RL_TIMING_CURVE_SSE2 1
+#include <emmintrin.h>
+#else
+#define RL_TIMING_CURVE_SSE2 0
+#endif
 
 namespace rl {
 namespace animation {
@@ -105,22 +114,379 @@ static inline double TimingCurve_SolveX(double ax,
   return TimingCurve_SampleCurve(ay, by, cy, xSolution);
 }
 
+/*
+ *  ============================================================================
+ *  Sampling curves.
+ *  ============================================================================
+ */
+
+const double TimingCurve::MaximumSampleError = 1e-4;
+
+struct TimingCurve::Samples {
+  /*
+   *  The coefficients of the cubic Hermite spline through each pair of
+   *  adjacent samples, lowest order first. The spline is evaluated at the
+   *  position of the unit time within the interval. The extra interval is
+   *  the constant end value so that a unit time of 1 needs no special case.
+   */
+  double coefficients[SampleCount + 1][4];
+};
+
+struct TimingCurve_Coefficients {
+  double a;
+  double b;
+  double c;
+};
+
+static constexpr TimingCurve_Coefficients TimingCurve_MakeCoefficients(
+    double c1,
+    double c2) {
+  /*
+   *  Same as the coefficients computed by the constructor.
+   */
+  return {
+      1.0 - 3.0 * c1 - (3.0 * (c2 - c1) - 3.0 * c1),  // a
+      3.0 * (c2 - c1) - 3.0 * c1,                     // b
+      3.0 * c1,                                       // c
+  };
+}
+
+static constexpr double TimingCurve_Sample(TimingCurve_Coefficients k,
+                                           double t) {
+  return ((k.a * t + k.b) * t + k.c) * t;
+}
+
+static constexpr double TimingCurve_Derivative(TimingCurve_Coefficients k,
+                                               double t) {
+  return (3.0 * k.a * t + 2.0 * k.b) * t + k.c;
+}
+
+static constexpr double TimingCurve_SecondDerivative(
+    TimingCurve_Coefficients k,
+    double t) {
+  return 6.0 * k.a * t + 2.0 * k.b;
+}
+
+static constexpr double TimingCurve_Abs(double value) {
+  return value < 0.0 ? -value : value;
+}
+
+static constexpr bool TimingCurve_IsZero(double value) {
+  return TimingCurve_Abs(value) < 1e-9;
+}
+
+/**
+ *  The slope of the progress along the time axis at the given parameter.
+ *  Where both derivatives vanish, the slope is the limit of the ratio of the
+ *  first higher derivatives that do not. Where only the time derivative
+ *  vanishes, the curve is vertical and the slope is infinite.
+ */
+static constexpr double TimingCurve_Slope(TimingCurve_Coefficients x,
+                                          TimingCurve_Coefficients y,
+                                          double t) {
+  double dx = TimingCurve_Derivative(x, t);
+  double dy = TimingCurve_Derivative(y, t);
+  if (TimingCurve_IsZero(dx) && TimingCurve_IsZero(dy)) {
+    dx = TimingCurve_SecondDerivative(x, t);
+    dy = TimingCurve_SecondDerivative(y, t);
+  }
+  if (TimingCurve_IsZero(dx) && TimingCurve_IsZero(dy)) {
+    dx = 6.0 * x.a;
+    dy = 6.0 * y.a;
+  }
+  if (TimingCurve_IsZero(dx)) {
+    if (TimingCurve_IsZero(dy)) {
+      return 0.0;
+    }
+    return dy < 0.0 ? -std::numeric_limits<double>::infinity()
+                    : std::numeric_limits<double>::infinity();
+  }
+  return dy / dx;
+}
+
+/**
+ *  Find the parameter of the curve at which it reaches the given unit time by
+ *  bisection. Slow but usable in constant expressions and accurate to the
+ *  precision of a double.
+ */
+static constexpr double TimingCurve_Bisect(TimingCurve_Coefficients x,
+                                           double time) {
+  double low = 0.0;
+  double high = 1.0;
+  for (int i = 0; i < 64; i++) {
+    const double middle = (low + high) * 0.5;
+    if (TimingCurve_Sample(x, middle) < time) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return (low + high) * 0.5;
+}
+
+/**
+ *  The parameter, progress and slope of a curve at each sampled unit time.
+ *  Slopes are scaled to the width of a sample interval.
+ */
+struct TimingCurve_Knots {
+  double parameters[TimingCurve::SampleCount + 1];
+  double values[TimingCurve::SampleCount + 1];
+  double slopes[TimingCurve::SampleCount + 1];
+};
+
+static constexpr TimingCurve_Knots TimingCurve_MakeKnots(double c1x,
+                                                         double c1y,
+                                                         double c2x,
+                                                         double c2y) {
+  const auto x = TimingCurve_MakeCoefficients(c1x, c2x);
+  const auto y = TimingCurve_MakeCoefficients(c1y, c2y);
+  const size_t count = TimingCurve::SampleCount;
+
+  TimingCurve_Knots knots{};
+
+  for (size_t i = 0; i <= count; i++) {
+    /*
+     *  The end points of all curves are fixed. Pin them so that finished
+     *  animations settle on their end values exactly.
+     */
+    const double t = i == 0 ? 0.0
+                            : i == count ? 1.0
+                                         : TimingCurve_Bisect(
+                                               x, static_cast<double>(i) /
+                                                      count);
+
+    knots.parameters[i] = t;
+    knots.values[i] =
+        i == 0 ? 0.0 : i == count ? 1.0 : TimingCurve_Sample(y, t);
+
+    knots.slopes[i] = TimingCurve_Slope(x, y, t) / count;
+  }
+
+  return knots;
+}
+
+static constexpr TimingCurve::Samples TimingCurve_MakeSamples(
+    const TimingCurve_Knots& knots) {
+  const auto& values = knots.values;
+  const auto& slopes = knots.slopes;
+  const size_t count = TimingCurve::SampleCount;
+
+  TimingCurve::Samples samples{};
+
+  for (size_t i = 0; i < count; i++) {
+    auto& coefficients = samples.coefficients[i];
+    coefficients[0] = values[i];
+    coefficients[1] = slopes[i];
+    coefficients[2] =
+        3.0 * (values[i + 1] - values[i]) - 2.0 * slopes[i] - slopes[i + 1];
+    coefficients[3] =
+        2.0 * (values[i] - values[i + 1]) + slopes[i] + slopes[i + 1];
+  }
+
+  samples.coefficients[count][0] = values[count];
+
+  return samples;
+}
+
+/**
+ *  Mark the sample intervals in which the progress of the curve turns around.
+ *  These are the intervals containing the roots of the derivative of the
+ *  progress within the curve.
+ */
+static void TimingCurve_FindTurningIntervals(TimingCurve_Coefficients x,
+                                             TimingCurve_Coefficients y,
+                                             bool* turning) {
+  /*
+   *  `3 a t^2 + 2 b t + c'
+   */
+  const double a = 3.0 * y.a;
+  const double b = 2.0 * y.b;
+  const double c = y.c;
+
+  double roots[2] = {-1.0, -1.0};
+  if (TimingCurve_IsZero(a)) {
+    if (!TimingCurve_IsZero(b)) {
+      roots[0] = -c / b;
+    }
+  } else {
+    const double discriminant = b * b - 4.0 * a * c;
+    if (discriminant >= 0.0) {
+      const double root = std::sqrt(discriminant);
+      roots[0] = (-b - root) / (2.0 * a);
+      roots[1] = (-b + root) / (2.0 * a);
+    }
+  }
+
+  for (auto root : roots) {
+    if (root <= 0.0 || root >= 1.0) {
+      continue;
+    }
+    const double time = TimingCurve_Sample(x, root);
+    const auto interval = static_cast<size_t>(time * TimingCurve::SampleCount);
+    turning[std::min(interval, TimingCurve::SampleCount - 1)] = true;
+  }
+}
+
+/**
+ *  Check that the tangents at the ends of a sample interval in which the curve
+ *  is monotone keep the spline through them monotone too. Fritsch and Carlson
+ *  show that this is the case when the ratios `a' and `b' of the tangents to
+ *  the secant of the interval are not negative and `a^2 + b^2 <= 9'. Curves
+ *  that are vertical somewhere have infinite tangents and fail this check.
+ */
+static bool TimingCurve_IsMonotone(double secant, double m0, double m1) {
+  if (secant == 0.0) {
+    return m0 == 0.0 && m1 == 0.0;
+  }
+  const double alpha = m0 / secant;
+  const double beta = m1 / secant;
+  return alpha >= 0.0 && beta >= 0.0 && alpha * alpha + beta * beta <= 9.0;
+}
+
+/**
+ *  Check that the spline through the knots of a curve follows the curve.
+ *
+ *  The progress of the curve must be a function of time. This is the case
+ *  when the control points are within the unit interval along the time axis.
+ *  Otherwise, the curve folds back on itself.
+ *
+ *  Where the curve is monotone within a sample interval, the spline must be
+ *  monotone too. And the spline must stay within `MaximumSampleError' of
+ *  points on the curve between the knots. Those points are found by
+ *  evaluating the curve at parameters between the parameters of the knots.
+ *  Unlike finding the progress at a given unit time, this needs no iteration.
+ */
+static bool TimingCurve_CanSample(const geom::Point& c1,
+                                  const geom::Point& c2,
+                                  const TimingCurve_Knots& knots) {
+  if (c1.x < 0.0 || c1.x > 1.0 || c2.x < 0.0 || c2.x > 1.0) {
+    return false;
+  }
+
+  const auto x = TimingCurve_MakeCoefficients(c1.x, c2.x);
+  const auto y = TimingCurve_MakeCoefficients(c1.y, c2.y);
+  const size_t count = TimingCurve::SampleCount;
+
+  /*
+   *  The progress of curves that overshoot turns around at most twice. The
+   *  spline turns around there too.
+   */
+  bool turning[count] = {};
+  TimingCurve_FindTurningIntervals(x, y, turning);
+
+  const size_t checks = 4;
+
+  for (size_t i = 0; i < count; i++) {
+    const double secant = knots.values[i + 1] - knots.values[i];
+    const double m0 = knots.slopes[i];
+    const double m1 = knots.slopes[i + 1];
+
+    if (!std::isfinite(m0) || !std::isfinite(m1)) {
+      return false;
+    }
+
+    if (!turning[i] && !TimingCurve_IsMonotone(secant, m0, m1)) {
+      return false;
+    }
+
+    const double c2 = 3.0 * secant - 2.0 * m0 - m1;
+    const double c3 = -2.0 * secant + m0 + m1;
+
+    for (size_t j = 1; j < checks; j++) {
+      const double fraction = static_cast<double>(j) / checks;
+      const double parameter =
+          knots.parameters[i] +
+          (knots.parameters[i + 1] - knots.parameters[i]) * fraction;
+      const double f = TimingCurve_Sample(x, parameter) * count - i;
+      const double spline = ((c3 * f + c2) * f + m0) * f + knots.values[i];
+      const double exact = TimingCurve_Sample(y, parameter);
+      if (TimingCurve_Abs(spline - exact) > TimingCurve::MaximumSampleError) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static constexpr TimingCurve::Samples LinearSamples =
+    TimingCurve_MakeSamples(TimingCurve_MakeKnots(0.0, 0.0, 1.0, 1.0));
+static constexpr TimingCurve::Samples EaseInSamples =
+    TimingCurve_MakeSamples(TimingCurve_MakeKnots(0.42, 0.0, 1.0, 1.0));
+static constexpr TimingCurve::Samples EaseOutSamples =
+    TimingCurve_MakeSamples(TimingCurve_MakeKnots(0.0, 0.0, 0.58, 1.0));
+static constexpr TimingCurve::Samples EaseInEaseOutSamples =
+    TimingCurve_MakeSamples(TimingCurve_MakeKnots(0.42, 0.0, 0.58, 1.0));
+
+static inline double TimingCurve_Clamp(double t) {
+  return t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+}
+
+/**
+ *  Evaluate the spline through the samples around the given unit time.
+ */
+static inline double TimingCurve_Interpolate(
+    const TimingCurve::Samples& samples,
+    double t) {
+  const double position = TimingCurve_Clamp(t) * TimingCurve::SampleCount;
+  const auto interval = static_cast<size_t>(position);
+  const double f = position - interval;
+  const auto& c = samples.coefficients[interval];
+  return ((c[3] * f + c[2]) * f + c[1]) * f + c[0];
+}
+
+#if RL_TIMING_CURVE_SSE2
+static inline void TimingCurve_InterpolatePair(
+    const TimingCurve::Samples& samples,
+    const double* t,
+    double* out) {
+  const auto clamped = _mm_min_pd(
+      _mm_max_pd(_mm_loadu_pd(t), _mm_setzero_pd()), _mm_set1_pd(1.0));
+  const auto position =
+      _mm_mul_pd(clamped, _mm_set1_pd(TimingCurve::SampleCount));
+
+  double positions[2];
+  _mm_storeu_pd(positions, position);
+  const auto i0 = static_cast<size_t>(positions[0]);
+  const auto i1 = static_cast<size_t>(positions[1]);
+  const auto& c0 = samples.coefficients[i0];
+  const auto& c1 = samples.coefficients[i1];
+
+  const auto f = _mm_sub_pd(position, _mm_set_pd(i1, i0));
+
+  auto result = _mm_set_pd(c1[3], c0[3]);
+  result = _mm_add_pd(_mm_mul_pd(result, f), _mm_set_pd(c1[2], c0[2]));
+  result = _mm_add_pd(_mm_mul_pd(result, f), _mm_set_pd(c1[1], c0[1]));
+  result = _mm_add_pd(_mm_mul_pd(result, f), _mm_set_pd(c1[0], c0[0]));
+  _mm_storeu_pd(out, result);
+}
+#endif
+
+/*
+ *  ============================================================================
+ *  Timing curves.
+ *  ============================================================================
+ */
+
 TimingCurve TimingCurve::SystemTimingCurve(Type type) {
   switch (type) {
     case Type::Linear:
-      return TimingCurve({0.0, 0.0}, {1.0, 1.0});
+      return TimingCurve({0.0, 0.0}, {1.0, 1.0}, &LinearSamples);
     case Type::EaseIn:
-      return TimingCurve({0.42, 0.0}, {1.0, 1.0});
+      return TimingCurve({0.42, 0.0}, {1.0, 1.0}, &EaseInSamples);
     case Type::EaseOut:
-      return TimingCurve({0.0, 0.0}, {0.58, 1.0});
+      return TimingCurve({0.0, 0.0}, {0.58, 1.0}, &EaseOutSamples);
     case Type::EaseInEaseOut:
-      return TimingCurve({0.42, 0.0}, {0.58, 1.0});
+      return TimingCurve({0.42, 0.0}, {0.58, 1.0}, &EaseInEaseOutSamples);
   }
 
-  return TimingCurve({0.0, 0.0}, {1.0, 1.0});
+  return TimingCurve({0.0, 0.0}, {1.0, 1.0}, &LinearSamples);
 }
 
-TimingCurve::TimingCurve(const geom::Point& c1, const geom::Point& c2) {
+TimingCurve::TimingCurve(const geom::Point& c1,
+                         const geom::Point& c2,
+                         const Samples* samples)
+    : _samples(samples) {
   _cx = 3.0 * c1.x;
   _bx = 3.0 * (c2.x - c1.x) - _cx;
   _ax = 1.0 - _cx - _bx;
@@ -130,8 +496,56 @@ TimingCurve::TimingCurve(const geom::Point& c1, const geom::Point& c2) {
   _ay = 1.0 - _cy - _by;
 }
 
+TimingCurve::TimingCurve(const geom::Point& c1, const geom::Point& c2)
+    : TimingCurve(c1, c2, nullptr) {
+  const auto knots = TimingCurve_MakeKnots(c1.x, c1.y, c2.x, c2.y);
+
+  /*
+   *  Curves that cannot be sampled are solved instead.
+   */
+  if (!TimingCurve_CanSample(c1, c2, knots)) {
+    return;
+  }
+
+  _ownedSamples = std::make_shared<Samples>(TimingCurve_MakeSamples(knots));
+  _samples = _ownedSamples.get();
+}
+
+bool TimingCurve::isSampled() const {
+  return _samples != nullptr;
+}
+
 double TimingCurve::x(double t) const {
-  return TimingCurve_SolveX(_ax, _bx, _cx, _ay, _by, _cy, t, 1e-3);
+  if (_samples == nullptr) {
+    return solve(t, 1e-6);
+  }
+
+  return TimingCurve_Interpolate(*_samples, t);
+}
+
+void TimingCurve::evaluate(const double* t, double* out, size_t n) const {
+  size_t i = 0;
+
+  if (_samples == nullptr) {
+    for (; i < n; i++) {
+      out[i] = solve(t[i], 1e-6);
+    }
+    return;
+  }
+
+#if RL_TIMING_CURVE_SSE2
+  for (; i + 2 <= n; i += 2) {
+    TimingCurve_InterpolatePair(*_samples, t + i, out + i);
+  }
+#endif
+
+  for (; i < n; i++) {
+    out[i] = TimingCurve_Interpolate(*_samples, t[i]);
+  }
+}
+
+double TimingCurve::solve(double t, double epsilon) const {
+  return TimingCurve_SolveX(_ax, _bx, _cx, _ay, _by, _cy, t, epsilon);
 }
 
 }  // namespace animation
@@ -0,0 +1,167 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/Director.h>
+#include <TestRunner/TestRunner.h>
+#include "Lerp.h"
+
+namespace rl {
+namespace animation {
+namespace testing {
+
+using Property = entity::Entity::Property;
+
+static core::ClockPoint After(const core::ClockPoint& start, double seconds) {
+  return start + core::ClockDuration(seconds);
+}
+
+TEST(DirectorTest, FinishedInterpolationsAreRetired) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+
+  std::vector<Director::Key> completed;
+  Director director(
+      [&](const Director::Key& key) { completed.emplace_back(key); });
+  instrumentation::Stopwatch stopwatch;
+
+  const auto start = core::Clock::now();
+  Director::Key key(entity.identifier(), Property::Opacity);
+  director.setInterpolator(key, start, Action(1.0), 0.0, 1.0, entity);
+  ASSERT_EQ(director.interpolationsCount(), 1u);
+
+  ASSERT_EQ(director.stepInterpolations(stopwatch, After(start, 0.25)), 1u);
+  ASSERT_DOUBLE_EQ(entity.opacity(), 0.25);
+  ASSERT_EQ(completed.size(), 0u);
+
+  /*
+   *  The step past the end applies the final value exactly and retires the
+   *  interpolation.
+   */
+  ASSERT_EQ(director.stepInterpolations(stopwatch, After(start, 1.5)), 1u);
+  ASSERT_EQ(entity.opacity(), 1.0);
+  ASSERT_EQ(director.interpolationsCount(), 0u);
+  ASSERT_EQ(completed.size(), 1u);
+  ASSERT_TRUE(Director::Key::Equal()(completed[0], key));
+
+  ASSERT_EQ(director.stepInterpolations(stopwatch, After(start, 2.0)), 0u);
+  ASSERT_EQ(completed.size(), 1u);
+}
+
+TEST(DirectorTest, RepetitionsAndReversalsAreHonored) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+  Director director;
+  instrumentation::Stopwatch stopwatch;
+
+  Action action(1.0);
+  action.setRepeatCount(2);
+  action.setAutoReverses(true);
+
+  const auto start = core::Clock::now();
+  director.setInterpolator(
+      Director::Key(entity.identifier(), Property::Position), start, action,
+      geom::Point{0.0, 0.0}, geom::Point{100.0, 200.0}, entity);
+
+  director.stepInterpolations(stopwatch, After(start, 0.5));
+  ASSERT_DOUBLE_EQ(entity.position().x, 50.0);
+  ASSERT_DOUBLE_EQ(entity.position().y, 100.0);
+
+  director.stepInterpolations(stopwatch, After(start, 1.25));
+  ASSERT_DOUBLE_EQ(entity.position().x, 75.0);
+  ASSERT_DOUBLE_EQ(entity.position().y, 150.0);
+  ASSERT_EQ(director.interpolationsCount(), 1u);
+
+  /*
+   *  The reversed second repetition ends where the first one started.
+   */
+  director.stepInterpolations(stopwatch, After(start, 2.0));
+  ASSERT_EQ(entity.position(), geom::Point(0.0, 0.0));
+  ASSERT_EQ(director.interpolationsCount(), 0u);
+}
+
+TEST(DirectorTest, NewInterpolationsReplaceRunningOnes) {
+  core::Namespace ns;
+  entity::Entity first(core::Name{ns});
+  entity::Entity second(core::Name{ns});
+
+  size_t completions = 0;
+  Director director([&](const Director::Key&) { completions++; });
+  instrumentation::Stopwatch stopwatch;
+
+  const auto start = core::Clock::now();
+  const geom::Rect from(0.0, 0.0, 10.0, 10.0);
+  const geom::Rect to(10.0, 10.0, 20.0, 20.0);
+
+  director.setInterpolator(Director::Key(first.identifier(), Property::Bounds),
+                           start, Action(1.0), from, to, first);
+  director.setInterpolator(Director::Key(second.identifier(), Property::Bounds),
+                           start, Action(1.0), from, to, second);
+  director.setInterpolator(Director::Key(first.identifier(), Property::Bounds),
+                           After(start, 0.5), Action(1.0), to, from, first);
+  ASSERT_EQ(director.interpolationsCount(), 2u);
+
+  director.stepInterpolations(stopwatch, After(start, 1.0));
+  ASSERT_EQ(second.bounds(), to);
+  ASSERT_EQ(first.bounds(), geom::Rect(5.0, 5.0, 15.0, 15.0));
+  ASSERT_EQ(completions, 1u);
+
+  director.stepInterpolations(stopwatch, After(start, 1.5));
+  ASSERT_EQ(first.bounds(), from);
+  ASSERT_EQ(completions, 2u);
+  ASSERT_EQ(director.interpolationsCount(), 0u);
+}
+
+TEST(DirectorTest, BatchedLerpsMatchIndividualLerps) {
+  std::vector<double> unit;
+  std::vector<double> fromNumbers, toNumbers;
+  std::vector<geom::Rect> fromRects, toRects;
+  std::vector<entity::ColorHSB> fromColors, toColors;
+
+  /*
+   *  An odd count exercises the remainder of the paired number lerps.
+   */
+  const size_t count = 7;
+  for (size_t i = 0; i < count; i++) {
+    const double value = i;
+    unit.emplace_back(value / (count - 1));
+    fromNumbers.emplace_back(value);
+    toNumbers.emplace_back(-3.0 * value);
+    fromRects.emplace_back(value, 2.0 * value, 3.0, 4.0);
+    toRects.emplace_back(-value, 0.5, 30.0 * value, 40.0);
+    fromColors.emplace_back(0.1, 0.2, 0.3, value / count);
+    toColors.emplace_back(0.9, 0.8, 0.7, 1.0);
+  }
+
+  std::vector<double> numbers(count);
+  LerpBatch(fromNumbers.data(), toNumbers.data(), unit.data(), numbers.data(),
+            count);
+
+  std::vector<geom::Rect> rects(count);
+  LerpBatch(fromRects.data(), toRects.data(), unit.data(), rects.data(),
+            count);
+
+  std::vector<entity::ColorHSB> colors(count, fromColors[0]);
+  LerpBatch(fromColors.data(), toColors.data(), unit.data(), colors.data(),
+            count);
+
+  for (size_t i = 0; i < count; i++) {
+    ASSERT_EQ(numbers[i], Lerp(fromNumbers[i], toNumbers[i], unit[i]));
+    ASSERT_EQ(rects[i], Lerp(fromRects[i], toRects[i], unit[i]));
+
+    const auto color = Lerp(fromColors[i], toColors[i], unit[i]);
+    ASSERT_EQ(colors[i].hue, color.hue);
+    ASSERT_EQ(colors[i].saturation, color.saturation);
+    ASSERT_EQ(colors[i].brightness, color.brightness);
+    ASSERT_EQ(colors[i].alpha, color.alpha);
+  }
+
+  ASSERT_EQ(numbers[0], fromNumbers[0]);
+  ASSERT_EQ(numbers[count - 1], toNumbers[count - 1]);
+  ASSERT_EQ(rects[count - 1], toRects[count - 1]);
+}
+
+}  // namespace testing
+}  // namespace animation
+}  // namespace rl
@@ -0,0 +1,233 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/Director.h>
+#include <Animation/SimulationDescriptor.h>
+#include <Core/Message.h>
+#include <TestRunner/TestRunner.h>
+#include <cmath>
+
+namespace rl {
+namespace animation {
+namespace testing {
+
+using Property = entity::Entity::Property;
+
+/*
+ *  Simulations are stepped on a fake clock with a fixed frame interval so that
+ *  the results do not depend on the speed of the machine running the tests.
+ */
+static const core::ClockDuration FrameInterval(1.0 / 60.0);
+static const size_t MaximumFrames = 60 * 10;
+
+static core::ClockPoint FakeStart() {
+  return core::ClockPoint(core::ClockDuration(1000.0));
+}
+
+/**
+ *  Step the director one frame at a time until it has nothing left to step.
+ *
+ *  @return the number of frames stepped
+ */
+static size_t StepUntilIdle(Director& director,
+                            const core::ClockPoint& start) {
+  instrumentation::Stopwatch stopwatch;
+  size_t frames = 0;
+  auto time = start;
+  while (frames < MaximumFrames &&
+         director.stepInterpolations(stopwatch, time) > 0) {
+    time += FrameInterval;
+    frames++;
+  }
+  return frames;
+}
+
+TEST(SimulationTest, FrictionFlingSettlesAndRetires) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+  entity.setPosition({0.0, 50.0});
+
+  std::vector<Director::Key> completed;
+  Director director(
+      [&](const Director::Key& key) { completed.emplace_back(key); });
+
+  auto fling = SimulationDescriptor::Friction(0.01, 0.0, 1000.0);
+  fling.setTarget(entity.identifier(), Property::Position,
+                  SimulationDescriptor::Axis::X);
+  director.setSimulation(FakeStart(), fling, entity);
+  ASSERT_EQ(director.simulationsCount(), 1u);
+
+  /*
+   *  Velocity decays by the drag each second and falls under the tolerance
+   *  after three seconds.
+   */
+  const auto frames = StepUntilIdle(director, FakeStart());
+  ASSERT_GT(frames, 170u);
+  ASSERT_LT(frames, 190u);
+
+  ASSERT_NEAR(entity.position().x, -1000.0 / std::log(0.01), 1e-2);
+  ASSERT_EQ(entity.position().y, 50.0);
+  ASSERT_EQ(director.simulationsCount(), 0u);
+  ASSERT_EQ(completed.size(), 1u);
+  ASSERT_TRUE(Director::Key::Equal()(
+      completed[0], Director::Key(entity.identifier(), Property::Position)));
+}
+
+TEST(SimulationTest, ScrollPastTrailingEdgeSpringsBack) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+  entity.setBounds({0.0, 0.0, 100.0, 100.0});
+
+  Director director;
+
+  auto scroll = SimulationDescriptor::Scroll(
+      120.0, 0.0, 0.0, 100.0, SpringDescription::WithRatio(1.0, 100.0, 1.0),
+      0.1);
+  scroll.setTarget(entity.identifier(), Property::Bounds,
+                   SimulationDescriptor::Axis::Y);
+  director.setSimulation(FakeStart(), scroll, entity);
+
+  instrumentation::Stopwatch stopwatch;
+  director.stepInterpolations(stopwatch, FakeStart() + FrameInterval);
+  ASSERT_LT(entity.bounds().origin.y, 120.0);
+  ASSERT_GT(entity.bounds().origin.y, 100.0);
+
+  StepUntilIdle(director, FakeStart() + 2 * FrameInterval);
+  ASSERT_EQ(director.simulationsCount(), 0u);
+  ASSERT_NEAR(entity.bounds().origin.y, 100.0, 1e-3);
+  ASSERT_EQ(entity.bounds().origin.x, 0.0);
+  ASSERT_EQ(entity.bounds().size, geom::Size(100.0, 100.0));
+}
+
+TEST(SimulationTest, NewSimulationsReplaceRunningOnes) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+
+  size_t completions = 0;
+  Director director([&](const Director::Key&) { completions++; });
+
+  auto fadeIn = SimulationDescriptor::Gravity(2.0, 0.0, 1.0, 0.0);
+  fadeIn.setTarget(entity.identifier(), Property::Opacity);
+  auto moveX = SimulationDescriptor::Friction(0.01, 0.0, 10.0);
+  moveX.setTarget(entity.identifier(), Property::Position,
+                  SimulationDescriptor::Axis::X);
+  auto moveY = SimulationDescriptor::Friction(0.01, 0.0, 10.0);
+  moveY.setTarget(entity.identifier(), Property::Position,
+                  SimulationDescriptor::Axis::Y);
+
+  director.setSimulation(FakeStart(), fadeIn, entity);
+  director.setSimulation(FakeStart(), moveX, entity);
+  director.setSimulation(FakeStart(), moveY, entity);
+  director.setSimulation(FakeStart(), fadeIn, entity);
+  ASSERT_EQ(director.simulationsCount(), 3u);
+
+  StepUntilIdle(director, FakeStart());
+  ASSERT_EQ(director.simulationsCount(), 0u);
+  ASSERT_EQ(completions, 3u);
+  ASSERT_GE(entity.opacity(), 1.0);
+  ASSERT_EQ(entity.position().x, entity.position().y);
+}
+
+TEST(SimulationTest, ReplacementsFindSimulationsMovedByRetirement) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+
+  Director director;
+
+  auto fadeIn = SimulationDescriptor::Gravity(2.0, 0.0, 1.0, 0.0);
+  fadeIn.setTarget(entity.identifier(), Property::Opacity);
+  auto fling = SimulationDescriptor::Friction(0.01, 0.0, 1000.0);
+  fling.setTarget(entity.identifier(), Property::Position,
+                  SimulationDescriptor::Axis::X);
+
+  director.setSimulation(FakeStart(), fadeIn, entity);
+  director.setSimulation(FakeStart(), fling, entity);
+  ASSERT_EQ(director.simulationsCount(), 2u);
+
+  /*
+   *  Retiring the fade moves the fling into its slot. Starting the fling again
+   *  must replace it in the new slot.
+   */
+  instrumentation::Stopwatch stopwatch;
+  auto time = FakeStart();
+  while (director.simulationsCount() > 1) {
+    time += FrameInterval;
+    director.stepInterpolations(stopwatch, time);
+  }
+
+  director.setSimulation(time, fling, entity);
+  ASSERT_EQ(director.simulationsCount(), 1u);
+  director.setSimulation(time, fadeIn, entity);
+  ASSERT_EQ(director.simulationsCount(), 2u);
+}
+
+TEST(SimulationTest, DescriptorsSurviveMessages) {
+  core::Namespace ns;
+  entity::Entity entity(core::Name{ns});
+
+  auto spring = SimulationDescriptor::Spring(
+      SpringDescription(1.0, 200.0, 5.0), 10.0, 40.0, 3.0);
+  spring.setTarget(entity.identifier(), Property::AnchorPoint,
+                   SimulationDescriptor::Axis::Y);
+
+  core::Message message;
+  ASSERT_TRUE(message.encode(spring));
+
+  core::Namespace otherNS;
+  SimulationDescriptor decoded;
+  ASSERT_TRUE(message.decode(decoded, &otherNS));
+
+  ASSERT_EQ(decoded.type(), SimulationDescriptor::Type::Spring);
+  ASSERT_FALSE(decoded.identifier().isDead());
+  ASSERT_EQ(decoded.property(), Property::AnchorPoint);
+  ASSERT_EQ(decoded.axis(), SimulationDescriptor::Axis::Y);
+
+  auto expected = spring.createSimulation();
+  auto actual = decoded.createSimulation();
+  for (double t = 0.0; t < 2.0; t += 0.25) {
+    ASSERT_EQ(actual->x(core::ClockDuration(t)),
+              expected->x(core::ClockDuration(t)));
+  }
+}
+
+TEST(SimulationTest, MalformedDescriptorsAreRejected) {
+  core::Namespace ns;
+  core::Name identifier(ns);
+
+  /*
+   *  A descriptor whose target was never set drives no property.
+   */
+  core::Message untargeted;
+  ASSERT_TRUE(untargeted.encode(SimulationDescriptor{}));
+  SimulationDescriptor decoded;
+  ASSERT_FALSE(untargeted.decode(decoded, &ns));
+
+  /*
+   *  Encode the fields of a descriptor by hand with a type that does not
+   *  exist.
+   */
+  core::Message unknownType;
+  ASSERT_TRUE(unknownType.encode(static_cast<uint8_t>(200)));
+  ASSERT_TRUE(unknownType.encode(identifier));
+  ASSERT_TRUE(unknownType.encode(Property::Position));
+  ASSERT_TRUE(unknownType.encode(SimulationDescriptor::Axis::X));
+  for (size_t i = 0; i < 9; i++) {
+    ASSERT_TRUE(unknownType.encode(1.0));
+  }
+  ASSERT_FALSE(unknownType.decode(decoded, &ns));
+
+  /*
+   *  Even if the track is handed such a descriptor, it is not started.
+   */
+  entity::Entity entity(identifier);
+  Director director;
+  ASSERT_FALSE(director.setSimulation(FakeStart(), SimulationDescriptor{},
+                                      entity));
+  ASSERT_EQ(director.simulationsCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace animation
+}  // namespace rl
@@ -0,0 +1,138 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Animation/TimingCurve.h>
+#include <TestRunner/TestRunner.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace rl {
+namespace animation {
+namespace testing {
+
+static const TimingCurve::Type SystemTypes[] = {
+    TimingCurve::Type::Linear,
+    TimingCurve::Type::EaseIn,
+    TimingCurve::Type::EaseOut,
+    TimingCurve::Type::EaseInEaseOut,
+};
+
+static double MaximumError(const TimingCurve& curve) {
+  double maximum = 0.0;
+  const size_t count = 10000;
+  for (size_t i = 0; i <= count; i++) {
+    const double t = static_cast<double>(i) / count;
+    maximum = std::max(maximum, std::fabs(curve.x(t) - curve.solve(t, 1e-12)));
+  }
+  return maximum;
+}
+
+TEST(TimingCurveTest, SystemCurvesAreWithinSampleError) {
+  for (auto type : SystemTypes) {
+    auto curve = TimingCurve::SystemTimingCurve(type);
+    ASSERT_TRUE(curve.isSampled());
+    ASSERT_LE(MaximumError(curve), TimingCurve::MaximumSampleError);
+  }
+}
+
+TEST(TimingCurveTest, EndPointsAreExact) {
+  for (auto type : SystemTypes) {
+    auto curve = TimingCurve::SystemTimingCurve(type);
+    ASSERT_EQ(curve.x(0.0), 0.0);
+    ASSERT_EQ(curve.x(1.0), 1.0);
+    ASSERT_EQ(curve.x(-0.5), 0.0);
+    ASSERT_EQ(curve.x(1.5), 1.0);
+  }
+}
+
+TEST(TimingCurveTest, BatchEvaluationMatchesIndividualEvaluation) {
+  std::vector<double> times;
+  for (size_t i = 0; i <= 101; i++) {
+    times.emplace_back(i / 101.0);
+  }
+
+  for (auto type : SystemTypes) {
+    auto curve = TimingCurve::SystemTimingCurve(type);
+
+    std::vector<double> values(times.size());
+    curve.evaluate(times.data(), values.data(), times.size());
+
+    std::vector<double> inPlace = times;
+    curve.evaluate(inPlace.data(), inPlace.data(), inPlace.size());
+
+    for (size_t i = 0; i < times.size(); i++) {
+      ASSERT_EQ(values[i], curve.x(times[i]));
+      ASSERT_EQ(inPlace[i], values[i]);
+    }
+  }
+}
+
+TEST(TimingCurveTest, CustomCurvesAreSampledWhenAccurate) {
+  TimingCurve overshoot({0.3, -0.4}, {0.7, 1.4});
+  ASSERT_TRUE(overshoot.isSampled());
+  ASSERT_LE(MaximumError(overshoot), TimingCurve::MaximumSampleError);
+
+  /*
+   *  Control points outside the unit square along the time axis make the
+   *  curve double back on itself. It cannot be sampled by time.
+   */
+  TimingCurve loop({1.5, 0.0}, {-0.5, 1.0});
+  ASSERT_FALSE(loop.isSampled());
+  ASSERT_EQ(loop.x(0.25), loop.solve(0.25, 1e-6));
+}
+
+TEST(TimingCurveTest, VerticalCurvesAreNotSampled) {
+  /*
+   *  Both control points sit on the progress axis. The curve leaves the
+   *  origin vertically.
+   */
+  TimingCurve vertical({0.0, 1.0}, {0.0, 1.0});
+  ASSERT_FALSE(vertical.isSampled());
+
+  /*
+   *  Almost vertical at the origin. The tangents at the knots are within the
+   *  monotone bounds but the curve bends too quickly between them.
+   */
+  TimingCurve steep({0.02, 1.6}, {0.5, 0.3});
+  ASSERT_FALSE(steep.isSampled());
+  ASSERT_EQ(steep.x(0.25), steep.solve(0.25, 1e-6));
+}
+
+TEST(TimingCurveTest, DegenerateCurvesAreSampled) {
+  /*
+   *  Both derivatives vanish at the origin. The slope there is the ratio of
+   *  the third derivatives.
+   */
+  TimingCurve linear({0.0, 0.0}, {0.0, 0.0});
+  ASSERT_TRUE(linear.isSampled());
+  ASSERT_LE(MaximumError(linear), TimingCurve::MaximumSampleError);
+}
+
+TEST(TimingCurveTest, SampledCustomCurvesAreWithinSampleError) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> time(0.0, 1.0);
+  std::uniform_real_distribution<double> progress(-1.0, 2.0);
+
+  size_t sampled = 0;
+  for (size_t i = 0; i < 200; i++) {
+    TimingCurve curve({time(generator), progress(generator)},
+                      {time(generator), progress(generator)});
+    if (!curve.isSampled()) {
+      continue;
+    }
+    sampled++;
+    ASSERT_LE(MaximumError(curve), TimingCurve::MaximumSampleError);
+  }
+
+  /*
+   *  Most curves with control points in these ranges can be sampled.
+   */
+  ASSERT_GT(sampled, 100u);
+}
+
+}  // namespace testing
+}  // namespace animation
+}  // namespace rl
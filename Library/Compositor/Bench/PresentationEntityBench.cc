@@ -0,0 +1,88 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Compositor/PresentationEntity.h>
+#include <memory>
+#include <vector>
+
+static const size_t kChildrenPerEntity = 8;
+
+using Entities =
+    std::vector<std::unique_ptr<rl::compositor::PresentationEntity>>;
+
+/**
+ *  Create a tree of colored boxes with the given number of entities. Each
+ *  entity has a fixed number of children. The last entity is a leaf at the
+ *  deepest level of the tree.
+ */
+static Entities CreateTree(rl::core::Namespace& ns, size_t count) {
+  Entities entities;
+  entities.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    entities.emplace_back(std::make_unique<rl::compositor::PresentationEntity>(
+        rl::core::Name{ns}));
+    auto& entity = *entities.back();
+    entity.setBounds({0.0, 0.0, 10.0, 10.0});
+    entity.setPosition({1.0, 1.0});
+    entity.setBackgroundColor(rl::entity::Color::Red());
+
+    if (i > 0) {
+      entities[(i - 1) / kChildrenPerEntity]->addChild(&entity);
+    }
+  }
+
+  return entities;
+}
+
+/*
+ *  Measures the time taken to render a frame of a large tree when only a
+ *  single entity has been updated since the last frame.
+ */
+static void RenderTree(benchmark::State& state, bool updateLeaf) {
+  const size_t count = state.range(0);
+
+  rl::core::Namespace ns;
+  auto entities = CreateTree(ns, count);
+  auto& root = *entities.front();
+  auto& updated = updateLeaf ? *entities.back() : root;
+
+  {
+    rl::compositor::FrontEndPass pass;
+    root.render(pass, {});
+  }
+
+  double offset = 0.0;
+
+  while (state.KeepRunning()) {
+    offset += 1.0;
+    updated.setPosition({offset, offset});
+
+    rl::compositor::FrontEndPass pass;
+    root.render(pass, {});
+    benchmark::DoNotOptimize(pass);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RenderTreeWithAnimatingLeaf(benchmark::State& state) {
+  RenderTree(state, true);
+}
+
+static void BM_RenderTreeWithAnimatingRoot(benchmark::State& state) {
+  RenderTree(state, false);
+}
+
+BENCHMARK(BM_RenderTreeWithAnimatingLeaf)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(10000, 100000);
+
+BENCHMARK(BM_RenderTreeWithAnimatingRoot)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(10000, 100000);
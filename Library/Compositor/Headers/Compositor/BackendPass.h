@@ -17,6 +17,7 @@ namespace compositor {
 
 class TextureTransaction;
 class Texture;
+class GlyphAtlasTexture;
 
 class BackEndPass {
  public:
@@ -28,14 +29,27 @@ class BackEndPass {
 
   void addFrontEndPass(FrontEndPass frontEndPass);
 
+  /**
+   *  @return the areas of the frame changed by any of the front-end passes
+   *          since the last frame
+   */
+  Damage damage() const;
+
   bool render(Frame& frame, core::WorkQueue* preparationWQ);
 
   RL_WARN_UNUSED_RESULT
   std::shared_ptr<Texture> prepareTexture(std::shared_ptr<Texture> texture);
 
+  /**
+   *  @return the atlas of the context being rendered into. Only available
+   *          while primitives are being prepared.
+   */
+  GlyphAtlasTexture* glyphAtlas() const;
+
  private:
   std::vector<FrontEndPass> _frontEndPasses;
   std::unique_ptr<TextureTransaction> _textureTransaction;
+  GlyphAtlasTexture* _glyphAtlas;
 
   RL_DISALLOW_COPY_AND_ASSIGN(BackEndPass);
 };
@@ -7,10 +7,42 @@
 
 #include <Core/Instrumentation.h>
 #include <Core/Macros.h>
+#include <Geometry/Size.h>
 
 namespace rl {
 namespace compositor {
 
+/**
+ *  The time spent in each phase of a single frame.
+ */
+struct FramePhaseTimings {
+  core::ClockDuration update;
+  core::ClockDuration constraints;
+  core::ClockDuration render;
+  core::ClockDuration present;
+
+  FramePhaseTimings()
+      : update(0.0), constraints(0.0), render(0.0), present(0.0) {}
+};
+
+/**
+ *  A snapshot of the effectiveness of a cache.
+ */
+struct CacheStatistics {
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t entries;
+  size_t bytes;
+
+  CacheStatistics() : hits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+
+  double hitRate() const {
+    const auto lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+  }
+};
+
 class CompositorStatistics {
  public:
   CompositorStatistics();
@@ -23,8 +55,55 @@ class CompositorStatistics {
 
   instrumentation::Counter& primitiveCount();
 
+  instrumentation::Counter& drawCallCount();
+
   instrumentation::Counter& frameCount();
 
+  instrumentation::Stopwatch& updatePhaseTimer();
+
+  instrumentation::Stopwatch& constraintsPhaseTimer();
+
+  instrumentation::Stopwatch& renderPhaseTimer();
+
+  instrumentation::Stopwatch& presentPhaseTimer();
+
+  instrumentation::Counter& missedDeadlinesCount();
+
+  /**
+   *  @return the statistics of the process wide tessellation cache as of the
+   *          end of the last frame
+   */
+  const CacheStatistics& tessellationCacheStatistics() const;
+
+  /**
+   *  @return the statistics of the process wide decoded image cache as of the
+   *          end of the last frame
+   */
+  const CacheStatistics& imageCacheStatistics() const;
+
+  /**
+   *  Record the timings of the phases of a frame that was paced to a deadline.
+   *
+   *  @param timings        the time spent in each phase of the frame
+   *  @param missedDeadline if the frame was presented after its deadline
+   */
+  void recordFramePhases(const FramePhaseTimings& timings,
+                         bool missedDeadline);
+
+  /**
+   *  Record the size of the region redrawn in the current frame.
+   *
+   *  @param damagedSize the size of the damaged region in pixels
+   *  @param frameSize   the size of the frame in pixels
+   */
+  void recordDamage(const geom::Size& damagedSize,
+                    const geom::Size& frameSize);
+
+  /**
+   *  @return the fraction of the pixels of the last frame that were redrawn
+   */
+  double damagedPixelFraction() const;
+
   void start();
 
   void stop();
@@ -33,7 +112,16 @@ class CompositorStatistics {
   instrumentation::Stopwatch _frameTimer;
   instrumentation::Counter _entityCount;
   instrumentation::Counter _primitiveCount;
+  instrumentation::Counter _drawCallCount;
   instrumentation::Counter _frameCount;
+  instrumentation::Stopwatch _updatePhaseTimer;
+  instrumentation::Stopwatch _constraintsPhaseTimer;
+  instrumentation::Stopwatch _renderPhaseTimer;
+  instrumentation::Stopwatch _presentPhaseTimer;
+  instrumentation::Counter _missedDeadlinesCount;
+  CacheStatistics _tessellationCacheStatistics;
+  CacheStatistics _imageCacheStatistics;
+  double _damagedPixelFraction;
 
   void displayCurrentStatisticsToConsole() const;
 
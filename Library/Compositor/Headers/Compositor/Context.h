@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Compositor/CompositorStatistics.h>
+#include <Compositor/Damage.h>
 #include <Compositor/ThreadBinding.h>
 #include <Core/Macros.h>
 #include <Event/TouchEvent.h>
@@ -14,9 +15,11 @@ namespace rl {
 namespace compositor {
 
 class ProgramCatalog;
+class BatchVertices;
 class BoxVertices;
 class ConsoleRenderer;
 class Frame;
+class GlyphAtlasTexture;
 class StrokeVertices;
 
 class Context {
@@ -33,6 +36,18 @@ class Context {
 
   const StrokeVertices& unitBoxStrokeVertices();
 
+  BatchVertices& batchVertices();
+
+  /**
+   *  @return the atlas the glyphs of all text in this context are drawn from
+   */
+  GlyphAtlasTexture& glyphAtlas();
+
+  /**
+   *  @return the damage of the frames recently rendered in this context
+   */
+  DamageHistory& damageHistory();
+
   RL_WARN_UNUSED_RESULT
   bool beginUsing();
 
@@ -44,6 +59,12 @@ class Context {
 
   void renderConsole(const Frame& frame);
 
+  /**
+   *  @return the area of the frame covered by the console when it was last
+   *          rendered
+   */
+  geom::Rect consoleBounds() const;
+
   RL_WARN_UNUSED_RESULT
   bool applyTouchesToConsole(const event::TouchEvent::PhaseMap& touches);
 
@@ -55,6 +76,9 @@ class Context {
   std::unique_ptr<ProgramCatalog> _programCatalog;
   std::unique_ptr<BoxVertices> _unitBoxVertices;
   std::unique_ptr<StrokeVertices> _unitBoxStrokeVertices;
+  std::unique_ptr<BatchVertices> _batchVertices;
+  std::unique_ptr<GlyphAtlasTexture> _glyphAtlas;
+  DamageHistory _damageHistory;
 
   RL_DISALLOW_COPY_AND_ASSIGN(Context);
 };
@@ -0,0 +1,98 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Geometry/Rect.h>
+#include <Geometry/Size.h>
+#include <deque>
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  The region of a frame whose contents have changed and must be redrawn.
+ *  Since rendering can only be scissored to a single rectangle, the region is
+ *  approximated by the bounding box of all the areas added to it.
+ */
+class Damage {
+ public:
+  Damage();
+
+  bool isEmpty() const;
+
+  /**
+   *  @return the bounding box of the damaged areas. Meaningless if the damage
+   *          is empty.
+   */
+  const geom::Rect& bounds() const;
+
+  /**
+   *  Add an area to the damage. Areas with no size are ignored.
+   *
+   *  @param rect the damaged area
+   */
+  void add(const geom::Rect& rect);
+
+  void add(const Damage& damage);
+
+  /**
+   *  @return if anything drawn within the given rect is affected by the damage
+   */
+  bool intersects(const geom::Rect& rect) const;
+
+  /**
+   *  @return the damaged pixels of a frame of the given size. The bounds are
+   *          rounded out to whole pixels and clipped to the frame.
+   */
+  geom::Rect pixelBounds(const geom::Size& size) const;
+
+ private:
+  bool _empty;
+  geom::Rect _bounds;
+};
+
+/**
+ *  The damage of recently presented frames. Surfaces may render into a buffer
+ *  that still holds the contents of an earlier frame. Only the areas damaged
+ *  since that frame need to be redrawn.
+ */
+class DamageHistory {
+ public:
+  static const size_t MaxBufferAge;
+
+  DamageHistory();
+
+  ~DamageHistory();
+
+  /**
+   *  Record the damage of a new frame and find the region of the buffer being
+   *  rendered into that must be redrawn.
+   *
+   *  @param damage    the damage of the new frame
+   *  @param size      the size of the new frame
+   *  @param bufferAge the number of frames since the buffer was presented.
+   *                   Zero if the contents of the buffer are undefined.
+   *
+   *  @return the damage of the buffer. This is the entire frame if the
+   *          contents of the buffer are not known.
+   */
+  Damage accumulate(const Damage& damage,
+                    const geom::Size& size,
+                    size_t bufferAge);
+
+ private:
+  geom::Size _size;
+  /*
+   *  Ordered from the most to the least recent frame.
+   */
+  std::deque<Damage> _frames;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(DamageHistory);
+};
+
+}  // namespace compositor
+}  // namespace rl
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Compositor/Context.h>
+#include <Compositor/Damage.h>
 #include <Core/Macros.h>
 #include <Event/TouchEvent.h>
 #include <Geometry/Matrix.h>
@@ -41,6 +42,22 @@ class Frame {
    */
   const geom::Matrix& projectionMatrix() const;
 
+  /**
+   *  Restrict rendering to the damaged region of the surface. Must be set
+   *  before the frame begins. By default, the entire frame is redrawn.
+   *
+   *  @param damage    the areas of the frame changed since the last frame
+   *  @param bufferAge the number of frames since the buffer being rendered
+   *                   into was last presented. Zero if the contents of the
+   *                   buffer are undefined.
+   */
+  void setDamage(const Damage& damage, size_t bufferAge);
+
+  /**
+   *  @return the region of the frame being redrawn
+   */
+  const Damage& damage() const;
+
   /**
    *  Pop the last item off the opacity stack as the visitor backs out of the
    *  layer hierarchy.
@@ -71,6 +88,7 @@ class Frame {
   geom::Size _size;
   geom::Matrix _projectionMatrix;
   Context& _context;
+  Damage _damage;
 
   void prepareFrame();
 
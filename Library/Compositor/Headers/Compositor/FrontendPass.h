@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include <Compositor/Damage.h>
 #include <Core/Macros.h>
+#include <Geometry/Rect.h>
 #include <memory>
 #include <vector>
 
@@ -13,32 +15,81 @@ namespace rl {
 namespace compositor {
 
 class BackEndPass;
-class Frame;
+class DrawList;
 class Primitive;
 
 class FrontEndPass {
  public:
+  /**
+   *  A retained run of primitives along with the runs of its children. The
+   *  primitives of a fragment are drawn before those of its children.
+   *
+   *  Fragments are owned by whoever renders them and may be added to the
+   *  passes of subsequent frames without being rebuilt. So a fragment may only
+   *  be modified once the passes it was added to have been rendered.
+   */
+  struct Fragment {
+    std::vector<std::shared_ptr<Primitive>> primitives;
+    /**
+     *  If set, the primitives of the fragment (not its children) draw nothing
+     *  outside the bounds. They may be skipped when the bounds are not
+     *  damaged.
+     */
+    bool bounded = false;
+    geom::Rect bounds;
+    std::vector<std::shared_ptr<Fragment>> children;
+  };
+
   FrontEndPass();
 
   ~FrontEndPass();
 
   FrontEndPass(FrontEndPass&&);
 
+  FrontEndPass& operator=(FrontEndPass&&);
+
   bool hasRenderables() const;
 
   size_t primitivesCount() const;
 
   void addPrimitive(std::shared_ptr<Primitive> primitive);
 
+  /**
+   *  Add a retained fragment to the pass. The fragment is referenced and not
+   *  copied. So adding a fragment is constant time irrespective of the number
+   *  of primitives in it.
+   *
+   *  @param fragment the fragment to add
+   */
+  void addFragment(std::shared_ptr<Fragment> fragment);
+
+  /**
+   *  Mark an area of the frame as changed since the last frame.
+   *
+   *  @param rect the changed area in the coordinate space of the frame
+   */
+  void addDamage(const geom::Rect& rect);
+
+  /**
+   *  @return the areas of the frame changed by this pass since the last frame
+   */
+  const Damage& damage() const;
+
  private:
-  std::vector<std::shared_ptr<Primitive>> _primitives;
+  std::vector<std::shared_ptr<Fragment>> _fragments;
+  Damage _damage;
+  /*
+   *  The fragment owned by the pass that individually added primitives are
+   *  appended to.
+   */
+  std::shared_ptr<Fragment> _tail;
 
   /*
    *  This will be removed once the pass IR is formalized.
    */
   friend class BackEndPass;
   bool prepareInBackendPass(BackEndPass& pass);
-  bool renderInBackEndPass(const BackEndPass& pass, Frame& frame) const;
+  void recordInBackEndPass(DrawList& drawList, const Damage& damage) const;
 
   RL_DISALLOW_COPY_AND_ASSIGN(FrontEndPass);
 };
@@ -34,16 +34,60 @@ class PresentationEntity : public entity::Entity {
 
   geom::Point convertPointFromWindow(const geom::Point& point) const;
 
+  /**
+   *  Add the primitives of the entity and its descendants to the pass. The
+   *  areas of the frame changed since the last render are added to the damage
+   *  of the pass.
+   *
+   *  The primitives and model view matrices of the subtree are retained
+   *  across renders. Only entities updated since the last render (and the
+   *  descendants of those whose transforms changed) are visited. So the cost
+   *  of a render is proportional to the depth of the updated entities and not
+   *  the size of the subtree.
+   *
+   *  @param frontEndPass the pass to add the primitives to
+   *  @param viewMatrix   the view matrix of the parent
+   */
   void render(FrontEndPass& frontEndPass, const geom::Matrix& viewMatrix);
 
  private:
+  enum PendingUpdate : uint8_t {
+    TransformUpdate = 1 << 0,
+    ContentsUpdate = 1 << 1,
+    HierarchyUpdate = 1 << 2,
+    DescendantsUpdate = 1 << 3,
+  };
+
+  geom::Matrix _renderedViewMatrix;
   geom::Matrix _renderedModelViewMatrix;
+  Borrowed _parent;
   std::vector<Borrowed> _children;
+  /*
+   *  The children with pending updates of their own. Updates of the subtree
+   *  only descend into these.
+   */
+  std::vector<Borrowed> _updatedChildren;
+  uint8_t _pendingUpdates;
+  /*
+   *  The areas of descendants removed since the last render.
+   */
+  Damage _removedDamage;
+  std::shared_ptr<FrontEndPass::Fragment> _fragment;
   std::unique_ptr<PrimitivesCache> _primitivesCache;
 
-  void renderContents(FrontEndPass& frontEndPass) const;
+  void setNeedsUpdate(uint8_t updates);
 
-  void renderStroke(FrontEndPass& frontEndPass) const;
+  void update(FrontEndPass& frontEndPass,
+              const geom::Matrix& viewMatrix,
+              bool viewMatrixChanged);
+
+  geom::Rect renderedBounds() const;
+
+  void updateContents();
+
+  void updateStroke();
+
+  void didUpdateProperties(PropertyMaskType properties) override;
 
   RL_DISALLOW_COPY_AND_ASSIGN(PresentationEntity);
 };
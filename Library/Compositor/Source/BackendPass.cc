@@ -4,13 +4,17 @@
  */
 
 #include <Compositor/BackendPass.h>
+#include "Console.h"
+#include "DrawList.h"
+#include "GlyphAtlasTexture.h"
 #include "TextureTransaction.h"
 
 namespace rl {
 namespace compositor {
 
 BackEndPass::BackEndPass()
-    : _textureTransaction(std::make_unique<TextureTransaction>()) {}
+    : _textureTransaction(std::make_unique<TextureTransaction>()),
+      _glyphAtlas(nullptr) {}
 
 BackEndPass::~BackEndPass() = default;
 
@@ -19,13 +23,25 @@ bool BackEndPass::hasRenderables() const {
 }
 
 void BackEndPass::addFrontEndPass(FrontEndPass frontEndPass) {
-  if (!frontEndPass.hasRenderables()) {
+  /*
+   *  Passes without renderables must still be rendered if they removed
+   *  something from the frame.
+   */
+  if (!frontEndPass.hasRenderables() && frontEndPass.damage().isEmpty()) {
     return;
   }
 
   _frontEndPasses.emplace_back(std::move(frontEndPass));
 }
 
+Damage BackEndPass::damage() const {
+  Damage damage;
+  for (const auto& frontEndPass : _frontEndPasses) {
+    damage.add(frontEndPass.damage());
+  }
+  return damage;
+}
+
 bool BackEndPass::render(Frame& frame, core::WorkQueue* preparationWQ) {
   if (!hasRenderables()) {
     return false;
@@ -33,25 +49,40 @@ bool BackEndPass::render(Frame& frame, core::WorkQueue* preparationWQ) {
 
   /*
    *  Give primitives a chance to set themselves up in this back-end pass.
+   *  All text in the frame is drawn from the glyphs placed while preparing.
    */
+  _glyphAtlas = &frame.context().glyphAtlas();
+  _glyphAtlas->beginFrame();
+
   for (auto& frontEndPass : _frontEndPasses) {
     frontEndPass.prepareInBackendPass(*this);
   }
 
+  _glyphAtlas = nullptr;
+
   if (!_textureTransaction->commit(preparationWQ)) {
     return false;
   }
 
   /*
-   *  Render all primitives in each pass.
+   *  Record the primitives of all passes in painter's order. Primitives that
+   *  share state are drawn together in as few draw calls as possible.
+   *  Primitives outside the damaged region of the frame are skipped.
    */
-  auto& primitivesStatistics = frame.context().statistics().primitiveCount();
+  DrawList drawList(RL_CONSOLE_GET_VALUE_ONCE("Batch Primitives", true));
 
   for (const auto& frontEndPass : _frontEndPasses) {
-    RL_RETURN_IF_FALSE(frontEndPass.renderInBackEndPass(*this, frame));
-    primitivesStatistics.increment(frontEndPass.primitivesCount());
+    frontEndPass.recordInBackEndPass(drawList, frame.damage());
   }
 
+  drawList.finalize();
+
+  RL_RETURN_IF_FALSE(drawList.render(frame));
+
+  auto& statistics = frame.context().statistics();
+  statistics.primitiveCount().increment(drawList.primitivesCount());
+  statistics.drawCallCount().increment(drawList.drawCallCount());
+
   return true;
 }
 
@@ -60,5 +91,9 @@ std::shared_ptr<Texture> BackEndPass::prepareTexture(
   return _textureTransaction->registerTexture(texture);
 }
 
+GlyphAtlasTexture* BackEndPass::glyphAtlas() const {
+  return _glyphAtlas;
+}
+
 }  // namespace compositor
 }  // namespace rl
@@ -0,0 +1,71 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <GLFoundation/GLFoundation.h>
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  The state shared by primitives that may be drawn together in a single draw
+ *  call.
+ */
+struct BatchKey {
+  enum class Type {
+    None,
+    ColoredBox,
+    TexturedBox,
+    Text,
+  };
+
+  Type type;
+
+  /*
+   *  Identifies additional state (like the texture) that must be bound to draw
+   *  the batch. Never dereferenced by the batcher.
+   */
+  const void* state;
+
+  BatchKey() : type(Type::None), state(nullptr) {}
+
+  BatchKey(Type aType, const void* aState = nullptr)
+      : type(aType), state(aState) {}
+
+  bool isBatchable() const { return type != Type::None; }
+
+  bool operator==(const BatchKey& other) const {
+    return type == other.type && state == other.state;
+  }
+
+  bool operator!=(const BatchKey& other) const { return !(*this == other); }
+};
+
+/**
+ *  A single vertex in the shared vertex buffer of batched primitives.
+ */
+struct BatchVertex {
+  /*
+   *  The position of the vertex in the coordinate space of the frame. The
+   *  projection is applied on the GPU.
+   */
+  GLfloat position[4];
+
+  /*
+   *  The meaning of the attributes depends on the type of the batch. Colored
+   *  boxes store their color with opacity applied. Textured boxes store the
+   *  texture coordinates followed by their opacity. Glyphs store their atlas
+   *  coordinates followed by their color with opacity applied, packed as
+   *  red and green then blue and alpha in 16 bits each.
+   */
+  GLfloat attributes[4];
+};
+
+static_assert(sizeof(BatchVertex) == sizeof(GLfloat) * 8,
+              "Batch vertices must be tightly packed.");
+
+}  // namespace compositor
+}  // namespace rl
@@ -4,12 +4,20 @@
  */
 
 #include <Compositor/CompositorStatistics.h>
+#include <Image/ImageCache.h>
 #include "Console.h"
+#include "TessellationCache.h"
 
 namespace rl {
 namespace compositor {
 
-CompositorStatistics::CompositorStatistics() : _frameTimer(300) {}
+CompositorStatistics::CompositorStatistics()
+    : _frameTimer(300),
+      _updatePhaseTimer(300),
+      _constraintsPhaseTimer(300),
+      _renderPhaseTimer(300),
+      _presentPhaseTimer(300),
+      _damagedPixelFraction(0.0) {}
 
 CompositorStatistics::~CompositorStatistics() = default;
 
@@ -25,28 +33,117 @@ instrumentation::Counter& CompositorStatistics::primitiveCount() {
   return _primitiveCount;
 }
 
+instrumentation::Counter& CompositorStatistics::drawCallCount() {
+  return _drawCallCount;
+}
+
 instrumentation::Counter& CompositorStatistics::frameCount() {
   return _frameCount;
 }
 
+instrumentation::Stopwatch& CompositorStatistics::updatePhaseTimer() {
+  return _updatePhaseTimer;
+}
+
+instrumentation::Stopwatch& CompositorStatistics::constraintsPhaseTimer() {
+  return _constraintsPhaseTimer;
+}
+
+instrumentation::Stopwatch& CompositorStatistics::renderPhaseTimer() {
+  return _renderPhaseTimer;
+}
+
+instrumentation::Stopwatch& CompositorStatistics::presentPhaseTimer() {
+  return _presentPhaseTimer;
+}
+
+instrumentation::Counter& CompositorStatistics::missedDeadlinesCount() {
+  return _missedDeadlinesCount;
+}
+
+const CacheStatistics& CompositorStatistics::tessellationCacheStatistics()
+    const {
+  return _tessellationCacheStatistics;
+}
+
+const CacheStatistics& CompositorStatistics::imageCacheStatistics() const {
+  return _imageCacheStatistics;
+}
+
+void CompositorStatistics::recordFramePhases(const FramePhaseTimings& timings,
+                                             bool missedDeadline) {
+  _updatePhaseTimer.recordLap(timings.update);
+  _constraintsPhaseTimer.recordLap(timings.constraints);
+  _renderPhaseTimer.recordLap(timings.render);
+  _presentPhaseTimer.recordLap(timings.present);
+
+  if (missedDeadline) {
+    _missedDeadlinesCount.increment();
+  }
+}
+
+void CompositorStatistics::recordDamage(const geom::Size& damagedSize,
+                                        const geom::Size& frameSize) {
+  const auto framePixels = frameSize.width * frameSize.height;
+  _damagedPixelFraction =
+      framePixels <= 0.0
+          ? 0.0
+          : (damagedSize.width * damagedSize.height) / framePixels;
+}
+
+double CompositorStatistics::damagedPixelFraction() const {
+  return _damagedPixelFraction;
+}
+
 void CompositorStatistics::start() {
   _frameTimer.start();
   _frameCount.increment();
 }
 
 void CompositorStatistics::stop() {
+  /*
+   *  Tessellations and decoded images are shared by all contexts in the
+   *  process. So the caches keep their own statistics that are sampled here.
+   */
+  _tessellationCacheStatistics = TessellationCache::Shared().statistics();
+
+  const auto images = image::ImageCache::Shared().statistics();
+  _imageCacheStatistics.hits = images.hits;
+  _imageCacheStatistics.misses = images.misses;
+  _imageCacheStatistics.evictions = images.evictions;
+  _imageCacheStatistics.entries = images.entries;
+  _imageCacheStatistics.bytes = images.bytes;
+
   displayCurrentStatisticsToConsole();
 
   _frameTimer.stop();
   _entityCount.reset();
   _primitiveCount.reset();
+  _drawCallCount.reset();
 }
 
 void CompositorStatistics::displayCurrentStatisticsToConsole() const {
   RL_CONSOLE_DISPLAY_VALUE("Frame Time", _frameTimer);
+  RL_CONSOLE_DISPLAY_VALUE("Update", _updatePhaseTimer);
+  RL_CONSOLE_DISPLAY_VALUE("Constraints", _constraintsPhaseTimer);
+  RL_CONSOLE_DISPLAY_VALUE("Render", _renderPhaseTimer);
+  RL_CONSOLE_DISPLAY_VALUE("Present", _presentPhaseTimer);
   RL_CONSOLE_DISPLAY_LABEL("Entities: %zu", _entityCount.count());
   RL_CONSOLE_DISPLAY_LABEL("Primitives: %zu", _primitiveCount.count());
+  RL_CONSOLE_DISPLAY_LABEL("Draw Calls: %zu", _drawCallCount.count());
+  RL_CONSOLE_DISPLAY_LABEL("Damaged Pixels: %.1f%%",
+                           _damagedPixelFraction * 100.0);
   RL_CONSOLE_DISPLAY_LABEL("Frame Count: %zu", _frameCount.count());
+  RL_CONSOLE_DISPLAY_LABEL("Missed Deadlines: %zu",
+                           _missedDeadlinesCount.count());
+  RL_CONSOLE_DISPLAY_LABEL("Tessellation Cache: %zu KB in %zu (%.1f%% hits)",
+                           _tessellationCacheStatistics.bytes / 1024,
+                           _tessellationCacheStatistics.entries,
+                           _tessellationCacheStatistics.hitRate() * 100.0);
+  RL_CONSOLE_DISPLAY_LABEL(
+      "Image Cache: %zu KB in %zu (%.1f%% hits, %zu evicted)",
+      _imageCacheStatistics.bytes / 1024, _imageCacheStatistics.entries,
+      _imageCacheStatistics.hitRate() * 100.0, _imageCacheStatistics.evictions);
 }
 
 }  // namespace compositor
@@ -3,6 +3,7 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <Compositor/Damage.h>
 #include <Core/Utilities.h>
 #include <GLFoundation/GLFoundation.h>
 #include <imgui/imgui.h>
@@ -217,6 +218,8 @@ void ConsoleRenderer::drawLists(void* data) {
                         sizeof(ImDrawVert),
                         reinterpret_cast<GLvoid*>(offsetof(ImDrawVert, col)));
 
+  Damage bounds;
+
   for (int n = 0; n < drawData->CmdListsCount; n++) {
     ImDrawList* cmdList = drawData->CmdLists[n];
     ImDrawIdx* idxBuffer = &cmdList->IdxBuffer.front();
@@ -232,6 +235,10 @@ void ConsoleRenderer::drawLists(void* data) {
       } else {
         glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pCmd->TextureId);
 
+        bounds.add({pCmd->ClipRect.x, pCmd->ClipRect.y,
+                    pCmd->ClipRect.z - pCmd->ClipRect.x,
+                    pCmd->ClipRect.w - pCmd->ClipRect.y});
+
         glScissor(static_cast<GLint>(pCmd->ClipRect.x),
                   static_cast<GLint>(height - pCmd->ClipRect.w),
                   static_cast<GLsizei>(pCmd->ClipRect.z - pCmd->ClipRect.x),
@@ -250,6 +257,8 @@ void ConsoleRenderer::drawLists(void* data) {
   glDisableVertexAttribArray(program.colorAttribute());
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  renderer._renderedBounds = bounds.bounds();
 }
 
 void ConsoleRenderer::render(const Frame& frame) {
@@ -276,6 +285,8 @@ void ConsoleRenderer::render(const Frame& frame) {
    */
   performRenderingSetupIfNecessary();
 
+  _renderedBounds = {};
+
   if (_framePending) {
     ImGui::End();
     ImGui::Render();
@@ -283,6 +294,11 @@ void ConsoleRenderer::render(const Frame& frame) {
   }
 }
 
+geom::Rect ConsoleRenderer::renderedBounds() const {
+  core::MutexLocker lock(_libraryMutex);
+  return _renderedBounds;
+}
+
 bool ConsoleRenderer::ensureFrameStarted() {
   if (_framePending) {
     return true;
@@ -31,6 +31,12 @@ class ConsoleRenderer {
 
   void render(const Frame& frame);
 
+  /**
+   *  @return the area of the frame covered by the console when it was last
+   *          rendered
+   */
+  geom::Rect renderedBounds() const;
+
   void beginSection(const char* section);
 
   void endSection();
@@ -45,7 +51,7 @@ class ConsoleRenderer {
   void getRange(const char* label, float* value, float minimum, float maximum);
 
  private:
-  core::Mutex _libraryMutex;
+  mutable core::Mutex _libraryMutex;
   bool _setupComplete;
   ImGuiIO& _io;
   std::map<event::TouchEvent::Identifier, geom::Point> _touches;
@@ -54,6 +60,7 @@ class ConsoleRenderer {
   unsigned int _fontAtlas;
   core::ClockPointSeconds _lastFrameTime;
   bool _framePending;
+  geom::Rect _renderedBounds;
 
   static void drawLists(void* data);
 
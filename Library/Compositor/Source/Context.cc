@@ -8,7 +8,9 @@
 #include <Geometry/PathBuilder.h>
 #include <Geometry/Rect.h>
 #include "ConsoleRenderer.h"
+#include "GlyphAtlasTexture.h"
 #include "ProgramCatalog.h"
+#include "Vertices/BatchVertices.h"
 #include "Vertices/BoxVertices.h"
 #include "Vertices/StrokeVertices.h"
 
@@ -19,7 +21,9 @@ Context::Context()
     : _beingUsed(false),
       _consoleRenderer(std::make_unique<ConsoleRenderer>()),
       _unitBoxVertices(
-          std::make_unique<BoxVertices>(geom::Rect{0.0, 0.0, 1.0, 1.0})) {
+          std::make_unique<BoxVertices>(geom::Rect{0.0, 0.0, 1.0, 1.0})),
+      _batchVertices(std::make_unique<BatchVertices>()),
+      _glyphAtlas(std::make_unique<GlyphAtlasTexture>()) {
   geom::PathBuilder builder;
   builder.addRect({0, 0, 100, 100});
   _unitBoxStrokeVertices = std::make_unique<StrokeVertices>(builder.path());
@@ -30,7 +34,10 @@ Context::Context()
 Context::~Context() = default;
 
 CompositorStatistics& Context::statistics() {
-  RL_ASSERT(_beingUsed);
+  /*
+   *  Frame phase timings are recorded after the frame has been presented. So
+   *  the statistics may be accessed outside of a frame.
+   */
   return _compositorStats;
 }
 
@@ -49,6 +56,20 @@ const StrokeVertices& Context::unitBoxStrokeVertices() {
   return *_unitBoxStrokeVertices;
 }
 
+BatchVertices& Context::batchVertices() {
+  RL_ASSERT(_beingUsed);
+  return *_batchVertices;
+}
+
+GlyphAtlasTexture& Context::glyphAtlas() {
+  RL_ASSERT(_beingUsed);
+  return *_glyphAtlas;
+}
+
+DamageHistory& Context::damageHistory() {
+  return _damageHistory;
+}
+
 bool Context::beginUsing() {
   if (_beingUsed || !_threadBinding.isBound()) {
     return false;
@@ -66,6 +87,10 @@ bool Context::beginUsing() {
     return false;
   }
 
+  if (!_batchVertices->prepare()) {
+    return false;
+  }
+
   _compositorStats.start();
 
   _beingUsed = true;
@@ -95,6 +120,14 @@ void Context::renderConsole(const Frame& frame) {
   _consoleRenderer->render(frame);
 }
 
+geom::Rect Context::consoleBounds() const {
+  if (_consoleRenderer == nullptr) {
+    return geom::Rect{};
+  }
+
+  return _consoleRenderer->renderedBounds();
+}
+
 bool Context::dispose() {
   if (_beingUsed) {
     return false;
@@ -103,6 +136,8 @@ bool Context::dispose() {
   _consoleRenderer = nullptr;
   _programCatalog = nullptr;
   _unitBoxVertices = nullptr;
+  _batchVertices = nullptr;
+  _glyphAtlas = nullptr;
 
   _threadBinding.unbind();
 
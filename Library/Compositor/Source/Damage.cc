@@ -0,0 +1,95 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/Damage.h>
+#include <cmath>
+
+namespace rl {
+namespace compositor {
+
+Damage::Damage() : _empty(true) {}
+
+bool Damage::isEmpty() const {
+  return _empty;
+}
+
+const geom::Rect& Damage::bounds() const {
+  return _bounds;
+}
+
+void Damage::add(const geom::Rect& rect) {
+  if (rect.isZero()) {
+    return;
+  }
+
+  _bounds = _empty ? rect : _bounds.unionWith(rect);
+  _empty = false;
+}
+
+void Damage::add(const Damage& damage) {
+  if (!damage._empty) {
+    add(damage._bounds);
+  }
+}
+
+bool Damage::intersects(const geom::Rect& rect) const {
+  return !_empty && _bounds.intersects(rect);
+}
+
+geom::Rect Damage::pixelBounds(const geom::Size& size) const {
+  if (_empty) {
+    return geom::Rect{};
+  }
+
+  /*
+   *  Primitives may touch partially covered pixels along their edges.
+   */
+  const double minX = std::floor(_bounds.origin.x);
+  const double minY = std::floor(_bounds.origin.y);
+  const double maxX = std::ceil(_bounds.origin.x + _bounds.size.width);
+  const double maxY = std::ceil(_bounds.origin.y + _bounds.size.height);
+
+  return geom::Rect{minX, minY, maxX - minX, maxY - minY}.intersection(
+      geom::Rect{size});
+}
+
+const size_t DamageHistory::MaxBufferAge = 4;
+
+DamageHistory::DamageHistory() = default;
+
+DamageHistory::~DamageHistory() = default;
+
+Damage DamageHistory::accumulate(const Damage& damage,
+                                 const geom::Size& size,
+                                 size_t bufferAge) {
+  /*
+   *  Buffers of a different size are reallocated and their contents lost.
+   */
+  if (size != _size) {
+    _frames.clear();
+    _size = size;
+  }
+
+  Damage accumulated;
+
+  if (bufferAge == 0 || bufferAge > _frames.size()) {
+    accumulated.add(geom::Rect{size});
+  } else {
+    accumulated.add(damage);
+    for (size_t i = 0; i < bufferAge - 1; i++) {
+      accumulated.add(_frames[i]);
+    }
+  }
+
+  _frames.push_front(damage);
+  if (_frames.size() > MaxBufferAge) {
+    _frames.pop_back();
+  }
+
+  return accumulated;
+}
+
+}  // namespace compositor
+}  // namespace rl
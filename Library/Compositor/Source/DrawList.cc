@@ -0,0 +1,131 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/Frame.h>
+#include <algorithm>
+#include "DrawList.h"
+#include "Primitive/Primitive.h"
+#include "Vertices/BatchVertices.h"
+
+namespace rl {
+namespace compositor {
+
+const size_t DrawList::MaxBatchLookback = 16;
+
+DrawList::DrawList(bool batching)
+    : _batching(batching), _finalized(false), _primitivesCount(0) {}
+
+DrawList::~DrawList() = default;
+
+void DrawList::addPrimitive(const Primitive& primitive) {
+  RL_ASSERT_MSG(!_finalized, "Primitives cannot be added once finalized");
+
+  _primitivesCount++;
+
+  auto key = _batching ? primitive.batchKey() : BatchKey{};
+
+  if (!key.isBatchable()) {
+    _batches.push_back({key, {}, {&primitive}});
+    return;
+  }
+
+  auto bounds = primitive.frameBounds();
+
+  if (auto batch = batchToJoin(key, bounds)) {
+    batch->bounds = batch->bounds.unionWith(bounds);
+    batch->primitives.push_back(&primitive);
+    return;
+  }
+
+  _batches.push_back({key, bounds, {&primitive}});
+}
+
+DrawList::Batch* DrawList::batchToJoin(const BatchKey& key,
+                                       const geom::Rect& bounds) {
+  const size_t lookback = std::min(_batches.size(), MaxBatchLookback);
+
+  for (size_t i = 0; i < lookback; i++) {
+    auto& batch = _batches[_batches.size() - 1 - i];
+
+    if (batch.key == key) {
+      return &batch;
+    }
+
+    /*
+     *  Joining an earlier batch draws the primitive before this one. That is
+     *  only allowed if the two don't overlap. Unbatchable primitives may
+     *  modify state used by everything after them (like clips). So nothing
+     *  may be moved across them.
+     */
+    if (!batch.key.isBatchable() || batch.bounds.intersects(bounds)) {
+      return nullptr;
+    }
+  }
+
+  return nullptr;
+}
+
+void DrawList::finalize() {
+  RL_ASSERT_MSG(!_finalized, "The list may only be finalized once");
+
+  _finalized = true;
+
+  _commands.reserve(_batches.size());
+
+  for (const auto& batch : _batches) {
+    const auto firstVertex = _vertices.size();
+
+    if (batch.key.isBatchable()) {
+      for (const auto primitive : batch.primitives) {
+        primitive->appendBatchVertices(_vertices);
+      }
+    }
+
+    _commands.push_back({batch.key, batch.primitives.front(),
+                         batch.primitives.size(), firstVertex,
+                         _vertices.size() - firstVertex});
+  }
+
+  _batches.clear();
+}
+
+const std::vector<DrawList::Command>& DrawList::commands() const {
+  return _commands;
+}
+
+const std::vector<BatchVertex>& DrawList::vertices() const {
+  return _vertices;
+}
+
+size_t DrawList::primitivesCount() const {
+  return _primitivesCount;
+}
+
+size_t DrawList::drawCallCount() const {
+  return _commands.size();
+}
+
+bool DrawList::render(Frame& frame) const {
+  RL_ASSERT_MSG(_finalized, "The list must be finalized before rendering");
+
+  if (_vertices.size() > 0 &&
+      !frame.context().batchVertices().update(_vertices)) {
+    return false;
+  }
+
+  for (const auto& command : _commands) {
+    if (command.key.isBatchable()) {
+      RL_RETURN_IF_FALSE(command.primitive->renderBatch(
+          frame, command.firstVertex, command.vertexCount));
+    } else {
+      RL_RETURN_IF_FALSE(command.primitive->render(frame));
+    }
+  }
+
+  return true;
+}
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,139 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Geometry/Rect.h>
+#include <vector>
+#include "Batch.h"
+
+namespace rl {
+namespace compositor {
+
+class Frame;
+class Primitive;
+
+/**
+ *  Records the draw calls necessary to render primitives in painter's order.
+ *  Adjacent primitives with the same batch key are coalesced into a single
+ *  draw call. A primitive may also be moved back to join an earlier batch as
+ *  long as it does not overlap anything drawn in between.
+ *
+ *  Recording the draw calls touches no graphics state. Only rendering the list
+ *  does.
+ */
+class DrawList {
+ public:
+  /**
+   *  A single draw call.
+   */
+  struct Command {
+    /**
+     *  The key of the batch drawn by this command. Unbatchable primitives are
+     *  drawn on their own with the default key.
+     */
+    BatchKey key;
+
+    /**
+     *  The first primitive drawn by this command. Batches are rendered by it.
+     */
+    const Primitive* primitive;
+
+    /**
+     *  The number of primitives drawn by this command.
+     */
+    size_t primitivesCount;
+
+    /**
+     *  The range of batch vertices drawn by this command. Empty for
+     *  unbatchable primitives.
+     */
+    size_t firstVertex;
+    size_t vertexCount;
+  };
+
+  /**
+   *  The number of most recent batches a primitive may be moved back across
+   *  to join one with the same key. Bounds the cost of recording each
+   *  primitive.
+   */
+  static const size_t MaxBatchLookback;
+
+  /**
+   *  Create a draw list.
+   *
+   *  @param batching if primitives may be batched. If not, each primitive is
+   *                  drawn on its own.
+   */
+  DrawList(bool batching = true);
+
+  ~DrawList();
+
+  /**
+   *  Add a primitive to be drawn after all primitives already added. The
+   *  primitive must be prepared and must outlive the list.
+   *
+   *  @param primitive the primitive to draw
+   */
+  void addPrimitive(const Primitive& primitive);
+
+  /**
+   *  Record the draw calls for all primitives added so far. No more primitives
+   *  may be added once the list is finalized.
+   */
+  void finalize();
+
+  /**
+   *  @return the draw calls recorded by the list
+   */
+  const std::vector<Command>& commands() const;
+
+  /**
+   *  @return the vertices of all batches in the list
+   */
+  const std::vector<BatchVertex>& vertices() const;
+
+  /**
+   *  @return the number of primitives added to the list
+   */
+  size_t primitivesCount() const;
+
+  /**
+   *  @return the number of draw calls necessary to render the list
+   */
+  size_t drawCallCount() const;
+
+  /**
+   *  Issue the recorded draw calls.
+   *
+   *  @param frame the frame to render into
+   *
+   *  @return if all draw calls were successful
+   */
+  RL_WARN_UNUSED_RESULT
+  bool render(Frame& frame) const;
+
+ private:
+  struct Batch {
+    BatchKey key;
+    geom::Rect bounds;
+    std::vector<const Primitive*> primitives;
+  };
+
+  const bool _batching;
+  bool _finalized;
+  size_t _primitivesCount;
+  std::vector<Batch> _batches;
+  std::vector<Command> _commands;
+  std::vector<BatchVertex> _vertices;
+
+  Batch* batchToJoin(const BatchKey& key, const geom::Rect& bounds);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(DrawList);
+};
+
+}  // namespace compositor
+}  // namespace rl
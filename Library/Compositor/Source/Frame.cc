@@ -7,6 +7,7 @@
 #include <Compositor/Frame.h>
 #include <Core/Utilities.h>
 #include <GLFoundation/GLFoundation.h>
+#include "Console.h"
 #include "Primitive/Primitive.h"
 
 namespace rl {
@@ -15,7 +16,9 @@ namespace compositor {
 Frame::Frame(geom::Size size, Context& context)
     : _size(size),
       _projectionMatrix(geom::Matrix::Orthographic(size)),
-      _context(context) {}
+      _context(context) {
+  _damage.add(geom::Rect{size});
+}
 
 Frame::~Frame() = default;
 
@@ -35,6 +38,26 @@ const geom::Size& Frame::size() const {
   return _size;
 }
 
+void Frame::setDamage(const Damage& damage, size_t bufferAge) {
+  Damage frameDamage = damage;
+
+  /*
+   *  The console is drawn over the entire frame. Redraw the area it last
+   *  covered so that it does not blend over its previous contents.
+   */
+  frameDamage.add(_context.consoleBounds());
+
+  if (!RL_CONSOLE_GET_VALUE_ONCE("Partial Redraw", true)) {
+    bufferAge = 0;
+  }
+
+  _damage = _context.damageHistory().accumulate(frameDamage, _size, bufferAge);
+}
+
+const Damage& Frame::damage() const {
+  return _damage;
+}
+
 bool Frame::begin() {
   if (!_context.beginUsing()) {
     return false;
@@ -54,9 +77,19 @@ bool Frame::end() {
 void Frame::prepareFrame() {
   glViewport(0, 0, _size.width, _size.height);
 
-  glScissor(0, 0, _size.width, _size.height);
+  /*
+   *  Everything outside the damaged region (including the clear) is left
+   *  untouched. The frame has its origin at the top left while the scissor
+   *  box has its at the bottom left.
+   */
+  const auto damaged = _damage.pixelBounds(_size);
+  glScissor(damaged.origin.x,
+            _size.height - damaged.origin.y - damaged.size.height,
+            damaged.size.width, damaged.size.height);
   glEnable(GL_SCISSOR_TEST);
 
+  _context.statistics().recordDamage(damaged.size, _size);
+
   glDisable(GL_CULL_FACE);
 
   glDisable(GL_DEPTH_TEST);
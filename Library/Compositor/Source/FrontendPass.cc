@@ -4,6 +4,7 @@
  */
 
 #include <Compositor/FrontendPass.h>
+#include "DrawList.h"
 #include "Primitive/Primitive.h"
 
 namespace rl {
@@ -15,35 +16,120 @@ FrontEndPass::~FrontEndPass() = default;
 
 FrontEndPass::FrontEndPass(FrontEndPass&&) = default;
 
+FrontEndPass& FrontEndPass::operator=(FrontEndPass&&) = default;
+
+/**
+ *  Visit the primitives of the fragment and its children in drawing order.
+ *  Visitation stops as soon as the visitor returns false.
+ */
+template <class Visitor>
+static bool VisitPrimitives(const FrontEndPass::Fragment& fragment,
+                            Visitor& visitor) {
+  for (const auto& primitive : fragment.primitives) {
+    if (!visitor(*primitive)) {
+      return false;
+    }
+  }
+
+  for (const auto& child : fragment.children) {
+    if (!VisitPrimitives(*child, visitor)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool FrontEndPass::hasRenderables() const {
-  return _primitives.size() > 0;
+  auto visitor = [](const Primitive&) { return false; };
+
+  for (const auto& fragment : _fragments) {
+    if (!VisitPrimitives(*fragment, visitor)) {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 size_t FrontEndPass::primitivesCount() const {
-  return _primitives.size();
+  size_t count = 0;
+  auto visitor = [&](const Primitive&) {
+    count++;
+    return true;
+  };
+
+  for (const auto& fragment : _fragments) {
+    VisitPrimitives(*fragment, visitor);
+  }
+
+  return count;
 }
 
 void FrontEndPass::addPrimitive(std::shared_ptr<Primitive> primitive) {
-  if (primitive != nullptr) {
-    _primitives.emplace_back(std::move(primitive));
+  if (primitive == nullptr) {
+    return;
+  }
+
+  if (_fragments.empty() || _fragments.back() != _tail) {
+    _tail = std::make_shared<Fragment>();
+    _fragments.push_back(_tail);
+  }
+
+  _tail->primitives.emplace_back(std::move(primitive));
+}
+
+void FrontEndPass::addFragment(std::shared_ptr<Fragment> fragment) {
+  if (fragment != nullptr) {
+    _fragments.emplace_back(std::move(fragment));
   }
 }
 
+void FrontEndPass::addDamage(const geom::Rect& rect) {
+  _damage.add(rect);
+}
+
+const Damage& FrontEndPass::damage() const {
+  return _damage;
+}
+
 bool FrontEndPass::prepareInBackendPass(BackEndPass& pass) {
-  for (const auto& primitive : _primitives) {
-    RL_RETURN_IF_FALSE(primitive->prepareToRender(pass));
+  auto visitor = [&](Primitive& primitive) {
+    primitive.bindToRenderThread();
+    RL_RETURN_IF_FALSE(primitive.prepareToRender(pass));
+    return true;
+  };
+
+  for (const auto& fragment : _fragments) {
+    RL_RETURN_IF_FALSE(VisitPrimitives(*fragment, visitor));
   }
 
   return true;
 }
 
-bool FrontEndPass::renderInBackEndPass(const BackEndPass& pass,
-                                       Frame& frame) const {
-  for (const auto& primitive : _primitives) {
-    RL_RETURN_IF_FALSE(primitive->render(frame));
+/**
+ *  Record the primitives of the fragment and its children that may draw within
+ *  the damaged region of the frame.
+ */
+static void RecordFragment(const FrontEndPass::Fragment& fragment,
+                           const Damage& damage,
+                           DrawList& drawList) {
+  if (!fragment.bounded || damage.intersects(fragment.bounds)) {
+    for (const auto& primitive : fragment.primitives) {
+      drawList.addPrimitive(*primitive);
+    }
   }
 
-  return true;
+  for (const auto& child : fragment.children) {
+    RecordFragment(*child, damage, drawList);
+  }
+}
+
+void FrontEndPass::recordInBackEndPass(DrawList& drawList,
+                                       const Damage& damage) const {
+  for (const auto& fragment : _fragments) {
+    RecordFragment(*fragment, damage, drawList);
+  }
 }
 
 }  // namespace compositor
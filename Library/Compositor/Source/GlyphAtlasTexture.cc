@@ -0,0 +1,116 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "GlyphAtlasTexture.h"
+
+namespace rl {
+namespace compositor {
+
+const geom::Size GlyphAtlasTexture::DefaultSize = {1024.0, 1024.0};
+
+GlyphAtlasTexture::GlyphAtlasTexture(const geom::Size& size)
+    : _atlas(size), _textureHandle(GL_NONE) {}
+
+GlyphAtlasTexture::~GlyphAtlasTexture() {
+  if (_textureHandle != GL_NONE) {
+    glDeleteTextures(1, &_textureHandle);
+    RL_GLAssert("There must be no errors post texture disposal");
+    _textureHandle = GL_NONE;
+  }
+}
+
+void GlyphAtlasTexture::beginFrame() {
+  _atlas.beginPass();
+}
+
+bool GlyphAtlasTexture::placeRun(const type::GlyphRun& run,
+                                 std::vector<type::Glyph>& glyphs) {
+  return _atlas.placeRun(run, glyphs);
+}
+
+const type::GlyphAtlas& GlyphAtlasTexture::atlas() const {
+  return _atlas;
+}
+
+bool GlyphAtlasTexture::bind(GLint samplerUniform, size_t activeIndex) {
+  if (!_atlas.isValid()) {
+    return false;
+  }
+
+  glActiveTexture(GL_TEXTURE0 + activeIndex);
+
+  RL_RETURN_IF_FALSE(upload());
+
+  glUniform1i(samplerUniform, activeIndex);
+
+  RL_GLAssert("There must be no errors when binding to a texture");
+
+  return true;
+}
+
+bool GlyphAtlasTexture::upload() {
+  const auto& image = _atlas.image();
+  const auto width = static_cast<GLsizei>(image.size().width);
+  const auto height = static_cast<GLsizei>(image.size().height);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (_textureHandle == GL_NONE) {
+    glGenTextures(1, &_textureHandle);
+    glBindTexture(GL_TEXTURE_2D, _textureHandle);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexImage2D(GL_TEXTURE_2D,              // target
+                 0,                          // level
+                 GL_LUMINANCE,               // internalformat
+                 width,                      // width
+                 height,                     // height
+                 0,                          // border
+                 GL_LUMINANCE,               // format
+                 GL_UNSIGNED_BYTE,           // type
+                 image.allocation().data()   // data
+                 );
+
+    RL_GLAssert("There must be no errors post texture upload.");
+
+    _atlas.clearDamage();
+    return true;
+  }
+
+  glBindTexture(GL_TEXTURE_2D, _textureHandle);
+
+  /*
+   *  Rows of the atlas are contiguous. Uploading whole rows lets the damaged
+   *  area be read straight out of the atlas.
+   */
+  const auto& damage = _atlas.damage();
+  const auto top = static_cast<GLsizei>(damage.origin.y);
+  const auto rows = static_cast<GLsizei>(damage.size.height);
+
+  if (rows > 0) {
+    glTexSubImage2D(GL_TEXTURE_2D,                           // target
+                    0,                                       // level
+                    0,                                       // xoffset
+                    top,                                     // yoffset
+                    width,                                   // width
+                    rows,                                    // height
+                    GL_LUMINANCE,                            // format
+                    GL_UNSIGNED_BYTE,                        // type
+                    image.allocation().data() + top * width  // data
+                    );
+
+    RL_GLAssert("There must be no errors post texture update.");
+  }
+
+  _atlas.clearDamage();
+  return true;
+}
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,67 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <GLFoundation/GLFoundation.h>
+#include <Typography/GlyphAtlas.h>
+#include <vector>
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  A glyph atlas and the texture its coverage is uploaded to. Only the parts
+ *  of the atlas that changed since the last upload are uploaded again.
+ *
+ *  Rasterizing glyphs into the atlas touches no graphics state. Only binding
+ *  the texture does.
+ */
+class GlyphAtlasTexture {
+ public:
+  static const geom::Size DefaultSize;
+
+  GlyphAtlasTexture(const geom::Size& size = DefaultSize);
+
+  ~GlyphAtlasTexture();
+
+  /**
+   *  Start placing the runs of a new frame. Glyphs placed in the frame stay
+   *  in the atlas till the frame is rendered.
+   */
+  void beginFrame();
+
+  /**
+   *  Find or rasterize the glyphs of the run in the atlas.
+   *
+   *  @param run    the run to place
+   *  @param glyphs the vector to append the glyphs of the run to
+   *
+   *  @return if all glyphs of the run could be placed
+   */
+  RL_WARN_UNUSED_RESULT
+  bool placeRun(const type::GlyphRun& run, std::vector<type::Glyph>& glyphs);
+
+  const type::GlyphAtlas& atlas() const;
+
+  /**
+   *  Bind the texture, uploading the glyphs rasterized since the last time it
+   *  was bound.
+   */
+  RL_WARN_UNUSED_RESULT
+  bool bind(GLint samplerUniform, size_t activeIndex = 0);
+
+ private:
+  type::GlyphAtlas _atlas;
+  GLuint _textureHandle;
+
+  bool upload();
+
+  RL_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasTexture);
+};
+
+}  // namespace compositor
+}  // namespace rl
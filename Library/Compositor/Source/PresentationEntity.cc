@@ -10,20 +10,65 @@
 namespace rl {
 namespace compositor {
 
+static void AddFragmentBounds(const FrontEndPass::Fragment& fragment,
+                              Damage& damage) {
+  if (fragment.bounded) {
+    damage.add(fragment.bounds);
+  }
+
+  for (const auto& child : fragment.children) {
+    AddFragmentBounds(*child, damage);
+  }
+}
+
 PresentationEntity::PresentationEntity(core::Name identifier)
     : Entity(identifier, nullptr),
+      _parent(nullptr),
+      _pendingUpdates(TransformUpdate | ContentsUpdate),
+      _fragment(std::make_shared<FrontEndPass::Fragment>()),
       _primitivesCache(std::make_unique<PrimitivesCache>()) {}
 
 PresentationEntity::~PresentationEntity() = default;
 
+const geom::Matrix& PresentationEntity::lastModelViewMatrix() const {
+  return _renderedModelViewMatrix;
+}
+
 void PresentationEntity::addChild(Borrowed entity) {
   _children.push_back(entity);
+
+  /*
+   *  The child must be placed in the coordinate space of its new parent.
+   */
+  entity->_parent = this;
+  entity->_pendingUpdates |= TransformUpdate;
+  _updatedChildren.push_back(entity);
+
+  setNeedsUpdate(HierarchyUpdate | DescendantsUpdate);
 }
 
 void PresentationEntity::removeChild(Borrowed entity) {
   auto found = std::find(_children.begin(), _children.end(), entity);
   RL_ASSERT(found != _children.end());
   _children.erase(found);
+
+  _updatedChildren.erase(
+      std::remove(_updatedChildren.begin(), _updatedChildren.end(), entity),
+      _updatedChildren.end());
+
+  /*
+   *  The entity may have already been added to another parent.
+   */
+  if (entity->_parent == this) {
+    entity->_parent = nullptr;
+  }
+
+  /*
+   *  The primitives of the subtree will no longer be drawn.
+   */
+  AddFragmentBounds(*entity->_fragment, _removedDamage);
+
+  setNeedsUpdate(HierarchyUpdate);
 }
 
 bool PresentationEntity::isWindowPointInside(const geom::Point& point) const {
@@ -39,24 +84,162 @@ geom::Point PresentationEntity::convertPointFromWindow(
 
 void PresentationEntity::render(FrontEndPass& frontEndPass,
                                 const geom::Matrix& viewMatrix) {
+  const bool viewMatrixChanged = viewMatrix != _renderedViewMatrix;
+
+  if (_pendingUpdates != 0 || viewMatrixChanged) {
+    update(frontEndPass, viewMatrix, viewMatrixChanged);
+  }
+
+  frontEndPass.addFragment(_fragment);
+}
+
+void PresentationEntity::setNeedsUpdate(uint8_t updates) {
+  const bool wasPending = _pendingUpdates != 0;
+
+  _pendingUpdates |= updates;
+
+  /*
+   *  Ancestors only need to know about the first update since the last
+   *  render. So marking an entity is amortized constant time.
+   */
+  if (!wasPending && _parent != nullptr) {
+    _parent->_updatedChildren.push_back(this);
+    _parent->setNeedsUpdate(DescendantsUpdate);
+  }
+}
+
+void PresentationEntity::update(FrontEndPass& frontEndPass,
+                                const geom::Matrix& viewMatrix,
+                                bool viewMatrixChanged) {
+  const bool transformChanged =
+      viewMatrixChanged || (_pendingUpdates & TransformUpdate);
+
   /*
    *  Update the model view matrix for the latest render pass. This allows
    *  us to perform constant time geometry conversions between arbitrary
    *  entities.
    */
+  if (transformChanged) {
+    _renderedViewMatrix = viewMatrix;
+    _renderedModelViewMatrix = viewMatrix * modelMatrix();
+  }
 
-  _renderedModelViewMatrix = viewMatrix * modelMatrix();
+  /*
+   *  Both the area previously covered by the entity and the one now covered by
+   *  it must be redrawn.
+   */
+  if (transformChanged || (_pendingUpdates & ContentsUpdate)) {
+    if (_fragment->bounded) {
+      frontEndPass.addDamage(_fragment->bounds);
+    }
+
+    _fragment->primitives.clear();
+    updateContents();
+    updateStroke();
+
+    _fragment->bounded = !_fragment->primitives.empty();
+    if (_fragment->bounded) {
+      _fragment->bounds = renderedBounds();
+      frontEndPass.addDamage(_fragment->bounds);
+    }
+  }
 
-  renderContents(frontEndPass);
+  if (_pendingUpdates & HierarchyUpdate) {
+    if (!_removedDamage.isEmpty()) {
+      frontEndPass.addDamage(_removedDamage.bounds());
+      _removedDamage = Damage{};
+    }
 
-  renderStroke(frontEndPass);
+    _fragment->children.clear();
+    _fragment->children.reserve(_children.size());
+    for (const auto& child : _children) {
+      _fragment->children.push_back(child->_fragment);
+    }
+  }
+
+  /*
+   *  A change in transform moves the entire subtree. Otherwise, only the
+   *  children that were themselves updated need to be visited.
+   */
+  if (transformChanged) {
+    for (const auto& child : _children) {
+      child->update(frontEndPass, _renderedModelViewMatrix, true);
+    }
+  } else {
+    for (const auto& child : _updatedChildren) {
+      child->update(frontEndPass, _renderedModelViewMatrix, false);
+    }
+  }
+
+  _updatedChildren.clear();
+  _pendingUpdates = 0;
+}
+
+geom::Rect PresentationEntity::renderedBounds() const {
+  /*
+   *  Paths are drawn in the coordinate space of the bounds but may extend
+   *  beyond them. Strokes and their antialiasing extend beyond both.
+   */
+  geom::Rect local(_bounds.size);
+  if (_path.componentCount() > 0) {
+    local = local.unionWith(_path.boundingBox());
+  }
+
+  const bool stroked =
+      _strokeSize >= Primitive::StrokeThreshold &&
+      _strokeColor.alpha * _opacity >= Primitive::AlphaThreshold;
+  const double outset = (stroked ? _strokeSize : 0.0) + 1.0;
+  local = {local.origin.x - outset, local.origin.y - outset,
+           local.size.width + 2.0 * outset, local.size.height + 2.0 * outset};
+
+  const geom::Point corners[] = {
+      local.origin,
+      {local.origin.x + local.size.width, local.origin.y},
+      {local.origin.x, local.origin.y + local.size.height},
+      {local.origin.x + local.size.width, local.origin.y + local.size.height},
+  };
+
+  geom::Rect bounds;
+  for (size_t i = 0; i < 4; i++) {
+    const auto vector = corners[i] * _renderedModelViewMatrix;
+    const geom::Point point(vector.x / vector.w, vector.y / vector.w);
+    bounds = i == 0 ? geom::Rect{point, {}} : bounds.withPoint(point);
+  }
+
+  return bounds;
+}
+
+void PresentationEntity::didUpdateProperties(PropertyMaskType properties) {
+  /*
+   *  Primitives capture the path and contents of the entity when created. So
+   *  they must be recreated when either changes. Recreating path primitives
+   *  for previously seen paths is cheap since tessellations are cached.
+   */
+  if (properties & (PropertyMask::PathMask | PropertyMask::ContentsMask)) {
+    _primitivesCache->clear();
+  }
+
+  uint8_t updates = 0;
+
+  if (properties & (PropertyMask::BoundsMask | PropertyMask::PositionMask |
+                    PropertyMask::AnchorPointMask |
+                    PropertyMask::TransformationMask)) {
+    updates |= TransformUpdate;
+  }
+
+  if (properties &
+      (PropertyMask::BackgroundColorMask | PropertyMask::ContentsMask |
+       PropertyMask::PathMask | PropertyMask::OpacityMask |
+       PropertyMask::StrokeSizeMask | PropertyMask::StrokeColorMask)) {
+    updates |= ContentsUpdate;
+  }
 
-  for (const auto& child : _children) {
-    child->render(frontEndPass, _renderedModelViewMatrix);
+  if (updates != 0) {
+    setNeedsUpdate(updates);
   }
 }
 
-void PresentationEntity::renderContents(FrontEndPass& frontEndPass) const {
+void PresentationEntity::updateContents() {
   // Decide the content type.
   PrimitivesCache::ContentType contentType = PrimitivesCache::ContentType::None;
   if (_opacity < Primitive::AlphaThreshold) {
@@ -86,12 +269,11 @@ void PresentationEntity::renderContents(FrontEndPass& frontEndPass) const {
     primitive->setSize(_bounds.size);
     primitive->setOpacity(_opacity);
     primitive->setModelViewMatrix(_renderedModelViewMatrix);
-    frontEndPass.addPrimitive(std::move(primitive));
+    _fragment->primitives.emplace_back(std::move(primitive));
   }
 }
 
-void PresentationEntity::renderStroke(
-    rl::compositor::FrontEndPass& frontEndPass) const {
+void PresentationEntity::updateStroke() {
   if (_strokeSize < Primitive::StrokeThreshold) {
     return;
   }
@@ -119,7 +301,7 @@ void PresentationEntity::renderStroke(
     primitive->setSize(_bounds.size);
     primitive->setOpacity(_opacity);
     primitive->setModelViewMatrix(_renderedModelViewMatrix);
-    frontEndPass.addPrimitive(std::move(primitive));
+    _fragment->primitives.emplace_back(std::move(primitive));
   }
 }
 
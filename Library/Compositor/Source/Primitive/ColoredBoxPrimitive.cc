@@ -7,6 +7,7 @@
 #include "ColoredBoxPrimitive.h"
 #include "ProgramCatalog.h"
 #include "Uniform.h"
+#include "Vertices/BatchVertices.h"
 #include "Vertices/BoxVertices.h"
 
 namespace rl {
@@ -50,5 +51,41 @@ bool ColoredBoxPrimitive::render(Frame& frame) const {
   return drawn;
 }
 
+BatchKey ColoredBoxPrimitive::batchKey() const {
+  return BatchKey::Type::ColoredBox;
+}
+
+void ColoredBoxPrimitive::appendBatchVertices(
+    std::vector<BatchVertex>& vertices) const {
+  for (const auto& corner : BoxCorners) {
+    auto vertex = boxBatchVertex(corner);
+    vertex.attributes[0] = _color.red;
+    vertex.attributes[1] = _color.green;
+    vertex.attributes[2] = _color.blue;
+    vertex.attributes[3] = _color.alpha * _opacity;
+    vertices.emplace_back(vertex);
+  }
+}
+
+bool ColoredBoxPrimitive::renderBatch(Frame& frame,
+                                      size_t firstVertex,
+                                      size_t vertexCount) const {
+  auto& program = frame.context().programCatalog().colorBatchProgram();
+
+  if (!program.use()) {
+    return false;
+  }
+
+  SetUniform(program.projectionUniform(), frame.projectionMatrix());
+
+  bool drawn = frame.context().batchVertices().draw(
+      program.positionAttribute(), program.colorAttribute(), firstVertex,
+      vertexCount);
+
+  RL_GLAssert("No errors while rendering");
+
+  return drawn;
+}
+
 }  // namespace compositor
 }  // namespace rl
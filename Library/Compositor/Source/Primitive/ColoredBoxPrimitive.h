@@ -21,6 +21,14 @@ class ColoredBoxPrimitive : public Primitive {
 
   bool render(Frame& frame) const override;
 
+  BatchKey batchKey() const override;
+
+  void appendBatchVertices(std::vector<BatchVertex>& vertices) const override;
+
+  bool renderBatch(Frame& frame,
+                   size_t firstVertex,
+                   size_t vertexCount) const override;
+
  private:
   RL_DISALLOW_COPY_AND_ASSIGN(ColoredBoxPrimitive);
 };
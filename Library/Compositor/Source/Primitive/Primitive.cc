@@ -38,5 +38,57 @@ void Primitive::setStrokeSize(double size) {
   _strokeSize = size;
 }
 
+const geom::Point Primitive::BoxCorners[6] = {
+    {0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0},  //
+    {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0},  //
+};
+
+BatchKey Primitive::batchKey() const {
+  return {};
+}
+
+void Primitive::appendBatchVertices(std::vector<BatchVertex>&) const {
+  RL_ASSERT_MSG(false, "Only batchable primitives have batch vertices");
+}
+
+bool Primitive::renderBatch(Frame&, size_t, size_t) const {
+  RL_ASSERT_MSG(false, "Only batchable primitives may render batches");
+  return false;
+}
+
+geom::Rect Primitive::frameBounds() const {
+  geom::Rect bounds;
+  bool first = true;
+
+  for (const auto& corner : BoxCorners) {
+    const auto vertex = boxBatchVertex(corner);
+    const geom::Point point(vertex.position[0] / vertex.position[3],
+                            vertex.position[1] / vertex.position[3]);
+    if (first) {
+      bounds = geom::Rect{point, {0.0, 0.0}};
+      first = false;
+    } else {
+      bounds = bounds.withPoint(point);
+    }
+  }
+
+  return bounds;
+}
+
+BatchVertex Primitive::boxBatchVertex(const geom::Point& corner) const {
+  auto vertex =
+      geom::Vector4{corner.x * _size.width, corner.y * _size.height, 0.0, 1.0} *
+      _modelViewMatrix;
+  return {{static_cast<GLfloat>(vertex.x), static_cast<GLfloat>(vertex.y),
+           static_cast<GLfloat>(vertex.z), static_cast<GLfloat>(vertex.w)},
+          {0.0f, 0.0f, 0.0f, 0.0f}};
+}
+
+void Primitive::bindToRenderThread() {
+#ifndef NDEBUG
+  _guard.rebind();
+#endif  // NDEBUG
+}
+
 }  // namespace compositor
 }  // namespace rl
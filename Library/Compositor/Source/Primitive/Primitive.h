@@ -9,7 +9,10 @@
 #include <Core/ThreadGuard.h>
 #include <Entity/Color.h>
 #include <Geometry/Matrix.h>
+#include <Geometry/Rect.h>
 #include <Geometry/Size.h>
+#include <vector>
+#include "Batch.h"
 
 namespace rl {
 namespace compositor {
@@ -39,12 +42,54 @@ class Primitive {
 
   void setStrokeSize(double size);
 
+  /**
+   *  Primitives may be created on any thread. But once prepared, they own
+   *  resources that must be collected on the thread that renders them.
+   */
+  void bindToRenderThread();
+
   RL_WARN_UNUSED_RESULT
   virtual bool prepareToRender(BackEndPass& backEndPass) = 0;
 
   RL_WARN_UNUSED_RESULT
   virtual bool render(Frame& frame) const = 0;
 
+  /**
+   *  @return the key of the batch the primitive may be drawn in. Primitives
+   *          that must be drawn on their own return the default key.
+   */
+  virtual BatchKey batchKey() const;
+
+  /**
+   *  Append the vertices that draw this primitive in a batch. Only invoked on
+   *  primitives with a batchable key.
+   *
+   *  @param vertices the vertices of all batches in the frame
+   */
+  virtual void appendBatchVertices(std::vector<BatchVertex>& vertices) const;
+
+  /**
+   *  Draw a batch of primitives with the same key as this one in a single draw
+   *  call. The vertices of the batch have already been uploaded to the batch
+   *  vertices of the context.
+   *
+   *  @param frame       the frame to render into
+   *  @param firstVertex the index of the first vertex in the batch
+   *  @param vertexCount the number of vertices in the batch
+   *
+   *  @return if the batch was rendered
+   */
+  RL_WARN_UNUSED_RESULT
+  virtual bool renderBatch(Frame& frame,
+                           size_t firstVertex,
+                           size_t vertexCount) const;
+
+  /**
+   *  @return the axis aligned bounds of the primitive in the coordinate space
+   *          of the frame
+   */
+  geom::Rect frameBounds() const;
+
  protected:
   RL_DEBUG_THREAD_GUARD(_guard);
   geom::Size _size;
@@ -53,6 +98,17 @@ class Primitive {
   entity::Color _color;
   double _strokeSize = 0.0;
 
+  /**
+   *  The corners of the two triangles that cover a unit box.
+   */
+  static const geom::Point BoxCorners[6];
+
+  /**
+   *  @return a batch vertex positioned at the given corner of the primitive
+   *          with its attributes left unset
+   */
+  BatchVertex boxBatchVertex(const geom::Point& corner) const;
+
  private:
   RL_DISALLOW_COPY_AND_ASSIGN(Primitive);
 };
@@ -0,0 +1,143 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/BackendPass.h>
+#include <algorithm>
+#include <cmath>
+#include "GlyphAtlasTexture.h"
+#include "ProgramCatalog.h"
+#include "TextPrimitive.h"
+#include "Uniform.h"
+#include "Vertices/BatchVertices.h"
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  Pack two color components into a single float. Each is quantized to 8
+ *  bits so both fit exactly in the mantissa.
+ */
+static GLfloat PackComponents(double high, double low) {
+  auto quantize = [](double component) {
+    return std::round(std::min(std::max(component, 0.0), 1.0) * 255.0);
+  };
+  return static_cast<GLfloat>(quantize(high) * 256.0 + quantize(low));
+}
+
+TextPrimitive::TextPrimitive(type::GlyphRun run)
+    : _run(std::move(run)), _atlas(nullptr) {
+  _size = _run.size();
+  _color = entity::Color::Black();
+}
+
+TextPrimitive::~TextPrimitive() = default;
+
+bool TextPrimitive::prepareToRender(BackEndPass& backEndPass) {
+  auto atlas = backEndPass.glyphAtlas();
+  return atlas != nullptr && prepareGlyphs(*atlas);
+}
+
+bool TextPrimitive::prepareGlyphs(GlyphAtlasTexture& atlas) {
+  _glyphs.clear();
+  _atlas = nullptr;
+
+  if (!atlas.placeRun(_run, _glyphs)) {
+    _glyphs.clear();
+    return false;
+  }
+
+  _atlas = &atlas;
+  return true;
+}
+
+bool TextPrimitive::render(Frame& frame) const {
+  /*
+   *  Text is only drawn on its own when batching is disabled. No batches are
+   *  drawn from the shared batch vertices then. So the glyphs of the run are
+   *  drawn as a batch of one from there.
+   */
+  std::vector<BatchVertex> vertices;
+  appendBatchVertices(vertices);
+
+  if (vertices.empty()) {
+    return _atlas != nullptr;
+  }
+
+  if (!frame.context().batchVertices().update(vertices)) {
+    return false;
+  }
+
+  return renderBatch(frame, 0, vertices.size());
+}
+
+BatchKey TextPrimitive::batchKey() const {
+  /*
+   *  Runs may be drawn together if their glyphs are in the same atlas. All
+   *  runs in a context share its atlas.
+   */
+  return {BatchKey::Type::Text, _atlas};
+}
+
+void TextPrimitive::appendBatchVertices(
+    std::vector<BatchVertex>& vertices) const {
+  if (_atlas == nullptr) {
+    return;
+  }
+
+  const auto& atlasSize = _atlas->atlas().size();
+  const auto redGreen = PackComponents(_color.red, _color.green);
+  const auto blueAlpha = PackComponents(_color.blue, _color.alpha * _opacity);
+
+  vertices.reserve(vertices.size() + _glyphs.size() * 6);
+
+  for (const auto& glyph : _glyphs) {
+    const auto& bounds = glyph.bounds();
+    const auto& atlasBounds = glyph.atlasBounds();
+
+    for (const auto& corner : BoxCorners) {
+      auto position =
+          geom::Vector4{bounds.origin.x + corner.x * bounds.size.width,
+                        bounds.origin.y + corner.y * bounds.size.height, 0.0,
+                        1.0} *
+          _modelViewMatrix;
+      const auto u =
+          (atlasBounds.origin.x + corner.x * atlasBounds.size.width) /
+          atlasSize.width;
+      const auto v =
+          (atlasBounds.origin.y + corner.y * atlasBounds.size.height) /
+          atlasSize.height;
+
+      vertices.push_back(
+          {{static_cast<GLfloat>(position.x), static_cast<GLfloat>(position.y),
+            static_cast<GLfloat>(position.z),
+            static_cast<GLfloat>(position.w)},
+           {static_cast<GLfloat>(u), static_cast<GLfloat>(v), redGreen,
+            blueAlpha}});
+    }
+  }
+}
+
+bool TextPrimitive::renderBatch(Frame& frame,
+                                size_t firstVertex,
+                                size_t vertexCount) const {
+  auto& program = frame.context().programCatalog().textBatchProgram();
+
+  if (!program.use()) {
+    return false;
+  }
+
+  if (_atlas == nullptr || !_atlas->bind(program.textureUniform())) {
+    return false;
+  }
+
+  SetUniform(program.projectionUniform(), frame.projectionMatrix());
+
+  return frame.context().batchVertices().draw(program.positionAttribute(),
+                                              program.attributesAttribute(),
+                                              firstVertex, vertexCount);
+}
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,67 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Typography/Glyph.h>
+#include <Typography/GlyphRun.h>
+#include <vector>
+#include "Primitive.h"
+
+namespace rl {
+namespace compositor {
+
+class GlyphAtlasTexture;
+
+/**
+ *  Draws a run of glyphs in the color of the primitive. Each glyph is a quad
+ *  sampling its coverage from the glyph atlas of the context. All glyphs of
+ *  the run, and of any other runs batched with it, are drawn in one call.
+ */
+class TextPrimitive : public Primitive {
+ public:
+  /**
+   *  Create a primitive sized to fit the run.
+   *
+   *  @param run the run to draw
+   */
+  TextPrimitive(type::GlyphRun run);
+
+  ~TextPrimitive() override;
+
+  bool prepareToRender(BackEndPass& backEndPass) override;
+
+  /**
+   *  Place the glyphs of the run in the atlas. Does not touch any graphics
+   *  state.
+   *
+   *  @param atlas the atlas to draw the glyphs from
+   *
+   *  @return if all glyphs of the run could be placed in the atlas
+   */
+  RL_WARN_UNUSED_RESULT
+  bool prepareGlyphs(GlyphAtlasTexture& atlas);
+
+  bool render(Frame& frame) const override;
+
+  BatchKey batchKey() const override;
+
+  void appendBatchVertices(std::vector<BatchVertex>& vertices) const override;
+
+  bool renderBatch(Frame& frame,
+                   size_t firstVertex,
+                   size_t vertexCount) const override;
+
+ private:
+  type::GlyphRun _run;
+  GlyphAtlasTexture* _atlas;
+  std::vector<type::Glyph> _glyphs;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(TextPrimitive);
+};
+
+}  // namespace compositor
+}  // namespace rl
@@ -8,13 +8,15 @@
 #include "Texture.h"
 #include "TexturedBoxPrimitive.h"
 #include "Uniform.h"
+#include "Vertices/BatchVertices.h"
 #include "Vertices/BoxVertices.h"
 
 namespace rl {
 namespace compositor {
 
-TexturedBoxPrimitive::TexturedBoxPrimitive(image::Image image)
-    : _texture(std::make_shared<Texture>(std::move(image))) {}
+TexturedBoxPrimitive::TexturedBoxPrimitive(image::Image image,
+                                           const geom::Size& sizeHint)
+    : _texture(std::make_shared<Texture>(std::move(image), sizeHint)) {}
 
 TexturedBoxPrimitive::~TexturedBoxPrimitive() = default;
 
@@ -54,5 +56,44 @@ bool TexturedBoxPrimitive::render(Frame& frame) const {
   return frame.context().unitBoxVertices().draw(program.positionAttribute());
 }
 
+BatchKey TexturedBoxPrimitive::batchKey() const {
+  /*
+   *  Boxes may only be drawn together if they sample from the same texture.
+   *  Identical images share the same texture once prepared.
+   */
+  return {BatchKey::Type::TexturedBox, _texture.get()};
+}
+
+void TexturedBoxPrimitive::appendBatchVertices(
+    std::vector<BatchVertex>& vertices) const {
+  for (const auto& corner : BoxCorners) {
+    auto vertex = boxBatchVertex(corner);
+    vertex.attributes[0] = corner.x;
+    vertex.attributes[1] = corner.y;
+    vertex.attributes[2] = _opacity;
+    vertices.emplace_back(vertex);
+  }
+}
+
+bool TexturedBoxPrimitive::renderBatch(Frame& frame,
+                                       size_t firstVertex,
+                                       size_t vertexCount) const {
+  auto& program = frame.context().programCatalog().textureBatchProgram();
+
+  if (!program.use()) {
+    return false;
+  }
+
+  if (!_texture || !_texture->bind(program.textureUniform())) {
+    return false;
+  }
+
+  SetUniform(program.projectionUniform(), frame.projectionMatrix());
+
+  return frame.context().batchVertices().draw(program.positionAttribute(),
+                                              program.attributesAttribute(),
+                                              firstVertex, vertexCount);
+}
+
 }  // namespace compositor
 }  // namespace rl
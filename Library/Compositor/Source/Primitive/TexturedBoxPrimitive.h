@@ -16,7 +16,7 @@ class Texture;
 
 class TexturedBoxPrimitive : public Primitive {
  public:
-  TexturedBoxPrimitive(image::Image image);
+  TexturedBoxPrimitive(image::Image image, const geom::Size& sizeHint);
 
   ~TexturedBoxPrimitive() override;
 
@@ -24,6 +24,14 @@ class TexturedBoxPrimitive : public Primitive {
 
   bool render(Frame& frame) const override;
 
+  BatchKey batchKey() const override;
+
+  void appendBatchVertices(std::vector<BatchVertex>& vertices) const override;
+
+  bool renderBatch(Frame& frame,
+                   size_t firstVertex,
+                   size_t vertexCount) const override;
+
  private:
   std::shared_ptr<Texture> _texture;
 
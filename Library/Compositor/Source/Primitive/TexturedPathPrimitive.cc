@@ -12,9 +12,10 @@ namespace rl {
 namespace compositor {
 
 TexturedPathPrimitive::TexturedPathPrimitive(image::Image image,
-                                             const geom::Path& path)
+                                             const geom::Path& path,
+                                             const geom::Size& sizeHint)
     : _vertices(path, FillVertices::Winding::Odd),
-      _texture(std::make_shared<Texture>(std::move(image))) {}
+      _texture(std::make_shared<Texture>(std::move(image), sizeHint)) {}
 
 TexturedPathPrimitive::~TexturedPathPrimitive() = default;
 
@@ -17,7 +17,9 @@ namespace compositor {
 
 class TexturedPathPrimitive : public Primitive {
  public:
-  TexturedPathPrimitive(image::Image image, const geom::Path& path);
+  TexturedPathPrimitive(image::Image image,
+                        const geom::Path& path,
+                        const geom::Size& sizeHint);
 
   ~TexturedPathPrimitive() override;
 
@@ -3,6 +3,7 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <algorithm>
 #include "Primitive/ColoredBoxPrimitive.h"
 #include "Primitive/ColoredBoxStrokePrimitive.h"
 #include "Primitive/ColoredPathPrimitive.h"
@@ -14,7 +15,7 @@
 namespace rl {
 namespace compositor {
 
-PrimitivesCache::PrimitivesCache() {}
+PrimitivesCache::PrimitivesCache() : _texturedReductionFactor(0) {}
 
 PrimitivesCache::~PrimitivesCache() = default;
 
@@ -27,6 +28,10 @@ std::shared_ptr<Primitive> PrimitivesCache::acquire(
     return nullptr;
   }
 
+  if (contentType == ContentType::Image) {
+    invalidateTexturedPrimitivesIfReduced(entity);
+  }
+
   CacheKey key(contentType, primitiveType);
 
   auto found = _primitivesMap.find(key);
@@ -64,6 +69,39 @@ bool PrimitivesCache::invalidate(ContentType contentType,
   return true;
 }
 
+void PrimitivesCache::clear() {
+  _primitivesMap.clear();
+  _texturedSize = {};
+  _texturedReductionFactor = 0;
+}
+
+void PrimitivesCache::invalidateTexturedPrimitivesIfReduced(
+    const PresentationEntity& entity) {
+  const auto& size = entity.bounds().size;
+
+  if (size.width <= _texturedSize.width &&
+      size.height <= _texturedSize.height) {
+    return;
+  }
+
+  _texturedSize = {std::max(size.width, _texturedSize.width),
+                   std::max(size.height, _texturedSize.height)};
+
+  /*
+   *  The textures of the image are only recreated if they were reduced too
+   *  much for the larger size. Growing bounds otherwise keep their textures.
+   */
+  const auto factor = entity.contents().reductionFactor(_texturedSize);
+
+  if (factor == _texturedReductionFactor) {
+    return;
+  }
+
+  _texturedReductionFactor = factor;
+  invalidate(ContentType::Image, PrimitiveType::Box);
+  invalidate(ContentType::Image, PrimitiveType::Path);
+}
+
 std::shared_ptr<Primitive> PrimitivesCache::createColoredPrimitive(
     const PresentationEntity& entity,
     PrimitiveType type) const {
@@ -88,13 +126,14 @@ std::shared_ptr<Primitive> PrimitivesCache::createTexturedPrimitive(
     PrimitiveType type) const {
   switch (type) {
     case PrimitiveType::Box:
-      return std::make_shared<TexturedBoxPrimitive>(entity.contents());
+      return std::make_shared<TexturedBoxPrimitive>(entity.contents(),
+                                                    _texturedSize);
     case PrimitiveType::BoxStroke:
       RL_ASSERT("Textured box strokes are not supported");
       return nullptr;
     case PrimitiveType::Path:
-      return std::make_shared<TexturedPathPrimitive>(entity.contents(),
-                                                     entity.path());
+      return std::make_shared<TexturedPathPrimitive>(
+          entity.contents(), entity.path(), _texturedSize);
     case PrimitiveType::PathStroke:
       RL_ASSERT("Textured strokes are not supported.");
       return nullptr;
@@ -40,6 +40,8 @@ class PrimitivesCache {
 
   bool invalidate(ContentType contentType, PrimitiveType primitiveType);
 
+  void clear();
+
  private:
   struct CacheKey {
     ContentType contentType;
@@ -71,6 +73,14 @@ class PrimitivesCache {
                                            CacheKeyEqual>;
   PrimitivesMap _primitivesMap;
 
+  /*
+   *  The largest size the entity has been displayed at since its textured
+   *  primitives were created, and the factor their textures are reduced by
+   *  at that size.
+   */
+  geom::Size _texturedSize;
+  size_t _texturedReductionFactor;
+
   std::shared_ptr<Primitive> createPrimitive(const PresentationEntity& entity,
                                              ContentType contentType,
                                              PrimitiveType primitiveType);
@@ -81,6 +91,8 @@ class PrimitivesCache {
       const PresentationEntity& entity,
       PrimitiveType type) const;
 
+  void invalidateTexturedPrimitivesIfReduced(const PresentationEntity& entity);
+
   RL_DISALLOW_COPY_AND_ASSIGN(PrimitivesCache);
 };
 
@@ -0,0 +1,63 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "ColorBatchProgram.h"
+
+namespace rl {
+namespace compositor {
+
+static const char ColorBatchVertexShader[] = R"--(
+
+  attribute vec4 A_Position;
+  attribute vec4 A_Color;
+
+  uniform mat4 U_Projection;
+
+  varying vec4 V_Color;
+
+  void main() {
+    V_Color = A_Color;
+    gl_Position = U_Projection * A_Position;
+  }
+
+)--";
+
+static const char ColorBatchFragmentShader[] = R"--(
+
+#ifdef GL_ES
+  precision mediump float;
+#endif
+
+  varying vec4 V_Color;
+
+  void main() {
+    gl_FragColor = V_Color;
+  }
+
+)--";
+
+ColorBatchProgram::ColorBatchProgram()
+    : Program::Program(ColorBatchVertexShader, ColorBatchFragmentShader) {}
+
+void ColorBatchProgram::onLinkSuccess() {
+  _projectionUniform = indexForUniform("U_Projection");
+  _positionAttribute = indexForAttribute("A_Position");
+  _colorAttribute = indexForAttribute("A_Color");
+}
+
+GLint ColorBatchProgram::projectionUniform() const {
+  return _projectionUniform;
+}
+
+GLint ColorBatchProgram::positionAttribute() const {
+  return _positionAttribute;
+}
+
+GLint ColorBatchProgram::colorAttribute() const {
+  return _colorAttribute;
+}
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,39 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include "Program/Program.h"
+
+namespace rl {
+namespace compositor {
+
+/*
+ *  The program to be used for drawing batches of colored boxes. The transform
+ *  and color of each box are baked into its vertices.
+ */
+class ColorBatchProgram : public Program {
+ public:
+  ColorBatchProgram();
+
+  GLint projectionUniform() const;
+
+  GLint positionAttribute() const;
+
+  GLint colorAttribute() const;
+
+ private:
+  GLint _projectionUniform = -1;
+  GLint _positionAttribute = -1;
+  GLint _colorAttribute = -1;
+
+  void onLinkSuccess() override;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(ColorBatchProgram);
+};
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,83 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "TextBatchProgram.h"
+
+namespace rl {
+namespace compositor {
+
+/*
+ *  The color of each vertex is packed two components to an attribute. Vertex
+ *  shaders evaluate at high precision so they are exact when unpacked here.
+ */
+static const char TextBatchVertexShader[] = R"--(
+
+  attribute vec4 A_Position;
+  attribute vec4 A_Attributes;
+
+  uniform mat4 U_Projection;
+
+  varying vec2 V_TextureCoordinates;
+  varying vec4 V_Color;
+
+  vec2 Unpack(float components) {
+    float high = floor(components / 256.0);
+    return vec2(high, components - high * 256.0) / 255.0;
+  }
+
+  void main() {
+    V_TextureCoordinates = A_Attributes.xy;
+    V_Color = vec4(Unpack(A_Attributes.z), Unpack(A_Attributes.w));
+    gl_Position = U_Projection * A_Position;
+  }
+
+)--";
+
+static const char TextBatchFragmentShader[] = R"--(
+
+#ifdef GL_ES
+  precision mediump float;
+#endif
+
+  uniform sampler2D U_Texture;
+
+  varying vec2 V_TextureCoordinates;
+  varying vec4 V_Color;
+
+  void main() {
+    float coverage = texture2D(U_Texture, V_TextureCoordinates).r;
+    gl_FragColor = vec4(V_Color.rgb, V_Color.a * coverage);
+  }
+
+)--";
+
+TextBatchProgram::TextBatchProgram()
+    : Program::Program(TextBatchVertexShader, TextBatchFragmentShader) {}
+
+void TextBatchProgram::onLinkSuccess() {
+  _projectionUniform = indexForUniform("U_Projection");
+  _textureUniform = indexForUniform("U_Texture");
+  _positionAttribute = indexForAttribute("A_Position");
+  _attributesAttribute = indexForAttribute("A_Attributes");
+}
+
+GLint TextBatchProgram::projectionUniform() const {
+  return _projectionUniform;
+}
+
+GLint TextBatchProgram::textureUniform() const {
+  return _textureUniform;
+}
+
+GLint TextBatchProgram::positionAttribute() const {
+  return _positionAttribute;
+}
+
+GLint TextBatchProgram::attributesAttribute() const {
+  return _attributesAttribute;
+}
+
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,43 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include "Program/Program.h"
+
+namespace rl {
+namespace compositor {
+
+/*
+ *  The program to be used for drawing batches of glyphs from the same glyph
+ *  atlas. The atlas holds the coverage of each glyph. The transform and color
+ *  of each glyph are baked into its vertices.
+ */
+class TextBatchProgram : public Program {
+ public:
+  TextBatchProgram();
+
+  GLint projectionUniform() const;
+
+  GLint textureUniform() const;
+
+  GLint positionAttribute() const;
+
+  GLint attributesAttribute() const;
+
+ private:
+  GLint _projectionUniform = -1;
+  GLint _textureUniform = -1;
+  GLint _positionAttribute = -1;
+  GLint _attributesAttribute = -1;
+
+  void onLinkSuccess() override;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(TextBatchProgram);
+};
+
+}  // namespace compositor
+}  // namespace rl
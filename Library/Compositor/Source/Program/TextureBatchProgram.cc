@@ -0,0 +1,73 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "TextureBatchProgram.h"
+
+namespace rl {
+namespace compositor {
+
+static const char TextureBatchVertexShader[] = R"--(
+
+  attribute vec4 A_Position;
+  attribute vec4 A_Attributes;
+
+  uniform mat4 U_Projection;
+
+  varying vec2 V_TextureCoordinates;
+  varying float V_Alpha;
+
+  void main() {
+    V_TextureCoordinates = A_Attributes.xy;
+    V_Alpha = A_Attributes.z;
+    gl_Position = U_Projection * A_Position;
+  }
+
+)--";
+
+static const char TextureBatchFragmentShader[] = R"--(
+
+#ifdef GL_ES
+  precision mediump float;
+#endif
+
+  uniform sampler2D U_Texture;
+
+  varying vec2 V_TextureCoordinates;
+  varying float V_Alpha;
+
+  void main() {
+    gl_FragColor = V_Alpha * texture2D(U_Texture, V_TextureCoordinates);
+  }
+
+)--";
+
+TextureBatchProgram::TextureBatchProgram()
+    : Program::Program(TextureBatchVertexShader, TextureBatchFragmentShader) {}
+
+void TextureBatchProgram::onLinkSuccess() {
+  _projectionUniform = indexForUniform("U_Projection");
+  _textureUniform = indexForUniform("U_Texture");
+  _positionAttribute = indexForAttribute("A_Position");
+  _attributesAttribute = indexForAttribute("A_Attributes");
+}
+
+GLint TextureBatchProgram::projectionUniform() const {
+  return _projectionUniform;
+}
+
+GLint TextureBatchProgram::textureUniform() const {
+  return _textureUniform;
+}
+
+GLint TextureBatchProgram::positionAttribute() const {
+  return _positionAttribute;
+}
+
+GLint TextureBatchProgram::attributesAttribute() const {
+  return _attributesAttribute;
+}
+
+}  // namespace compositor
+}  // namespace rl
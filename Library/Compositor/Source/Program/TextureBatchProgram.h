@@ -0,0 +1,42 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include "Program/Program.h"
+
+namespace rl {
+namespace compositor {
+
+/*
+ *  The program to be used for drawing batches of boxes textured with the same
+ *  texture. The transform and opacity of each box are baked into its vertices.
+ */
+class TextureBatchProgram : public Program {
+ public:
+  TextureBatchProgram();
+
+  GLint projectionUniform() const;
+
+  GLint textureUniform() const;
+
+  GLint positionAttribute() const;
+
+  GLint attributesAttribute() const;
+
+ private:
+  GLint _projectionUniform = -1;
+  GLint _textureUniform = -1;
+  GLint _positionAttribute = -1;
+  GLint _attributesAttribute = -1;
+
+  void onLinkSuccess() override;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(TextureBatchProgram);
+};
+
+}  // namespace compositor
+}  // namespace rl
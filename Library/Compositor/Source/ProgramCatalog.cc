@@ -24,5 +24,17 @@ StrokeProgram& ProgramCatalog::strokeProgram() {
   return _strokeProgram;
 }
 
+ColorBatchProgram& ProgramCatalog::colorBatchProgram() {
+  return _colorBatchProgram;
+}
+
+TextureBatchProgram& ProgramCatalog::textureBatchProgram() {
+  return _textureBatchProgram;
+}
+
+TextBatchProgram& ProgramCatalog::textBatchProgram() {
+  return _textBatchProgram;
+}
+
 }  // namespace compositor
 }  // namespace rl
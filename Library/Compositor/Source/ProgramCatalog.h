@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include "Program/ColorBatchProgram.h"
 #include "Program/ColorProgram.h"
 #include "Program/Program.h"
 #include "Program/StrokeProgram.h"
+#include "Program/TextBatchProgram.h"
+#include "Program/TextureBatchProgram.h"
 #include "Program/TextureProgram.h"
 
 namespace rl {
@@ -25,10 +28,19 @@ class ProgramCatalog {
 
   StrokeProgram& strokeProgram();
 
+  ColorBatchProgram& colorBatchProgram();
+
+  TextureBatchProgram& textureBatchProgram();
+
+  TextBatchProgram& textBatchProgram();
+
  private:
   ColorProgram _colorProgram;
   TextureProgram _textureProgram;
   StrokeProgram _strokeProgram;
+  ColorBatchProgram _colorBatchProgram;
+  TextureBatchProgram _textureBatchProgram;
+  TextBatchProgram _textBatchProgram;
 
   RL_DISALLOW_COPY_AND_ASSIGN(ProgramCatalog);
 };
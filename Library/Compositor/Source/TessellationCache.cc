@@ -0,0 +1,138 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/Utilities.h>
+#include "TessellationCache.h"
+
+namespace rl {
+namespace compositor {
+
+const size_t TessellationCache::DefaultByteBudget = 16 * 1024 * 1024;
+
+TessellationCache::Tessellation::~Tessellation() = default;
+
+TessellationCache& TessellationCache::Shared() {
+  static TessellationCache cache(DefaultByteBudget);
+  return cache;
+}
+
+TessellationCache::TessellationCache(size_t byteBudget)
+    : _byteBudget(byteBudget),
+      _bytes(0),
+      _hits(0),
+      _misses(0),
+      _evictions(0) {}
+
+TessellationCache::~TessellationCache() = default;
+
+std::shared_ptr<const TessellationCache::Tessellation>
+TessellationCache::acquire(Type type,
+                           int variant,
+                           const geom::Path& path,
+                           const Tessellator& tessellator) {
+  Key key(type, variant, path);
+
+  {
+    core::MutexLocker lock(_lock);
+
+    auto found = _map.find(key);
+    if (found != _map.end()) {
+      _hits++;
+      /*
+       *  Mark the entry as the most recently used.
+       */
+      _entries.splice(_entries.begin(), _entries, found->second);
+      return found->second->tessellation;
+    }
+
+    _misses++;
+  }
+
+  /*
+   *  Tessellation is expensive. Don't hold up lookups of other paths while it
+   *  is in progress.
+   */
+  auto tessellation = tessellator();
+
+  if (tessellation == nullptr) {
+    return nullptr;
+  }
+
+  core::MutexLocker lock(_lock);
+
+  auto found = _map.find(key);
+  if (found != _map.end()) {
+    /*
+     *  Another thread tessellated the same path in the meantime. Prefer the
+     *  entry already cached so the tessellations are shared.
+     */
+    _entries.splice(_entries.begin(), _entries, found->second);
+    return found->second->tessellation;
+  }
+
+  _entries.push_front({{}, tessellation});
+  auto inserted = _map.emplace(std::move(key), _entries.begin());
+  _entries.front().mapEntry = inserted.first;
+  _bytes += tessellation->byteSize();
+
+  evictIfNecessary();
+
+  return tessellation;
+}
+
+void TessellationCache::evictIfNecessary() {
+  while (_bytes > _byteBudget && !_entries.empty()) {
+    const auto& entry = _entries.back();
+    _bytes -= entry.tessellation->byteSize();
+    _map.erase(entry.mapEntry);
+    _entries.pop_back();
+    _evictions++;
+  }
+}
+
+size_t TessellationCache::byteBudget() const {
+  core::MutexLocker lock(_lock);
+  return _byteBudget;
+}
+
+void TessellationCache::setByteBudget(size_t byteBudget) {
+  core::MutexLocker lock(_lock);
+  _byteBudget = byteBudget;
+  evictIfNecessary();
+}
+
+void TessellationCache::purge() {
+  core::MutexLocker lock(_lock);
+  _map.clear();
+  _entries.clear();
+  _bytes = 0;
+}
+
+CacheStatistics TessellationCache::statistics() const {
+  core::MutexLocker lock(_lock);
+  CacheStatistics statistics;
+  statistics.hits = _hits;
+  statistics.misses = _misses;
+  statistics.evictions = _evictions;
+  statistics.entries = _entries.size();
+  statistics.bytes = _bytes;
+  return statistics;
+}
+
+std::size_t TessellationCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = geom::Path::Hash()(key.path);
+  core::HashCombine(hash, static_cast<int>(key.type));
+  core::HashCombine(hash, key.variant);
+  return hash;
+}
+
+bool TessellationCache::KeyEqual::operator()(const Key& lhs,
+                                             const Key& rhs) const {
+  return lhs.type == rhs.type && lhs.variant == rhs.variant &&
+         geom::Path::Equal()(lhs.path, rhs.path);
+}
+
+}  // namespace compositor
+}  // namespace rl
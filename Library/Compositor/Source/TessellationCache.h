@@ -0,0 +1,154 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Compositor/CompositorStatistics.h>
+#include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Geometry/Path.h>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  A process wide cache of path tessellations. Tessellations are keyed on the
+ *  contents of the path (not its identity) so entities with identical paths
+ *  share the same tessellation. Since a mutated path is a different key, stale
+ *  tessellations are never returned and are eventually evicted.
+ *
+ *  The cache is bounded by the size of the vertex data it holds. The least
+ *  recently used tessellations are evicted first. Tessellations still in use
+ *  by vertices stay alive after eviction till those vertices are collected.
+ *
+ *  The cache may be used on any thread.
+ */
+class TessellationCache {
+ public:
+  /**
+   *  The result of tessellating a path. Immutable once cached.
+   */
+  class Tessellation {
+   public:
+    virtual ~Tessellation();
+
+    /**
+     *  @return the size of the vertex data held by the tessellation
+     */
+    virtual size_t byteSize() const = 0;
+  };
+
+  enum class Type {
+    Fill,
+    Stroke,
+  };
+
+  using Tessellator = std::function<std::shared_ptr<const Tessellation>()>;
+
+  static const size_t DefaultByteBudget;
+
+  /**
+   *  @return the cache shared by all vertices in the process
+   */
+  static TessellationCache& Shared();
+
+  /**
+   *  Create a cache bounded by the given size of vertex data.
+   *
+   *  @param byteBudget the maximum size of vertex data held by the cache
+   */
+  TessellationCache(size_t byteBudget);
+
+  ~TessellationCache();
+
+  /**
+   *  Find the tessellation of the path or tessellate it and cache the result.
+   *  The tessellator is invoked without holding the cache lock.
+   *
+   *  @param type       the type of the tessellation
+   *  @param variant    distinguishes tessellations of the same type and path
+   *                    (like the winding rule of fills)
+   *  @param path       the path to tessellate
+   *  @param tessellator tessellates the path on a miss
+   *
+   *  @return the tessellation of the path. May be null if the tessellator
+   *          failed.
+   */
+  std::shared_ptr<const Tessellation> acquire(Type type,
+                                              int variant,
+                                              const geom::Path& path,
+                                              const Tessellator& tessellator);
+
+  size_t byteBudget() const;
+
+  /**
+   *  Update the size of vertex data held by the cache. Evicts tessellations
+   *  immediately if the cache is over the new budget.
+   *
+   *  @param byteBudget the new budget
+   */
+  void setByteBudget(size_t byteBudget);
+
+  /**
+   *  Evict all tessellations. The hit and miss counts are preserved.
+   */
+  void purge();
+
+  /**
+   *  @return a snapshot of the statistics of the cache
+   */
+  CacheStatistics statistics() const;
+
+ private:
+  struct Key {
+    Type type;
+    int variant;
+    geom::Path path;
+
+    Key(Type aType, int aVariant, geom::Path aPath)
+        : type(aType), variant(aVariant), path(std::move(aPath)) {}
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const;
+  };
+
+  struct Entry;
+  using EntryList = std::list<Entry>;
+  using EntryMap =
+      std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual>;
+
+  struct Entry {
+    EntryMap::const_iterator mapEntry;
+    std::shared_ptr<const Tessellation> tessellation;
+  };
+
+  mutable core::Mutex _lock;
+  size_t _byteBudget RL_GUARDED_BY(_lock);
+  size_t _bytes RL_GUARDED_BY(_lock);
+  size_t _hits RL_GUARDED_BY(_lock);
+  size_t _misses RL_GUARDED_BY(_lock);
+  size_t _evictions RL_GUARDED_BY(_lock);
+  /*
+   *  Ordered from most to least recently used.
+   */
+  EntryList _entries RL_GUARDED_BY(_lock);
+  EntryMap _map RL_GUARDED_BY(_lock);
+
+  void evictIfNecessary() RL_REQUIRES(_lock);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace compositor
+}  // namespace rl
@@ -3,13 +3,19 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <Core/Utilities.h>
+#include <Image/ImageCache.h>
 #include "Texture.h"
 
 namespace rl {
 namespace compositor {
 
-Texture::Texture(image::Image image)
-    : _image(image), _state(State::Compressed), _textureHandle(GL_NONE) {}
+Texture::Texture(image::Image image, const geom::Size& sizeHint)
+    : _image(image),
+      _sizeHint(sizeHint),
+      _reductionFactor(_image.reductionFactor(sizeHint)),
+      _state(State::Compressed),
+      _textureHandle(GL_NONE) {}
 
 Texture::~Texture() {
   if (_textureHandle != GL_NONE) {
@@ -21,6 +27,8 @@ Texture::~Texture() {
 
 Texture::Texture(Texture&& other)
     : _image(std::move(other._image)),
+      _sizeHint(other._sizeHint),
+      _reductionFactor(other._reductionFactor),
       _imageResult(std::move(other._imageResult)),
       _state(other._state),
       _textureHandle(other._textureHandle) {
@@ -41,9 +49,13 @@ bool Texture::uncompress() {
     return false;
   }
 
-  auto result = _image.decode();
+  /*
+   *  Identical images used by other textures (even ones in other interfaces)
+   *  are only decoded once for each reduction factor.
+   */
+  auto result = image::ImageCache::Shared().decode(_image, _sizeHint);
 
-  if (result.wasSuccessful()) {
+  if (result != nullptr) {
     _imageResult = std::move(result);
     _state = State::Uncompressed;
     return true;
@@ -67,7 +79,7 @@ bool Texture::uploadToVRAM() {
     return false;
   }
 
-  if (!_imageResult.wasSuccessful()) {
+  if (_imageResult == nullptr || !_imageResult->wasSuccessful()) {
     /*
      *  The decode job itself failed.
      */
@@ -76,7 +88,7 @@ bool Texture::uploadToVRAM() {
     return false;
   }
 
-  const auto size = _imageResult.size();
+  const auto size = _imageResult->size();
 
   if (size.width <= 0.0 || size.height <= 0.0) {
     /*
@@ -93,7 +105,7 @@ bool Texture::uploadToVRAM() {
 
   GLint format = GL_NONE;
 
-  switch (_imageResult.components()) {
+  switch (_imageResult->components()) {
     case image::ImageResult::Components::Grey:
       format = GL_LUMINANCE;
       break;
@@ -139,11 +151,17 @@ bool Texture::uploadToVRAM() {
                0,                                  // border
                format,                             // format
                GL_UNSIGNED_BYTE,                   // type
-               _imageResult.allocation().data()    // data
+               _imageResult->allocation().data()   // data
                );
 
   RL_GLAssert("There must be no errors post texture upload.");
 
+  /*
+   *  The decoded image is no longer needed by this texture. The image cache
+   *  keeps it around for other textures while it is within budget.
+   */
+  _imageResult = nullptr;
+
   _state = State::UploadedToVRAM;
   return true;
 }
@@ -163,11 +181,14 @@ bool Texture::bind(GLint samplerUniform, size_t activeIndex) const {
 }
 
 std::size_t Texture::Hash::operator()(const Texture& key) const {
-  return image::Image::Hash()(key._image);
+  size_t seed = image::Image::Hash()(key._image);
+  core::HashCombine(seed, static_cast<uint64_t>(key._reductionFactor));
+  return seed;
 }
 
 bool Texture::Equal::operator()(const Texture& lhs, const Texture& rhs) const {
-  return image::Image::Equal()(lhs._image, rhs._image);
+  return lhs._reductionFactor == rhs._reductionFactor &&
+         image::Image::Equal()(lhs._image, rhs._image);
 }
 
 }  // namespace compositor
@@ -22,7 +22,15 @@ class Texture {
     Error,           //
   };
 
-  Texture(image::Image image);
+  /**
+   *  Create a texture of the image. The image is decoded reduced to about the
+   *  size hint.
+   *
+   *  @param image    the image to decode
+   *  @param sizeHint the size the texture is displayed at. See
+   *                  `image::Image::decode`.
+   */
+  Texture(image::Image image, const geom::Size& sizeHint);
 
   ~Texture();
 
@@ -47,7 +55,9 @@ class Texture {
  private:
   RL_DEBUG_THREAD_GUARD(_guard);
   image::Image _image;
-  image::ImageResult _imageResult;
+  geom::Size _sizeHint;
+  size_t _reductionFactor;
+  std::shared_ptr<const image::ImageResult> _imageResult;
   State _state;
   GLuint _textureHandle;
 
@@ -0,0 +1,61 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <cstddef>
+#include "Vertices/BatchVertices.h"
+
+namespace rl {
+namespace compositor {
+
+BatchVertices::BatchVertices() : Vertices(Vertices::Type::Array) {}
+
+bool BatchVertices::uploadVertexData() {
+  /*
+   *  The vertices are only known once the frame is being rendered.
+   */
+  return true;
+}
+
+bool BatchVertices::update(const std::vector<BatchVertex>& vertices) {
+  auto bound = bindBuffer();
+
+  if (!bound) {
+    return false;
+  }
+
+  /*
+   *  Respecifying the entire store lets the driver orphan the storage still in
+   *  use by the previous frame instead of stalling on it.
+   */
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BatchVertex),
+               vertices.data(), GL_STREAM_DRAW);
+
+  return true;
+}
+
+bool BatchVertices::draw(size_t positionAttributeIndex,
+                         size_t attributesAttributeIndex,
+                         size_t firstVertex,
+                         size_t vertexCount) const {
+  auto bound = bindBuffer();
+
+  if (!bound) {
+    return false;
+  }
+
+  auto positionDisable =
+      enableAttribute(positionAttributeIndex, 4, GL_FLOAT, sizeof(BatchVertex),
+                      offsetof(BatchVertex, position));
+  auto attributesDisable =
+      enableAttribute(attributesAttributeIndex, 4, GL_FLOAT,
+                      sizeof(BatchVertex), offsetof(BatchVertex, attributes));
+
+  glDrawArrays(GL_TRIANGLES, firstVertex, vertexCount);
+
+  return true;
+}
+
+}  // namespace compositor
+}  // namespace rl
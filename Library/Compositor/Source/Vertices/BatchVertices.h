@@ -0,0 +1,56 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <vector>
+#include "Batch.h"
+#include "Vertices/Vertices.h"
+
+namespace rl {
+namespace compositor {
+
+/**
+ *  The vertex buffer shared by all batches in a frame. Its contents are
+ *  replaced once per frame.
+ */
+class BatchVertices : public Vertices {
+ public:
+  BatchVertices();
+
+  /**
+   *  Replace the contents of the buffer with the vertices of the batches in
+   *  the current frame.
+   *
+   *  @param vertices the vertices to upload
+   *
+   *  @return if the vertices were uploaded
+   */
+  RL_WARN_UNUSED_RESULT
+  bool update(const std::vector<BatchVertex>& vertices);
+
+  /**
+   *  Draw a range of the vertices in the buffer as triangles.
+   *
+   *  @param positionAttributeIndex   the index of the position attribute
+   *  @param attributesAttributeIndex the index of the batch specific attribute
+   *  @param firstVertex              the first vertex to draw
+   *  @param vertexCount              the number of vertices to draw
+   *
+   *  @return if the vertices were drawn
+   */
+  bool draw(size_t positionAttributeIndex,
+            size_t attributesAttributeIndex,
+            size_t firstVertex,
+            size_t vertexCount) const;
+
+ private:
+  bool uploadVertexData() override;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(BatchVertices);
+};
+
+}  // namespace compositor
+}  // namespace rl
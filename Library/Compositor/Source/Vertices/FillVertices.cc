@@ -6,6 +6,7 @@
 #include <libtess2/tesselator.h>
 #include "Console.h"
 #include "FillVertices.h"
+#include "TessellationCache.h"
 
 namespace rl {
 namespace compositor {
@@ -80,11 +81,24 @@ static void DestroyTessellator(TESStesselator* tessellator) {
   }
 }
 
-FillVertices::FillVertices(const geom::Path& path, Winding winding)
-    : Vertices(Vertices::Type::ElementArray) {
-  if (path.componentCount() == 0) {
-    return;
+struct FillVertices::Tessellation : public TessellationCache::Tessellation {
+  geom::Size size;
+  std::vector<gl::GLPoint> vertices;
+  std::vector<GLshort> elements;
+
+  size_t byteSize() const override {
+    return vertices.size() * sizeof(decltype(vertices)::value_type) +
+           elements.size() * sizeof(decltype(elements)::value_type);
   }
+};
+
+std::shared_ptr<const FillVertices::Tessellation> FillVertices::tessellate(
+    const geom::Path& path,
+    Winding winding) {
+  /*
+   *  Failed tessellations are cached too so they are not attempted again.
+   */
+  auto result = std::make_shared<Tessellation>();
 
   using Tessellator =
       std::unique_ptr<TESStesselator, decltype(&DestroyTessellator)>;
@@ -93,39 +107,41 @@ FillVertices::FillVertices(const geom::Path& path, Winding winding)
                           DestroyTessellator);
 
   if (tessellator == nullptr) {
-    return;
+    return result;
   }
 
   bool success = false;
-  std::tie(success, _size) = PopulateFillWithPath(tessellator.get(), path);
+  geom::Size size;
+  std::tie(success, size) = PopulateFillWithPath(tessellator.get(), path);
 
   if (!success) {
-    return;
+    return result;
   }
 
   /*
    *  Perform tessellation.
    */
-  auto result = tessTesselate(tessellator.get(),           // tessellator
-                              ToTessWindingRule(winding),  // winding
-                              TESS_POLYGONS,               // element type
-                              kPolygonSize,                // polygon size
-                              kVertexSize,                 // vertex size
-                              nullptr                      // normal
-                              );
-
-  if (result != 1) {
-    _size = {};
-    return;
+  auto tessellated = tessTesselate(tessellator.get(),           // tessellator
+                                   ToTessWindingRule(winding),  // winding
+                                   TESS_POLYGONS,               // element type
+                                   kPolygonSize,                // polygon size
+                                   kVertexSize,                 // vertex size
+                                   nullptr                      // normal
+                                   );
+
+  if (tessellated != 1) {
+    return result;
   }
 
+  result->size = size;
+
   /*
    *  Copy vertices to ensure they are packed correctly for upload.
    */
   int vertexItemCount = tessGetVertexCount(tessellator.get()) * kVertexSize;
   auto vertices = tessGetVertices(tessellator.get());
   for (int i = 0; i < vertexItemCount; i += 2) {
-    _vertices.emplace_back(vertices[i], vertices[i + 1]);
+    result->vertices.emplace_back(vertices[i], vertices[i + 1]);
   }
 
   /*
@@ -134,24 +150,34 @@ FillVertices::FillVertices(const geom::Path& path, Winding winding)
   int elementItemCount = tessGetElementCount(tessellator.get()) * kPolygonSize;
   auto elements = tessGetElements(tessellator.get());
   for (int i = 0; i < elementItemCount; i++) {
-    _elements.emplace_back(elements[i]);
+    result->elements.emplace_back(elements[i]);
   }
+
+  return result;
+}
+
+FillVertices::FillVertices(const geom::Path& path, Winding winding)
+    : Vertices(Vertices::Type::ElementArray) {
+  _tessellation = std::static_pointer_cast<const Tessellation>(
+      TessellationCache::Shared().acquire(
+          TessellationCache::Type::Fill, static_cast<int>(winding), path,
+          [&]() { return tessellate(path, winding); }));
 }
 
 FillVertices::~FillVertices() = default;
 
 const geom::Size& FillVertices::size() const {
-  return _size;
+  return _tessellation->size;
 }
 
 bool FillVertices::uploadVertexData() {
-  glBufferData(GL_ARRAY_BUFFER,
-               _vertices.size() * sizeof(decltype(_vertices)::value_type),
-               _vertices.data(), GL_STATIC_DRAW);
+  const auto& vertices = _tessellation->vertices;
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(gl::GLPoint),
+               vertices.data(), GL_STATIC_DRAW);
 
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-               _elements.size() * sizeof(decltype(_elements)::value_type),
-               _elements.data(), GL_STATIC_DRAW);
+  const auto& elements = _tessellation->elements;
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, elements.size() * sizeof(GLshort),
+               elements.data(), GL_STATIC_DRAW);
 
   return true;
 }
@@ -170,7 +196,8 @@ bool FillVertices::draw(size_t positionAttributeIndex) const {
                           ? GL_LINE_LOOP
                           : GL_TRIANGLES;
 
-  glDrawElements(mode, _elements.size(), GL_UNSIGNED_SHORT, nullptr);
+  glDrawElements(mode, _tessellation->elements.size(), GL_UNSIGNED_SHORT,
+                 nullptr);
 
   return true;
 }
@@ -7,7 +7,7 @@
 
 #include <Core/Macros.h>
 #include <Geometry/Path.h>
-#include <vector>
+#include <memory>
 #include "Vertices/Vertices.h"
 
 namespace rl {
@@ -32,9 +32,15 @@ class FillVertices : public Vertices {
   bool draw(size_t positionAttributeIndex) const;
 
  private:
-  geom::Size _size;
-  std::vector<gl::GLPoint> _vertices;
-  std::vector<GLshort> _elements;
+  struct Tessellation;
+
+  /*
+   *  Shared with all other vertices for the same path and winding.
+   */
+  std::shared_ptr<const Tessellation> _tessellation;
+
+  static std::shared_ptr<const Tessellation> tessellate(const geom::Path& path,
+                                                       Winding winding);
 
   bool uploadVertexData() override;
 
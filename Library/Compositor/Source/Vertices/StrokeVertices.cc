@@ -7,27 +7,51 @@
 #include <Geometry/Vector.h>
 #include <stddef.h>
 #include "Console.h"
+#include "TessellationCache.h"
 
 namespace rl {
 namespace compositor {
 
-StrokeVertices::StrokeVertices(const geom::Path& path)
-    : Vertices(Vertices::Type::Array) {
-  _size = path.boundingBox().size;
+struct StrokeVertices::Tessellation : public TessellationCache::Tessellation {
+  std::vector<StrokeVertex> vertices;
 
-  if (_size.isZero()) {
-    return;
+  size_t byteSize() const override {
+    return vertices.size() * sizeof(StrokeVertex);
   }
+};
 
-  geom::SmoothingApproximation defaultApproximation;
-  path.smoothPoints(std::bind(&StrokeVertices::tessellatePathComponent, this,
-                              std::placeholders::_1),
-                    defaultApproximation);
+StrokeVertices::StrokeVertices(const geom::Path& path)
+    : Vertices(Vertices::Type::Array), _size(path.boundingBox().size) {
+  _tessellation = std::static_pointer_cast<const Tessellation>(
+      TessellationCache::Shared().acquire(
+          TessellationCache::Type::Stroke, 0, path,
+          [&]() { return tessellate(path, _size); }));
 }
 
 StrokeVertices::~StrokeVertices() = default;
 
+std::shared_ptr<const StrokeVertices::Tessellation> StrokeVertices::tessellate(
+    const geom::Path& path,
+    const geom::Size& size) {
+  auto result = std::make_shared<Tessellation>();
+
+  if (size.isZero()) {
+    return result;
+  }
+
+  geom::SmoothingApproximation defaultApproximation;
+  path.smoothPoints(
+      [&](const std::vector<geom::Point>& points) {
+        return tessellatePathComponent(*result, size, points);
+      },
+      defaultApproximation);
+
+  return result;
+}
+
 bool StrokeVertices::tessellatePathComponent(
+    Tessellation& tessellation,
+    const geom::Size& size,
     const std::vector<geom::Point>& points) {
   if (points.size() < 2) {
     /*
@@ -36,6 +60,8 @@ bool StrokeVertices::tessellatePathComponent(
     return true;
   }
 
+  auto& vertices = tessellation.vertices;
+
   for (size_t i = 0, length = points.size(); i < length; i++) {
     const bool lastPoint = i == length - 1;
 
@@ -45,7 +71,7 @@ bool StrokeVertices::tessellatePathComponent(
     double dx = p2.x - p1.x;
     double dy = p2.y - p1.y;
 
-    const gl::GLPoint vertex(p1.x / _size.width, p1.y / _size.height);
+    const gl::GLPoint vertex(p1.x / size.width, p1.y / size.height);
 
     const double direction = lastPoint ? -1.0 : 1.0;
 
@@ -53,12 +79,12 @@ bool StrokeVertices::tessellatePathComponent(
         geom::Vector3{-dy * direction, dx * direction}.normalize();
 
     if (i == 0) {
-      _vertices.emplace_back(vertex, -normal, 0.0);
-      _vertices.emplace_back(vertex, normal, 0.0);
+      vertices.emplace_back(vertex, -normal, 0.0);
+      vertices.emplace_back(vertex, normal, 0.0);
     }
 
-    _vertices.emplace_back(vertex, normal, 1.0);
-    _vertices.emplace_back(vertex, -normal, 1.0);
+    vertices.emplace_back(vertex, normal, 1.0);
+    vertices.emplace_back(vertex, -normal, 1.0);
   }
 
   return true;
@@ -77,9 +103,9 @@ bool StrokeVertices::setSize(const geom::Size& size) {
 }
 
 bool StrokeVertices::uploadVertexData() {
-  glBufferData(GL_ARRAY_BUFFER,
-               _vertices.size() * sizeof(decltype(_vertices)::value_type),
-               _vertices.data(), GL_STATIC_DRAW);
+  const auto& vertices = _tessellation->vertices;
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(StrokeVertex),
+               vertices.data(), GL_STATIC_DRAW);
 
   return true;
 }
@@ -108,7 +134,7 @@ bool StrokeVertices::draw(size_t positionAttributeIndex,
   glDrawArrays(RL_CONSOLE_GET_VALUE_ONCE("Show Stroke Mesh", false)
                    ? GL_LINE_STRIP
                    : GL_TRIANGLE_STRIP,
-               0, _vertices.size());
+               0, _tessellation->vertices.size());
 
   return true;
 }
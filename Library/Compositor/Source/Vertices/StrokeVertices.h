@@ -7,6 +7,8 @@
 
 #include <Core/Macros.h>
 #include <Geometry/Path.h>
+#include <memory>
+#include <vector>
 #include "Vertices/Vertices.h"
 
 namespace rl {
@@ -43,11 +45,21 @@ class StrokeVertices : public Vertices {
           segmentContinuation(pSegmentContinuation) {}
   };
 
-  std::vector<StrokeVertex> _vertices;
+  struct Tessellation;
 
-  bool uploadVertexData() override;
+  /*
+   *  Shared with all other vertices for the same path.
+   */
+  std::shared_ptr<const Tessellation> _tessellation;
+
+  static std::shared_ptr<const Tessellation> tessellate(const geom::Path& path,
+                                                       const geom::Size& size);
 
-  bool tessellatePathComponent(const std::vector<geom::Point>& points);
+  static bool tessellatePathComponent(Tessellation& tessellation,
+                                      const geom::Size& size,
+                                      const std::vector<geom::Point>& points);
+
+  bool uploadVertexData() override;
 
   RL_DISALLOW_COPY_AND_ASSIGN(StrokeVertices);
 };
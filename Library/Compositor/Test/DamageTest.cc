@@ -0,0 +1,161 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/Damage.h>
+#include <Compositor/PresentationEntity.h>
+#include <TestRunner/TestRunner.h>
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+static const geom::Size kFrameSize(100.0, 100.0);
+
+static Damage Render(PresentationEntity& root) {
+  FrontEndPass pass;
+  root.render(pass, {});
+  return pass.damage();
+}
+
+static void SetupBox(PresentationEntity& entity, const geom::Rect& frame) {
+  entity.setBounds({{}, frame.size});
+  entity.setAnchorPoint({0.0, 0.0});
+  entity.setPosition(frame.origin);
+  entity.setBackgroundColor(entity::Color::Red());
+}
+
+TEST(DamageTest, BoundsOfAddedAreas) {
+  Damage damage;
+  ASSERT_TRUE(damage.isEmpty());
+  ASSERT_FALSE(damage.intersects({0.0, 0.0, 10.0, 10.0}));
+
+  damage.add(geom::Rect{10.0, 10.0, 0.0, 5.0});
+  ASSERT_TRUE(damage.isEmpty());
+
+  damage.add(geom::Rect{10.0, 10.0, 10.0, 10.0});
+  damage.add(geom::Rect{40.0, 5.0, 10.0, 10.0});
+  ASSERT_FALSE(damage.isEmpty());
+  ASSERT_EQ(damage.bounds(), geom::Rect(10.0, 5.0, 40.0, 15.0));
+  ASSERT_TRUE(damage.intersects({25.0, 10.0, 1.0, 1.0}));
+  ASSERT_FALSE(damage.intersects({60.0, 10.0, 1.0, 1.0}));
+
+  /*
+   *  Pixel bounds cover partially damaged pixels and are clipped to the frame.
+   */
+  Damage fractional;
+  fractional.add(geom::Rect{10.5, 20.25, 10.0, 10.0});
+  ASSERT_EQ(fractional.pixelBounds(kFrameSize),
+            geom::Rect(10.0, 20.0, 11.0, 11.0));
+
+  Damage offscreen;
+  offscreen.add(geom::Rect{-10.0, 90.0, 20.0, 20.0});
+  ASSERT_EQ(offscreen.pixelBounds(kFrameSize),
+            geom::Rect(0.0, 90.0, 10.0, 10.0));
+}
+
+TEST(DamageTest, HistoryAccumulatesDamageSinceBufferWasPresented) {
+  DamageHistory history;
+
+  Damage first;
+  first.add(geom::Rect{0.0, 0.0, 10.0, 10.0});
+  Damage second;
+  second.add(geom::Rect{20.0, 0.0, 10.0, 10.0});
+  Damage third;
+  third.add(geom::Rect{40.0, 0.0, 10.0, 10.0});
+
+  /*
+   *  Nothing is known about the buffer of the first frame.
+   */
+  auto damage = history.accumulate(first, kFrameSize, 1);
+  ASSERT_EQ(damage.bounds(), geom::Rect(kFrameSize));
+
+  damage = history.accumulate(second, kFrameSize, 1);
+  ASSERT_EQ(damage.bounds(), geom::Rect(20.0, 0.0, 10.0, 10.0));
+
+  damage = history.accumulate(third, kFrameSize, 2);
+  ASSERT_EQ(damage.bounds(), geom::Rect(20.0, 0.0, 30.0, 10.0));
+
+  damage = history.accumulate(first, kFrameSize, 3);
+  ASSERT_EQ(damage.bounds(), geom::Rect(0.0, 0.0, 50.0, 10.0));
+
+  /*
+   *  Buffers with undefined contents or older than the history are redrawn
+   *  entirely.
+   */
+  damage = history.accumulate(first, kFrameSize, 0);
+  ASSERT_EQ(damage.bounds(), geom::Rect(kFrameSize));
+
+  damage = history.accumulate(first, kFrameSize, DamageHistory::MaxBufferAge);
+  ASSERT_EQ(damage.bounds(), geom::Rect(0.0, 0.0, 50.0, 10.0));
+
+  damage =
+      history.accumulate(first, kFrameSize, DamageHistory::MaxBufferAge + 1);
+  ASSERT_EQ(damage.bounds(), geom::Rect(kFrameSize));
+
+  /*
+   *  Resizing the frame discards the history.
+   */
+  damage = history.accumulate(first, {200.0, 200.0}, 1);
+  ASSERT_EQ(damage.bounds(), geom::Rect(0.0, 0.0, 200.0, 200.0));
+}
+
+TEST(DamageTest, UpdatedEntitiesDamageOldAndNewBounds) {
+  core::Namespace ns;
+  PresentationEntity root(core::Name{ns});
+  PresentationEntity parent(core::Name{ns});
+  PresentationEntity leaf(core::Name{ns});
+  PresentationEntity sibling(core::Name{ns});
+
+  SetupBox(root, {0.0, 0.0, 100.0, 100.0});
+  SetupBox(parent, {10.0, 10.0, 50.0, 50.0});
+  SetupBox(leaf, {10.0, 10.0, 10.0, 10.0});
+  SetupBox(sibling, {70.0, 70.0, 10.0, 10.0});
+  root.addChild(&parent);
+  root.addChild(&sibling);
+  parent.addChild(&leaf);
+
+  /*
+   *  Everything is damaged on the first render. Antialiasing extends the
+   *  damage by a pixel.
+   */
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(-1.0, -1.0, 102.0, 102.0));
+  ASSERT_TRUE(Render(root).isEmpty());
+
+  leaf.setPosition({30.0, 10.0});
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(19.0, 19.0, 32.0, 12.0));
+
+  leaf.setBackgroundColor(entity::Color::Blue());
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(39.0, 19.0, 12.0, 12.0));
+
+  /*
+   *  Strokes extend the damage by their size.
+   */
+  sibling.setStrokeSize(2.0);
+  sibling.setStrokeColor(entity::Color::Blue());
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(67.0, 67.0, 16.0, 16.0));
+
+  /*
+   *  Moving a parent damages its entire subtree.
+   */
+  parent.setPosition({20.0, 10.0});
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(9.0, 9.0, 62.0, 52.0));
+
+  /*
+   *  Removed subtrees are damaged. Entities that are no longer drawn don't
+   *  damage anything.
+   */
+  root.removeChild(&parent);
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(19.0, 9.0, 52.0, 52.0));
+
+  sibling.setOpacity(0.0);
+  ASSERT_EQ(Render(root).bounds(), geom::Rect(67.0, 67.0, 16.0, 16.0));
+
+  sibling.setPosition({0.0, 0.0});
+  ASSERT_TRUE(Render(root).isEmpty());
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,214 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/BackendPass.h>
+#include <TestRunner/TestRunner.h>
+#include <memory>
+#include <vector>
+#include "DrawList.h"
+#include "Primitive/ColoredBoxPrimitive.h"
+#include "Primitive/ColoredBoxStrokePrimitive.h"
+#include "Primitive/TexturedBoxPrimitive.h"
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+/**
+ *  Place the primitive at the given rect in the coordinate space of the frame.
+ */
+static void Place(Primitive& primitive, const geom::Rect& rect) {
+  primitive.setSize(rect.size);
+  primitive.setModelViewMatrix(
+      geom::Matrix::Translation({rect.origin.x, rect.origin.y, 0.0}));
+}
+
+static std::unique_ptr<ColoredBoxPrimitive> ColoredBox(const geom::Rect& rect) {
+  auto box = std::make_unique<ColoredBoxPrimitive>();
+  Place(*box, rect);
+  return box;
+}
+
+static std::unique_ptr<TexturedBoxPrimitive> TexturedBox(
+    BackEndPass& pass,
+    const image::Image& image,
+    const geom::Rect& rect) {
+  auto box = std::make_unique<TexturedBoxPrimitive>(image, rect.size);
+  Place(*box, rect);
+  /*
+   *  Preparing the primitive only registers its texture with the pass. Boxes
+   *  with the same image end up sharing the same texture.
+   */
+  EXPECT_TRUE(box->prepareToRender(pass));
+  return box;
+}
+
+/*
+ *  Images are compared by their contents. Images with different seeds are
+ *  different textures.
+ */
+static image::Image MakeImage(uint8_t seed = 0) {
+  const uint8_t bytes[] = {seed, 1, 2, 3};
+  return image::Image{core::Allocation{bytes, sizeof(bytes)}};
+}
+
+TEST(DrawListTest, DisjointColoredBoxesAreDrawnInOneCall) {
+  std::vector<std::unique_ptr<Primitive>> boxes;
+  DrawList list;
+
+  for (size_t i = 0; i < 100; i++) {
+    boxes.emplace_back(ColoredBox({i * 10.0, 0.0, 10.0, 10.0}));
+    list.addPrimitive(*boxes.back());
+  }
+
+  list.finalize();
+
+  ASSERT_EQ(list.primitivesCount(), 100u);
+  ASSERT_EQ(list.drawCallCount(), 1u);
+  ASSERT_EQ(list.commands()[0].primitivesCount, 100u);
+  ASSERT_EQ(list.vertices().size(), 600u);
+}
+
+TEST(DrawListTest, OverlappingBoxesKeepPaintersOrder) {
+  BackEndPass pass;
+  auto image = MakeImage();
+  std::vector<std::unique_ptr<Primitive>> boxes;
+  DrawList list;
+
+  /*
+   *  Every box overlaps the previous one. So the colored and textured boxes
+   *  must be drawn alternately.
+   */
+  for (size_t i = 0; i < 10; i++) {
+    const geom::Rect rect(i * 5.0, 0.0, 10.0, 10.0);
+    if (i % 2 == 0) {
+      boxes.emplace_back(ColoredBox(rect));
+    } else {
+      boxes.emplace_back(TexturedBox(pass, image, rect));
+    }
+    list.addPrimitive(*boxes.back());
+  }
+
+  list.finalize();
+
+  ASSERT_EQ(list.drawCallCount(), 10u);
+  for (size_t i = 0; i < 10; i++) {
+    ASSERT_EQ(list.commands()[i].primitive, boxes[i].get());
+  }
+}
+
+TEST(DrawListTest, DisjointBoxesAreReorderedIntoBatches) {
+  BackEndPass pass;
+  auto image = MakeImage();
+  auto otherImage = MakeImage(1);
+  std::vector<std::unique_ptr<Primitive>> boxes;
+  DrawList list;
+
+  /*
+   *  Interleave colored boxes with boxes textured with one of two images.
+   */
+  for (size_t i = 0; i < 30; i++) {
+    const geom::Rect rect(i * 10.0, 0.0, 10.0, 10.0);
+    switch (i % 3) {
+      case 0:
+        boxes.emplace_back(ColoredBox(rect));
+        break;
+      case 1:
+        boxes.emplace_back(TexturedBox(pass, image, rect));
+        break;
+      case 2:
+        boxes.emplace_back(TexturedBox(pass, otherImage, rect));
+        break;
+    }
+    list.addPrimitive(*boxes.back());
+  }
+
+  list.finalize();
+
+  ASSERT_EQ(list.drawCallCount(), 3u);
+  for (size_t i = 0; i < 3; i++) {
+    const auto& command = list.commands()[i];
+    ASSERT_EQ(command.primitive, boxes[i].get());
+    ASSERT_EQ(command.primitivesCount, 10u);
+    ASSERT_EQ(command.firstVertex, i * 60u);
+    ASSERT_EQ(command.vertexCount, 60u);
+  }
+}
+
+TEST(DrawListTest, UnbatchablePrimitivesAreBarriers) {
+  std::vector<std::unique_ptr<Primitive>> primitives;
+  DrawList list;
+
+  primitives.emplace_back(ColoredBox({0.0, 0.0, 10.0, 10.0}));
+  primitives.emplace_back(ColoredBox({20.0, 0.0, 10.0, 10.0}));
+  primitives.emplace_back(std::make_unique<ColoredBoxStrokePrimitive>(
+      entity::Color::Red()));
+  primitives.emplace_back(ColoredBox({40.0, 0.0, 10.0, 10.0}));
+  primitives.emplace_back(ColoredBox({60.0, 0.0, 10.0, 10.0}));
+
+  for (const auto& primitive : primitives) {
+    list.addPrimitive(*primitive);
+  }
+
+  list.finalize();
+
+  ASSERT_EQ(list.drawCallCount(), 3u);
+
+  const auto& commands = list.commands();
+  ASSERT_EQ(commands[0].primitivesCount, 2u);
+  ASSERT_FALSE(commands[1].key.isBatchable());
+  ASSERT_EQ(commands[1].primitive, primitives[2].get());
+  ASSERT_EQ(commands[1].vertexCount, 0u);
+  ASSERT_EQ(commands[2].primitive, primitives[3].get());
+  ASSERT_EQ(commands[2].primitivesCount, 2u);
+}
+
+TEST(DrawListTest, DisablingBatchingDrawsEachPrimitive) {
+  std::vector<std::unique_ptr<Primitive>> boxes;
+  DrawList list(false);
+
+  for (size_t i = 0; i < 10; i++) {
+    boxes.emplace_back(ColoredBox({i * 10.0, 0.0, 10.0, 10.0}));
+    list.addPrimitive(*boxes.back());
+  }
+
+  list.finalize();
+
+  ASSERT_EQ(list.drawCallCount(), 10u);
+  ASSERT_EQ(list.vertices().size(), 0u);
+}
+
+TEST(DrawListTest, BatchVerticesCarryTransformColorAndOpacity) {
+  ColoredBoxPrimitive box;
+  box.setSize({20.0, 10.0});
+  box.setModelViewMatrix(geom::Matrix::Translation({5.0, 7.0, 0.0}));
+  box.setColor({0.25, 0.5, 0.75, 0.5});
+  box.setOpacity(0.5);
+
+  DrawList list;
+  list.addPrimitive(box);
+  list.finalize();
+
+  const auto& vertices = list.vertices();
+  ASSERT_EQ(vertices.size(), 6u);
+
+  geom::Rect bounds(vertices[0].position[0], vertices[0].position[1], 0.0,
+                    0.0);
+  for (const auto& vertex : vertices) {
+    bounds = bounds.withPoint({vertex.position[0], vertex.position[1]});
+    ASSERT_EQ(vertex.position[3], 1.0f);
+    ASSERT_EQ(vertex.attributes[0], 0.25f);
+    ASSERT_EQ(vertex.attributes[1], 0.5f);
+    ASSERT_EQ(vertex.attributes[2], 0.75f);
+    ASSERT_EQ(vertex.attributes[3], 0.25f);
+  }
+
+  ASSERT_EQ(bounds, geom::Rect(5.0, 7.0, 20.0, 10.0));
+  ASSERT_EQ(box.frameBounds(), geom::Rect(5.0, 7.0, 20.0, 10.0));
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
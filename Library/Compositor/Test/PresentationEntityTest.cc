@@ -0,0 +1,172 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/PresentationEntity.h>
+#include <TestRunner/TestRunner.h>
+#include <memory>
+#include <vector>
+#include "Primitive/ColoredBoxPrimitive.h"
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+using Entities = std::vector<std::unique_ptr<PresentationEntity>>;
+
+static PresentationEntity& AddBox(Entities& entities,
+                                  core::Namespace& ns,
+                                  PresentationEntity* parent,
+                                  const geom::Point& position) {
+  entities.emplace_back(std::make_unique<PresentationEntity>(core::Name{ns}));
+  auto& entity = *entities.back();
+  entity.setBounds({0.0, 0.0, 10.0, 10.0});
+  entity.setAnchorPoint({0.0, 0.0});
+  entity.setPosition(position);
+  entity.setBackgroundColor(entity::Color::Red());
+  if (parent != nullptr) {
+    parent->addChild(&entity);
+  }
+  return entity;
+}
+
+static size_t Render(PresentationEntity& root) {
+  FrontEndPass pass;
+  root.render(pass, {});
+  return pass.primitivesCount();
+}
+
+static geom::Matrix Translation(double x, double y) {
+  return geom::Matrix::Translation({x, y, 0.0});
+}
+
+TEST(PresentationEntityTest, FragmentsAreAddedWithoutCopyingPrimitives) {
+  auto fragment = std::make_shared<FrontEndPass::Fragment>();
+  fragment->primitives.push_back(std::make_shared<ColoredBoxPrimitive>());
+  fragment->children.push_back(std::make_shared<FrontEndPass::Fragment>());
+  fragment->children.back()->primitives.push_back(
+      std::make_shared<ColoredBoxPrimitive>());
+
+  FrontEndPass pass;
+  ASSERT_FALSE(pass.hasRenderables());
+
+  pass.addFragment(std::make_shared<FrontEndPass::Fragment>());
+  ASSERT_FALSE(pass.hasRenderables());
+
+  pass.addPrimitive(std::make_shared<ColoredBoxPrimitive>());
+  pass.addFragment(fragment);
+  pass.addPrimitive(std::make_shared<ColoredBoxPrimitive>());
+  pass.addPrimitive(std::make_shared<ColoredBoxPrimitive>());
+
+  ASSERT_TRUE(pass.hasRenderables());
+  ASSERT_EQ(pass.primitivesCount(), 5u);
+}
+
+TEST(PresentationEntityTest, UnchangedSubtreesKeepTheirPrimitives) {
+  core::Namespace ns;
+  Entities entities;
+
+  auto& root = AddBox(entities, ns, nullptr, {0.0, 0.0});
+  auto& left = AddBox(entities, ns, &root, {10.0, 0.0});
+  auto& leftLeaf = AddBox(entities, ns, &left, {1.0, 2.0});
+  auto& right = AddBox(entities, ns, &root, {20.0, 0.0});
+  auto& rightLeaf = AddBox(entities, ns, &right, {3.0, 4.0});
+
+  ASSERT_EQ(Render(root), 5u);
+  ASSERT_EQ(leftLeaf.lastModelViewMatrix(), Translation(11.0, 2.0));
+  ASSERT_EQ(rightLeaf.lastModelViewMatrix(), Translation(23.0, 4.0));
+
+  /*
+   *  Moving a leaf only updates that leaf.
+   */
+  leftLeaf.setPosition({5.0, 5.0});
+  ASSERT_EQ(Render(root), 5u);
+  ASSERT_EQ(leftLeaf.lastModelViewMatrix(), Translation(15.0, 5.0));
+  ASSERT_EQ(rightLeaf.lastModelViewMatrix(), Translation(23.0, 4.0));
+
+  /*
+   *  Moving an interior entity moves all its descendants.
+   */
+  right.setPosition({30.0, 10.0});
+  ASSERT_EQ(Render(root), 5u);
+  ASSERT_EQ(right.lastModelViewMatrix(), Translation(30.0, 10.0));
+  ASSERT_EQ(rightLeaf.lastModelViewMatrix(), Translation(33.0, 14.0));
+  ASSERT_EQ(leftLeaf.lastModelViewMatrix(), Translation(15.0, 5.0));
+
+  /*
+   *  Changing the view matrix moves the entire tree.
+   */
+  FrontEndPass pass;
+  root.render(pass, Translation(100.0, 0.0));
+  ASSERT_EQ(pass.primitivesCount(), 5u);
+  ASSERT_EQ(leftLeaf.lastModelViewMatrix(), Translation(115.0, 5.0));
+  ASSERT_EQ(rightLeaf.lastModelViewMatrix(), Translation(133.0, 14.0));
+}
+
+TEST(PresentationEntityTest, ContentUpdatesAreRenderedIncrementally) {
+  core::Namespace ns;
+  Entities entities;
+
+  auto& root = AddBox(entities, ns, nullptr, {0.0, 0.0});
+  auto& parent = AddBox(entities, ns, &root, {10.0, 0.0});
+  auto& leaf = AddBox(entities, ns, &parent, {1.0, 2.0});
+
+  ASSERT_EQ(Render(root), 3u);
+
+  /*
+   *  Transparent entities have no primitives. Strokes add one.
+   */
+  leaf.setOpacity(0.0);
+  ASSERT_EQ(Render(root), 2u);
+
+  leaf.setOpacity(1.0);
+  leaf.setStrokeSize(2.0);
+  leaf.setStrokeColor(entity::Color::Blue());
+  ASSERT_EQ(Render(root), 4u);
+
+  parent.setBounds({0.0, 0.0, 0.0, 0.0});
+  ASSERT_EQ(Render(root), 3u);
+}
+
+TEST(PresentationEntityTest, HierarchyUpdatesAreRenderedIncrementally) {
+  core::Namespace ns;
+  Entities entities;
+
+  auto& root = AddBox(entities, ns, nullptr, {0.0, 0.0});
+  auto& first = AddBox(entities, ns, &root, {10.0, 0.0});
+  auto& second = AddBox(entities, ns, &root, {20.0, 0.0});
+  auto& leaf = AddBox(entities, ns, &first, {1.0, 2.0});
+
+  ASSERT_EQ(Render(root), 4u);
+  ASSERT_EQ(leaf.lastModelViewMatrix(), Translation(11.0, 2.0));
+
+  /*
+   *  Move the leaf to another parent. Updates to the leaf made while it was
+   *  detached must still be picked up.
+   */
+  first.removeChild(&leaf);
+  ASSERT_EQ(Render(root), 3u);
+
+  leaf.setBackgroundColor(entity::Color::Blue());
+  second.addChild(&leaf);
+  ASSERT_EQ(Render(root), 4u);
+  ASSERT_EQ(leaf.lastModelViewMatrix(), Translation(21.0, 2.0));
+
+  /*
+   *  Adding to the new parent before removing from the old one (as happens
+   *  when both are part of the same transaction) is also supported.
+   */
+  first.addChild(&leaf);
+  second.removeChild(&leaf);
+  ASSERT_EQ(Render(root), 4u);
+  ASSERT_EQ(leaf.lastModelViewMatrix(), Translation(11.0, 2.0));
+
+  leaf.setPosition({0.0, 0.0});
+  ASSERT_EQ(Render(root), 4u);
+  ASSERT_EQ(leaf.lastModelViewMatrix(), Translation(10.0, 0.0));
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
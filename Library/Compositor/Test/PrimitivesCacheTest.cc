@@ -0,0 +1,70 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/PresentationEntity.h>
+#include <TestRunner/TestRunner.h>
+#include <cstring>
+#include <string>
+#include "PrimitivesCache.h"
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+/**
+ *  Create a square grey image encoded as a binary PGM.
+ */
+static image::Image SquareImage(size_t size) {
+  const auto header = "P5\n" + std::to_string(size) + " " +
+                      std::to_string(size) + "\n255\n";
+
+  core::Allocation allocation;
+  RL_ASSERT(allocation.resize(header.size() + size * size));
+  memmove(allocation.data(), header.data(), header.size());
+
+  return image::Image{std::move(allocation)};
+}
+
+TEST(PrimitivesCacheTest, TexturesAreRecreatedOnlyWhenReducedTooMuch) {
+  using ContentType = PrimitivesCache::ContentType;
+  using PrimitiveType = PrimitivesCache::PrimitiveType;
+
+  core::Namespace ns;
+  PresentationEntity entity(core::Name{ns});
+  entity.setContents(SquareImage(64));
+
+  PrimitivesCache cache;
+  const auto acquire = [&](double size) {
+    entity.setBounds({0.0, 0.0, size, size});
+    return cache.acquire(entity, ContentType::Image, PrimitiveType::Box);
+  };
+
+  /*
+   *  Reduced by a factor of four.
+   */
+  auto primitive = acquire(16.0);
+  ASSERT_NE(primitive, nullptr);
+  ASSERT_EQ(acquire(16.0), primitive);
+
+  /*
+   *  Shrinking keeps the larger texture.
+   */
+  ASSERT_EQ(acquire(8.0), primitive);
+
+  /*
+   *  Now only reduced by a factor of three.
+   */
+  auto larger = acquire(20.0);
+  ASSERT_NE(larger, primitive);
+
+  /*
+   *  Still reduced by a factor of three.
+   */
+  ASSERT_EQ(acquire(21.0), larger);
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
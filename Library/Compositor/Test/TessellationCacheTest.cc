@@ -0,0 +1,168 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Compositor/PresentationEntity.h>
+#include <Geometry/PathBuilder.h>
+#include <TestRunner/TestRunner.h>
+#include "TessellationCache.h"
+#include "Vertices/FillVertices.h"
+#include "Vertices/StrokeVertices.h"
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+class FakeTessellation : public TessellationCache::Tessellation {
+ public:
+  FakeTessellation(size_t byteSize) : _byteSize(byteSize) {}
+
+  size_t byteSize() const override { return _byteSize; }
+
+ private:
+  size_t _byteSize;
+};
+
+static geom::Path RoundedRectPath(double size) {
+  geom::PathBuilder builder;
+  builder.addRoundedRect({{0.0, 0.0}, {size, size}}, {10.0, 10.0, 10.0, 10.0});
+  return builder.path();
+}
+
+static geom::Path EllipsePath(double size) {
+  geom::PathBuilder builder;
+  builder.addEllipse({size / 2.0, size / 2.0}, {size / 2.0, size / 2.0});
+  return builder.path();
+}
+
+TEST(TessellationCacheTest, IdenticalPathsShareTessellations) {
+  auto& cache = TessellationCache::Shared();
+  cache.purge();
+  const auto before = cache.statistics();
+
+  FillVertices first(RoundedRectPath(100.0), FillVertices::Winding::Odd);
+  FillVertices second(RoundedRectPath(100.0), FillVertices::Winding::Odd);
+
+  auto after = cache.statistics();
+  ASSERT_EQ(after.misses - before.misses, 1u);
+  ASSERT_EQ(after.hits - before.hits, 1u);
+  ASSERT_EQ(after.entries, 1u);
+  ASSERT_GT(after.bytes, 0u);
+  ASSERT_EQ(first.size(), second.size());
+  ASSERT_EQ(first.size(), geom::Size(100.0, 100.0));
+
+  /*
+   *  Strokes, other winding rules and other paths are tessellated separately.
+   */
+  StrokeVertices stroke(RoundedRectPath(100.0));
+  FillVertices nonZero(RoundedRectPath(100.0), FillVertices::Winding::NonZero);
+  FillVertices other(RoundedRectPath(200.0), FillVertices::Winding::Odd);
+
+  after = cache.statistics();
+  ASSERT_EQ(after.misses - before.misses, 4u);
+  ASSERT_EQ(after.hits - before.hits, 1u);
+  ASSERT_EQ(after.entries, 4u);
+  ASSERT_EQ(other.size(), geom::Size(200.0, 200.0));
+}
+
+TEST(TessellationCacheTest, EvictsLeastRecentlyUsedWhenOverBudget) {
+  TessellationCache cache(300);
+
+  size_t tessellations = 0;
+  auto tessellator = [&]() {
+    tessellations++;
+    return std::make_shared<FakeTessellation>(100);
+  };
+
+  auto acquire = [&](double size) {
+    return cache.acquire(TessellationCache::Type::Fill, 0,
+                         RoundedRectPath(size), tessellator);
+  };
+
+  auto first = acquire(10.0);
+  acquire(20.0);
+  acquire(30.0);
+  ASSERT_EQ(tessellations, 3u);
+  ASSERT_EQ(cache.statistics().bytes, 300u);
+
+  /*
+   *  Touch the first path so that the second is now the least recently used.
+   */
+  ASSERT_EQ(acquire(10.0), first);
+  acquire(40.0);
+
+  auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.entries, 3u);
+  ASSERT_EQ(statistics.bytes, 300u);
+  ASSERT_EQ(statistics.evictions, 1u);
+
+  ASSERT_EQ(acquire(10.0), first);
+  ASSERT_EQ(tessellations, 4u);
+  acquire(20.0);
+  ASSERT_EQ(tessellations, 5u);
+
+  cache.setByteBudget(100);
+  statistics = cache.statistics();
+  ASSERT_EQ(statistics.entries, 1u);
+  ASSERT_EQ(statistics.bytes, 100u);
+  ASSERT_EQ(statistics.evictions, 4u);
+
+  cache.purge();
+  statistics = cache.statistics();
+  ASSERT_EQ(statistics.entries, 0u);
+  ASSERT_EQ(statistics.bytes, 0u);
+  ASSERT_EQ(statistics.hits, 2u);
+  ASSERT_EQ(statistics.misses, 5u);
+}
+
+TEST(TessellationCacheTest, PathMutationRecreatesPrimitives) {
+  auto& cache = TessellationCache::Shared();
+  cache.purge();
+  const auto before = cache.statistics();
+
+  core::Namespace ns;
+  PresentationEntity entity(core::Name{ns});
+  entity.setBackgroundColor(entity::Color::Red());
+  entity.setPath(RoundedRectPath(100.0));
+
+  PresentationEntity sibling(core::Name{ns});
+  sibling.setBackgroundColor(entity::Color::Red());
+  sibling.setPath(RoundedRectPath(100.0));
+
+  auto render = [](PresentationEntity& entity) {
+    FrontEndPass pass;
+    entity.render(pass, {});
+    ASSERT_EQ(pass.primitivesCount(), 1u);
+  };
+
+  render(entity);
+  render(sibling);
+  render(entity);
+
+  auto after = cache.statistics();
+  ASSERT_EQ(after.misses - before.misses, 1u);
+  ASSERT_EQ(after.hits - before.hits, 1u);
+
+  entity.setPath(EllipsePath(100.0));
+  render(entity);
+  render(entity);
+
+  after = cache.statistics();
+  ASSERT_EQ(after.misses - before.misses, 2u);
+  ASSERT_EQ(after.hits - before.hits, 1u);
+
+  /*
+   *  Changing back to a previously seen path hits the cache.
+   */
+  entity.setPath(RoundedRectPath(100.0));
+  render(entity);
+
+  after = cache.statistics();
+  ASSERT_EQ(after.misses - before.misses, 2u);
+  ASSERT_EQ(after.hits - before.hits, 2u);
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
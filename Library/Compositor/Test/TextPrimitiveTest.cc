@@ -0,0 +1,126 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <TestRunner/TestRunner.h>
+#include <Typography/AttributedStringBuilder.h>
+#include <memory>
+#include <vector>
+#include "DrawList.h"
+#include "GlyphAtlasTexture.h"
+#include "Primitive/TextPrimitive.h"
+
+namespace rl {
+namespace compositor {
+namespace testing {
+
+static std::unique_ptr<TextPrimitive> Text(const type::FontLibrary& library,
+                                           const std::string& text,
+                                           const geom::Point& origin) {
+  type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0}).appendText(text);
+  auto string = builder.attributedString();
+  type::TextRuns runs{string};
+
+  auto primitive = std::make_unique<TextPrimitive>(
+      type::GlyphRun{string.string(), runs.runs()[0], library});
+  primitive->setModelViewMatrix(
+      geom::Matrix::Translation({origin.x, origin.y, 0.0}));
+  return primitive;
+}
+
+TEST(TextPrimitiveTest, RunsAreDrawnInOneBatch) {
+  type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(core::URI{"Roboto-Regular.ttf"}, 0));
+
+  GlyphAtlasTexture atlas({256.0, 256.0});
+  atlas.beginFrame();
+
+  std::vector<std::unique_ptr<TextPrimitive>> texts;
+  DrawList list;
+
+  for (size_t i = 0; i < 10; i++) {
+    texts.emplace_back(Text(library, "Hello World", {0.0, i * 20.0}));
+    ASSERT_TRUE(texts.back()->prepareGlyphs(atlas));
+    list.addPrimitive(*texts.back());
+  }
+
+  list.finalize();
+
+  /*
+   *  Each glyph but the space is a quad.
+   */
+  ASSERT_EQ(list.drawCallCount(), 1u);
+  ASSERT_EQ(list.commands()[0].primitivesCount, 10u);
+  ASSERT_EQ(list.vertices().size(), 10u * 10u * 6u);
+
+  /*
+   *  Each run is drawn at its own origin from the same glyphs in the atlas.
+   */
+  const auto& vertices = list.vertices();
+  for (size_t i = 0; i < 60; i++) {
+    const auto& first = vertices[i];
+    const auto& last = vertices[vertices.size() - 60 + i];
+    ASSERT_EQ(first.position[0], last.position[0]);
+    ASSERT_EQ(first.position[1] + 180.0f, last.position[1]);
+    ASSERT_EQ(first.attributes[0], last.attributes[0]);
+    ASSERT_EQ(first.attributes[1], last.attributes[1]);
+    ASSERT_GE(first.attributes[0], 0.0f);
+    ASSERT_LE(first.attributes[0], 1.0f);
+    ASSERT_GE(first.attributes[1], 0.0f);
+    ASSERT_LE(first.attributes[1], 1.0f);
+  }
+
+  /*
+   *  Glyphs are only rasterized the first time they are seen at a subpixel
+   *  position.
+   */
+  auto statistics = atlas.atlas().statistics();
+  ASSERT_EQ(statistics.hits + statistics.misses, 10u * 11u);
+  ASSERT_EQ(statistics.entries, statistics.misses);
+  ASSERT_LT(statistics.misses, 11u);
+}
+
+TEST(TextPrimitiveTest, ColorAndOpacityArePackedIntoVertices) {
+  type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(core::URI{"Roboto-Regular.ttf"}, 0));
+
+  GlyphAtlasTexture atlas({256.0, 256.0});
+  auto text = Text(library, "A", {0.0, 0.0});
+  text->setColor({1.0, 0.5, 0.0, 1.0});
+  text->setOpacity(0.5);
+  ASSERT_TRUE(text->prepareGlyphs(atlas));
+
+  std::vector<BatchVertex> vertices;
+  text->appendBatchVertices(vertices);
+  ASSERT_EQ(vertices.size(), 6u);
+
+  for (const auto& vertex : vertices) {
+    ASSERT_EQ(vertex.attributes[2], 255.0f * 256.0f + 128.0f);
+    ASSERT_EQ(vertex.attributes[3], 0.0f * 256.0f + 128.0f);
+  }
+}
+
+TEST(TextPrimitiveTest, UnpreparedTextDrawsNothing) {
+  type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(core::URI{"Roboto-Regular.ttf"}, 0));
+
+  auto text = Text(library, "Hello", {0.0, 0.0});
+
+  std::vector<BatchVertex> vertices;
+  text->appendBatchVertices(vertices);
+  ASSERT_TRUE(vertices.empty());
+
+  /*
+   *  Text may only be batched with other text drawn from the same atlas.
+   */
+  GlyphAtlasTexture atlas({256.0, 256.0});
+  auto other = Text(library, "World", {0.0, 20.0});
+  ASSERT_TRUE(other->prepareGlyphs(atlas));
+  ASSERT_NE(text->batchKey(), other->batchKey());
+}
+
+}  // namespace testing
+}  // namespace compositor
+}  // namespace rl
@@ -0,0 +1,135 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Coordinator/InterfaceController.h>
+#include <Coordinator/TransactionPayload.h>
+#include <Core/EventLoop.h>
+
+static const size_t kBoxesPerInterface = 256;
+
+/**
+ *  Populate the interface of the controller with boxes whose positions are
+ *  animated indefinitely.
+ */
+static void AddAnimatedBoxes(rl::coordinator::InterfaceController& controller,
+                             size_t count) {
+  rl::core::Namespace ns;
+
+  using Property = rl::entity::Entity::Property;
+  using PropertyMask = rl::entity::Entity::PropertyMask;
+
+  rl::coordinator::TransactionPayload::EntityMap entities;
+
+  auto transfer = [&](const rl::entity::Entity& entity) {
+    auto& transferEntity = entities[entity.identifier()];
+    if (!transferEntity) {
+      using TransferEntity = rl::coordinator::TransferEntity;
+      transferEntity = std::make_unique<TransferEntity>(entity.identifier());
+    }
+    return transferEntity.get();
+  };
+
+  rl::entity::Entity root(rl::core::Name{ns});
+  root.setBounds({0.0, 0.0, 800.0, 600.0});
+  transfer(root)->record(root, Property::Bounds, rl::core::Name{});
+  transfer(root)->record(root, Property::MakeRoot, root.identifier());
+
+  for (size_t i = 0; i < count; i++) {
+    rl::entity::Entity box(rl::core::Name{ns});
+    box.setBounds({0.0, 0.0, 10.0, 10.0});
+    box.setPosition({(i * 10.0), (i * 5.0)});
+    box.setBackgroundColor(rl::entity::Color::Red());
+    transfer(box)->record(box, Property::Bounds, rl::core::Name{});
+    transfer(box)->record(box, Property::Position, rl::core::Name{});
+    transfer(box)->record(box, Property::BackgroundColor, rl::core::Name{});
+    transfer(box)->record(box, Property::AddedTo, root.identifier());
+  }
+
+  rl::animation::Action action(1.0);
+  action.setRepeatCount(rl::animation::Action::RepeatCountInfinity);
+  action.setAutoReverses(true);
+  action.setPropertyMask(PropertyMask::PositionMask);
+
+  rl::coordinator::TransactionPayload payload(std::move(action),
+                                              std::move(entities), {}, {});
+
+  rl::core::Message message;
+  auto encoded = message.encode(payload);
+  RL_ASSERT(encoded);
+
+  rl::core::Messages messages;
+  messages.emplace_back(std::move(message));
+
+  auto channel = controller.channel();
+  auto sent = channel->sendMessages(std::move(messages));
+  RL_ASSERT(sent == rl::core::IOResult::Success);
+  auto read = channel->readPendingMessageNow();
+  RL_ASSERT(read == rl::core::IOResult::Success);
+}
+
+/*
+ *  Measures the time taken to update and render the interfaces for a single
+ *  frame.
+ */
+static void UpdateAndRenderInterfaces(benchmark::State& state,
+                                      bool concurrent) {
+  const size_t interfaceCount = state.range(0);
+
+  auto loop = rl::core::EventLoop::Current();
+
+  std::list<rl::coordinator::InterfaceController> controllers;
+  for (size_t i = 0; i < interfaceCount; i++) {
+    controllers.emplace_back("bench", rl::geom::Size{800.0, 600.0}, nullptr);
+    auto& controller = controllers.back();
+    controller.scheduleChannel(*loop, true);
+    AddAnimatedBoxes(controller, kBoxesPerInterface);
+  }
+
+  /*
+   *  There is no back-end pass to bind primitives to a render thread. So
+   *  create them on this thread.
+   */
+  rl::coordinator::RenderInterfaceControllers(controllers, nullptr);
+
+  rl::core::WorkQueue workQueue;
+  auto queue = concurrent ? &workQueue : nullptr;
+
+  while (state.KeepRunning()) {
+    rl::compositor::FramePhaseTimings timings;
+    auto updated = rl::coordinator::UpdateInterfaceControllers(
+        controllers, {}, rl::core::Clock::now(), timings, queue);
+    RL_ASSERT(updated);
+    auto passes =
+        rl::coordinator::RenderInterfaceControllers(controllers, queue);
+    benchmark::DoNotOptimize(passes);
+  }
+
+  for (auto& controller : controllers) {
+    controller.scheduleChannel(*loop, false);
+  }
+
+  state.SetItemsProcessed(state.iterations() * interfaceCount);
+}
+
+static void BM_InterfacesSerial(benchmark::State& state) {
+  UpdateAndRenderInterfaces(state, false);
+}
+
+static void BM_InterfacesConcurrent(benchmark::State& state) {
+  UpdateAndRenderInterfaces(state, true);
+}
+
+BENCHMARK(BM_InterfacesSerial)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+BENCHMARK(BM_InterfacesConcurrent)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
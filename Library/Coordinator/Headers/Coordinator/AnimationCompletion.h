@@ -0,0 +1,29 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Namespace.h>
+#include <Core/Utilities.h>
+#include <Entity/Entity.h>
+
+namespace rl {
+namespace coordinator {
+
+/**
+ *  Reported to the interface when an animation of one of its entity properties
+ *  finishes. The entity is identified by its handle in the namespace of the
+ *  interface.
+ */
+struct AnimationCompletion {
+  core::Name::Handle entityHandle;
+  entity::Entity::Property property;
+};
+
+static_assert(rl_trivially_copyable(AnimationCompletion),
+              "Animation completions are sent as plain data");
+
+}  // namespace coordinator
+}  // namespace rl
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <Compositor/BackendPass.h>
 #include <Compositor/Context.h>
 #include <Coordinator/CoordinatorAcquisitionProtocol.h>
+#include <Coordinator/FrameScheduler.h>
 #include <Coordinator/InterfaceController.h>
 #include <Coordinator/PresentationGraph.h>
 #include <Core/DebugTagGenerator.h>
@@ -19,6 +21,7 @@ namespace rl {
 namespace coordinator {
 
 class RenderSurface;
+class ScopedRenderSurfaceAccess;
 
 class Coordinator {
  public:
@@ -61,6 +64,15 @@ class Coordinator {
 
   void redrawCurrentFrameNow();
 
+  /**
+   *  The scheduler that paces the frames rendered by the coordinator. The
+   *  platform may deliver vsync signals to it or update the refresh interval
+   *  of the display.
+   *
+   *  @return the frame scheduler
+   */
+  FrameScheduler& frameScheduler();
+
  private:
   std::shared_ptr<RenderSurface> _surface;
   core::EventLoop* _loop;
@@ -71,21 +83,36 @@ class Coordinator {
   core::Mutex _interfaceControllersMutex;
   std::list<InterfaceController> _interfaceControllers
       RL_GUARDED_BY(_interfaceControllersMutex);
-  std::shared_ptr<core::EventLoopSource> _animationsSource;
+  FrameScheduler _frameScheduler;
   event::TouchEventChannel& _touchEventChannel;
+  core::Mutex _pendingTouchesMutex;
+  event::TouchEvent::PhaseMap _pendingTouches
+      RL_GUARDED_BY(_pendingTouchesMutex);
   CoordinatorAcquisitionProtocol _coordinatorAcquisitionProtocol;
   bool _forceAnotherFrame;
 
-  CoordinatorAcquisitionProtocol::VendorResult acquireFreshCoordinatorChannel();
+  CoordinatorAcquisitionProtocol::VendorResult acquireFreshCoordinatorChannel(
+      std::shared_ptr<core::Channel> completionsChannel);
 
   void setupOrTeardownChannels(bool setup);
 
   void scheduleInterfaceChannels(bool schedule)
       RL_REQUIRES(_interfaceControllersMutex);
 
-  bool renderSingleFrame() RL_REQUIRES(_interfaceControllersMutex);
+  void onTouchEventMessage(core::Message message);
+
+  event::TouchEvent::PhaseMap takePendingTouches();
+
+  bool renderSingleFrame(compositor::FramePhaseTimings& timings)
+      RL_REQUIRES(_interfaceControllersMutex);
+
+  bool renderBackEndPass(compositor::BackEndPass& backEndPass,
+                         ScopedRenderSurfaceAccess& surfaceAccess)
+      RL_REQUIRES(_interfaceControllersMutex);
 
-  void updateAndRenderInterfaceControllers(bool force);
+  bool updateAndRenderInterfaceControllers(
+      const FrameScheduler::BeginFrameArgs& args,
+      bool force);
 
   RL_DISALLOW_COPY_AND_ASSIGN(Coordinator);
 };
@@ -20,12 +20,18 @@ class CoordinatorAcquisitionProtocol : public core::Protocol {
  public:
   using VendorResult = std::pair<std::shared_ptr<core::Channel> /* channel */,
                                  std::string /* tag */>;
-  using ChannelVendor = std::function<VendorResult(void)>;
+  using ChannelVendor = std::function<VendorResult(
+      std::shared_ptr<core::Channel> /* completions channel */)>;
 
   /**
    *  Create the client side of the coordinator acquisition protocol.
+   *
+   *  @param completionsChannel the channel on which the client reads the
+   *                            completions of its animations. It is sent to
+   *                            the vendor along with the request.
    */
-  CoordinatorAcquisitionProtocol();
+  CoordinatorAcquisitionProtocol(
+      std::shared_ptr<core::Channel> completionsChannel);
 
   /**
    *  Create the vendor side of the coordinator acquisition protocol. The
@@ -33,12 +39,14 @@ class CoordinatorAcquisitionProtocol : public core::Protocol {
    *
    *  @param vendor the channel acquisition callback for this vendor. A channel
    *                will be requested when the bootstrap server notices a
-   *                pending advertisement resolution for this protocol.
+   *                pending advertisement resolution for this protocol. The
+   *                completions channel sent by the client is passed along.
    */
   CoordinatorAcquisitionProtocol(ChannelVendor vendor);
 
  private:
   ChannelVendor _vendor;
+  std::shared_ptr<core::Channel> _completionsChannel;
 
   std::string advertisementName() const override;
 
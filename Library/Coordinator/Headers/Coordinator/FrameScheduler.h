@@ -0,0 +1,176 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/EventLoop.h>
+#include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Core/Timing.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace rl {
+namespace coordinator {
+
+/**
+ *  Paces frames to the vertical sync of the display. Vsync signals are only
+ *  requested while frames are needed. Once a frame finishes without requesting
+ *  another and no frame has been requested in the meantime, the scheduler goes
+ *  idle and the loop it is scheduled on is not woken up till there is more work
+ *  to do.
+ *
+ *  The vsync signal may be delivered by the platform (usually from a display
+ *  link on its own thread). When the platform provides no such signal, a timer
+ *  firing at the refresh interval of the display stands in for it.
+ */
+class FrameScheduler {
+ public:
+  /**
+   *  The arguments delivered to the callback that begins each frame.
+   */
+  struct BeginFrameArgs {
+    /**
+     *  The time of the vsync that began the frame.
+     */
+    core::ClockPoint frameTime;
+    /**
+     *  The time by which the frame must be presented to make the next vsync.
+     *  Animations are sampled at this time since that is when the frame will
+     *  be visible.
+     */
+    core::ClockPoint deadline;
+    /**
+     *  The refresh interval of the display.
+     */
+    core::ClockDuration interval;
+
+    BeginFrameArgs(core::ClockPoint aFrameTime, core::ClockDuration aInterval)
+        : frameTime(aFrameTime),
+          deadline(aFrameTime + aInterval),
+          interval(aInterval) {}
+  };
+
+  /**
+   *  Begins a frame.
+   *
+   *  @return if another frame is needed right after this one. Usually because
+   *          animations are still in flight or the frame could not be rendered.
+   */
+  using BeginFrameCallback = std::function<bool(const BeginFrameArgs&)>;
+
+  /**
+   *  Notifies the platform that vsync signals are (or are no longer) needed.
+   */
+  using VsyncRequestCallback = std::function<void(bool)>;
+
+  /**
+   *  Create a frame scheduler for a display with the given refresh interval.
+   *
+   *  @param refreshInterval the refresh interval of the display
+   */
+  FrameScheduler(core::ClockDuration refreshInterval);
+
+  ~FrameScheduler();
+
+  /**
+   *  @return the refresh interval of the display
+   */
+  core::ClockDuration refreshInterval() const;
+
+  /**
+   *  Update the refresh interval of the display. Takes effect when the
+   *  scheduler next wakes up from being idle.
+   *
+   *  @param refreshInterval the new refresh interval
+   */
+  void setRefreshInterval(core::ClockDuration refreshInterval);
+
+  /**
+   *  Set the callback invoked on the loop the scheduler is scheduled on to
+   *  begin each frame.
+   *
+   *  @param callback the begin frame callback
+   */
+  void setBeginFrameCallback(BeginFrameCallback callback);
+
+  /**
+   *  Use vsync signals delivered by the platform via `vsync` instead of the
+   *  timer. Must be set before the scheduler is scheduled.
+   *
+   *  @param callback the callback invoked (on the loop the scheduler is
+   *                  scheduled on) when the scheduler starts and stops needing
+   *                  vsync signals
+   */
+  void setExternalVsync(VsyncRequestCallback callback);
+
+  /**
+   *  @return if vsync signals are delivered by the platform
+   */
+  bool hasExternalVsync() const;
+
+  /**
+   *  Schedule or unschedule the scheduler on the given loop. Frames begin on
+   *  this loop.
+   *
+   *  @param loop     the loop
+   *  @param schedule if the scheduler is being scheduled or unscheduled
+   */
+  void schedule(core::EventLoop& loop, bool schedule);
+
+  /**
+   *  Request a frame. If the scheduler is idle, the frame begins as soon as
+   *  the loop wakes up. Otherwise, it begins on the next vsync. May be called on
+   *  any thread.
+   */
+  void setNeedsFrame();
+
+  /**
+   *  Deliver a vsync signal from the platform. May be called on any thread.
+   *
+   *  @param frameTime the time of the vsync
+   */
+  void vsync(core::ClockPoint frameTime);
+
+  /**
+   *  @return if the scheduler is not requesting vsync signals
+   */
+  bool isIdle() const;
+
+  /**
+   *  @return the number of frames begun by the scheduler
+   */
+  size_t frameCount() const;
+
+ private:
+  std::atomic<double> _refreshInterval;
+  BeginFrameCallback _beginFrameCallback;
+  VsyncRequestCallback _vsyncRequestCallback;
+  core::EventLoop* _loop;
+  std::shared_ptr<core::EventLoopSource> _wakeSource;
+  std::shared_ptr<core::EventLoopSource> _vsyncTimer;
+  std::atomic_bool _needsFrame;
+  std::atomic_bool _idle;
+  std::atomic_size_t _frameCount;
+  core::Mutex _pendingVsyncMutex;
+  bool _hasPendingVsync RL_GUARDED_BY(_pendingVsyncMutex);
+  core::ClockPoint _pendingVsync RL_GUARDED_BY(_pendingVsyncMutex);
+
+  void wake();
+
+  void onWake();
+
+  void onVsyncTimer();
+
+  void beginFrame(core::ClockPoint frameTime);
+
+  void requestVsync(bool request);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(FrameScheduler);
+};
+
+}  // namespace coordinator
+}  // namespace rl
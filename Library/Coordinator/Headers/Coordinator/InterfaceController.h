@@ -5,19 +5,42 @@
 
 #pragma once
 
+#include <Compositor/CompositorStatistics.h>
 #include <Compositor/FrontendPass.h>
 #include <Compositor/InterfaceStatistics.h>
 #include <Coordinator/PresentationGraph.h>
 #include <Core/Channel.h>
 #include <Core/Macros.h>
+#include <Core/WorkQueue.h>
 #include <Event/TouchEvent.h>
+#include <list>
 
 namespace rl {
 namespace coordinator {
 
 class InterfaceController {
  public:
-  InterfaceController(const std::string& debugTag, const geom::Size& size);
+  using NeedsFrameCallback = std::function<void(void)>;
+
+  /**
+   *  Create an interface controller
+   *
+   *  @param debugTag           the debug tag of the interface
+   *  @param size               the size of the interface
+   *  @param needsFrameCallback invoked (on any thread) when the presentation
+   *                            graph of the interface has updates that need a
+   *                            frame
+   *  @param completionsChannel the channel vended by the interface on which
+   *                            the completions of its animations are sent.
+   *                            Each message contains the
+   *                            `AnimationCompletion`s of one update encoded
+   *                            as a vector. May be `nullptr`.
+   */
+  InterfaceController(const std::string& debugTag,
+                      const geom::Size& size,
+                      NeedsFrameCallback needsFrameCallback,
+                      std::shared_ptr<core::Channel> completionsChannel =
+                          nullptr);
 
   void scheduleChannel(core::EventLoop& loop, bool schedule);
 
@@ -25,7 +48,20 @@ class InterfaceController {
 
   void setSize(const geom::Size& size);
 
-  bool update(const event::TouchEvent::PhaseMap& touchesIfAny);
+  /**
+   *  Update the presentation graph of the interface for the upcoming frame.
+   *
+   *  @param touchesIfAny  the touches delivered since the last frame
+   *  @param frameDeadline the time by which the frame will be presented.
+   *                       Interpolations are stepped to this time.
+   *  @param timings       the phase timings of the frame that are updated with
+   *                       the time spent updating this interface
+   *
+   *  @return if the interface has updates that need to be rendered
+   */
+  bool update(const event::TouchEvent::PhaseMap& touchesIfAny,
+              const core::ClockPoint& frameDeadline,
+              compositor::FramePhaseTimings& timings);
 
   RL_WARN_UNUSED_RESULT
   compositor::FrontEndPass render();
@@ -38,7 +74,10 @@ class InterfaceController {
   std::string _debugTag;
   core::Namespace _localNS;
   std::shared_ptr<core::Channel> _channel;
+  NeedsFrameCallback _needsFrameCallback;
+  std::shared_ptr<core::Channel> _completionsChannel;
   mutable core::Mutex _graphMutex;
+  std::vector<AnimationCompletion> _completions RL_GUARDED_BY(_graphMutex);
   PresentationGraph _graph RL_GUARDED_BY(_graphMutex);
 
   void onChannelMessage(core::Message message);
@@ -48,12 +87,59 @@ class InterfaceController {
   bool applyPendingTouchEvents(const event::TouchEvent::PhaseMap& touches)
       RL_REQUIRES(_graphMutex);
 
-  bool applyAnimations() RL_REQUIRES(_graphMutex);
+  bool applyAnimations(const core::ClockPoint& time) RL_REQUIRES(_graphMutex);
+
+  /*
+   *  Invoked by the graph while animations are stepped. The graph mutex is
+   *  held but the analysis cannot see that through the callback.
+   */
+  void onAnimationCompletion(const AnimationCompletion& completion)
+      RL_NO_THREAD_SAFETY_ANALYSIS;
+
+  void sendCompletions() RL_REQUIRES(_graphMutex);
 
   bool enforceConstraints() RL_REQUIRES(_graphMutex);
 
   RL_DISALLOW_COPY_AND_ASSIGN(InterfaceController);
 };
 
+/**
+ *  Update the given interface controllers for the upcoming frame. Each
+ *  controller owns its presentation graph. So, if a work queue is provided, the
+ *  controllers are updated concurrently on it.
+ *
+ *  @param controllers   the interface controllers to update
+ *  @param touchesIfAny  the touches delivered since the last frame
+ *  @param frameDeadline the time by which the frame will be presented
+ *  @param timings       the phase timings of the frame. Updated with the
+ *                       timings of the slowest controller in each phase.
+ *  @param workQueue     the work queue to update the controllers on. May be
+ *                       `nullptr`.
+ *
+ *  @return if any of the controllers has updates that need to be rendered
+ */
+bool UpdateInterfaceControllers(
+    std::list<InterfaceController>& controllers,
+    const event::TouchEvent::PhaseMap& touchesIfAny,
+    const core::ClockPoint& frameDeadline,
+    compositor::FramePhaseTimings& timings,
+    core::WorkQueue* workQueue);
+
+/**
+ *  Render the given interface controllers into front-end passes. If a work
+ *  queue is provided, the controllers are rendered concurrently on it.
+ *
+ *  @param controllers the interface controllers to render
+ *  @param workQueue   the work queue to render the controllers on. May be
+ *                     `nullptr`.
+ *
+ *  @return the front-end passes of the controllers. The passes are in the same
+ *          order as the controllers regardless of the order in which they were
+ *          rendered.
+ */
+std::vector<compositor::FrontEndPass> RenderInterfaceControllers(
+    std::list<InterfaceController>& controllers,
+    core::WorkQueue* workQueue);
+
 }  // namespace coordinator
 }  // namespace rl
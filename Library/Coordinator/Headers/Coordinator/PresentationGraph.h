@@ -7,10 +7,10 @@
 
 #include <Animation/Action.h>
 #include <Animation/Director.h>
-#include <Animation/Interpolator.h>
 #include <Compositor/FrontendPass.h>
 #include <Compositor/InterfaceStatistics.h>
 #include <Compositor/PresentationEntity.h>
+#include <Coordinator/AnimationCompletion.h>
 #include <Coordinator/TransactionPayload.h>
 #include <Coordinator/TransferEntity.h>
 #include <Core/Macros.h>
@@ -24,9 +24,23 @@ namespace coordinator {
 
 class PresentationGraph {
  public:
+  using CompletionCallback =
+      std::function<void(const AnimationCompletion& /* completion */)>;
+
+  /**
+   *  Create a presentation graph.
+   *
+   *  @param localNS            the namespace transactions are decoded into
+   *  @param size               the size of the interface
+   *  @param debugTag           the debug tag of the interface
+   *  @param completionCallback invoked while stepping interpolations with each
+   *                            animation of an entity sent by the interface
+   *                            that finished
+   */
   PresentationGraph(core::Namespace& localNS,
                     const geom::Size& size,
-                    const std::string& debugTag);
+                    const std::string& debugTag,
+                    CompletionCallback completionCallback);
 
   ~PresentationGraph();
 
@@ -46,7 +60,7 @@ class PresentationGraph {
    */
   size_t applyConstraints();
 
-  bool stepInterpolations();
+  bool stepInterpolations(const core::ClockPoint& time);
 
   bool resolveVisualUpdates();
 
@@ -59,10 +73,12 @@ class PresentationGraph {
       std::map<core::Name, std::unique_ptr<compositor::PresentationEntity>>;
 
   core::Namespace& _localNS;
+  CompletionCallback _completionCallback;
   compositor::InterfaceStatistics _stats;
   IdentifierPresentationEntityMap _entities;
   geom::Size _size;
   compositor::PresentationEntity* _root;
+  compositor::PresentationEntity* _renderedRoot;
   animation::Director _animationDirector;
   layout::Solver _layoutSolver;
   bool _hasVisualUpdates;
@@ -94,13 +110,19 @@ class PresentationGraph {
 
   void onSuggestionsCommit(std::vector<layout::Suggestion>&& suggestions);
 
+  void onSimulationsCommit(
+      std::vector<animation::SimulationDescriptor>&& simulations,
+      const core::ClockPoint& commitTime);
+
+  void onAnimationCompletion(const animation::Director::Key& key);
+
   void onEditVariableUpdate(const expr::Variable& variable, bool addOrRemove);
 
-  void onEditVariableSuggest(const expr::Variable& variable, double value);
+  void onEditVariableSuggestions(
+      const std::vector<layout::Suggestion>& suggestions);
 
   layout::Solver::FlushResult resolveConstraintUpdate(
-      const expr::Variable& variable,
-      double value);
+      const layout::Solver::VariableUpdates& updates);
 
   double resolveConstraintConstant(const expr::Variable& variable) const;
 
@@ -31,6 +31,15 @@ class RenderSurface {
    */
   virtual bool present() = 0;
 
+  /**
+   *  The number of frames since the buffer about to be rendered into was last
+   *  presented. If the contents of the buffer are known, only the areas
+   *  changed since then are redrawn.
+   *
+   *  @return the age of the buffer. Zero if its contents are undefined.
+   */
+  virtual size_t bufferAge();
+
   virtual void accessWillBegin() = 0;
 
   virtual void accessDidEnd() = 0;
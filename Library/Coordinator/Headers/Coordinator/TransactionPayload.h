@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Animation/Action.h>
+#include <Animation/SimulationDescriptor.h>
 #include <Coordinator/TransferEntity.h>
 #include <Core/Macros.h>
 #include <Layout/Constraint.h>
@@ -27,6 +28,9 @@ class TransactionPayload final : public core::ArchiveSerializable,
       std::function<void(std::vector<layout::Constraint>&&)>;
   using SuggestionsCallback =
       std::function<void(std::vector<layout::Suggestion>&&)>;
+  using SimulationsCallback =
+      std::function<void(std::vector<animation::SimulationDescriptor>&&,
+                         const core::ClockPoint&)>;
 
   TransactionPayload();
 
@@ -35,13 +39,16 @@ class TransactionPayload final : public core::ArchiveSerializable,
   TransactionPayload(animation::Action&& action,
                      EntityMap&& entities,
                      std::vector<layout::Constraint>&& constraints,
-                     std::vector<layout::Suggestion>&& suggestions);
+                     std::vector<layout::Suggestion>&& suggestions,
+                     std::vector<animation::SimulationDescriptor>&&
+                         simulations = {});
 
   TransactionPayload(const core::ClockPoint& commitTime,
                      ActionCallback actionCallback,
                      TransferRecordCallback transferRecordCallback,
                      ConstraintsCallback constraintsCallback,
-                     SuggestionsCallback suggestionsCallback);
+                     SuggestionsCallback suggestionsCallback,
+                     SimulationsCallback simulationsCallback);
 
   bool serialize(core::Message& message) const override;
 
@@ -63,6 +70,7 @@ class TransactionPayload final : public core::ArchiveSerializable,
   EntityMap _entities;
   std::vector<layout::Constraint> _constraints;
   std::vector<layout::Suggestion> _suggestions;
+  std::vector<animation::SimulationDescriptor> _simulations;
 
   /*
    *  Used when reading
@@ -72,6 +80,7 @@ class TransactionPayload final : public core::ArchiveSerializable,
   TransferRecordCallback _transferRecordCallback;
   ConstraintsCallback _constraintsCallback;
   SuggestionsCallback _suggestionsCallback;
+  SimulationsCallback _simulationsCallback;
 
   RL_DISALLOW_COPY_AND_ASSIGN(TransactionPayload);
 };
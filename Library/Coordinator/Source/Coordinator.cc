@@ -8,6 +8,7 @@
 #include <Coordinator/Coordinator.h>
 #include <Coordinator/RenderSurface.h>
 #include <Core/TraceEvent.h>
+#include <iterator>
 
 namespace rl {
 namespace coordinator {
@@ -17,17 +18,22 @@ Coordinator::Coordinator(std::shared_ptr<RenderSurface> surface,
     : _surface(surface),
       _loop(nullptr),
       _interfaceTagGenerator("rl.interface"),
-      _animationsSource(core::EventLoopSource::Timer(
-          std::chrono::duration_cast<core::ClockDurationNano>(
-              core::ClockDurationSeconds(1.0 / 60.0)))),
+      _frameScheduler(core::ClockDurationSeconds(1.0 / 60.0)),
       _touchEventChannel(touchEventChannel),
       _coordinatorAcquisitionProtocol(
-          std::bind(&Coordinator::acquireFreshCoordinatorChannel, this)),
+          std::bind(&Coordinator::acquireFreshCoordinatorChannel,
+                    this,
+                    std::placeholders::_1)),
       _forceAnotherFrame(true) {
   RL_ASSERT_MSG(_surface != nullptr,
                 "A surface must be provided to the coordinator");
-  _animationsSource->setWakeFunction(std::bind(
-      &Coordinator::updateAndRenderInterfaceControllers, this, false));
+  namespace P = std::placeholders;
+  _frameScheduler.setBeginFrameCallback(std::bind(
+      &Coordinator::updateAndRenderInterfaceControllers, this, P::_1, false));
+  /*
+   *  The first frame is rendered as soon as the coordinator starts running.
+   */
+  _frameScheduler.setNeedsFrame();
 }
 
 Coordinator::~Coordinator() = default;
@@ -95,27 +101,40 @@ void Coordinator::renderSurfaceWasTornDown() {
    */
 }
 
+FrameScheduler& Coordinator::frameScheduler() {
+  return _frameScheduler;
+}
+
 void Coordinator::setupOrTeardownChannels(bool setup) {
   core::MutexLocker lock(_interfaceControllersMutex);
   if (setup) {
     scheduleInterfaceChannels(true);
-    _loop->addSource(_animationsSource);
+    _frameScheduler.schedule(*_loop, true);
+    namespace P = std::placeholders;
+    _touchEventChannel.setMessageCallback(
+        std::bind(&Coordinator::onTouchEventMessage, this, P::_1));
+    _loop->addSource(_touchEventChannel.source());
     _loop->addSource(_coordinatorAcquisitionProtocol.source());
   } else {
     scheduleInterfaceChannels(false);
-    _loop->removeSource(_animationsSource);
+    _frameScheduler.schedule(*_loop, false);
+    _touchEventChannel.setMessageCallback(nullptr);
+    _loop->removeSource(_touchEventChannel.source());
     _loop->removeSource(_coordinatorAcquisitionProtocol.source());
   }
 }
 
 CoordinatorAcquisitionProtocol::VendorResult
-Coordinator::acquireFreshCoordinatorChannel() {
+Coordinator::acquireFreshCoordinatorChannel(
+    std::shared_ptr<core::Channel> completionsChannel) {
   core::MutexLocker lock(_interfaceControllersMutex);
   /*
    *  Create a new interface controller for this reques
    */
-  _interfaceControllers.emplace_back(_interfaceTagGenerator.acquire(),
-                                     _surfaceSize);
+  _interfaceControllers.emplace_back(
+      _interfaceTagGenerator.acquire(), _surfaceSize,
+      std::bind(&FrameScheduler::setNeedsFrame, &_frameScheduler),
+      completionsChannel);
 
   /*
    *  Schedule all channels
@@ -140,37 +159,84 @@ void Coordinator::scheduleInterfaceChannels(bool schedule) {
   }
 }
 
-void Coordinator::updateAndRenderInterfaceControllers(bool force) {
+void Coordinator::onTouchEventMessage(core::Message message) {
+  event::TouchEvent touch(message);
+
+  {
+    core::MutexLocker lock(_pendingTouchesMutex);
+    _pendingTouches[touch.phase()].emplace_back(std::move(touch));
+  }
+
+  _frameScheduler.setNeedsFrame();
+}
+
+event::TouchEvent::PhaseMap Coordinator::takePendingTouches() {
+  event::TouchEvent::PhaseMap touches;
+
+  {
+    core::MutexLocker lock(_pendingTouchesMutex);
+    std::swap(touches, _pendingTouches);
+  }
+
+  /*
+   *  Touches that arrived since the loop last serviced the touch event channel.
+   */
+  for (auto& drained : _touchEventChannel.drainPendingTouches()) {
+    auto& phaseTouches = touches[drained.first];
+    std::move(drained.second.begin(), drained.second.end(),
+              std::back_inserter(phaseTouches));
+  }
+
+  return touches;
+}
+
+bool Coordinator::updateAndRenderInterfaceControllers(
+    const FrameScheduler::BeginFrameArgs& args,
+    bool force) {
   RL_TRACE_INSTANT(__function__);
   RL_TRACE_AUTO(__function__);
 
-  auto touchesIfAny = _touchEventChannel.drainPendingTouches();
+  auto touchesIfAny = takePendingTouches();
 
   const bool consoleInterceptsTouches =
       _context.applyTouchesToConsole(touchesIfAny);
 
   bool wasUpdated = consoleInterceptsTouches;
 
+  compositor::FramePhaseTimings timings;
+
   core::MutexLocker lock(_interfaceControllersMutex);
 
-  for (auto& controller : _interfaceControllers) {
-    wasUpdated |= controller.update(touchesIfAny);
-  }
+  wasUpdated |= UpdateInterfaceControllers(_interfaceControllers, touchesIfAny,
+                                           args.deadline, timings, &_workQueue);
 
   if (wasUpdated || _forceAnotherFrame || force) {
     /*
      *  If the scene was updated but the frame could not be rendered (for
      *  whatever reason), force the next frame.
      */
-    _forceAnotherFrame = !renderSingleFrame();
+    _forceAnotherFrame = !renderSingleFrame(timings);
+
+    _context.statistics().recordFramePhases(
+        timings, core::Clock::now() > args.deadline);
   }
+
+  /*
+   *  Interfaces with updates in this frame (most notably, ones with running
+   *  interpolations) need another frame. Once there are no more updates, the
+   *  scheduler goes idle till another transaction or touch arrives.
+   */
+  return wasUpdated || _forceAnotherFrame;
 }
 
 void Coordinator::redrawCurrentFrameNow() {
-  updateAndRenderInterfaceControllers(true);
+  updateAndRenderInterfaceControllers(
+      FrameScheduler::BeginFrameArgs(core::Clock::now(),
+                                     _frameScheduler.refreshInterval()),
+      true);
 }
 
-bool Coordinator::renderSingleFrame() {
+bool Coordinator::renderSingleFrame(compositor::FramePhaseTimings& timings) {
   RL_TRACE_AUTO(__function__);
 
   if (_surfaceSize.width <= 0.0 || _surfaceSize.height <= 0.0) {
@@ -180,26 +246,49 @@ bool Coordinator::renderSingleFrame() {
     return true;
   }
 
+  const auto renderStart = core::Clock::now();
+
   /*
    *  A single backend pass is created for all registered interface controller.
    *  The result of rendering of each interface controller is a discrete
-   *  front-end pass.
+   *  front-end pass. Interface controllers are rendered concurrently but their
+   *  passes are always added in the same order.
    */
   compositor::BackEndPass backEndPass;
 
-  for (auto& interface : _interfaceControllers) {
-    backEndPass.addFrontEndPass(interface.render());
+  for (auto& pass :
+       RenderInterfaceControllers(_interfaceControllers, &_workQueue)) {
+    backEndPass.addFrontEndPass(std::move(pass));
   }
 
   if (!backEndPass.hasRenderables()) {
     /*
      *  Don't bother acquiring the surface is there are no renderables.
      */
+    timings.render += core::Clock::now() - renderStart;
     return true;
   }
 
-  ScopedRenderSurfaceAccess surfaceAccess(*_surface);
+  bool rendered = false;
+  core::ClockPoint presentStart;
 
+  {
+    ScopedRenderSurfaceAccess surfaceAccess(*_surface);
+    rendered = renderBackEndPass(backEndPass, surfaceAccess);
+    /*
+     *  The surface is presented as access to it ends.
+     */
+    presentStart = core::Clock::now();
+  }
+
+  timings.render += presentStart - renderStart;
+  timings.present += core::Clock::now() - presentStart;
+
+  return rendered;
+}
+
+bool Coordinator::renderBackEndPass(compositor::BackEndPass& backEndPass,
+                                    ScopedRenderSurfaceAccess& surfaceAccess) {
   if (!surfaceAccess.acquired()) {
     return false;
   }
@@ -210,6 +299,8 @@ bool Coordinator::renderSingleFrame() {
     return false;
   }
 
+  frame.setDamage(backEndPass.damage(), _surface->bufferAge());
+
   if (!frame.begin()) {
     return false;
   }
@@ -14,8 +14,11 @@ CoordinatorAcquisitionProtocol::CoordinatorAcquisitionProtocol(
   RL_ASSERT(_vendor);
 }
 
-CoordinatorAcquisitionProtocol::CoordinatorAcquisitionProtocol()
-    : core::Protocol(false) {}
+CoordinatorAcquisitionProtocol::CoordinatorAcquisitionProtocol(
+    std::shared_ptr<core::Channel> completionsChannel)
+    : core::Protocol(false), _completionsChannel(completionsChannel) {
+  RL_ASSERT(_completionsChannel != nullptr);
+}
 
 void CoordinatorAcquisitionProtocol::onRequest(
     core::Message requestMessage,
@@ -25,14 +28,21 @@ void CoordinatorAcquisitionProtocol::onRequest(
   std::string tag;
 
   /*
-   *  We don't send any extra information for service acquisition. So we
-   *  should not expect anything while servicing the request either.
+   *  The only extra information sent for service acquisition is the channel
+   *  on which the client reads its animation completions.
    */
-  if (requestMessage.readCompleted()) {
-    std::tie(channel, tag) = _vendor();
+  core::RawAttachment completionsAttachment;
+  if (requestMessage.decode(completionsAttachment) &&
+      requestMessage.readCompleted()) {
+    std::tie(channel, tag) = _vendor(
+        std::make_shared<core::Channel>(std::move(completionsAttachment)));
   }
 
-  auto result =
+  /*
+   *  The client may hang up before its request is serviced. There is no one
+   *  left to reply to in that case.
+   */
+  RL_UNUSED(
       fulfillRequest(identifier, std::move(replyChannel),
                      [&channel, &tag](core::Message& responseMessage) {
                        if (channel == nullptr) {
@@ -53,16 +63,12 @@ void CoordinatorAcquisitionProtocol::onRequest(
                        const auto& attachment = channel->attachment();
 
                        return responseMessage.encode(attachment);
-                     });
-
-  RL_ASSERT(result == core::IOResult::Success);
+                     }));
 }
 
-bool CoordinatorAcquisitionProtocol::populateRequestPayload(core::Message&) {
-  /*
-   *  There is nothing extra to encode
-   */
-  return true;
+bool CoordinatorAcquisitionProtocol::populateRequestPayload(
+    core::Message& message) {
+  return message.encode(_completionsChannel->attachment());
 }
 
 std::string CoordinatorAcquisitionProtocol::advertisementName() const {
@@ -0,0 +1,204 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Coordinator/FrameScheduler.h>
+#include <Core/TraceEvent.h>
+
+namespace rl {
+namespace coordinator {
+
+FrameScheduler::FrameScheduler(core::ClockDuration refreshInterval)
+    : _refreshInterval(refreshInterval.count()),
+      _loop(nullptr),
+      _wakeSource(core::EventLoopSource::Trivial()),
+      _needsFrame(false),
+      _idle(true),
+      _frameCount(0),
+      _hasPendingVsync(false) {
+  _wakeSource->setWakeFunction([&](core::IOResult) { onWake(); });
+}
+
+FrameScheduler::~FrameScheduler() {
+  RL_ASSERT_MSG(_loop == nullptr,
+                "The frame scheduler must be unscheduled before collection");
+}
+
+core::ClockDuration FrameScheduler::refreshInterval() const {
+  return core::ClockDuration(_refreshInterval.load());
+}
+
+void FrameScheduler::setRefreshInterval(core::ClockDuration refreshInterval) {
+  _refreshInterval = refreshInterval.count();
+}
+
+void FrameScheduler::setBeginFrameCallback(BeginFrameCallback callback) {
+  _beginFrameCallback = callback;
+}
+
+void FrameScheduler::setExternalVsync(VsyncRequestCallback callback) {
+  RL_ASSERT_MSG(_loop == nullptr,
+                "The vsync source cannot be changed once scheduled");
+  _vsyncRequestCallback = callback;
+}
+
+bool FrameScheduler::hasExternalVsync() const {
+  return static_cast<bool>(_vsyncRequestCallback);
+}
+
+void FrameScheduler::schedule(core::EventLoop& loop, bool schedule) {
+  if (schedule) {
+    RL_ASSERT(_loop == nullptr);
+    _loop = &loop;
+    _loop->addSource(_wakeSource);
+  } else {
+    RL_ASSERT(_loop == &loop);
+    if (!_idle) {
+      _idle = true;
+      requestVsync(false);
+    }
+    _loop->removeSource(_wakeSource);
+    _loop = nullptr;
+  }
+}
+
+void FrameScheduler::setNeedsFrame() {
+  _needsFrame = true;
+
+  /*
+   *  While vsync signals are being requested, the frame will begin on the next
+   *  one. Otherwise, the loop needs to be woken up.
+   */
+  if (_idle) {
+    wake();
+  }
+}
+
+void FrameScheduler::vsync(core::ClockPoint frameTime) {
+  {
+    core::MutexLocker lock(_pendingVsyncMutex);
+    _hasPendingVsync = true;
+    _pendingVsync = frameTime;
+  }
+  wake();
+}
+
+bool FrameScheduler::isIdle() const {
+  return _idle;
+}
+
+size_t FrameScheduler::frameCount() const {
+  return _frameCount;
+}
+
+void FrameScheduler::wake() {
+  _wakeSource->writer()(_wakeSource->handles().writeHandle);
+}
+
+void FrameScheduler::onWake() {
+  bool hasPendingVsync = false;
+  core::ClockPoint frameTime;
+
+  {
+    core::MutexLocker lock(_pendingVsyncMutex);
+    hasPendingVsync = _hasPendingVsync;
+    frameTime = _pendingVsync;
+    _hasPendingVsync = false;
+  }
+
+  if (!_idle) {
+    /*
+     *  Vsync signals delivered after the scheduler went idle are stale.
+     */
+    if (hasPendingVsync) {
+      beginFrame(frameTime);
+    }
+    return;
+  }
+
+  if (!_needsFrame) {
+    return;
+  }
+
+  _idle = false;
+  requestVsync(true);
+
+  if (!hasExternalVsync()) {
+    /*
+     *  Don't wait for the first tick of the timer to respond to the update that
+     *  woke the scheduler up.
+     */
+    beginFrame(core::Clock::now());
+  }
+}
+
+void FrameScheduler::onVsyncTimer() {
+  if (!_idle) {
+    beginFrame(core::Clock::now());
+  }
+}
+
+void FrameScheduler::beginFrame(core::ClockPoint frameTime) {
+  RL_TRACE_AUTO(__function__);
+
+  _needsFrame = false;
+
+  const BeginFrameArgs args(frameTime, refreshInterval());
+
+  bool needsAnotherFrame = false;
+  if (_beginFrameCallback) {
+    needsAnotherFrame = _beginFrameCallback(args);
+  }
+
+  _frameCount++;
+
+  if (needsAnotherFrame) {
+    return;
+  }
+
+  /*
+   *  Frames may be requested on other threads while going idle. Either this
+   *  thread sees the request or the requester sees that the scheduler is idle
+   *  and wakes it back up.
+   */
+  _idle = true;
+
+  if (_needsFrame) {
+    _idle = false;
+    return;
+  }
+
+  requestVsync(false);
+}
+
+void FrameScheduler::requestVsync(bool request) {
+  if (hasExternalVsync()) {
+    _vsyncRequestCallback(request);
+    return;
+  }
+
+  if (_loop == nullptr) {
+    return;
+  }
+
+  if (request) {
+    /*
+     *  A fresh timer keeps frames in phase with the one that woke the scheduler
+     *  up.
+     */
+    _vsyncTimer = core::EventLoopSource::Timer(
+        std::chrono::duration_cast<core::ClockDurationNano>(refreshInterval()));
+    _vsyncTimer->setWakeFunction([&](core::IOResult) { onVsyncTimer(); });
+    _loop->addSource(_vsyncTimer);
+  } else if (_vsyncTimer != nullptr) {
+    /*
+     *  The timer may be the source currently being dispatched. So it is only
+     *  removed from the loop here and collected when the next one is created.
+     */
+    _loop->removeSource(_vsyncTimer);
+  }
+}
+
+}  // namespace coordinator
+}  // namespace rl
@@ -4,17 +4,29 @@
  */
 
 #include <Coordinator/InterfaceController.h>
+#include <Core/Latch.h>
 #include <Core/TraceEvent.h>
+#include <algorithm>
 
 namespace rl {
 namespace coordinator {
 
 InterfaceController::InterfaceController(const std::string& debugTag,
-                                         const geom::Size& size)
+                                         const geom::Size& size,
+                                         NeedsFrameCallback needsFrameCallback,
+                                         std::shared_ptr<core::Channel>
+                                             completionsChannel)
     : _debugTag(debugTag),
       _localNS(),
       _channel(std::make_shared<core::Channel>()),
-      _graph(_localNS, size, debugTag) {}
+      _needsFrameCallback(needsFrameCallback),
+      _completionsChannel(completionsChannel),
+      _graph(_localNS,
+             size,
+             debugTag,
+             std::bind(&InterfaceController::onAnimationCompletion,
+                       this,
+                       std::placeholders::_1)) {}
 
 std::shared_ptr<core::Channel> InterfaceController::channel() const {
   return _channel;
@@ -41,42 +53,67 @@ void InterfaceController::scheduleChannel(core::EventLoop& loop,
 
 void InterfaceController::onChannelMessage(core::Message message) {
   RL_TRACE_AUTO(__function__);
-  core::MutexLocker lock(_graphMutex);
-  _graph.applyTransactions(message);
+  {
+    core::MutexLocker lock(_graphMutex);
+    _graph.applyTransactions(message);
+  }
+  setNeedsUpdate();
 }
 
 void InterfaceController::setSize(const geom::Size& size) {
   RL_TRACE_AUTO(__function__);
-  core::MutexLocker lock(_graphMutex);
-  _graph.updateSize(size);
+  {
+    core::MutexLocker lock(_graphMutex);
+    _graph.updateSize(size);
+  }
+  setNeedsUpdate();
 }
 
-bool InterfaceController::update(const event::TouchEvent::PhaseMap& touches) {
+void InterfaceController::setNeedsUpdate() {
+  if (_needsFrameCallback) {
+    _needsFrameCallback();
+  }
+}
+
+bool InterfaceController::update(const event::TouchEvent::PhaseMap& touches,
+                                 const core::ClockPoint& frameDeadline,
+                                 compositor::FramePhaseTimings& timings) {
   RL_TRACE_AUTO(__function__);
 
   core::MutexLocker lock(_graphMutex);
 
+  const auto updateStart = core::Clock::now();
+
   /*
    *  Step 1: Apply animations
    */
-  bool animationsUpdated = applyAnimations();
+  bool animationsUpdated = applyAnimations(frameDeadline);
+  sendCompletions();
 
   /*
    *  Step 2: Flush pending touches on the current state of the graph
    */
   bool touchesUpdated = applyPendingTouchEvents(touches);
 
+  const auto constraintsStart = core::Clock::now();
+
   /*
    *  Step 3: Enforce constraints
    */
   bool constraintsEnforced = enforceConstraints();
 
+  const auto constraintsEnd = core::Clock::now();
+
   /*
    *  Step 4: Resolve any other visual updates not covered by any of the above
    *  cases.
    */
   bool hasVisualUpdates = _graph.resolveVisualUpdates();
 
+  timings.update += (constraintsStart - updateStart) +
+                    (core::Clock::now() - constraintsEnd);
+  timings.constraints += constraintsEnd - constraintsStart;
+
   bool hasRenderableUpdates = (animationsUpdated || touchesUpdated ||
                                constraintsEnforced || hasVisualUpdates);
 
@@ -89,9 +126,41 @@ bool InterfaceController::applyPendingTouchEvents(
   return _graph.applyTouchMap(touches);
 }
 
-bool InterfaceController::applyAnimations() {
+bool InterfaceController::applyAnimations(const core::ClockPoint& time) {
   RL_TRACE_AUTO(__function__);
-  return _graph.stepInterpolations();
+  return _graph.stepInterpolations(time);
+}
+
+void InterfaceController::onAnimationCompletion(
+    const AnimationCompletion& completion) {
+  if (_completionsChannel == nullptr) {
+    return;
+  }
+
+  _completions.emplace_back(completion);
+}
+
+void InterfaceController::sendCompletions() {
+  if (_completions.empty()) {
+    return;
+  }
+
+  RL_TRACE_AUTO(__function__);
+
+  core::Message message;
+  if (message.encodeVectorCopyable(_completions)) {
+    core::Messages messages;
+    messages.emplace_back(std::move(message));
+
+    /*
+     *  The frame must not wait on the interface to read its completions. If
+     *  the interface falls that far behind, the completions are dropped.
+     */
+    _completionsChannel->sendMessages(std::move(messages),
+                                      core::ClockDurationNano(0));
+  }
+
+  _completions.clear();
 }
 
 bool InterfaceController::enforceConstraints() {
@@ -112,5 +181,108 @@ void InterfaceController::presentStatistics() const {
   _graph.presentStatistics();
 }
 
+/**
+ *  Perform the work for each of the given number of items. All but one of the
+ *  items are dispatched onto the work queue. The calling thread works on the
+ *  remaining item and then waits for the rest.
+ */
+static void PerformConcurrently(size_t count,
+                                std::function<void(size_t)> work,
+                                core::WorkQueue* workQueue) {
+  if (workQueue == nullptr || count < 2) {
+    for (size_t i = 0; i < count; i++) {
+      work(i);
+    }
+    return;
+  }
+
+  core::Latch latch(count - 1);
+
+  std::vector<core::WorkQueue::WorkItem> items;
+  items.reserve(count - 1);
+  for (size_t i = 1; i < count; i++) {
+    items.emplace_back([i, &work, &latch]() {
+      work(i);
+      latch.countDown();
+    });
+  }
+
+  if (!workQueue->dispatch(items.begin(), items.end())) {
+    for (const auto& item : items) {
+      item();
+    }
+  }
+
+  work(0);
+
+  latch.wait();
+}
+
+bool UpdateInterfaceControllers(
+    std::list<InterfaceController>& controllers,
+    const event::TouchEvent::PhaseMap& touchesIfAny,
+    const core::ClockPoint& frameDeadline,
+    compositor::FramePhaseTimings& timings,
+    core::WorkQueue* workQueue) {
+  RL_TRACE_AUTO(__function__);
+
+  std::vector<InterfaceController*> updating;
+  for (auto& controller : controllers) {
+    updating.push_back(&controller);
+  }
+
+  /*
+   *  Each controller writes to its own slot. So no synchronization is
+   *  necessary.
+   */
+  std::vector<compositor::FramePhaseTimings> controllerTimings(updating.size());
+  std::vector<uint8_t> updated(updating.size(), false);
+
+  PerformConcurrently(updating.size(),
+                      [&](size_t index) {
+                        updated[index] = updating[index]->update(
+                            touchesIfAny, frameDeadline,
+                            controllerTimings[index]);
+                      },
+                      workQueue);
+
+  /*
+   *  Controllers are updated concurrently. So the slowest controller in each
+   *  phase determines the duration of that phase.
+   */
+  compositor::FramePhaseTimings slowest;
+  for (const auto& controllerTiming : controllerTimings) {
+    slowest.update = std::max(slowest.update, controllerTiming.update);
+    slowest.constraints =
+        std::max(slowest.constraints, controllerTiming.constraints);
+  }
+  timings.update += slowest.update;
+  timings.constraints += slowest.constraints;
+
+  return std::any_of(updated.begin(), updated.end(),
+                     [](uint8_t value) { return value != 0; });
+}
+
+std::vector<compositor::FrontEndPass> RenderInterfaceControllers(
+    std::list<InterfaceController>& controllers,
+    core::WorkQueue* workQueue) {
+  RL_TRACE_AUTO(__function__);
+
+  std::vector<InterfaceController*> rendering;
+  for (auto& controller : controllers) {
+    rendering.push_back(&controller);
+  }
+
+  std::vector<compositor::FrontEndPass> passes(rendering.size());
+
+  PerformConcurrently(rendering.size(),
+                      [&](size_t index) {
+                        passes[index] = rendering[index]->render();
+                      },
+                      workQueue);
+
+  return passes;
+}
+
 }  // namespace coordinator
 }  // namespace rl
@@ -12,11 +12,17 @@ namespace coordinator {
 
 PresentationGraph::PresentationGraph(core::Namespace& localNS,
                                      const geom::Size& size,
-                                     const std::string& debugTag)
+                                     const std::string& debugTag,
+                                     CompletionCallback completionCallback)
     : _localNS(localNS),
+      _completionCallback(completionCallback),
       _stats(debugTag),
       _size(size),
       _root(nullptr),
+      _renderedRoot(nullptr),
+      _animationDirector(std::bind(&PresentationGraph::onAnimationCompletion,
+                                   this,
+                                   std::placeholders::_1)),
       _layoutSolver(localNS),
       _hasVisualUpdates(false),
       _proxyResolver(_localNS,
@@ -30,10 +36,9 @@ PresentationGraph::PresentationGraph(core::Namespace& localNS,
                                this,
                                std::placeholders::_1,
                                std::placeholders::_2),
-                     std::bind(&PresentationGraph::onEditVariableSuggest,
+                     std::bind(&PresentationGraph::onEditVariableSuggestions,
                                this,
-                               std::placeholders::_1,
-                               std::placeholders::_2),
+                               std::placeholders::_1),
                      std::bind(&PresentationGraph::resolveConstraintConstant,
                                this,
                                std::placeholders::_1)) {}
@@ -116,10 +121,14 @@ void PresentationGraph::updateRootSizeSuggestions() {
   auto bounds = _root->bounds();
   auto position = _root->position();
 
-  _layoutSolver.suggestValueForVariable(boundsWidth, bounds.size.width);
-  _layoutSolver.suggestValueForVariable(boundsHeight, bounds.size.height);
-  _layoutSolver.suggestValueForVariable(positionX, position.x);
-  _layoutSolver.suggestValueForVariable(positionY, position.y);
+  const auto priority = layout::priority::Strong();
+
+  _layoutSolver.applySuggestions({
+      {boundsWidth, bounds.size.width, priority},    //
+      {boundsHeight, bounds.size.height, priority},  //
+      {positionX, position.x, priority},             //
+      {positionY, position.y, priority},             //
+  });
 }
 
 compositor::PresentationEntity& PresentationGraph::presentationEntityForName(
@@ -170,7 +179,8 @@ bool PresentationGraph::applyTransactionSingle(core::Message& arena,
       std::bind(&G::onActionCommit, this, P::_1),
       std::bind(&G::onTransferEntityCommit, this, P::_1, P::_2, P::_3),
       std::bind(&G::onConstraintsCommit, this, P::_1),
-      std::bind(&G::onSuggestionsCommit, this, P::_1));
+      std::bind(&G::onSuggestionsCommit, this, P::_1),
+      std::bind(&G::onSimulationsCommit, this, P::_1, P::_2));
 
   RL_RETURN_IF_FALSE(payload.deserialize(arena, &_localNS));
 
@@ -256,9 +266,8 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 presentationEntity.bounds(),
                 /* to value */
                 transferEntity.bounds(),
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setBounds,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
 
             break;
           case Property::Position:
@@ -273,9 +282,8 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 presentationEntity.position(),
                 /* to value */
                 transferEntity.position(),
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setPosition,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
             break;
           case Property::AnchorPoint:
             _animationDirector.setInterpolator<geom::Point>(
@@ -289,9 +297,8 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 presentationEntity.anchorPoint(),
                 /* to value */
                 transferEntity.anchorPoint(),
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setAnchorPoint,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
             break;
           case Property::Transformation: {
             /*
@@ -316,9 +323,8 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 fromDecomposition.second,
                 /* to value */
                 toDecomposition.second,
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setTransformation,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
           } break;
           case Property::BackgroundColor: {
             /*
@@ -341,9 +347,8 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 from,
                 /* to value */
                 to,
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setBackgroundColor,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
           } break;
           case Property::Opacity:
             _animationDirector.setInterpolator<double>(
@@ -357,26 +362,23 @@ void PresentationGraph::onTransferEntityCommit(animation::Action& action,
                 presentationEntity.opacity(),
                 /* to value */
                 transferEntity.opacity(),
-                /* stepper */
-                std::bind(&compositor::PresentationEntity::setOpacity,
-                          &presentationEntity, std::placeholders::_1));
+                /* entity */
+                presentationEntity);
             break;
           case Property::StrokeSize:
-            _animationDirector.setInterpolator<
-                double>(/* key */
-                        key,
-                        /* start time */
-                        time,
-                        /* action */
-                        action,
-                        /* from value */
-                        presentationEntity.strokeSize(),
-                        /* to value */
-                        transferEntity.strokeSize(),
-                        /* stepper */
-                        std::bind(
-                            &compositor::PresentationEntity::setStrokeSize,
-                            &presentationEntity, std::placeholders::_1));
+            _animationDirector.setInterpolator<double>(
+                /* key */
+                key,
+                /* start time */
+                time,
+                /* action */
+                action,
+                /* from value */
+                presentationEntity.strokeSize(),
+                /* to value */
+                transferEntity.strokeSize(),
+                /* entity */
+                presentationEntity);
             break;
           default:
             RL_ASSERT_MSG(false, "Non animatable property encountered.");
@@ -439,24 +441,62 @@ void PresentationGraph::onSuggestionsCommit(
   for (const auto& suggestion : suggestions) {
     /*
      *  If the edit variable for the suggestion does not exist yet in the
-     *  solver. Add it and make a suggestion.
+     *  solver, add it before the suggestions are applied.
      */
-    auto suggestionResult = _layoutSolver.applySuggestion(suggestion);
-
-    if (suggestionResult == layout::Result::UnknownEditVariable) {
+    if (!_layoutSolver.hasEditVariable(suggestion.variable())) {
       const auto editAddResult = _layoutSolver.addEditVariable(
           suggestion.variable(), suggestion.priority());
+      RL_ASSERT_MSG(editAddResult == layout::Result::Success,
+                    "Must be able to add edit variable for suggestion");
+    }
+  }
 
-      if (editAddResult == layout::Result::Success) {
-        suggestionResult = _layoutSolver.applySuggestion(suggestion);
-      }
+  /*
+   *  Re-optimize the solver once for all suggestions in the transaction.
+   */
+  const auto suggestionResult = _layoutSolver.applySuggestions(suggestions);
+  RL_ASSERT_MSG(suggestionResult == layout::Result::Success,
+                "Must be able to apply constraint suggestions");
+
+  syncSolverStats();
+}
+
+void PresentationGraph::onSimulationsCommit(
+    std::vector<animation::SimulationDescriptor>&& simulations,
+    const core::ClockPoint& commitTime) {
+  RL_TRACE_AUTO(__function__);
+
+  for (const auto& simulation : simulations) {
+    /*
+     *  The identifier was read off the wire. Do not create an entity for a
+     *  name that never resolved.
+     */
+    if (simulation.identifier().isDead()) {
+      continue;
     }
 
-    RL_ASSERT_MSG(suggestionResult == layout::Result::Success,
-                  "Must be able to apply constraint suggestion");
+    _animationDirector.setSimulation(
+        commitTime, simulation,
+        presentationEntityForName(simulation.identifier()));
   }
+}
 
-  syncSolverStats();
+void PresentationGraph::onAnimationCompletion(
+    const animation::Director::Key& key) {
+  if (!_completionCallback) {
+    return;
+  }
+
+  /*
+   *  Only the interface can make use of the completion. Entities that were
+   *  never sent by it have no handle there.
+   */
+  const auto handle = key.entityIdentifier.counterpart();
+  if (handle == core::DeadHandle) {
+    return;
+  }
+
+  _completionCallback({handle, key.entityProperty});
 }
 
 void PresentationGraph::onEditVariableUpdate(const expr::Variable& variable,
@@ -475,9 +515,9 @@ void PresentationGraph::onEditVariableUpdate(const expr::Variable& variable,
   syncSolverStats();
 }
 
-void PresentationGraph::onEditVariableSuggest(const expr::Variable& variable,
-                                              double value) {
-  auto result = _layoutSolver.suggestValueForVariable(variable, value);
+void PresentationGraph::onEditVariableSuggestions(
+    const std::vector<layout::Suggestion>& suggestions) {
+  auto result = _layoutSolver.applySuggestions(suggestions);
   RL_ASSERT(result == layout::Result::Success);
   syncSolverStats();
 }
@@ -488,6 +528,14 @@ void PresentationGraph::syncSolverStats() {
 }
 
 void PresentationGraph::render(compositor::FrontEndPass& frontEndPass) {
+  /*
+   *  Nothing drawn by the previous root is known to be covered by the new one.
+   */
+  if (_root != _renderedRoot) {
+    frontEndPass.addDamage(geom::Rect{_size});
+    _renderedRoot = _root;
+  }
+
   if (_root == nullptr) {
     return;
   }
@@ -499,9 +547,9 @@ void PresentationGraph::presentStatistics() const {
   _stats.present();
 }
 
-bool PresentationGraph::stepInterpolations() {
+bool PresentationGraph::stepInterpolations(const core::ClockPoint& time) {
   const auto count =
-      _animationDirector.stepInterpolations(_stats.interpolations());
+      _animationDirector.stepInterpolations(_stats.interpolations(), time);
   _stats.interpolationsCount().reset(count);
   return count > 0;
 }
@@ -519,13 +567,16 @@ bool PresentationGraph::applyTouchMap(
 
 size_t PresentationGraph::applyConstraints() {
   namespace P = std::placeholders;
-  return _layoutSolver.flushUpdates(std::bind(
-      &PresentationGraph::resolveConstraintUpdate, this, P::_1, P::_2));
+  return _layoutSolver.flushGroupedUpdates(std::bind(
+      &PresentationGraph::resolveConstraintUpdate, this, P::_1));
 }
 
 layout::Solver::FlushResult PresentationGraph::resolveConstraintUpdate(
-    const expr::Variable& variable,
-    double value) {
+    const layout::Solver::VariableUpdates& updates) {
+  /*
+   *  All updates are for variables of the same entity.
+   */
+  const auto& variable = updates.front().first;
   auto found = _entities.find(variable.identifier());
   if (found == _entities.end()) {
     /*
@@ -538,9 +589,9 @@ layout::Solver::FlushResult PresentationGraph::resolveConstraintUpdate(
     return layout::Solver::FlushResult::NoUpdates;
   }
   /*
-   *  Actually update the property.
+   *  Actually update the properties.
    */
-  expr::Variable::SetProperty(*found->second, variable.property(), value);
+  expr::Variable::SetProperties(*found->second, updates);
   return layout::Solver::FlushResult::Updated;
 }
 
@@ -13,6 +13,10 @@ RenderSurface::RenderSurface() = default;
 
 RenderSurface::~RenderSurface() = default;
 
+size_t RenderSurface::bufferAge() {
+  return 0;
+}
+
 ScopedRenderSurfaceAccess::ScopedRenderSurfaceAccess(RenderSurface& surface)
     : _surface(surface), _finalized(false) {
   RL_TRACE_AUTO("SurfaceMakeCurrent");
@@ -19,27 +19,31 @@ TransactionPayload::TransactionPayload(
     animation::Action&& action,
     EntityMap&& entities,
     std::vector<layout::Constraint>&& constraints,
-    std::vector<layout::Suggestion>&& suggestions)
+    std::vector<layout::Suggestion>&& suggestions,
+    std::vector<animation::SimulationDescriptor>&& simulations)
     : _action(std::move(action)),
       _entities(std::move(entities)),
       _constraints(std::move(constraints)),
-      _suggestions(std::move(suggestions)) {}
+      _suggestions(std::move(suggestions)),
+      _simulations(std::move(simulations)) {}
 
 TransactionPayload::TransactionPayload(
     const core::ClockPoint& commitTime,
     ActionCallback actionCallback,
     TransferRecordCallback transferRecordCallback,
     ConstraintsCallback constraintsCallback,
-    SuggestionsCallback suggestionsCallback)
+    SuggestionsCallback suggestionsCallback,
+    SimulationsCallback simulationsCallback)
     : _commitTime(commitTime),
       _actionCallback(actionCallback),
       _transferRecordCallback(transferRecordCallback),
       _constraintsCallback(constraintsCallback),
-      _suggestionsCallback(suggestionsCallback) {}
+      _suggestionsCallback(suggestionsCallback),
+      _simulationsCallback(simulationsCallback) {}
 
 bool TransactionPayload::serialize(core::Message& message) const {
   /*
-   *  Step 1: Encode the Action, Constraints and Suggestions
+   *  Step 1: Encode the Action, Constraints, Suggestions and Simulations
    */
   RL_RETURN_IF_FALSE(message.encode(_action));
 
@@ -47,6 +51,8 @@ bool TransactionPayload::serialize(core::Message& message) const {
 
   RL_RETURN_IF_FALSE(message.encode(_suggestions));
 
+  RL_RETURN_IF_FALSE(message.encode(_simulations));
+
   /*
    *  Step 2: Encode the transfer record count
    */
@@ -84,13 +90,19 @@ bool TransactionPayload::deserialize(core::Message& message,
   RL_RETURN_IF_FALSE(message.decode(suggestions, ns));
 
   /*
-   *  Step 4.1: Read the transfer record count
+   *  Step 4: Read simulations.
+   */
+  std::vector<animation::SimulationDescriptor> simulations;
+  RL_RETURN_IF_FALSE(message.decode(simulations, ns));
+
+  /*
+   *  Step 5.1: Read the transfer record count
    */
   size_t transferRecords = 0;
   RL_RETURN_IF_FALSE(message.decode(transferRecords, ns));
 
   /*
-   *  Step 4.2: Read the transfer records
+   *  Step 5.2: Read the transfer records
    */
   {
     RL_TRACE_AUTO("TransferRecordsCommit");
@@ -110,6 +122,14 @@ bool TransactionPayload::deserialize(core::Message& message,
     _suggestionsCallback(std::move(suggestions));
   }
 
+  /*
+   *  Simulations are started after the transfer records so that they step
+   *  from the committed values of the properties they drive.
+   */
+  if (simulations.size() > 0) {
+    _simulationsCallback(std::move(simulations), _commitTime);
+  }
+
   return true;
 }
 
@@ -118,6 +138,7 @@ enum TransactionArchiveKey {
   Constraints,
   Suggestions,
   Entities,
+  Simulations,
 };
 
 const core::ArchiveDef TransactionPayload::ArchiveDefinition = {
@@ -130,6 +151,7 @@ const core::ArchiveDef TransactionPayload::ArchiveDefinition = {
         TransactionArchiveKey::Constraints,  //
         TransactionArchiveKey::Suggestions,  //
         TransactionArchiveKey::Entities,     //
+        TransactionArchiveKey::Simulations,  //
     }};
 
 TransactionPayload::ArchiveName TransactionPayload::archiveName() const {
@@ -149,6 +171,8 @@ bool TransactionPayload::serialize(core::ArchiveItem& item) const {
     entities.push_back(*(entity.second));
   }
   RL_RETURN_IF_FALSE(item.encode(TransactionArchiveKey::Entities, entities));
+  RL_RETURN_IF_FALSE(
+      item.encode(TransactionArchiveKey::Simulations, _simulations));
 
   return true;
 }
@@ -164,6 +188,14 @@ bool TransactionPayload::deserialize(core::ArchiveItem& item,
   std::vector<TransferEntity> entities;
   RL_RETURN_IF_FALSE(item.decode(TransactionArchiveKey::Entities, entities, ns))
 
+  /*
+   *  Archives written before simulations could be started have no
+   *  simulations member.
+   */
+  if (!item.decode(TransactionArchiveKey::Simulations, _simulations, ns)) {
+    _simulations.clear();
+  }
+
   for (auto& entity : entities) {
     _entities.emplace(entity.identifier(),
                       std::make_unique<TransferEntity>(std::move(entity)));
@@ -0,0 +1,202 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Coordinator/FrameScheduler.h>
+#include <Core/Latch.h>
+#include <TestRunner/TestRunner.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace rl {
+namespace coordinator {
+namespace testing {
+
+static const core::ClockDurationSeconds kRefreshInterval(1.0 / 120.0);
+
+/**
+ *  Run the current loop with the scheduler scheduled on it for the given
+ *  duration.
+ */
+static void RunSchedulerFor(FrameScheduler& scheduler,
+                            core::ClockDurationMilli duration) {
+  auto loop = core::EventLoop::Current();
+
+  auto terminator = core::EventLoopSource::Timer(duration);
+  terminator->setWakeFunction([loop](core::IOResult) { loop->terminate(); });
+
+  scheduler.schedule(*loop, true);
+  loop->addSource(terminator);
+
+  loop->loop();
+
+  loop->removeSource(terminator);
+  scheduler.schedule(*loop, false);
+}
+
+TEST(FrameSchedulerTest, IdleWithoutFrameRequests) {
+  FrameScheduler scheduler(kRefreshInterval);
+
+  size_t frames = 0;
+  scheduler.setBeginFrameCallback(
+      [&](const FrameScheduler::BeginFrameArgs&) {
+        frames++;
+        return true;
+      });
+
+  RunSchedulerFor(scheduler, core::ClockDurationMilli(50));
+
+  ASSERT_EQ(frames, 0u);
+  ASSERT_EQ(scheduler.frameCount(), 0u);
+  ASSERT_TRUE(scheduler.isIdle());
+}
+
+TEST(FrameSchedulerTest, SingleFrameForSingleRequest) {
+  FrameScheduler scheduler(kRefreshInterval);
+
+  size_t frames = 0;
+  scheduler.setBeginFrameCallback(
+      [&](const FrameScheduler::BeginFrameArgs&) {
+        frames++;
+        return false;
+      });
+
+  scheduler.setNeedsFrame();
+  scheduler.setNeedsFrame();
+
+  RunSchedulerFor(scheduler, core::ClockDurationMilli(50));
+
+  ASSERT_EQ(frames, 1u);
+  ASSERT_TRUE(scheduler.isIdle());
+}
+
+TEST(FrameSchedulerTest, FramesContinueTillNoLongerNeeded) {
+  FrameScheduler scheduler(kRefreshInterval);
+
+  std::vector<FrameScheduler::BeginFrameArgs> frames;
+  scheduler.setBeginFrameCallback(
+      [&](const FrameScheduler::BeginFrameArgs& args) {
+        frames.emplace_back(args);
+        return frames.size() < 5;
+      });
+
+  scheduler.setNeedsFrame();
+
+  RunSchedulerFor(scheduler, core::ClockDurationMilli(200));
+
+  ASSERT_EQ(frames.size(), 5u);
+  ASSERT_EQ(scheduler.frameCount(), 5u);
+  ASSERT_TRUE(scheduler.isIdle());
+
+  for (size_t i = 0; i < frames.size(); i++) {
+    ASSERT_EQ(frames[i].interval, kRefreshInterval);
+    ASSERT_EQ(frames[i].deadline, frames[i].frameTime + kRefreshInterval);
+    if (i > 0) {
+      ASSERT_GT(frames[i].frameTime, frames[i - 1].frameTime);
+    }
+  }
+}
+
+TEST(FrameSchedulerTest, RequestsOnOtherThreadsWakeIdleScheduler) {
+  FrameScheduler scheduler(kRefreshInterval);
+
+  const size_t requests = 3;
+  std::vector<bool> idleBeforeRequest;
+
+  core::Latch framesLatch(requests);
+  scheduler.setBeginFrameCallback(
+      [&](const FrameScheduler::BeginFrameArgs&) {
+        framesLatch.countDown();
+        return false;
+      });
+
+  auto loop = core::EventLoop::Current();
+
+  std::thread requester([&] {
+    for (size_t i = 0; i < requests; i++) {
+      std::this_thread::sleep_for(core::ClockDurationMilli(20));
+      idleBeforeRequest.push_back(scheduler.isIdle());
+      scheduler.setNeedsFrame();
+    }
+    framesLatch.wait();
+    loop->terminate();
+  });
+
+  scheduler.schedule(*loop, true);
+  loop->loop();
+  scheduler.schedule(*loop, false);
+
+  requester.join();
+
+  ASSERT_EQ(scheduler.frameCount(), requests);
+  ASSERT_EQ(idleBeforeRequest, std::vector<bool>(requests, true));
+  ASSERT_TRUE(scheduler.isIdle());
+}
+
+TEST(FrameSchedulerTest, ExternalVsyncPacesFrames) {
+  FrameScheduler scheduler(kRefreshInterval);
+
+  std::atomic_bool displayLinkRunning(false);
+  std::atomic_bool terminated(false);
+  std::vector<bool> vsyncRequests;
+
+  auto loop = core::EventLoop::Current();
+
+  scheduler.setExternalVsync([&](bool request) {
+    vsyncRequests.push_back(request);
+    displayLinkRunning = request;
+    if (!request) {
+      loop->terminate();
+    }
+  });
+
+  std::vector<FrameScheduler::BeginFrameArgs> frames;
+  scheduler.setBeginFrameCallback(
+      [&](const FrameScheduler::BeginFrameArgs& args) {
+        frames.emplace_back(args);
+        return frames.size() < 3;
+      });
+
+  /*
+   *  Stands in for the display link on the platform.
+   */
+  std::vector<core::ClockPoint> vsyncTimes;
+  std::thread displayLink([&] {
+    while (!terminated) {
+      std::this_thread::sleep_for(core::ClockDurationMilli(5));
+      if (displayLinkRunning) {
+        auto time = core::Clock::now();
+        vsyncTimes.push_back(time);
+        scheduler.vsync(time);
+      }
+    }
+  });
+
+  scheduler.schedule(*loop, true);
+  scheduler.setNeedsFrame();
+  loop->loop();
+  scheduler.schedule(*loop, false);
+
+  terminated = true;
+  displayLink.join();
+
+  ASSERT_EQ(vsyncRequests, std::vector<bool>({true, false}));
+  ASSERT_EQ(frames.size(), 3u);
+  ASSERT_GE(vsyncTimes.size(), 3u);
+
+  /*
+   *  Vsyncs delivered faster than the loop can service them are coalesced.
+   */
+  for (const auto& frame : frames) {
+    ASSERT_NE(std::find(vsyncTimes.begin(), vsyncTimes.end(), frame.frameTime),
+              vsyncTimes.end());
+    ASSERT_EQ(frame.deadline, frame.frameTime + kRefreshInterval);
+  }
+}
+
+}  // namespace testing
+}  // namespace coordinator
+}  // namespace rl
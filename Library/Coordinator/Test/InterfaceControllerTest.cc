@@ -0,0 +1,188 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Coordinator/InterfaceController.h>
+#include <Coordinator/TransactionPayload.h>
+#include <Core/EventLoop.h>
+#include <TestRunner/TestRunner.h>
+
+namespace rl {
+namespace coordinator {
+namespace testing {
+
+/**
+ *  Send a transaction that adds the given number of opaque boxes to the
+ *  interface of the controller and wait for the controller to apply it.
+ */
+static void AddBoxes(InterfaceController& controller, size_t count) {
+  core::Namespace ns;
+
+  TransactionPayload::EntityMap entities;
+
+  auto transfer = [&](const entity::Entity& entity) {
+    auto& transferEntity = entities[entity.identifier()];
+    if (!transferEntity) {
+      transferEntity = std::make_unique<TransferEntity>(entity.identifier());
+    }
+    return transferEntity.get();
+  };
+
+  using Property = entity::Entity::Property;
+
+  entity::Entity root(core::Name{ns});
+  root.setBounds({0.0, 0.0, 800.0, 600.0});
+  transfer(root)->record(root, Property::Bounds, core::Name{});
+  transfer(root)->record(root, Property::MakeRoot, root.identifier());
+
+  for (size_t i = 0; i < count; i++) {
+    entity::Entity box(core::Name{ns});
+    box.setBounds({0.0, 0.0, 10.0, 10.0});
+    box.setPosition({10.0 * i, 10.0 * i});
+    box.setBackgroundColor(entity::Color::Red());
+    transfer(box)->record(box, Property::Bounds, core::Name{});
+    transfer(box)->record(box, Property::Position, core::Name{});
+    transfer(box)->record(box, Property::BackgroundColor, core::Name{});
+    transfer(box)->record(box, Property::AddedTo, root.identifier());
+  }
+
+  TransactionPayload payload(animation::Action{}, std::move(entities), {}, {});
+
+  core::Message message;
+  ASSERT_TRUE(message.encode(payload));
+
+  core::Messages messages;
+  messages.emplace_back(std::move(message));
+
+  auto channel = controller.channel();
+  ASSERT_EQ(channel->sendMessages(std::move(messages)),
+            core::IOResult::Success);
+  ASSERT_EQ(channel->readPendingMessageNow(), core::IOResult::Success);
+}
+
+TEST(InterfaceControllerTest, ConcurrentRenderPreservesControllerOrder) {
+  auto loop = core::EventLoop::Current();
+
+  const size_t controllerCount = 8;
+  size_t frameRequests = 0;
+
+  std::list<InterfaceController> controllers;
+  for (size_t i = 0; i < controllerCount; i++) {
+    controllers.emplace_back("controller", geom::Size{800.0, 600.0},
+                             [&]() { frameRequests++; });
+    auto& controller = controllers.back();
+    controller.scheduleChannel(*loop, true);
+    AddBoxes(controller, i + 1);
+  }
+
+  ASSERT_EQ(frameRequests, controllerCount);
+
+  core::WorkQueue workQueue;
+
+  compositor::FramePhaseTimings timings;
+  ASSERT_TRUE(UpdateInterfaceControllers(controllers, {}, core::Clock::now(),
+                                         timings, &workQueue));
+  ASSERT_GT(timings.update.count(), 0.0);
+
+  /*
+   *  Primitives are bound to the thread that renders them when prepared in a
+   *  back-end pass. There is none here. So create the primitives on this
+   *  thread before rendering concurrently.
+   */
+  ASSERT_EQ(RenderInterfaceControllers(controllers, nullptr).size(),
+            controllerCount);
+
+  for (size_t iteration = 0; iteration < 10; iteration++) {
+    auto passes = RenderInterfaceControllers(controllers, &workQueue);
+    ASSERT_EQ(passes.size(), controllerCount);
+    for (size_t i = 0; i < controllerCount; i++) {
+      ASSERT_EQ(passes[i].primitivesCount(), i + 1);
+    }
+  }
+
+  /*
+   *  With nothing left to update, no more frames are necessary.
+   */
+  compositor::FramePhaseTimings idleTimings;
+  ASSERT_FALSE(UpdateInterfaceControllers(
+      controllers, {}, core::Clock::now(), idleTimings, &workQueue));
+
+  for (auto& controller : controllers) {
+    controller.scheduleChannel(*loop, false);
+  }
+}
+
+TEST(InterfaceControllerTest, FinishedAnimationsAreReported) {
+  auto loop = core::EventLoop::Current();
+
+  /*
+   *  The channel the interface would vend. Messages sent on it by the
+   *  controller are read back here.
+   */
+  auto completionsChannel = std::make_shared<core::Channel>();
+
+  InterfaceController controller("controller", geom::Size{800.0, 600.0},
+                                 nullptr, completionsChannel);
+  controller.scheduleChannel(*loop, true);
+
+  core::Namespace ns;
+  entity::Entity box(core::Name{ns});
+  box.setOpacity(0.5);
+
+  using Property = entity::Entity::Property;
+
+  TransactionPayload::EntityMap entities;
+  entities[box.identifier()] =
+      std::make_unique<TransferEntity>(box.identifier());
+  entities[box.identifier()]->record(box, Property::Opacity, core::Name{});
+
+  animation::Action action(0.25);
+  action.setPropertyMask(entity::Entity::OpacityMask);
+
+  TransactionPayload payload(std::move(action), std::move(entities), {}, {});
+
+  core::Message message;
+  ASSERT_TRUE(message.encode(payload));
+
+  core::Messages messages;
+  messages.emplace_back(std::move(message));
+
+  auto channel = controller.channel();
+  ASSERT_EQ(channel->sendMessages(std::move(messages)),
+            core::IOResult::Success);
+  ASSERT_EQ(channel->readPendingMessageNow(), core::IOResult::Success);
+
+  /*
+   *  The interpolation is stepped past its end on the first update.
+   */
+  compositor::FramePhaseTimings timings;
+  ASSERT_TRUE(controller.update(
+      {}, core::Clock::now() + core::ClockDuration(10.0), timings));
+
+  auto completions =
+      completionsChannel->drainPendingMessages(core::ClockDurationNano(0));
+  ASSERT_EQ(completions.size(), 1u);
+
+  std::vector<AnimationCompletion> completed;
+  ASSERT_TRUE(completions[0].decodeVectorCopyable(completed, nullptr));
+  ASSERT_EQ(completed.size(), 1u);
+  ASSERT_EQ(completed[0].entityHandle, *box.identifier().handle());
+  ASSERT_EQ(completed[0].property, Property::Opacity);
+
+  /*
+   *  Nothing else finishes on later updates.
+   */
+  ASSERT_FALSE(controller.update(
+      {}, core::Clock::now() + core::ClockDuration(20.0), timings));
+  ASSERT_EQ(
+      completionsChannel->drainPendingMessages(core::ClockDurationNano(0))
+          .size(),
+      0u);
+
+  controller.scheduleChannel(*loop, false);
+}
+
+}  // namespace testing
+}  // namespace coordinator
+}  // namespace rl
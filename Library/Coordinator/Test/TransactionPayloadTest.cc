@@ -0,0 +1,77 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Coordinator/TransactionPayload.h>
+#include <Core/Message.h>
+#include <TestRunner/TestRunner.h>
+
+namespace rl {
+namespace coordinator {
+namespace testing {
+
+TEST(TransactionPayloadTest, SimulationsAreCommittedAfterTransferRecords) {
+  core::Namespace ns;
+  core::Namespace localNS;
+  entity::Entity entity(core::Name{ns});
+  entity.setPosition({20.0, 30.0});
+
+  using Property = entity::Entity::Property;
+
+  TransactionPayload::EntityMap entities;
+  entities[entity.identifier()] =
+      std::make_unique<TransferEntity>(entity.identifier());
+  entities[entity.identifier()]->record(entity, Property::Position,
+                                        core::Name{});
+
+  auto fling = animation::SimulationDescriptor::Friction(0.1, 20.0, 500.0);
+  fling.setTarget(entity.identifier(), Property::Position,
+                  animation::SimulationDescriptor::Axis::Y);
+
+  std::vector<animation::SimulationDescriptor> simulations;
+  simulations.emplace_back(fling);
+
+  core::Message message;
+  {
+    TransactionPayload payload(animation::Action{}, std::move(entities), {},
+                               {}, std::move(simulations));
+    ASSERT_TRUE(message.encode(payload));
+  }
+
+  /*
+   *  The commit time comes from a fake clock.
+   */
+  const core::ClockPoint commitTime(core::ClockDuration(42.0));
+
+  size_t transferRecords = 0;
+  std::vector<animation::SimulationDescriptor> committed;
+  core::ClockPoint committedTime;
+
+  TransactionPayload payload(
+      commitTime,  //
+      [](animation::Action&) {},
+      [&](animation::Action&, TransferEntity&, const core::ClockPoint&) {
+        transferRecords++;
+      },
+      [](std::vector<layout::Constraint>&&) {},
+      [](std::vector<layout::Suggestion>&&) {},
+      [&](std::vector<animation::SimulationDescriptor>&& simulations,
+          const core::ClockPoint& time) {
+        ASSERT_EQ(transferRecords, 1u);
+        committed = std::move(simulations);
+        committedTime = time;
+      });
+  ASSERT_TRUE(payload.deserialize(message, &localNS));
+
+  ASSERT_EQ(committed.size(), 1u);
+  ASSERT_EQ(committedTime, commitTime);
+  ASSERT_EQ(committed[0].type(),
+            animation::SimulationDescriptor::Type::Friction);
+  ASSERT_EQ(committed[0].property(), Property::Position);
+  ASSERT_EQ(committed[0].axis(), animation::SimulationDescriptor::Axis::Y);
+}
+
+}  // namespace testing
+}  // namespace coordinator
+}  // namespace rl
@@ -0,0 +1,88 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/Channel.h>
+#include <cstring>
+#include <thread>
+
+static const size_t kMessagesPerIteration = 256;
+
+static void SendMessages(benchmark::State& state,
+                         bool batched,
+                         bool channelMessages) {
+  const size_t payloadSize = state.range(0);
+
+  rl::core::Channel channel;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    rl::core::Messages messages;
+    for (size_t i = 0; i < kMessagesPerIteration; i++) {
+      auto message =
+          channelMessages ? channel.createMessage() : rl::core::Message{};
+      auto payload = message.encodeRaw<uint8_t>(payloadSize);
+      RL_ASSERT(payload != nullptr);
+      memset(payload, static_cast<int>(i), payloadSize);
+      messages.emplace_back(std::move(message));
+    }
+    state.ResumeTiming();
+
+    std::thread writer([&channel, &messages, batched]() {
+      if (batched) {
+        auto result = channel.sendMessages(std::move(messages));
+        RL_ASSERT(result == rl::core::IOResult::Success);
+      } else {
+        for (auto& message : messages) {
+          rl::core::Messages single;
+          single.emplace_back(std::move(message));
+          auto result = channel.sendMessages(std::move(single));
+          RL_ASSERT(result == rl::core::IOResult::Success);
+        }
+      }
+    });
+
+    size_t received = 0;
+    while (received < kMessagesPerIteration) {
+      received += channel
+                      .drainPendingMessages(rl::core::ClockDurationMilli(1000),
+                                            kMessagesPerIteration - received)
+                      .size();
+    }
+
+    writer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kMessagesPerIteration);
+  state.SetBytesProcessed(state.iterations() * kMessagesPerIteration *
+                          payloadSize);
+}
+
+static void BM_ChannelSendSingle(benchmark::State& state) {
+  SendMessages(state, false, false);
+}
+
+static void BM_ChannelSendBatched(benchmark::State& state) {
+  SendMessages(state, true, false);
+}
+
+static void BM_ChannelSendBatchedInArenas(benchmark::State& state) {
+  SendMessages(state, true, true);
+}
+
+BENCHMARK(BM_ChannelSendSingle)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(16, 64 << 10);
+
+BENCHMARK(BM_ChannelSendBatched)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(16, 64 << 10);
+
+BENCHMARK(BM_ChannelSendBatchedInArenas)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(16, 64 << 10);
@@ -0,0 +1,116 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/EventLoop.h>
+#include <Core/EventLoopThread.h>
+#include <Core/Latch.h>
+#include <vector>
+
+using Sources = std::vector<std::shared_ptr<rl::core::EventLoopSource>>;
+
+static void SignalSource(rl::core::EventLoopSource& source) {
+  source.writer()(source.handles().writeHandle);
+}
+
+/*
+ *  Measures the time taken by the loop to dispatch all its sources when they
+ *  are signalled at once.
+ */
+static void BM_EventLoopDispatchThroughput(benchmark::State& state) {
+  const size_t sourceCount = state.range(0);
+
+  auto loop = rl::core::EventLoop::Current();
+
+  size_t dispatched = 0;
+
+  Sources sources;
+  for (size_t i = 0; i < sourceCount; i++) {
+    auto source = rl::core::EventLoopSource::Trivial();
+    source->setWakeFunction(
+        [&dispatched, sourceCount, loop](rl::core::IOResult) {
+          if (++dispatched == sourceCount) {
+            loop->terminate();
+          }
+        });
+    loop->addSource(source);
+    sources.emplace_back(std::move(source));
+  }
+
+  while (state.KeepRunning()) {
+    dispatched = 0;
+
+    for (const auto& source : sources) {
+      SignalSource(*source);
+    }
+
+    loop->loop();
+  }
+
+  for (const auto& source : sources) {
+    loop->removeSource(source);
+  }
+
+  state.SetItemsProcessed(state.iterations() * sourceCount);
+}
+
+/*
+ *  Measures the time taken for a signal from another thread to be dispatched
+ *  by a loop that is watching the given number of sources.
+ */
+static void BM_EventLoopWakeupLatency(benchmark::State& state) {
+  const size_t sourceCount = state.range(0);
+
+  rl::core::EventLoopThread thread;
+
+  Sources sources;
+  for (size_t i = 0; i < sourceCount; i++) {
+    sources.emplace_back(rl::core::EventLoopSource::Trivial());
+  }
+
+  std::unique_ptr<rl::core::Latch> woken;
+
+  for (const auto& source : sources) {
+    source->setWakeFunction([&woken](rl::core::IOResult) {
+      woken->countDown();
+    });
+  }
+
+  {
+    auto loopAccess = thread.loop();
+    for (const auto& source : sources) {
+      loopAccess.get()->addSource(source);
+    }
+  }
+
+  size_t next = 0;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    woken = std::make_unique<rl::core::Latch>(1);
+    auto& source = *sources[next++ % sourceCount];
+    state.ResumeTiming();
+
+    SignalSource(source);
+    woken->wait();
+  }
+
+  {
+    auto loopAccess = thread.loop();
+    for (const auto& source : sources) {
+      loopAccess.get()->removeSource(source);
+    }
+  }
+}
+
+BENCHMARK(BM_EventLoopDispatchThroughput)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1, 1000);
+
+BENCHMARK(BM_EventLoopWakeupLatency)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)
+    ->Range(1, 1000);
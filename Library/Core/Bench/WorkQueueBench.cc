@@ -0,0 +1,123 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/WorkQueue.h>
+#include <thread>
+
+static const size_t kItemsPerProducer = 1000;
+
+static void DispatchFromProducers(benchmark::State& state,
+                                  rl::core::WorkQueue::Mode mode,
+                                  bool batched) {
+  const size_t producers = state.range(0);
+
+  rl::core::WorkQueue queue(mode);
+
+  while (state.KeepRunning()) {
+    rl::core::Latch done(producers * kItemsPerProducer);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; i++) {
+      threads.emplace_back([&queue, &done, batched]() {
+        auto item = [&done]() { done.countDown(); };
+
+        if (batched) {
+          std::vector<rl::core::WorkQueue::WorkItem> items(kItemsPerProducer,
+                                                           item);
+          auto dispatched = queue.dispatch(items.begin(), items.end());
+          RL_ASSERT(dispatched);
+        } else {
+          for (size_t j = 0; j < kItemsPerProducer; j++) {
+            auto dispatched = queue.dispatch(item);
+            RL_ASSERT(dispatched);
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    done.wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * producers * kItemsPerProducer);
+}
+
+static void WorkQueueShared(benchmark::State& state) {
+  DispatchFromProducers(state, rl::core::WorkQueue::Mode::Shared, false);
+}
+
+static void WorkQueueSharedBatch(benchmark::State& state) {
+  DispatchFromProducers(state, rl::core::WorkQueue::Mode::Shared, true);
+}
+
+static void WorkQueueWorkStealing(benchmark::State& state) {
+  DispatchFromProducers(state, rl::core::WorkQueue::Mode::WorkStealing, false);
+}
+
+static void WorkQueueWorkStealingBatch(benchmark::State& state) {
+  DispatchFromProducers(state, rl::core::WorkQueue::Mode::WorkStealing, true);
+}
+
+BENCHMARK(WorkQueueShared)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+BENCHMARK(WorkQueueSharedBatch)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+BENCHMARK(WorkQueueWorkStealing)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+BENCHMARK(WorkQueueWorkStealingBatch)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+static void WorkQueueWorkStealingFanOut(benchmark::State& state) {
+  /*
+   *  Items dispatched from within workers stay on the worker deques and never
+   *  touch the injection queue.
+   */
+  const size_t fanout = state.range(0);
+
+  rl::core::WorkQueue queue(rl::core::WorkQueue::Mode::WorkStealing);
+
+  while (state.KeepRunning()) {
+    rl::core::Latch done(fanout * fanout);
+
+    for (size_t i = 0; i < fanout; i++) {
+      auto dispatched = queue.dispatch([&queue, &done, fanout]() {
+        for (size_t j = 0; j < fanout; j++) {
+          auto nested = queue.dispatch([&done]() { done.countDown(); });
+          RL_ASSERT(nested);
+        }
+      });
+      RL_ASSERT(dispatched);
+    }
+
+    done.wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * fanout * fanout);
+}
+
+BENCHMARK(WorkQueueWorkStealingFanOut)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(4)
+    ->Range(4, 64)
+    ->UseRealTime();
@@ -18,6 +18,7 @@ namespace rl {
 namespace core {
 
 class ChannelProvider;
+class SharedMemoryArenaPool;
 
 /**
  *  The core communication mechanism between the various subsystems in Radar.
@@ -58,6 +59,21 @@ class Channel {
   IOResult sendMessages(Messages message,
                         ClockDurationNano timeout = ClockDurationNano::max());
 
+  /**
+   *  Create an empty message to be sent on this channel. If the channel
+   *  supports it, large messages are encoded directly into shared memory
+   *  arenas leased from the channel and are sent without being copied.
+   *
+   *  @return the new message
+   */
+  Message createMessage() const;
+
+  /**
+   *  @return the pool of shared memory arenas used to send large messages on
+   *          this channel or `nullptr` if the channel does not use arenas
+   */
+  std::shared_ptr<SharedMemoryArenaPool> arenaPool() const;
+
   /**
    *  When a message arrive on this channel, a callback may be invoked on the
    *  loop where this channel is scheduled. Get this callback.
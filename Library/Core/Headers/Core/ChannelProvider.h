@@ -8,6 +8,7 @@
 #include <Core/EventLoopSource.h>
 #include <Core/IOResult.h>
 #include <Core/Message.h>
+#include <Core/SharedMemoryArenaPool.h>
 #include <memory>
 #include <vector>
 
@@ -55,6 +56,16 @@ class ChannelProvider {
    */
   virtual AttachmentRef attachment() = 0;
 
+  /**
+   *  Providers that can send messages in shared memory arenas without copying
+   *  them return the pool those arenas are leased from.
+   *
+   *  @return the arena pool or `nullptr` if arenas are not supported
+   */
+  virtual std::shared_ptr<SharedMemoryArenaPool> arenaPool() const {
+    return nullptr;
+  }
+
   /**
    *  The desctuctor
    */
@@ -114,6 +114,22 @@ class EventLoopSource {
 
   void setCustomWaitSetUpdateHandler(WaitSetUpdateHandler updateHandler);
 
+  /**
+   *  Edge triggered sources are only signalled when new data becomes available
+   *  instead of for as long as data is available. The reader must drain all
+   *  available data each time the source is signalled. Only affects sources
+   *  without custom wait set update handlers and must be set before the source
+   *  is added to a wait set.
+   *
+   *  @param edgeTriggered if the source is edge triggered
+   */
+  void setEdgeTriggered(bool edgeTriggered);
+
+  /**
+   *  @return if the source is edge triggered
+   */
+  bool isEdgeTriggered() const;
+
   void attemptRead();
 
   /**
@@ -146,6 +162,7 @@ class EventLoopSource {
   WakeFunction _wakeFunction;
   std::atomic_bool _handlesAllocated;
   Mutex _handlesAllocationMutex;
+  bool _edgeTriggered;
 
   void updateInWaitSetForSimpleRead(WaitSet& waitset, bool shouldAdd);
 
@@ -16,6 +16,9 @@
 namespace rl {
 namespace core {
 
+class SharedMemoryArena;
+class SharedMemoryArenaPool;
+
 class Message {
  public:
   /**
@@ -32,6 +35,23 @@ class Message {
    */
   Message(uint8_t* buffer, size_t bufferLength, bool vmAllocated);
 
+  /**
+   *  Create an empty message that moves into an arena leased from the pool
+   *  once it grows past the lease threshold of the pool. Channels that support
+   *  arenas send such messages without copying them.
+   *
+   *  @param pool the pool to lease arenas from
+   */
+  Message(std::shared_ptr<SharedMemoryArenaPool> pool);
+
+  /**
+   *  Create a message whose contents are already in the given arena
+   *
+   *  @param arena  the arena containing the message data
+   *  @param length the message data length
+   */
+  Message(std::shared_ptr<SharedMemoryArena> arena, size_t length);
+
   /**
    *  Moves a given message
    */
@@ -187,6 +207,11 @@ class Message {
 
   const std::vector<AttachmentRef>& attachments() const;
 
+  /**
+   *  @return the arena backing the message buffer (if any)
+   */
+  const std::shared_ptr<SharedMemoryArena>& arena() const;
+
   /**
    *  The size of the data already read during previous `decode` operations
    *
@@ -203,6 +228,8 @@ class Message {
 
  private:
   uint8_t* _buffer;
+  std::shared_ptr<SharedMemoryArena> _arena;
+  std::shared_ptr<SharedMemoryArenaPool> _arenaPool;
   std::vector<AttachmentRef> _attachments;
   std::vector<RawAttachment> _rawAttachments;
   size_t _bufferLength;
@@ -213,6 +240,8 @@ class Message {
 
   bool resizeBuffer(size_t size);
 
+  bool resizeArena(size_t size);
+
   uint8_t* encodeRawUnsafe(size_t size);
 
   uint8_t* decodeRawUnsafe(size_t size);
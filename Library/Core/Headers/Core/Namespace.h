@@ -38,6 +38,12 @@ class Name : public MessageSerializable {
 
   bool isDead() const;
 
+  /**
+   *  @return the handle of the remote name this name was decoded from or
+   *          `DeadHandle` if the name is local
+   */
+  Handle counterpart() const;
+
   size_t hash() const;
 
   bool serialize(Message& message) const override;
@@ -110,6 +116,8 @@ class Namespace {
 
   Name::HandleRef createHandle(Name::Handle counterpart);
 
+  Name::Handle counterpart(Name::Handle local) const;
+
   void destroy(Name::Handle name);
 
   RL_DISALLOW_COPY_AND_ASSIGN(Namespace);
@@ -31,6 +31,32 @@ class SharedMemory {
    */
   void cleanup();
 
+  /**
+   *  Close the handle to the shared memory while keeping the mapping alive. The
+   *  reference remains ready for use but may no longer be shared.
+   */
+  void closeHandle();
+
+  /**
+   *  Make the contents of the shared memory immutable. The writable mapping is
+   *  replaced by a read-only one. Where the platform supports it (sealed
+   *  memfds on Linux), the kernel also rejects writes and resizes through
+   *  every handle to the memory, including ones already sent to other
+   *  processes.
+   *
+   *  @return if the kernel enforces the immutability of the contents
+   */
+  bool seal();
+
+  /**
+   *  Relinquish ownership of the handle to the caller. The mapping stays alive
+   *  but the reference may no longer be shared.
+   *
+   *  @return the handle to the shared memory
+   */
+  RL_WARN_UNUSED_RESULT
+  Handle takeHandle();
+
   /**
    *  Returns if the shared memory reference is ready for use
    *
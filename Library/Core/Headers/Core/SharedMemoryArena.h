@@ -0,0 +1,109 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Core/SharedMemory.h>
+#include <memory>
+
+namespace rl {
+namespace core {
+
+/**
+ *  A shared memory region used to transfer out-of-line message payloads. A
+ *  small header precedes the payload and keeps track of the length of the
+ *  payload as well as the number of references to the arena across all
+ *  processes that have it mapped. An arena whose reference count drops to zero
+ *  may be reused by its creator.
+ */
+class SharedMemoryArena {
+ public:
+  /**
+   *  Create a new arena that can hold a payload of the given capacity. The
+   *  arena starts out with no references.
+   *
+   *  @param capacity the capacity of the payload
+   */
+  SharedMemoryArena(size_t capacity);
+
+  ~SharedMemoryArena();
+
+  /**
+   *  Map an arena from a handle received from another process. The handle is
+   *  closed once mapped. The reference taken by the sender on behalf of this
+   *  reader is released when the returned arena is collected.
+   *
+   *  @param handle the handle to the arena
+   *
+   *  @return the mapped arena. Check if it is ready before use.
+   */
+  static std::shared_ptr<SharedMemoryArena> Receive(
+      SharedMemory::Handle handle);
+
+  /**
+   *  @return if the arena is mapped and its header is consistent
+   */
+  bool isReady() const;
+
+  /**
+   *  @return the address of the payload
+   */
+  uint8_t* data() const;
+
+  /**
+   *  @return the maximum length of the payload
+   */
+  size_t capacity() const;
+
+  /**
+   *  @return the length of the payload as set by the writer of the arena
+   */
+  size_t length() const;
+
+  /**
+   *  Update the length of the payload. Must not exceed the capacity.
+   */
+  void setLength(size_t length);
+
+  /**
+   *  @return the handle that may be sent to other processes. Arenas mapped
+   *          from a received handle no longer have one.
+   */
+  SharedMemory::Handle handle() const;
+
+  /**
+   *  Take the first reference to an arena that has no references.
+   *
+   *  @return if the reference was taken. Fails if the arena is still in use.
+   */
+  RL_WARN_UNUSED_RESULT
+  bool acquire();
+
+  /**
+   *  Take an additional reference to the arena. Usually on behalf of a reader
+   *  the arena is about to be sent to.
+   */
+  void retain();
+
+  /**
+   *  Drop a reference to the arena.
+   */
+  void release();
+
+ private:
+  struct Header;
+
+  SharedMemory _memory;
+  Header* _header;
+  size_t _capacity;
+
+  SharedMemoryArena(SharedMemory::Handle handle, bool assumeOwnership);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SharedMemoryArena);
+};
+
+}  // namespace core
+}  // namespace rl
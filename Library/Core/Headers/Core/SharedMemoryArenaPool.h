@@ -0,0 +1,90 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Core/SharedMemoryArena.h>
+#include <atomic>
+#include <list>
+#include <memory>
+
+namespace rl {
+namespace core {
+
+/**
+ *  A pool of shared memory arenas that are recycled once all their readers are
+ *  done with them. This saves the creation, mapping and unmapping of a fresh
+ *  region for each large message sent over a channel.
+ */
+class SharedMemoryArenaPool {
+ public:
+  /**
+   *  Create a pool of shared memory arenas
+   *
+   *  @param leaseThreshold payloads no larger than this are cheaper to copy
+   *                        than to transfer in an arena
+   *  @param maxPooledBytes the total capacity of the arenas kept around for
+   *                        reuse
+   */
+  SharedMemoryArenaPool(size_t leaseThreshold,
+                        size_t maxPooledBytes = 16 * 1024 * 1024);
+
+  ~SharedMemoryArenaPool();
+
+  /**
+   *  Lease an arena that can hold a payload of at least the given size. The
+   *  arena is returned to the pool once the lease and all references taken
+   *  on behalf of readers are released.
+   *
+   *  @param size the minimum capacity of the arena
+   *
+   *  @return the arena or `nullptr` if one could not be created
+   */
+  std::shared_ptr<SharedMemoryArena> lease(size_t size);
+
+  /**
+   *  @return the payload size past which messages are worth moving into an
+   *          arena
+   */
+  size_t leaseThreshold() const;
+
+  /**
+   *  @return the number of leases serviced by a recycled arena
+   */
+  size_t hits() const;
+
+  /**
+   *  @return the number of leases that needed a new arena
+   */
+  size_t misses() const;
+
+  /**
+   *  @return the total capacity of the arenas currently held by the pool
+   */
+  size_t pooledBytes() const;
+
+ private:
+  const size_t _leaseThreshold;
+  const size_t _maxPooledBytes;
+  mutable Mutex _arenasMutex;
+  /*
+   *  Ordered from the least to the most recently leased.
+   */
+  std::list<std::shared_ptr<SharedMemoryArena>> _arenas
+      RL_GUARDED_BY(_arenasMutex);
+  size_t _pooledBytes RL_GUARDED_BY(_arenasMutex);
+  std::atomic_size_t _hits;
+  std::atomic_size_t _misses;
+
+  std::shared_ptr<SharedMemoryArena> acquirePooledArena(size_t capacity);
+  void addPooledArena(std::shared_ptr<SharedMemoryArena> arena);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SharedMemoryArenaPool);
+};
+
+}  // namespace core
+}  // namespace rl
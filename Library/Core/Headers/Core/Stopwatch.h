@@ -27,6 +27,14 @@ class Stopwatch {
 
   void stop();
 
+  /**
+   *  Record a lap whose duration was measured elsewhere. Useful when the lap is
+   *  the sum of a number of disjoint intervals.
+   *
+   *  @param duration the duration of the lap
+   */
+  void recordLap(core::ClockDuration duration);
+
  private:
   std::vector<core::ClockDuration> _laps;
   size_t _currentLapIndex;
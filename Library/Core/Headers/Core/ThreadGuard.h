@@ -27,6 +27,12 @@ class ThreadGuard {
 
   bool isThreadValid() const { return std::this_thread::get_id() == _threadID; }
 
+  /**
+   *  Guard the current thread instead. Used when an object created on one
+   *  thread is handed off to another that owns it from then on.
+   */
+  void rebind() { _threadID = std::this_thread::get_id(); }
+
  private:
   std::thread::id _threadID;
 
@@ -7,6 +7,7 @@
 
 #include <Core/EventLoopSource.h>
 #include <Core/Macros.h>
+#include <array>
 #include <unordered_set>
 
 namespace rl {
@@ -55,12 +56,20 @@ class WaitSet {
   bool removeSource(std::shared_ptr<EventLoopSource> source);
 
   /**
-   *  Waits for events to be signalled on the waitset
+   *  Waits for events to be signalled on the waitset. Each wait on the
+   *  platform harvests as many signalled sources as are available (up to a
+   *  limit). Harvested events are handed out one by one without waiting again
+   *  before the platform is consulted for more.
    *
    *  @return the result of the wait
    */
   Result wait(ClockDurationNano timeout);
 
+  /**
+   *  @return the number of harvested events not yet handed out by `wait`
+   */
+  size_t harvestedCount() const;
+
   Handle handle() const;
 
   WaitSetProvider& provider() const;
@@ -68,9 +77,19 @@ class WaitSet {
  private:
   using EventLoopSourceRef = std::shared_ptr<EventLoopSource>;
 
+  static const size_t kMaxHarvestedEvents = 64;
+
   std::unique_ptr<WaitSetProvider> _provider;
-  Mutex _sourcesMutex;
+  mutable Mutex _sourcesMutex;
   std::unordered_set<EventLoopSourceRef> _sources RL_GUARDED_BY(_sourcesMutex);
+  std::array<Result, kMaxHarvestedEvents> _harvested
+      RL_GUARDED_BY(_sourcesMutex);
+  size_t _harvestedHead RL_GUARDED_BY(_sourcesMutex);
+  size_t _harvestedCount RL_GUARDED_BY(_sourcesMutex);
+  std::array<Result, kMaxHarvestedEvents> _harvesting;
+
+  bool nextHarvested(Result& result);
+  void discardHarvested(EventLoopSource* source);
 
   RL_DISALLOW_COPY_AND_ASSIGN(WaitSet);
 };
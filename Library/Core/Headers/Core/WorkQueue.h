@@ -8,6 +8,8 @@
 #include <Core/EventLoop.h>
 #include <Core/EventLoopThread.h>
 #include <Core/Latch.h>
+#include <deque>
+#include <vector>
 
 namespace rl {
 namespace core {
@@ -16,23 +18,86 @@ class WorkQueue {
  public:
   using WorkItem = std::function<void(void)>;
 
+  enum class Mode {
+    /**
+     *  All workers service a single queue guarded by a mutex.
+     */
+    Shared,
+    /**
+     *  Each worker owns a lock-free deque and steals from its peers when it
+     *  runs out of work. Items dispatched from threads outside the pool go
+     *  through a global injection queue. Items still pending when the queue
+     *  is collected are performed on the collecting thread.
+     */
+    WorkStealing,
+  };
+
   WorkQueue();
 
+  /**
+   *  Create a work queue with the specified mode and number of workers.
+   *
+   *  @param mode     the strategy used to hand work items to workers
+   *  @param poolSize the number of worker threads. If zero, a default derived
+   *                  from the hardware concurrency is used.
+   */
+  WorkQueue(Mode mode, size_t poolSize = 0);
+
   ~WorkQueue();
 
   RL_WARN_UNUSED_RESULT
   bool dispatch(WorkItem work);
 
+  /**
+   *  Dispatch a range of work items with a single wakeup of the workers.
+   *
+   *  @param first the iterator to the first work item
+   *  @param last  the iterator past the last work item
+   *
+   *  @return if all the work items in the range were dispatched
+   */
+  template <class Iterator>
+  RL_WARN_UNUSED_RESULT bool dispatch(Iterator first, Iterator last) {
+    std::vector<WorkItem> items;
+    for (auto i = first; i != last; ++i) {
+      if (*i == nullptr) {
+        return false;
+      }
+      items.emplace_back(*i);
+    }
+    return dispatchItems(items);
+  }
+
+  Mode mode() const;
+
   size_t workerCount() const;
 
  private:
+  struct Worker;
+
+  const Mode _mode;
   std::shared_ptr<EventLoopSource> _workSource;
+  std::vector<std::unique_ptr<Worker>> _stealingWorkers;
   std::vector<std::unique_ptr<EventLoopThread>> _workers;
   Mutex _workItemsMutex;
   std::list<WorkItem> _workItems RL_GUARDED_BY(_workItemsMutex);
+  std::deque<WorkItem> _injectedItems RL_GUARDED_BY(_workItemsMutex);
+  std::atomic_size_t _pendingItems;
+  std::atomic_size_t _sleepingWorkers;
+
+  void setupSharedWorkers(size_t poolSize);
+  void setupStealingWorkers(size_t poolSize);
+  bool dispatchItems(std::vector<WorkItem>& items);
 
   void work();
   WorkItem acquireWork();
+  void enqueueSharedWork(WorkItem* items, size_t count);
+
+  void workStealing(Worker& worker);
+  WorkItem acquireStealingWork(Worker& worker);
+  void enqueueStealingWork(WorkItem* items, size_t count);
+  void wakeSleepingWorkers(size_t count);
+  void flushStealingWork();
 
   RL_DISALLOW_COPY_AND_ASSIGN(WorkQueue);
 };
@@ -76,6 +76,17 @@ IOResult Channel::sendMessages(Messages messages, ClockDurationNano timeout) {
   return IOResult::Failure;
 }
 
+Message Channel::createMessage() const {
+  if (auto pool = _provider->arenaPool()) {
+    return Message(std::move(pool));
+  }
+  return Message();
+}
+
+std::shared_ptr<SharedMemoryArenaPool> Channel::arenaPool() const {
+  return _provider->arenaPool();
+}
+
 const Channel::MessageCallback& Channel::messageCallback() const {
   return _messageCallback;
 }
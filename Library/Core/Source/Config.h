@@ -115,6 +115,19 @@
 
 #endif  // !defined(RL_SHMEM)
 
+/*
+ *  Detect batched socket writes by Platform
+ */
+#if !defined(RL_SOCKET_SENDMMSG)
+
+#if RL_OS_LINUX
+#define RL_SOCKET_SENDMMSG 1
+#else
+#define RL_SOCKET_SENDMMSG 0
+#endif
+
+#endif  // !defined(RL_SOCKET_SENDMMSG)
+
 /*
  *  In case selection by platform ends up will all in process variants (instead
  *  of the the other way around by setting RL_DISABLE_XPC), set that flag
@@ -34,6 +34,20 @@ void SharedMemory::cleanup() {
   RL_ASSERT(false);
 }
 
+void SharedMemory::closeHandle() {
+  RL_ASSERT(false);
+}
+
+bool SharedMemory::seal() {
+  RL_ASSERT(false);
+  return false;
+}
+
+SharedMemory::Handle SharedMemory::takeHandle() {
+  RL_ASSERT(false);
+  return -1;
+}
+
 SharedMemory::~SharedMemory() {
   cleanup();
 }
@@ -46,7 +46,9 @@ static inline void EPollInvoke(int eventsMask,
 
 void EventLoopSource::updateInWaitSetForSimpleRead(WaitSet& waitset,
                                                    bool shouldAdd) {
-  EPollInvoke(EPOLLIN,                                    // events mask
+  const int eventsMask = EPOLLIN | (isEdgeTriggered() ? EPOLLET : 0);
+
+  EPollInvoke(eventsMask,                                 // events mask
               this,                                       // data
               HANDLE_CAST(waitset.handle()),              // epoll descriptor
               shouldAdd ? EPOLL_CTL_ADD : EPOLL_CTL_DEL,  // operation
@@ -10,6 +10,7 @@
 #include <Core/Utilities.h>
 #include <sys/epoll.h>
 #include <unistd.h>
+#include <algorithm>
 #include "EPollWaitSet.h"
 
 namespace rl {
@@ -24,40 +25,58 @@ EPollWaitSet::~EPollWaitSet() {
   RL_CHECK(::close(_handle));
 }
 
+/*
+ *  The maximum number of events collected by a single call to `epoll_wait`.
+ */
+static const size_t kMaxEPollEvents = 64;
+
 WaitSet::Result EPollWaitSet::wait(ClockDurationNano timeout) {
-  struct epoll_event event = {};
+  WaitSet::Result result(WaitSet::WakeReason::Timeout, nullptr);
+  harvest(timeout, &result, 1);
+  return result;
+}
+
+size_t EPollWaitSet::harvest(ClockDurationNano timeout,
+                             WaitSet::Result* results,
+                             size_t capacity) {
+  RL_ASSERT(capacity > 0);
+
+  struct epoll_event events[kMaxEPollEvents];
 
   int val = RL_TEMP_FAILURE_RETRY(
-      ::epoll_wait(_handle, &event, 1, ToUnixTimeoutMS(timeout)));
+      ::epoll_wait(_handle, events,
+                   static_cast<int>(std::min(capacity, kMaxEPollEvents)),
+                   ToUnixTimeoutMS(timeout)));
 
   RL_ASSERT(val != -1);
 
-  switch (val) {
-    case 0:
-      /*
-       *  A zero return from an epoll_wait indicates the expiry of a timeout.
-       */
-      return WaitSet::Result(WaitSet::WakeReason::Timeout, nullptr);
-    case 1: {
+  if (val < 0) {
+    results[0] = WaitSet::Result(WaitSet::WakeReason::Error, nullptr);
+    return 1;
+  }
+
+  /*
+   *  A zero return from an epoll_wait indicates the expiry of a timeout.
+   */
+  for (int i = 0; i < val; i++) {
+    const auto& event = events[i];
+
+    /*
+     *  Check if the indicated item woke up because of a read or error.
+     */
+    auto reason = WaitSet::WakeReason::ReadAvailable;
+    if (event.events & (EPOLLERR | EPOLLHUP)) {
       /*
-       *  The only indicated item woke up. Check if it was because of a read or
-       *  error.
+       *  In case of error or hangups, the source has awoken for termination.
        */
-      auto result = WaitSet::WakeReason::ReadAvailable;
-      if (event.events & (EPOLLERR | EPOLLHUP)) {
-        /*
-         *  In case of error or hangups, the source has awoken for termination.
-         */
-        result = WaitSet::WakeReason::Error;
-      }
-      return WaitSet::Result(result,
-                             static_cast<EventLoopSource*>(event.data.ptr));
+      reason = WaitSet::WakeReason::Error;
     }
-    default:
-      break;
+
+    results[i] =
+        WaitSet::Result(reason, static_cast<EventLoopSource*>(event.data.ptr));
   }
 
-  return WaitSet::Result(WaitSet::WakeReason::Error, nullptr);
+  return val;
 }
 
 WaitSet::Handle EPollWaitSet::handle() const {
@@ -23,6 +23,10 @@ class EPollWaitSet : public WaitSetProvider {
 
   WaitSet::Result wait(ClockDurationNano timeout) override;
 
+  size_t harvest(ClockDurationNano timeout,
+                 WaitSet::Result* results,
+                 size_t capacity) override;
+
   WaitSet::Handle handle() const override;
 
  private:
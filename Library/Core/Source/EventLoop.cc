@@ -65,7 +65,10 @@ void EventLoop::loop(std::function<void(void)> onReady) {
        */
 
       /*
-       *  Sleep indefinitely the first time around
+       *  Sleep indefinitely the first time around. The wait set harvests all
+       *  sources signalled at the time of the wake in one go. Subsequent
+       *  zero timeout waits hand those out without going back to the
+       *  platform till all of them have been dispatched.
        */
       EventLoopSource* source = _waitSet.wait(timeout).second;
 
@@ -24,10 +24,13 @@ EventLoopSource::EventLoopSource(RWHandlesProvider handleProvider,
       _readHandler(readHandler),
       _writeHandler(writeHandler),
       _customWaitSetUpdateHandler(waitsetUpdateHandler),
-      _handlesAllocated(false) {}
+      _handlesAllocated(false),
+      _edgeTriggered(false) {}
 
 EventLoopSource::EventLoopSource()
-    : _handles(Handles(-1, -1)), _handlesAllocated(false) {}
+    : _handles(Handles(-1, -1)),
+      _handlesAllocated(false),
+      _edgeTriggered(false) {}
 
 EventLoopSource::~EventLoopSource() {
   if (_handlesAllocated && _handlesCollector) {
@@ -103,6 +106,14 @@ void EventLoopSource::setCustomWaitSetUpdateHandler(
   _customWaitSetUpdateHandler = updateHandler;
 }
 
+void EventLoopSource::setEdgeTriggered(bool edgeTriggered) {
+  _edgeTriggered = edgeTriggered;
+}
+
+bool EventLoopSource::isEdgeTriggered() const {
+  return _edgeTriggered;
+}
+
 void EventLoopSource::attemptRead() {
   RL_TRACE_AUTO("EventLoopSource::AttemptRead");
 
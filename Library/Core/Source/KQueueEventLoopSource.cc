@@ -34,13 +34,15 @@ static inline void KEventInvoke(int queue,
 
 void EventLoopSource::updateInWaitSetForSimpleRead(WaitSet& waitset,
                                                    bool shouldAdd) {
-  KEventInvoke(HANDLE_CAST(waitset.handle()),  /* queue */
-               handles().readHandle,           /* ident */
-               EVFILT_READ,                    /* filter */
-               shouldAdd ? EV_ADD : EV_DELETE, /* flags */
-               0,                              /* filter-flags */
-               0,                              /* data */
-               this);                          /* user-data */
+  const uint16_t addFlags = EV_ADD | (isEdgeTriggered() ? EV_CLEAR : 0);
+
+  KEventInvoke(HANDLE_CAST(waitset.handle()),    /* queue */
+               handles().readHandle,             /* ident */
+               EVFILT_READ,                      /* filter */
+               shouldAdd ? addFlags : EV_DELETE, /* flags */
+               0,                                /* filter-flags */
+               0,                                /* data */
+               this);                            /* user-data */
 }
 
 std::shared_ptr<EventLoopSource> EventLoopSource::Timer(
@@ -16,6 +16,7 @@
 #endif
 
 #include <Core/Message.h>
+#include <Core/SharedMemoryArenaPool.h>
 #include <Core/Utilities.h>
 #include <stdlib.h>
 #include <string>
@@ -48,8 +49,27 @@ Message::Message(uint8_t* buffer, size_t bufferLength, bool vmAllocated)
       _attachmentsRead(0),
       _vmAllocated(vmAllocated) {}
 
+Message::Message(std::shared_ptr<SharedMemoryArenaPool> pool)
+    : Message(nullptr, 0, false) {
+  _arenaPool = std::move(pool);
+}
+
+Message::Message(std::shared_ptr<SharedMemoryArena> arena, size_t length)
+    : Message(nullptr, 0, false) {
+  if (arena == nullptr || !arena->isReady() || length > arena->capacity()) {
+    return;
+  }
+
+  _arena = std::move(arena);
+  _buffer = _arena->data();
+  _bufferLength = length;
+  _dataLength = length;
+}
+
 Message::Message(Message&& message)
     : _buffer(message._buffer),
+      _arena(std::move(message._arena)),
+      _arenaPool(std::move(message._arenaPool)),
       _attachments(std::move(message._attachments)),
       _rawAttachments(std::move(message._rawAttachments)),
       _bufferLength(message._bufferLength),
@@ -61,7 +81,10 @@ Message::Message(Message&& message)
 }
 
 Message::~Message() {
-  if (_buffer == nullptr) {
+  if (_buffer == nullptr || _arena != nullptr) {
+    /*
+     *  Arenas are released along with the reference to them.
+     */
     return;
   }
 
@@ -93,6 +116,17 @@ bool Message::reserve(size_t length) {
 }
 
 bool Message::resizeBuffer(size_t size) {
+  if (_arenaPool != nullptr && size > _arenaPool->leaseThreshold()) {
+    return resizeArena(size);
+  }
+
+  if (_arena != nullptr) {
+    /*
+     *  Messages received in an arena cannot grow.
+     */
+    return false;
+  }
+
   if (_buffer == nullptr) {
     RL_ASSERT(_bufferLength == 0);
 
@@ -122,6 +156,32 @@ bool Message::resizeBuffer(size_t size) {
   return success;
 }
 
+bool Message::resizeArena(size_t size) {
+  auto arena = _arenaPool->lease(size);
+
+  if (arena == nullptr) {
+    return false;
+  }
+
+  /*
+   *  Move whatever has already been encoded into the new arena. The previous
+   *  arena (if any) goes back to the pool.
+   */
+  if (_dataLength > 0) {
+    memcpy(arena->data(), _buffer, _dataLength);
+  }
+
+  if (_arena == nullptr) {
+    free(_buffer);
+  }
+
+  _arena = std::move(arena);
+  _buffer = _arena->data();
+  _bufferLength = _arena->capacity();
+
+  return true;
+}
+
 bool Message::encode(const MessageSerializable& value) {
   return value.serialize(*this);
 }
@@ -257,6 +317,10 @@ uint8_t* Message::operator[](size_t index) {
   return _buffer + index;
 }
 
+const std::shared_ptr<SharedMemoryArena>& Message::arena() const {
+  return _arena;
+}
+
 uint8_t* Message::data() const {
   return _buffer;
 }
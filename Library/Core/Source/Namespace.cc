@@ -80,6 +80,14 @@ bool Name::isDead() const {
   return _handle == nullptr;
 }
 
+Name::Handle Name::counterpart() const {
+  if (_handle == nullptr || _ns == nullptr) {
+    return DeadHandle;
+  }
+
+  return _ns->counterpart(*_handle);
+}
+
 size_t Name::hash() const {
   return std::hash<HandleRef>()(_handle);
 }
@@ -170,6 +178,13 @@ void Namespace::destroy(Name::Handle local) {
   _localToCounterpartMap.erase(mappingFound);
 }
 
+Name::Handle Namespace::counterpart(Name::Handle local) const {
+  MutexLocker lock(_mapsMutex);
+
+  auto found = _localToCounterpartMap.find(local);
+  return found == _localToCounterpartMap.end() ? DeadHandle : found->second;
+}
+
 size_t Namespace::mappedNamesCount() const {
   MutexLocker lock(_mapsMutex);
   return _localToCounterpartMap.size();
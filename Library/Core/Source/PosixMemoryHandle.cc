@@ -31,7 +31,19 @@ static std::string SharedMemory_RandomFileName() {
   return stream.str();
 }
 
-SharedMemory::Handle SharedMemoryHandleCreate(size_t size) {
+/*
+ *  Anonymous memory files need no name and may be sealed once their contents
+ *  are written. Named POSIX shared memory is used where they are unavailable.
+ */
+static SharedMemory::Handle SharedMemory_CreateMemoryFile() {
+#if defined(MFD_ALLOW_SEALING)
+  return ::memfd_create("rl_SharedMemory", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+  return -1;
+#endif
+}
+
+static SharedMemory::Handle SharedMemory_CreateNamed() {
   SharedMemory::Handle newHandle = -1;
 
   auto tempFile = SharedMemory_RandomFileName();
@@ -62,6 +74,20 @@ SharedMemory::Handle SharedMemoryHandleCreate(size_t size) {
     RL_CHECK(::shm_unlink(tempFile.c_str()));
   }
 
+  return newHandle;
+}
+
+SharedMemory::Handle SharedMemoryHandleCreate(size_t size) {
+  SharedMemory::Handle newHandle = SharedMemory_CreateMemoryFile();
+
+  if (newHandle == -1) {
+    newHandle = SharedMemory_CreateNamed();
+  }
+
+  if (newHandle == -1) {
+    return -1;
+  }
+
 /*
  *  Set the size of the shared memory
  */
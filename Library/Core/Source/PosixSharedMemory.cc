@@ -14,6 +14,7 @@
 
 #include <Core/SharedMemory.h>
 #include <Core/Utilities.h>
+#include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -117,15 +118,68 @@ void SharedMemory::cleanup() {
 
   if (_assumeOwnership) {
     RL_CHECK(::munmap(_address, _size));
-    RL_CHECK(::close(_handle));
   }
 
-  _handle = -1;
+  closeHandle();
+
   _size = 0;
   _address = nullptr;
   _ready = false;
 }
 
+void SharedMemory::closeHandle() {
+  if (_handle == -1) {
+    return;
+  }
+
+  if (_assumeOwnership) {
+    RL_CHECK(::close(_handle));
+  }
+
+  _handle = -1;
+}
+
+bool SharedMemory::seal() {
+  if (!_ready || _handle == -1) {
+    return false;
+  }
+
+  /*
+   *  Writes may only be sealed once there are no shared mappings of the memory
+   *  left that could be made writable. Drop the writable mapping before
+   *  sealing and map the memory again read-only after.
+   */
+  RL_CHECK(::munmap(_address, _size));
+  _address = nullptr;
+
+#if defined(F_ADD_SEALS)
+  const int seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+  const auto sealed = ::fcntl(_handle, F_ADD_SEALS, seals) == 0;
+#else
+  const auto sealed = false;
+#endif
+
+  auto readOnly = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, _handle, 0);
+
+  if (readOnly == MAP_FAILED) {
+    RL_LOG_ERRNO();
+    closeHandle();
+    _size = 0;
+    _ready = false;
+    return false;
+  }
+
+  _address = static_cast<uint8_t*>(readOnly);
+
+  return sealed;
+}
+
+SharedMemory::Handle SharedMemory::takeHandle() {
+  auto handle = _handle;
+  _handle = -1;
+  return handle;
+}
+
 SharedMemory::~SharedMemory() {
   cleanup();
 }
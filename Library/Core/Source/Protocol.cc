@@ -122,11 +122,15 @@ void Protocol::sendRequest(Response response) {
     return response(IOResult::Failure, Message{});
   }
 
-  if (!populateRequestPayload(message)) {
+  /*
+   *  The reply channel is always the first attachment so that the payload
+   *  may contain attachments of its own.
+   */
+  if (!message.encode(_channel->attachment())) {
     return response(IOResult::Failure, Message{});
   }
 
-  if (!message.encode(_channel->attachment())) {
+  if (!populateRequestPayload(message)) {
     return response(IOResult::Failure, Message{});
   }
 
@@ -0,0 +1,146 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/SharedMemoryArena.h>
+#include <atomic>
+#include <new>
+
+namespace rl {
+namespace core {
+
+/*
+ *  The header lives in memory shared between processes. So the atomics in it
+ *  must not fall back to locks private to each process.
+ */
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "Arena references must be lock free across processes");
+
+struct SharedMemoryArena::Header {
+  std::atomic<uint32_t> references;
+  uint32_t reserved;
+  uint64_t length;
+};
+
+/*
+ *  Keep the payload aligned to a cache line.
+ */
+static const size_t kArenaHeaderSize = 64;
+
+SharedMemoryArena::SharedMemoryArena(size_t capacity)
+    : _memory(capacity + kArenaHeaderSize),
+      _header(nullptr),
+      _capacity(0) {
+  static_assert(sizeof(Header) <= kArenaHeaderSize,
+                "The arena header must fit in its reserved space");
+
+  if (!_memory.isReady()) {
+    return;
+  }
+
+  _header = new (_memory.address()) Header();
+  _header->references = 0;
+  _header->reserved = 0;
+  _header->length = 0;
+  _capacity = capacity;
+}
+
+std::shared_ptr<SharedMemoryArena> SharedMemoryArena::Receive(
+    SharedMemory::Handle handle) {
+  return std::shared_ptr<SharedMemoryArena>(
+      new SharedMemoryArena(handle, true), [](SharedMemoryArena* arena) {
+        arena->release();
+        delete arena;
+      });
+}
+
+SharedMemoryArena::SharedMemoryArena(SharedMemory::Handle handle,
+                                     bool assumeOwnership)
+    : _memory(handle, assumeOwnership),
+      _header(nullptr),
+      _capacity(0) {
+  /*
+   *  The mapping is all that is needed from here on.
+   */
+  _memory.closeHandle();
+
+  if (!_memory.isReady() || _memory.size() < kArenaHeaderSize) {
+    return;
+  }
+
+  auto header = reinterpret_cast<Header*>(_memory.address());
+  auto capacity = _memory.size() - kArenaHeaderSize;
+
+  if (header->length > capacity) {
+    /*
+     *  The sender claims a payload larger than the arena itself. Don't trust
+     *  any of it.
+     */
+    return;
+  }
+
+  _header = header;
+  _capacity = capacity;
+}
+
+SharedMemoryArena::~SharedMemoryArena() = default;
+
+bool SharedMemoryArena::isReady() const {
+  return _header != nullptr;
+}
+
+uint8_t* SharedMemoryArena::data() const {
+  return _header == nullptr ? nullptr : _memory.address() + kArenaHeaderSize;
+}
+
+size_t SharedMemoryArena::capacity() const {
+  return _capacity;
+}
+
+size_t SharedMemoryArena::length() const {
+  return _header == nullptr ? 0 : static_cast<size_t>(_header->length);
+}
+
+void SharedMemoryArena::setLength(size_t length) {
+  RL_ASSERT(_header != nullptr && length <= _capacity);
+  _header->length = length;
+}
+
+SharedMemory::Handle SharedMemoryArena::handle() const {
+  return _memory.handle();
+}
+
+bool SharedMemoryArena::acquire() {
+  if (_header == nullptr) {
+    return false;
+  }
+
+  uint32_t expected = 0;
+  return _header->references.compare_exchange_strong(
+      expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void SharedMemoryArena::retain() {
+  RL_ASSERT(_header != nullptr);
+  _header->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedMemoryArena::release() {
+  if (_header == nullptr) {
+    return;
+  }
+
+  /*
+   *  The other side of the arena may be misbehaving. Never wrap around.
+   */
+  auto references = _header->references.load(std::memory_order_relaxed);
+  while (references > 0 &&
+         !_header->references.compare_exchange_weak(
+             references, references - 1, std::memory_order_release,
+             std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace core
+}  // namespace rl
@@ -0,0 +1,151 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/SharedMemoryArenaPool.h>
+#include <Core/Utilities.h>
+#include <algorithm>
+#include <limits>
+
+namespace rl {
+namespace core {
+
+/*
+ *  Arenas are only handed out for leases that would not waste more than this
+ *  factor of their capacity.
+ */
+static const size_t kMaxArenaCapacityWaste = 4;
+
+static size_t ArenaCapacityForSize(size_t size, size_t leaseThreshold) {
+  size = std::max(size, leaseThreshold);
+
+  if (size > std::numeric_limits<uint32_t>::max() / 2) {
+    return size;
+  }
+
+  return NextPowerOfTwoSize(static_cast<uint32_t>(size));
+}
+
+/**
+ *  Wrap a reference to the arena in one that releases the leased reference
+ *  once the lease is collected.
+ */
+static std::shared_ptr<SharedMemoryArena> ArenaLease(
+    std::shared_ptr<SharedMemoryArena> arena) {
+  auto leased = arena.get();
+  return std::shared_ptr<SharedMemoryArena>(
+      leased, [arena](SharedMemoryArena*) { arena->release(); });
+}
+
+SharedMemoryArenaPool::SharedMemoryArenaPool(size_t leaseThreshold,
+                                             size_t maxPooledBytes)
+    : _leaseThreshold(leaseThreshold),
+      _maxPooledBytes(maxPooledBytes),
+      _pooledBytes(0),
+      _hits(0),
+      _misses(0) {}
+
+SharedMemoryArenaPool::~SharedMemoryArenaPool() = default;
+
+std::shared_ptr<SharedMemoryArena> SharedMemoryArenaPool::lease(size_t size) {
+  const auto capacity = ArenaCapacityForSize(size, _leaseThreshold);
+
+  if (auto arena = acquirePooledArena(capacity)) {
+    _hits++;
+    return ArenaLease(std::move(arena));
+  }
+
+  _misses++;
+
+  auto arena = std::make_shared<SharedMemoryArena>(capacity);
+
+  if (!arena->isReady() || !arena->acquire()) {
+    return nullptr;
+  }
+
+  addPooledArena(arena);
+
+  return ArenaLease(std::move(arena));
+}
+
+std::shared_ptr<SharedMemoryArena> SharedMemoryArenaPool::acquirePooledArena(
+    size_t capacity) {
+  MutexLocker lock(_arenasMutex);
+
+  for (auto i = _arenas.begin(), end = _arenas.end(); i != end; ++i) {
+    auto available = (*i)->capacity();
+    if (available < capacity ||
+        available > capacity * kMaxArenaCapacityWaste) {
+      continue;
+    }
+
+    /*
+     *  Readers in other processes may still hold references to the arena.
+     */
+    if (!(*i)->acquire()) {
+      continue;
+    }
+
+    auto arena = *i;
+    _arenas.splice(_arenas.end(), _arenas, i);
+    return arena;
+  }
+
+  return nullptr;
+}
+
+void SharedMemoryArenaPool::addPooledArena(
+    std::shared_ptr<SharedMemoryArena> arena) {
+  const auto capacity = arena->capacity();
+
+  if (capacity > _maxPooledBytes) {
+    /*
+     *  This arena will be used just the once.
+     */
+    return;
+  }
+
+  MutexLocker lock(_arenasMutex);
+
+  /*
+   *  Evict the least recently leased arenas that are no longer in use till
+   *  the new arena fits.
+   */
+  for (auto i = _arenas.begin();
+       i != _arenas.end() && _pooledBytes + capacity > _maxPooledBytes;) {
+    if ((*i)->acquire()) {
+      _pooledBytes -= (*i)->capacity();
+      i = _arenas.erase(i);
+    } else {
+      ++i;
+    }
+  }
+
+  if (_pooledBytes + capacity > _maxPooledBytes) {
+    return;
+  }
+
+  _pooledBytes += capacity;
+  _arenas.emplace_back(std::move(arena));
+}
+
+size_t SharedMemoryArenaPool::leaseThreshold() const {
+  return _leaseThreshold;
+}
+
+size_t SharedMemoryArenaPool::hits() const {
+  return _hits;
+}
+
+size_t SharedMemoryArenaPool::misses() const {
+  return _misses;
+}
+
+size_t SharedMemoryArenaPool::pooledBytes() const {
+  MutexLocker lock(_arenasMutex);
+  return _pooledBytes;
+}
+
+}  // namespace core
+}  // namespace rl
@@ -8,7 +8,8 @@
 #if RL_CHANNELS == RL_CHANNELS_SOCKET
 
 #include <Core/Message.h>
-#include <Core/SharedMemory.h>
+#include <Core/SharedMemoryArenaPool.h>
+#include <Core/Timing.h>
 #include <Core/Utilities.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -30,6 +31,7 @@ static const size_t kMaxInlineBufferSize = 4096;
 static const size_t kMaxControlBufferItemCount = 24;
 static const size_t kMaxControlBufferSize =
     CMSG_SPACE(sizeof(SocketPair::Handle) * kMaxControlBufferItemCount);
+static const size_t kMaxWriteBatchCount = 64;
 
 /**
  *  This header is always the first item present in the scatter gather array
@@ -46,6 +48,11 @@ class SocketPayloadHeader {
 
   bool isDataInline() const { return _isDataInline; }
 
+  void update(bool isDataInline, uint8_t oolDescriptors) {
+    _oolDescriptors = oolDescriptors;
+    _isDataInline = isDataInline;
+  }
+
  private:
   uint8_t _oolDescriptors;
   bool _isDataInline;
@@ -56,9 +63,71 @@ class SocketPayloadHeader {
 static_assert(rl_trivially_copyable(SocketPayloadHeader),
               "The socket payload must be trivially copyable");
 
+/**
+ *  The scatter gather arrays and control buffers for a batch of messages that
+ *  go out in as few syscalls as possible. The batch is allocated once per
+ *  channel and reused for all writes.
+ */
+class SocketWriteBatch {
+ public:
+  SocketWriteBatch();
+
+  bool isReady() const;
+
+  /**
+   *  Prepare the entry at the given index in the batch for the message. The
+   *  message must outlive the call to `send`.
+   */
+  IOResult prepare(size_t index,
+                   const Message& message,
+                   SharedMemoryArenaPool& pool);
+
+  /**
+   *  Send the first `count` prepared entries in the batch.
+   *
+   *  @param sent the number of entries that were completely sent
+   */
+  IOResult send(SocketPair::Handle writer,
+                size_t count,
+                const SocketWriteDeadline& deadline,
+                size_t& sent);
+
+  /**
+   *  Release the resources held by the first `count` entries. Only the first
+   *  `sent` of those made it to the reader.
+   */
+  void reset(size_t count, size_t sent);
+
+ private:
+  struct Entry {
+    SocketPayloadHeader header;
+    struct iovec vec[2];
+    size_t expectedSendSize;
+    std::shared_ptr<SharedMemoryArena> oolMemoryArena;
+
+    Entry() : vec(), expectedSendSize(0) {}
+  };
+
+  std::vector<Entry> _entries;
+#if RL_SOCKET_SENDMMSG
+  struct mmsghdr _headers[kMaxWriteBatchCount];
+#else
+  struct msghdr _headers[kMaxWriteBatchCount];
+#endif
+  Allocation _controlBuffers;
+  bool _ready;
+
+  struct msghdr& messageHeader(size_t index);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SocketWriteBatch);
+};
+
 SocketChannel::SocketChannel(Channel& channel)
     : _channel(channel),
-      _pair(std::make_shared<SocketPair>(kMaxInlineBufferSize)) {
+      _pair(std::make_shared<SocketPair>(kMaxInlineBufferSize)),
+      _writeBatch(std::make_unique<SocketWriteBatch>()),
+      _arenaPool(
+          std::make_shared<SharedMemoryArenaPool>(kMaxInlineBufferSize)) {
   bool success = setup();
   RL_ASSERT(success);
 }
@@ -66,7 +135,10 @@ SocketChannel::SocketChannel(Channel& channel)
 SocketChannel::SocketChannel(Channel& channel, RawAttachment attachment)
     : _channel(channel),
       _pair(std::make_shared<SocketPair>(std::move(attachment),
-                                         kMaxInlineBufferSize)) {
+                                         kMaxInlineBufferSize)),
+      _writeBatch(std::make_unique<SocketWriteBatch>()),
+      _arenaPool(
+          std::make_shared<SharedMemoryArenaPool>(kMaxInlineBufferSize)) {
   bool success = setup();
   RL_ASSERT(success);
 }
@@ -86,10 +158,6 @@ std::shared_ptr<EventLoopSource> SocketChannel::createSource() const {
     return EventLoopSource::Handles(_pair->readHandle(), _pair->writeHandle());
   };
 
-  EventLoopSource::IOHandler readHandler = [this](EventLoopSource::Handle) {
-    return _channel.readPendingMessageNow();
-  };
-
   /*
    *  We are specifying a null write handler since we will
    *  never directly signal this source. Instead, we will write
@@ -98,8 +166,37 @@ std::shared_ptr<EventLoopSource> SocketChannel::createSource() const {
    *  The channel owns the socket handle, so there is no deallocation
    *  callback either.
    */
-  return std::make_shared<EventLoopSource>(provider, nullptr, readHandler,
-                                           nullptr, nullptr);
+  auto source = std::make_shared<EventLoopSource>(provider, nullptr, nullptr,
+                                                  nullptr, nullptr);
+
+  /*
+   *  The source owns the reader. So the reader cannot outlive the source.
+   */
+  auto sourcePtr = source.get();
+
+  source->setReader([this, sourcePtr](EventLoopSource::Handle) {
+    /*
+     *  The wake may be stale if the message was already drained by someone
+     *  else. So never block on the read.
+     */
+    auto result = _channel.readPendingMessageNow(ClockDurationNano(0));
+
+    if (!sourcePtr->isEdgeTriggered()) {
+      return result;
+    }
+
+    /*
+     *  Edge triggered sources won't be signalled again for messages already
+     *  pending on the socket. Read till there are none left.
+     */
+    while (result == IOResult::Success) {
+      result = _channel.readPendingMessageNow(ClockDurationNano(0));
+    }
+
+    return result == IOResult::Timeout ? IOResult::Success : result;
+  });
+
+  return source;
 }
 
 bool SocketChannel::doTerminate() {
@@ -108,12 +205,52 @@ bool SocketChannel::doTerminate() {
 
 IOResult SocketChannel::writeMessages(Messages&& messages,
                                       ClockDurationNano timeout) {
-  for (const auto& message : messages) {
+  std::lock_guard<std::mutex> lock(_writeBatchMutex);
+
+  if (!_writeBatch->isReady()) {
+    return IOResult::Failure;
+  }
+
+  /*
+   *  A single deadline applies to all messages in the batch.
+   */
+  SocketWriteDeadline deadline(timeout);
+
+  size_t written = 0;
+
+  while (written < messages.size()) {
     /*
-     *  TODO: All messages need to be written in one shot so that timeout
-     *        guarantees hold.
+     *  Prepare as many messages as will fit in the batch.
      */
-    auto result = writeMessageSingle(message, timeout);
+    size_t prepared = 0;
+    auto result = IOResult::Success;
+
+    while (written + prepared < messages.size() &&
+           prepared < kMaxWriteBatchCount) {
+      result = _writeBatch->prepare(prepared, messages[written + prepared],
+                                    *_arenaPool);
+      if (result != IOResult::Success) {
+        break;
+      }
+      prepared++;
+    }
+
+    /*
+     *  Send out what was prepared. If a message could not be prepared, the
+     *  messages before it still go out before the error is reported.
+     */
+    size_t sent = 0;
+    auto sendResult =
+        _writeBatch->send(_pair->writeHandle(), prepared, deadline, sent);
+
+    _writeBatch->reset(prepared, sent);
+
+    written += sent;
+
+    if (sendResult != IOResult::Success) {
+      return sendResult;
+    }
+
     if (result != IOResult::Success) {
       return result;
     }
@@ -122,63 +259,102 @@ IOResult SocketChannel::writeMessages(Messages&& messages,
   return IOResult::Success;
 }
 
-static IOResult SocketSendMessage(SocketPair::Handle writer,
-                                  struct msghdr* messageHeader,
-                                  size_t expectedSendSize,
-                                  ClockDurationNano timeout) {
-  int64_t sent = 0;
-  while (true) {
-    sent = RL_TEMP_FAILURE_RETRY(::sendmsg(writer, messageHeader, 0));
+SocketWriteDeadline::SocketWriteDeadline(ClockDurationNano timeout)
+    : _timeout(timeout), _start(Clock::now()) {}
 
-    if (sent == -1 && errno == EAGAIN) {
-      if (timeout.count() == 0) {
-        /*
-         *  No need for an extra syscall if the timeout is zero.
-         */
-        return IOResult::Timeout;
-      }
+ClockDurationNano SocketWriteDeadline::remaining() const {
+  if (_timeout.count() == 0 || _timeout == ClockDurationNano::max()) {
+    return _timeout;
+  }
 
-      /*
-       *  We definitely need to poll for write, setup the poll structure
-       */
-      struct pollfd pollFd = {
-          .fd = writer,
-          .events = POLLOUT,
-          .revents = 0,
-      };
+  auto elapsed =
+      std::chrono::duration_cast<ClockDurationNano>(Clock::now() - _start);
 
-      auto timeoutMS = ToUnixTimeoutMS(timeout);
+  return elapsed >= _timeout ? ClockDurationNano(0) : _timeout - elapsed;
+}
 
-      auto pollResult = RL_TEMP_FAILURE_RETRY(::poll(&pollFd, 1, timeoutMS));
+/**
+ *  Wait for the socket to become writable again before the deadline expires.
+ *
+ *  @return if the socket became writable
+ */
+static IOResult SocketPollForWrite(SocketPair::Handle writer,
+                                   const SocketWriteDeadline& deadline) {
+  auto timeout = deadline.remaining();
 
-      if (pollResult == 0) {
-        /*
-         *  Poll timeout expired
-         */
-        return IOResult::Timeout;
-      }
+  if (timeout.count() == 0) {
+    /*
+     *  No need for an extra syscall if the timeout is zero.
+     */
+    return IOResult::Timeout;
+  }
 
-      if (pollResult == 1) {
-        /*
-         *  Socket write is available
-         */
-        continue;
-      }
-    }
+  /*
+   *  We definitely need to poll for write, setup the poll structure
+   */
+  struct pollfd pollFd = {
+      .fd = writer,
+      .events = POLLOUT,
+      .revents = 0,
+  };
 
-    break;
+  auto timeoutMS = ToUnixTimeoutMS(timeout);
+
+  auto pollResult = RL_TEMP_FAILURE_RETRY(::poll(&pollFd, 1, timeoutMS));
+
+  if (pollResult == 0) {
+    /*
+     *  Poll timeout expired
+     */
+    return IOResult::Timeout;
+  }
+
+  if (pollResult == 1) {
+    /*
+     *  Socket write is available
+     */
+    return IOResult::Success;
   }
 
-  return sent == static_cast<int64_t>(expectedSendSize) ? IOResult::Success
-                                                        : IOResult::Failure;
+  return IOResult::Failure;
 }
 
-/*
- *  Temporary workaround till we can optimize sending multiple messages in one
- *  call. We already use scatter gather arrays, so should stick it in there.
- */
-IOResult SocketChannel::writeMessageSingle(const Message& message,
-                                           ClockDurationNano timeout) {
+SocketWriteBatch::SocketWriteBatch() : _entries(kMaxWriteBatchCount) {
+  _ready = _controlBuffers.resize(kMaxWriteBatchCount * kMaxControlBufferSize);
+
+  for (size_t i = 0; i < kMaxWriteBatchCount; i++) {
+    auto& entry = _entries[i];
+
+    /*
+     *  The first item in the scatter gather array is always the payload
+     *  header. Inline message buffers (if present) are the second.
+     */
+    entry.vec[0].iov_base = &entry.header;
+    entry.vec[0].iov_len = sizeof(entry.header);
+
+    auto& messageHeader = this->messageHeader(i);
+    memset(&messageHeader, 0, sizeof(messageHeader));
+    messageHeader.msg_iov = entry.vec;
+  }
+}
+
+bool SocketWriteBatch::isReady() const {
+  return _ready;
+}
+
+struct msghdr& SocketWriteBatch::messageHeader(size_t index) {
+#if RL_SOCKET_SENDMMSG
+  return _headers[index].msg_hdr;
+#else
+  return _headers[index];
+#endif
+}
+
+IOResult SocketWriteBatch::prepare(size_t index,
+                                   const Message& message,
+                                   SharedMemoryArenaPool& pool) {
+  auto& entry = _entries[index];
+
   /*
    *  Check if the message buffer is small enough to be sent inline
    */
@@ -187,30 +363,37 @@ IOResult SocketChannel::writeMessageSingle(const Message& message,
   const auto& attachments = message.attachments();
   auto oolDescriptors = attachments.size();
 
-  std::unique_ptr<SharedMemory> oolMemoryArena;
-
   /*
-   *  If the message cannot be sent inline, we allocate a shared memory arena
-   *  large enough to hold the message and send the descriptor of that arena
-   *  instead of the message.
+   *  If the message cannot be sent inline, we send the descriptor of a shared
+   *  memory arena containing the message instead of the message. Messages
+   *  encoded directly into an arena are sent as is. Others are copied into
+   *  an arena leased from the pool.
    */
   if (!isDataInline) {
-    oolMemoryArena = std::make_unique<SharedMemory>(message.size());
+    const auto& messageArena = message.arena();
+
+    if (messageArena != nullptr && messageArena->handle() != -1) {
+      entry.oolMemoryArena = messageArena;
+    } else {
+      entry.oolMemoryArena = pool.lease(message.size());
+
+      if (entry.oolMemoryArena == nullptr) {
+        /*
+         *  We could not allocate an OOL memory arena to transfer the contents
+         *  of this large message. We may be able to service this later
+         *  though.
+         */
+        return IOResult::Timeout;
+      }
 
-    if (!oolMemoryArena->isReady() ||
-        oolMemoryArena->size() != message.size()) {
       /*
-       *  We could not allocate an OOL memory arena to transfer the contents
-       *  of this large message. We may be able to service this later though.
+       *  Copy the contents of the large message into the arena we are going
+       *  to send the handle OOL for
        */
-      return IOResult::Timeout;
+      memcpy(entry.oolMemoryArena->data(), message.data(), message.size());
     }
 
-    /*
-     *  Copy the contents of the large message into the arena we are going to
-     *  send the handle OOL for
-     */
-    memcpy(oolMemoryArena->address(), message.data(), message.size());
+    entry.oolMemoryArena->setLength(message.size());
 
     /*
      *  The OOL memory arena takes up another descriptor
@@ -222,83 +405,72 @@ IOResult SocketChannel::writeMessageSingle(const Message& message,
     /*
      *  This is too many descriptors for this implementation
      */
+    entry.oolMemoryArena = nullptr;
     return IOResult::Failure;
   }
 
-  const size_t vecLength = isDataInline ? 2 : 1;
+  entry.header.update(isDataInline, oolDescriptors);
 
-  SocketPayloadHeader header(isDataInline, oolDescriptors);
-
-  struct iovec vec[vecLength];
-
-  /*
-   *  The first item in the scatter gather array is always the payload header
-   */
-  vec[0].iov_base = &header;
-  vec[0].iov_len = sizeof(header);
-
-  /*
-   *  Inline message buffers (if present) are the second item in the array
-   */
-  if (vecLength == 2) {
-    vec[1].iov_base = reinterpret_cast<void*>(message.data());
-    vec[1].iov_len = message.size();
+  if (isDataInline) {
+    entry.vec[1].iov_base = reinterpret_cast<void*>(message.data());
+    entry.vec[1].iov_len = message.size();
   }
 
+  entry.expectedSendSize =
+      sizeof(SocketPayloadHeader) + (isDataInline ? message.size() : 0);
+
   /*
-   *  Create the message header containing the inline data descriptions and
+   *  Update the message header containing the inline data descriptions and
    *  attachments
    */
-  struct msghdr messageHeader = {
-    .msg_name = nullptr,
-    .msg_namelen = 0,
-    .msg_iov = vec,
+  auto& messageHeader = this->messageHeader(index);
+
+  const size_t vecLength = isDataInline ? 2 : 1;
 #if RL_OS_MAC
-    .msg_iovlen = static_cast<int>(vecLength),
+  messageHeader.msg_iovlen = static_cast<int>(vecLength);
 #else
-    .msg_iovlen = vecLength,
+  messageHeader.msg_iovlen = vecLength;
 #endif
-    .msg_control = nullptr,
-    .msg_controllen = 0,
-    .msg_flags = 0,
-  };
-
-  Allocation controlBuffer;
+  messageHeader.msg_control = nullptr;
+  messageHeader.msg_controllen = 0;
 
   /*
    *  If there are any OOL descriptors (explicitly via attachments or OOL
-   *  memory arenas), the control message needs to be initialized.
+   *  memory arenas), the control message needs to be initialized. Each entry
+   *  in the batch has its own slice of the preallocated control buffers.
    */
   if (oolDescriptors > 0) {
-    if (!controlBuffer.resize(
-            CMSG_SPACE((oolDescriptors * sizeof(SocketPair::Handle))))) {
-      /*
-       *  We could not allocate enough memory on the client for the control
-       *  buffer. Memory pressure may subside later. So Timeout.
-       */
-      return IOResult::Timeout;
-    }
+    auto controlBuffer =
+        _controlBuffers.data() + (index * kMaxControlBufferSize);
+    auto controlLength =
+        CMSG_SPACE((oolDescriptors * sizeof(SocketPair::Handle)));
 
-    messageHeader.msg_control = controlBuffer.data();
-    messageHeader.msg_controllen = static_cast<socklen_t>(controlBuffer.size());
+    memset(controlBuffer, 0, controlLength);
+
+    messageHeader.msg_control = controlBuffer;
+    messageHeader.msg_controllen = static_cast<socklen_t>(controlLength);
 
     struct cmsghdr* cmsg = CMSG_FIRSTHDR(&messageHeader);
 
     if (cmsg == nullptr) {
+      entry.oolMemoryArena = nullptr;
       return IOResult::Failure;
     }
 
-    auto descCount = 0;
-    std::vector<SocketPair::Handle> handles;
-    handles.resize(oolDescriptors);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = static_cast<socklen_t>(
+        CMSG_LEN(oolDescriptors * sizeof(SocketPair::Handle)));
+
+    auto handles = reinterpret_cast<SocketPair::Handle*>(CMSG_DATA(cmsg));
+    size_t descCount = 0;
 
-    for (const auto& attachment : message.attachments()) {
+    for (const auto& attachment : attachments) {
       if (attachment == nullptr) {
         continue;
       }
 
-      SocketPair::Handle handle = attachment->messageHandle().handle();
-      handles[descCount++] = handle;
+      handles[descCount++] = attachment->messageHandle().handle();
     }
 
     if (!isDataInline) {
@@ -306,24 +478,84 @@ IOResult SocketChannel::writeMessageSingle(const Message& message,
        *  The last descriptor is the memory arena handle (if OOL). The arena
        *  cannot be nullptr since we return early with a timeout in that case.
        */
-      handles[descCount++] = oolMemoryArena->handle();
+      handles[descCount++] = entry.oolMemoryArena->handle();
     }
+  }
 
-    cmsg->cmsg_level = SOL_SOCKET;
-    cmsg->cmsg_type = SCM_RIGHTS;
-    cmsg->cmsg_len = static_cast<socklen_t>(
-        CMSG_LEN(oolDescriptors * sizeof(SocketPair::Handle)));
-    memcpy(CMSG_DATA(cmsg), handles.data(),
-           handles.size() * sizeof(SocketPair::Handle));
+  /*
+   *  The reader releases this reference once it is done with the message. It
+   *  must be taken before the reader can possibly see the arena.
+   */
+  if (entry.oolMemoryArena != nullptr) {
+    entry.oolMemoryArena->retain();
   }
 
-  const auto expectedSendSize =
-      sizeof(SocketPayloadHeader) + (isDataInline ? message.size() : 0);
+  return IOResult::Success;
+}
+
+IOResult SocketWriteBatch::send(SocketPair::Handle writer,
+                                size_t count,
+                                const SocketWriteDeadline& deadline,
+                                size_t& sent) {
+  sent = 0;
+
+  while (sent < count) {
+#if RL_SOCKET_SENDMMSG
+    /*
+     *  Hand the kernel as much of the batch as it will take in one call.
+     */
+    auto result = RL_TEMP_FAILURE_RETRY(::sendmmsg(
+        writer, &_headers[sent], static_cast<unsigned int>(count - sent), 0));
+
+    if (result > 0) {
+      for (auto i = sent, end = sent + result; i < end; i++) {
+        if (_headers[i].msg_len != _entries[i].expectedSendSize) {
+          return IOResult::Failure;
+        }
+      }
+      sent += result;
+      continue;
+    }
+#else
+    auto result =
+        RL_TEMP_FAILURE_RETRY(::sendmsg(writer, &_headers[sent], 0));
 
-  auto result = SocketSendMessage(_pair->writeHandle(), &messageHeader,
-                                  expectedSendSize, timeout);
+    if (result >= 0) {
+      if (static_cast<size_t>(result) != _entries[sent].expectedSendSize) {
+        return IOResult::Failure;
+      }
+      sent++;
+      continue;
+    }
+#endif
+
+    if (result == -1 && errno == EAGAIN) {
+      auto pollResult = SocketPollForWrite(writer, deadline);
+      if (pollResult != IOResult::Success) {
+        return pollResult;
+      }
+      continue;
+    }
 
-  return result;
+    return IOResult::Failure;
+  }
+
+  return IOResult::Success;
+}
+
+void SocketWriteBatch::reset(size_t count, size_t sent) {
+  /*
+   *  The OOL memory arenas have been sent (or abandoned) and their descriptors
+   *  duplicated into the receiver. Drop our references along with the ones
+   *  taken on behalf of readers that will never see the arena.
+   */
+  for (size_t i = 0; i < count; i++) {
+    if (i >= sent && _entries[i].oolMemoryArena != nullptr) {
+      _entries[i].oolMemoryArena->release();
+    }
+    _entries[i].oolMemoryArena = nullptr;
+    _entries[i].vec[1].iov_base = nullptr;
+  }
 }
 
 using RecvResult = std::pair<IOResult, ssize_t>;
@@ -402,6 +634,10 @@ AttachmentRef SocketChannel::attachment() {
   return _pair;
 }
 
+std::shared_ptr<SharedMemoryArenaPool> SocketChannel::arenaPool() const {
+  return _arenaPool;
+}
+
 IOReadResult SocketChannel::readMessage(ClockDurationNano timeout) {
   std::lock_guard<std::mutex> lock(_readBufferMutex);
 
@@ -497,7 +733,7 @@ IOReadResult SocketChannel::readMessage(ClockDurationNano timeout) {
     return IOReadResult(IOResult::Failure, Message{});
   }
 
-  std::unique_ptr<SharedMemory> oolMemoryArena;
+  std::shared_ptr<SharedMemoryArena> oolMemoryArena;
   std::vector<RawAttachment> attachments;
 
   if (totalDescriptors > 0) {
@@ -525,17 +761,15 @@ IOReadResult SocketChannel::readMessage(ClockDurationNano timeout) {
 
       if (oolMemoryArenaDescriptorIndex == i) {
         /*
-         *  We create a shared memory instance from the handle but make it not
-         *  own this handle or its mapping. We then manually close the handle
-         *  and create a message from the same with a vm allocated backing. This
-         *  message unmaps the allocation when it is done.
+         *  The arena maps the handle and closes it right away. The message
+         *  created from the arena unmaps it when it is done and releases the
+         *  reference the sender took on our behalf. This hands the arena back
+         *  to the pool of the sender.
          *
          *  This way, there are no copies and we can get rid of descriptor
          *  entirely.
          */
-        oolMemoryArena = std::make_unique<SharedMemory>(
-            handle, false /* does not own its handle or mapping */);
-        RL_CHECK(::close(handle));
+        oolMemoryArena = SharedMemoryArena::Receive(handle);
       } else {
         /*
          *  This is a regular channel attachment
@@ -547,34 +781,23 @@ IOReadResult SocketChannel::readMessage(ClockDurationNano timeout) {
     }
   }
 
-  /*
-   *  Create the message we will be returning to the caller
-   */
-  uint8_t* buffer = nullptr;
-  size_t bufferLength = 0;
-  bool vmDeallocate = false;
+  if (!header.isDataInline() &&
+      (oolMemoryArena == nullptr || !oolMemoryArena->isReady())) {
+    /*
+     *  The header said there was OOL data but we were not able to initialize
+     *  the OOL arena
+     */
+    return IOReadResult(IOResult::Failure, Message{});
+  }
 
   /*
-   *  Initialize the message data
+   *  Create the message we will be returning to the caller
    */
-  if (header.isDataInline()) {
-    buffer = _inlineMessageBuffer.data();
-    bufferLength = inlineMessageSize;
-  } else {
-    if (oolMemoryArena == nullptr || !oolMemoryArena->isReady()) {
-      /*
-       *  The header said there was OOL data but we were not able to
-       *  initialize the OOL arena
-       */
-      return IOReadResult(IOResult::Failure, Message{});
-    }
-
-    buffer = oolMemoryArena->address();
-    bufferLength = oolMemoryArena->size();
-    vmDeallocate = true;
-  }
-
-  Message message(buffer, bufferLength, vmDeallocate);
+  auto length = oolMemoryArena == nullptr ? 0 : oolMemoryArena->length();
+  Message message =
+      header.isDataInline()
+          ? Message(_inlineMessageBuffer.data(), inlineMessageSize, false)
+          : Message(std::move(oolMemoryArena), length);
 
   if (!message.encode(std::move(attachments))) {
     return IOReadResult(IOResult::Failure, Message{});
@@ -19,6 +19,27 @@
 namespace rl {
 namespace core {
 
+class SocketWriteBatch;
+
+/**
+ *  A single deadline that applies to all the writes in a batch.
+ */
+class SocketWriteDeadline {
+ public:
+  SocketWriteDeadline(ClockDurationNano timeout);
+
+  /**
+   *  @return the time remaining till the deadline expires
+   */
+  ClockDurationNano remaining() const;
+
+ private:
+  const ClockDurationNano _timeout;
+  const ClockPointNano _start;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SocketWriteDeadline);
+};
+
 class SocketChannel : public ChannelProvider {
  public:
   SocketChannel(Channel& owner);
@@ -36,6 +57,8 @@ class SocketChannel : public ChannelProvider {
 
   AttachmentRef attachment() override;
 
+  std::shared_ptr<SharedMemoryArenaPool> arenaPool() const override;
+
   bool doTerminate() override;
 
  private:
@@ -46,12 +69,13 @@ class SocketChannel : public ChannelProvider {
   Allocation _inlineMessageBuffer;
   Allocation _controlBuffer;
 
+  std::mutex _writeBatchMutex;
+  std::unique_ptr<SocketWriteBatch> _writeBatch;
+  std::shared_ptr<SharedMemoryArenaPool> _arenaPool;
+
   RL_WARN_UNUSED_RESULT
   bool setup();
 
-  IOResult writeMessageSingle(const Message& message,
-                              ClockDurationNano timeout);
-
   RL_DISALLOW_COPY_AND_ASSIGN(SocketChannel);
 };
 
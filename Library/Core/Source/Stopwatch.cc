@@ -19,7 +19,11 @@ void Stopwatch::start() {
 }
 
 void Stopwatch::stop() {
-  _laps[_currentLapIndex] = core::Clock::now() - _currentLapStartPoint;
+  recordLap(core::Clock::now() - _currentLapStartPoint);
+}
+
+void Stopwatch::recordLap(core::ClockDuration duration) {
+  _laps[_currentLapIndex] = duration;
   _currentLapIndex = (_currentLapIndex + 1) % _laps.size();
 }
 
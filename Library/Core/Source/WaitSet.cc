@@ -26,7 +26,10 @@ using PlatformWaitSetProvider =
 #error Unknown WaitSet Implementation
 #endif
 
-WaitSet::WaitSet() : _provider(std::make_unique<PlatformWaitSetProvider>()) {}
+WaitSet::WaitSet()
+    : _provider(std::make_unique<PlatformWaitSetProvider>()),
+      _harvestedHead(0),
+      _harvestedCount(0) {}
 
 WaitSet::~WaitSet() {
   for (auto const& source : _sources) {
@@ -56,6 +59,7 @@ bool WaitSet::removeSource(std::shared_ptr<EventLoopSource> source) {
   core::MutexLocker lock(_sourcesMutex);
   if (_sources.erase(source) != 0) {
     _provider->updateSource(*this, *source, false);
+    discardHarvested(source.get());
     return true;
   }
 
@@ -63,30 +67,93 @@ bool WaitSet::removeSource(std::shared_ptr<EventLoopSource> source) {
 }
 
 WaitSet::Result WaitSet::wait(ClockDurationNano timeout) {
-  auto result = _provider->wait(timeout);
+  Result result(WakeReason::Timeout, nullptr);
 
   /*
-   *  In case of terminations initiated from the remote end, we need to cleanup
-   *  our collection of sources.
+   *  Events harvested during a previous wait are handed out before waiting on
+   *  the platform again.
    */
-  if (result.first == WaitSet::WakeReason::Error && result.second != nullptr) {
-    EventLoopSourceRef found;
+  if (nextHarvested(result)) {
+    return result;
+  }
+
+  auto count =
+      _provider->harvest(timeout, _harvesting.data(), _harvesting.size());
+
+  if (count == 0) {
+    return result;
+  }
 
-    core::MutexLocker lock(_sourcesMutex);
+  core::MutexLocker lock(_sourcesMutex);
+
+  for (size_t i = 0; i < count; i++) {
+    const auto& harvested = _harvesting[i];
+
+    /*
+     *  In case of terminations initiated from the remote end, we need to
+     *  cleanup our collection of sources.
+     */
+    if (harvested.first == WakeReason::Error && harvested.second != nullptr) {
+      EventLoopSourceRef found;
+
+      for (const auto& source : _sources) {
+        if (source.get() == harvested.second) {
+          found = source;
+          break;
+        }
+      }
 
-    for (const auto& source : _sources) {
-      if (source.get() == result.second) {
-        found = source;
-        break;
+      if (found != nullptr) {
+        _sources.erase(found);
       }
     }
 
-    if (found != nullptr) {
-      _sources.erase(found);
+    _harvested[i] = harvested;
+  }
+
+  /*
+   *  The first harvested event is handed out right away.
+   */
+  _harvestedHead = 1;
+  _harvestedCount = count - 1;
+
+  return _harvested[0];
+}
+
+bool WaitSet::nextHarvested(Result& result) {
+  core::MutexLocker lock(_sourcesMutex);
+
+  while (_harvestedCount > 0) {
+    result = _harvested[_harvestedHead];
+
+    _harvestedHead = (_harvestedHead + 1) % kMaxHarvestedEvents;
+    _harvestedCount--;
+
+    /*
+     *  Skip over events for sources that were removed after being harvested.
+     */
+    if (result.first == WakeReason::Timeout) {
+      continue;
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+void WaitSet::discardHarvested(EventLoopSource* source) {
+  for (size_t i = 0; i < _harvestedCount; i++) {
+    auto& harvested = _harvested[(_harvestedHead + i) % kMaxHarvestedEvents];
+    if (harvested.second == source) {
+      harvested = Result(WakeReason::Timeout, nullptr);
     }
   }
+}
 
-  return result;
+size_t WaitSet::harvestedCount() const {
+  core::MutexLocker lock(_sourcesMutex);
+  return _harvestedCount;
 }
 
 WaitSet::Handle WaitSet::handle() const {
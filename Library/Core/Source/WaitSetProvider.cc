@@ -15,6 +15,21 @@ void WaitSetProvider::updateSource(WaitSet& waitset,
   source.updateInWaitSet(waitset, addedOrRemoved);
 }
 
+size_t WaitSetProvider::harvest(ClockDurationNano timeout,
+                                WaitSet::Result* results,
+                                size_t capacity) {
+  RL_ASSERT(capacity > 0);
+
+  auto result = wait(timeout);
+
+  if (result.first == WaitSet::WakeReason::Timeout) {
+    return 0;
+  }
+
+  results[0] = result;
+  return 1;
+}
+
 WaitSetProvider::~WaitSetProvider() {}
 
 }  // namespace core
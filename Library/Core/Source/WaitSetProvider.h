@@ -17,6 +17,22 @@ class WaitSetProvider {
  public:
   virtual WaitSet::Result wait(ClockDurationNano timeout) = 0;
 
+  /**
+   *  Wait for events on the wait set and harvest as many of them as fit in the
+   *  results. Providers that can only report one event per wait need not
+   *  override this.
+   *
+   *  @param timeout  the timeout of the wait
+   *  @param results  the results to fill
+   *  @param capacity the maximum number of results to harvest. Must be at
+   *                  least one.
+   *
+   *  @return the number of results harvested. Zero if the timeout expired.
+   */
+  virtual size_t harvest(ClockDurationNano timeout,
+                         WaitSet::Result* results,
+                         size_t capacity);
+
   virtual WaitSet::Handle handle() const = 0;
 
   virtual void updateSource(WaitSet& waitset,
@@ -4,19 +4,85 @@
  */
 
 #include <Core/Thread.h>
+#include <Core/ThreadLocal.h>
 #include <Core/WorkQueue.h>
 #include <algorithm>
+#include "WorkStealingDeque.h"
 
 namespace rl {
 namespace core {
 
-WorkQueue::WorkQueue() : _workSource(EventLoopSource::Trivial()) {
+/*
+ *  The maximum number of items a worker moves out of the injection queue into
+ *  its own deque in one go.
+ */
+static const size_t kMaxInjectionBatch = 32;
+
+struct WorkQueue::Worker {
+  WorkQueue* const queue;
+  const size_t index;
+  WorkStealingDeque deque;
+  std::shared_ptr<EventLoopSource> source;
+  std::atomic_bool sleeping;
+  std::vector<WorkItem> injected;
+
+  Worker(WorkQueue* aQueue, size_t aIndex)
+      : queue(aQueue),
+        index(aIndex),
+        source(EventLoopSource::Trivial()),
+        sleeping(true) {}
+
+  RL_DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+RL_THREAD_LOCAL ThreadLocal CurrentStealingWorker;
+
+static size_t DefaultPoolSize(WorkQueue::Mode mode) {
+  const size_t concurrency =
+      std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  switch (mode) {
+    case WorkQueue::Mode::Shared:
+      return std::min<size_t>(concurrency, 8);
+    case WorkQueue::Mode::WorkStealing:
+      return concurrency;
+  }
+
+  return 1;
+}
+
+WorkQueue::WorkQueue() : WorkQueue(Mode::Shared) {}
+
+WorkQueue::WorkQueue(Mode mode, size_t poolSize)
+    : _mode(mode), _pendingItems(0), _sleepingWorkers(0) {
+  if (poolSize == 0) {
+    poolSize = DefaultPoolSize(mode);
+  }
+
+  switch (_mode) {
+    case Mode::Shared:
+      setupSharedWorkers(poolSize);
+      break;
+    case Mode::WorkStealing:
+      setupStealingWorkers(poolSize);
+      break;
+  }
+}
+
+WorkQueue::~WorkQueue() {
+  _workers.clear();
+
+  if (_mode == Mode::WorkStealing) {
+    flushStealingWork();
+  }
+}
+
+void WorkQueue::setupSharedWorkers(size_t poolSize) {
+  _workSource = EventLoopSource::Trivial();
+
   /*
    *  Start worker threads
    */
-  const auto poolSize =
-      std::min<uint32_t>(std::thread::hardware_concurrency(), 8);
-
   Latch ready(poolSize);
 
   for (size_t i = 0; i < poolSize; i++) {
@@ -37,8 +103,34 @@ WorkQueue::WorkQueue() : _workSource(EventLoopSource::Trivial()) {
   }
 }
 
-WorkQueue::~WorkQueue() {
-  _workers.clear();
+void WorkQueue::setupStealingWorkers(size_t poolSize) {
+  /*
+   *  Start worker threads. All workers start out asleep.
+   */
+  Latch ready(poolSize);
+
+  for (size_t i = 0; i < poolSize; i++) {
+    _stealingWorkers.emplace_back(std::make_unique<Worker>(this, i));
+    _workers.emplace_back(std::make_unique<EventLoopThread>(ready));
+  }
+
+  _sleepingWorkers = poolSize;
+
+  ready.wait();
+
+  /*
+   *  Unlike the shared mode, each worker gets its own work source so that
+   *  producers can wake exactly as many workers as there are items.
+   */
+  for (size_t i = 0; i < poolSize; i++) {
+    auto& worker = *_stealingWorkers[i];
+    worker.source->setWakeFunction(
+        std::bind(&WorkQueue::workStealing, this, std::ref(worker)));
+
+    auto loopAccess = _workers[i]->loop();
+    EventLoop* loop = loopAccess.get();
+    loop->addSource(worker.source);
+  }
 }
 
 void WorkQueue::work() {
@@ -69,6 +161,190 @@ WorkQueue::WorkItem WorkQueue::acquireWork() {
   return item;
 }
 
+void WorkQueue::workStealing(Worker& worker) {
+  CurrentStealingWorker.set(reinterpret_cast<uintptr_t>(&worker));
+
+  /*
+   *  If this wakeup was not initiated by a producer, the worker is still
+   *  accounted for as sleeping.
+   */
+  bool wasSleeping = true;
+  if (worker.sleeping.compare_exchange_strong(wasSleeping, false)) {
+    _sleepingWorkers--;
+  }
+
+  while (true) {
+    while (auto item = acquireStealingWork(worker)) {
+      item();
+    }
+
+    /*
+     *  Announce that this worker is about to sleep before checking for pending
+     *  items one last time. Producers increment the pending count before
+     *  checking for sleeping workers. So either this worker sees the new item
+     *  or the producer sees this worker asleep and wakes it.
+     */
+    worker.sleeping = true;
+    _sleepingWorkers++;
+
+    if (_pendingItems == 0) {
+      return;
+    }
+
+    /*
+     *  Work showed up while winding down. If a producer has already claimed
+     *  this worker, the wakeup it sent will be spurious.
+     */
+    wasSleeping = true;
+    if (worker.sleeping.compare_exchange_strong(wasSleeping, false)) {
+      _sleepingWorkers--;
+    }
+  }
+}
+
+WorkQueue::WorkItem WorkQueue::acquireStealingWork(Worker& worker) {
+  WorkItem item;
+
+  /*
+   *  Service the items in the local deque first.
+   */
+  if (auto local = worker.deque.pop()) {
+    std::unique_ptr<WorkItem> owned(local);
+    item = std::move(*owned);
+  }
+
+  /*
+   *  Then move a batch of items from the injection queue into the local deque.
+   *  Only hold the lock long enough to move the items out.
+   */
+  if (item == nullptr) {
+    {
+      MutexLocker lock(_workItemsMutex);
+      auto count = std::min(
+          _injectedItems.size() / _stealingWorkers.size() + 1,
+          std::min(_injectedItems.size(), kMaxInjectionBatch));
+      for (size_t i = 0; i < count; i++) {
+        worker.injected.emplace_back(std::move(_injectedItems.front()));
+        _injectedItems.pop_front();
+      }
+    }
+
+    if (worker.injected.size() > 0) {
+      item = std::move(worker.injected.front());
+      for (size_t i = 1; i < worker.injected.size(); i++) {
+        worker.deque.push(new WorkItem(std::move(worker.injected[i])));
+      }
+      worker.injected.clear();
+    }
+  }
+
+  /*
+   *  Finally, steal from peers. Start with the next worker so that thieves
+   *  don't all converge on the first one.
+   */
+  if (item == nullptr) {
+    const auto count = _stealingWorkers.size();
+    for (size_t i = 1; i < count; i++) {
+      auto& victim = *_stealingWorkers[(worker.index + i) % count];
+      if (auto stolen = victim.deque.steal()) {
+        std::unique_ptr<WorkItem> owned(stolen);
+        item = std::move(*owned);
+        break;
+      }
+    }
+  }
+
+  if (item == nullptr) {
+    return nullptr;
+  }
+
+  /*
+   *  If there is still more work to go around, get another worker going.
+   */
+  if (--_pendingItems > 0) {
+    wakeSleepingWorkers(1);
+  }
+
+  return item;
+}
+
+void WorkQueue::enqueueStealingWork(WorkItem* items, size_t count) {
+  /*
+   *  The pending count must be updated before the items are visible to workers
+   *  and before looking for sleeping workers.
+   */
+  _pendingItems += count;
+
+  auto current = reinterpret_cast<Worker*>(CurrentStealingWorker.get());
+  if (current != nullptr && current->queue == this) {
+    /*
+     *  Dispatches from one of our own workers go on its deque without taking
+     *  any locks. Idle peers will steal from it.
+     */
+    for (size_t i = 0; i < count; i++) {
+      current->deque.push(new WorkItem(std::move(items[i])));
+    }
+  } else {
+    MutexLocker lock(_workItemsMutex);
+    for (size_t i = 0; i < count; i++) {
+      _injectedItems.emplace_back(std::move(items[i]));
+    }
+  }
+
+  wakeSleepingWorkers(count);
+}
+
+void WorkQueue::wakeSleepingWorkers(size_t count) {
+  for (const auto& worker : _stealingWorkers) {
+    if (count == 0 || _sleepingWorkers == 0) {
+      return;
+    }
+
+    bool wasSleeping = true;
+    if (worker->sleeping.compare_exchange_strong(wasSleeping, false)) {
+      _sleepingWorkers--;
+      count--;
+      worker->source->writer()(worker->source->handles().writeHandle);
+    }
+  }
+}
+
+void WorkQueue::flushStealingWork() {
+  /*
+   *  All workers have been collected. Perform any items that are still pending
+   *  on this thread. These may dispatch further items.
+   */
+  while (true) {
+    WorkItem item;
+
+    {
+      MutexLocker lock(_workItemsMutex);
+      if (_injectedItems.size() > 0) {
+        item = std::move(_injectedItems.front());
+        _injectedItems.pop_front();
+      }
+    }
+
+    for (size_t i = 0; item == nullptr && i < _stealingWorkers.size(); i++) {
+      if (auto stolen = _stealingWorkers[i]->deque.steal()) {
+        std::unique_ptr<WorkItem> owned(stolen);
+        item = std::move(*owned);
+      }
+    }
+
+    if (item == nullptr) {
+      return;
+    }
+
+    _pendingItems--;
+    item();
+  }
+}
+
+WorkQueue::Mode WorkQueue::mode() const {
+  return _mode;
+}
+
 size_t WorkQueue::workerCount() const {
   return _workers.size();
 }
@@ -78,7 +354,37 @@ bool WorkQueue::dispatch(WorkItem work) {
     return false;
   }
 
-  auto initialCount = 1;
+  switch (_mode) {
+    case Mode::Shared:
+      enqueueSharedWork(&work, 1);
+      break;
+    case Mode::WorkStealing:
+      enqueueStealingWork(&work, 1);
+      break;
+  }
+
+  return true;
+}
+
+bool WorkQueue::dispatchItems(std::vector<WorkItem>& items) {
+  if (items.size() == 0) {
+    return true;
+  }
+
+  switch (_mode) {
+    case Mode::Shared:
+      enqueueSharedWork(items.data(), items.size());
+      break;
+    case Mode::WorkStealing:
+      enqueueStealingWork(items.data(), items.size());
+      break;
+  }
+
+  return true;
+}
+
+void WorkQueue::enqueueSharedWork(WorkItem* items, size_t count) {
+  size_t initialCount = 1;
 
   {
     /*
@@ -87,7 +393,9 @@ bool WorkQueue::dispatch(WorkItem work) {
      */
     MutexLocker lock(_workItemsMutex);
     initialCount = _workItems.size();
-    _workItems.push_back(work);
+    for (size_t i = 0; i < count; i++) {
+      _workItems.emplace_back(std::move(items[i]));
+    }
   }
 
   if (initialCount == 0) {
@@ -97,8 +405,6 @@ bool WorkQueue::dispatch(WorkItem work) {
      */
     _workSource->writer()(_workSource->handles().writeHandle);
   }
-
-  return true;
 }
 
 }  // namespace core
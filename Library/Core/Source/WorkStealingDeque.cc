@@ -0,0 +1,133 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "WorkStealingDeque.h"
+
+namespace rl {
+namespace core {
+
+/*
+ *  The memory orderings follow "Correct and Efficient Work-Stealing for Weak
+ *  Memory Models" (Lê, Pop, Cohen, Zappa Nardelli. PPoPP 2013).
+ */
+
+WorkStealingDeque::Buffer::Buffer(size_t capacity)
+    : _capacity(capacity),
+      _mask(capacity - 1),
+      _items(std::make_unique<std::atomic<Item>[]>(capacity)) {
+  RL_ASSERT_MSG(capacity != 0 && (capacity & _mask) == 0,
+                "The capacity of the deque must be a power of two");
+}
+
+size_t WorkStealingDeque::Buffer::capacity() const {
+  return _capacity;
+}
+
+WorkStealingDeque::Item WorkStealingDeque::Buffer::get(int64_t index) const {
+  return _items[static_cast<size_t>(index) & _mask].load(
+      std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::Buffer::put(int64_t index, Item item) {
+  _items[static_cast<size_t>(index) & _mask].store(item,
+                                                    std::memory_order_relaxed);
+}
+
+std::unique_ptr<WorkStealingDeque::Buffer> WorkStealingDeque::Buffer::grow(
+    int64_t bottom,
+    int64_t top) const {
+  auto buffer = std::make_unique<Buffer>(_capacity * 2);
+  for (auto i = top; i < bottom; i++) {
+    buffer->put(i, get(i));
+  }
+  return buffer;
+}
+
+WorkStealingDeque::WorkStealingDeque(size_t initialCapacity)
+    : _top(0), _bottom(0), _buffer(nullptr) {
+  _buffers.emplace_back(std::make_unique<Buffer>(initialCapacity));
+  _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() = default;
+
+void WorkStealingDeque::push(Item item) {
+  auto bottom = _bottom.load(std::memory_order_relaxed);
+  auto top = _top.load(std::memory_order_acquire);
+  auto buffer = _buffer.load(std::memory_order_relaxed);
+
+  if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+    /*
+     *  The buffer is full. Thieves may still be looking at the old buffer so it
+     *  is retained till the deque itself is collected.
+     */
+    _buffers.emplace_back(buffer->grow(bottom, top));
+    buffer = _buffers.back().get();
+    _buffer.store(buffer, std::memory_order_release);
+  }
+
+  buffer->put(bottom, item);
+  std::atomic_thread_fence(std::memory_order_release);
+  _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Item WorkStealingDeque::pop() {
+  auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  auto buffer = _buffer.load(std::memory_order_relaxed);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = _top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    /*
+     *  The deque was already empty.
+     */
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto item = buffer->get(bottom);
+
+  if (top == bottom) {
+    /*
+     *  This is the last item in the deque. Race the thieves for it.
+     */
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      item = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  return item;
+}
+
+WorkStealingDeque::Item WorkStealingDeque::steal() {
+  auto top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto bottom = _bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom) {
+    return nullptr;
+  }
+
+  auto item = _buffer.load(std::memory_order_acquire)->get(top);
+
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  return item;
+}
+
+size_t WorkStealingDeque::size() const {
+  auto bottom = _bottom.load(std::memory_order_relaxed);
+  auto top = _top.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+}  // namespace core
+}  // namespace rl
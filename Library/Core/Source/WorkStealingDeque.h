@@ -0,0 +1,97 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace rl {
+namespace core {
+
+/**
+ *  A lock-free Chase-Lev work stealing deque. The owning thread pushes and pops
+ *  items at the bottom of the deque while any other thread may steal items from
+ *  the top.
+ *
+ *  The deque only deals in pointers to items and does not take ownership of
+ *  the same.
+ */
+class WorkStealingDeque {
+ public:
+  using Item = std::function<void(void)>*;
+
+  WorkStealingDeque(size_t initialCapacity = 64);
+
+  ~WorkStealingDeque();
+
+  /**
+   *  Push an item on the bottom of the deque. May only be called on the owning
+   *  thread.
+   *
+   *  @param item the item to push
+   */
+  void push(Item item);
+
+  /**
+   *  Pop the most recently pushed item off the bottom of the deque. May only be
+   *  called on the owning thread.
+   *
+   *  @return the item or `nullptr` if the deque was empty.
+   */
+  Item pop();
+
+  /**
+   *  Steal the least recently pushed item off the top of the deque. May be
+   *  called on any thread.
+   *
+   *  @return the item or `nullptr` if the deque was empty or the steal lost a
+   *          race with another thief or the owner.
+   */
+  Item steal();
+
+  /**
+   *  @return a snapshot of the number of items in the deque.
+   */
+  size_t size() const;
+
+ private:
+  class Buffer {
+   public:
+    Buffer(size_t capacity);
+
+    size_t capacity() const;
+
+    Item get(int64_t index) const;
+
+    void put(int64_t index, Item item);
+
+    std::unique_ptr<Buffer> grow(int64_t bottom, int64_t top) const;
+
+   private:
+    const size_t _capacity;
+    const size_t _mask;
+    std::unique_ptr<std::atomic<Item>[]> _items;
+
+    RL_DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  std::atomic<int64_t> _top;
+  std::atomic<int64_t> _bottom;
+  std::atomic<Buffer*> _buffer;
+  /*
+   *  Thieves may still be reading from buffers that have been outgrown. These
+   *  are only collected along with the deque.
+   */
+  std::vector<std::unique_ptr<Buffer>> _buffers;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace core
+}  // namespace rl
@@ -3,10 +3,13 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include "Config.h"
+
 #include <thread>
 
 #include <Core/Channel.h>
 #include <Core/Latch.h>
+#include <Core/SharedMemoryArenaPool.h>
 #include <Core/Stopwatch.h>
 #include <TestRunner/TestRunner.h>
 
@@ -628,6 +631,205 @@ TEST(ChannelTest, TestSmallReadWriteWithAttachments) {
   thread.join();
 }
 
+TEST(ChannelTest, SendBatchOfMessagesInOrder) {
+  Channel channel;
+
+  const size_t count = 300;
+
+  std::thread writer([&] {
+    Messages messages;
+    for (size_t i = 0; i < count; i++) {
+      Message message;
+      ASSERT_TRUE(message.encode(i));
+      if (i % 50 == 0) {
+        /*
+         *  Sprinkle in a few messages large enough to go out of line.
+         */
+        ASSERT_TRUE(MemorySetOrCheckPattern(message.encodeRaw<uint8_t>(8192),
+                                            8192, true /* set */));
+      }
+      messages.emplace_back(std::move(message));
+    }
+    ASSERT_EQ(channel.sendMessages(std::move(messages)), IOResult::Success);
+  });
+
+  size_t received = 0;
+  while (received < count) {
+    auto messages =
+        channel.drainPendingMessages(ClockDurationMilli(1000), count - received);
+    ASSERT_NE(messages.size(), 0u);
+    for (auto& message : messages) {
+      size_t index = 0;
+      ASSERT_TRUE(message.decode(index, nullptr));
+      ASSERT_EQ(index, received);
+      if (index % 50 == 0) {
+        ASSERT_TRUE(MemorySetOrCheckPattern(message.decodeRaw<uint8_t>(8192),
+                                            8192, false /* check */));
+      }
+      ASSERT_TRUE(message.readCompleted());
+      received++;
+    }
+  }
+
+  writer.join();
+}
+
+TEST(ChannelTest, BatchWriteTimeoutAppliesToWholeBatch) {
+  Channel channel;
+
+  /*
+   *  Nobody is reading from the channel. The batch is larger than the socket
+   *  buffers so the write must give up once the single deadline expires.
+   */
+  Messages messages;
+  for (size_t i = 0; i < 1000; i++) {
+    Message message;
+    ASSERT_TRUE(MemorySetOrCheckPattern(message.encodeRaw<uint8_t>(1024), 1024,
+                                        true /* set */));
+    messages.emplace_back(std::move(message));
+  }
+
+  rl::instrumentation::Stopwatch stopwatch;
+
+  {
+    rl::instrumentation::AutoStopwatchLap lap(stopwatch);
+    ASSERT_EQ(channel.sendMessages(std::move(messages), ClockDurationMilli(50)),
+              IOResult::Timeout);
+  }
+
+  ASSERT_GE(stopwatch.lastLap(), ClockDurationMilli(25));
+  ASSERT_LT(stopwatch.lastLap(), ClockDurationMilli(5000));
+}
+
+TEST(ChannelTest, EdgeTriggeredSourceDrainsChannel) {
+  Channel channel;
+
+  /*
+   *  Few enough messages to fit in the socket buffers without a reader.
+   */
+  const size_t count = 4;
+  size_t received = 0;
+
+  /*
+   *  All messages are on the socket before the loop ever waits on it. So the
+   *  source is signalled just the once.
+   */
+  Messages messages;
+  for (size_t i = 0; i < count; i++) {
+    Message message;
+    ASSERT_TRUE(message.encode(i));
+    messages.emplace_back(std::move(message));
+  }
+  ASSERT_EQ(channel.sendMessages(std::move(messages)), IOResult::Success);
+
+  std::thread thread([&] {
+    auto loop = EventLoop::Current();
+
+    auto source = channel.source();
+    source->setEdgeTriggered(true);
+
+    channel.setMessageCallback([&](Message message, Namespace*) {
+      size_t index = 0;
+      ASSERT_TRUE(message.decode(index, nullptr));
+      ASSERT_EQ(index, received);
+      if (++received == count) {
+        loop->terminate();
+      }
+    });
+
+    ASSERT_TRUE(loop->addSource(source));
+
+    loop->loop();
+
+    ASSERT_TRUE(loop->removeSource(source));
+  });
+
+  thread.join();
+
+  ASSERT_EQ(received, count);
+}
+
+#if RL_CHANNELS == RL_CHANNELS_SOCKET
+
+TEST(ChannelTest, LargeMessagesRecycleArenas) {
+  Channel channel;
+
+  auto pool = channel.arenaPool();
+  ASSERT_NE(pool, nullptr);
+
+  const size_t rawSize = 100000;
+
+  for (size_t i = 0; i < 4; i++) {
+    Messages messages;
+    Message message;
+    ASSERT_TRUE(MemorySetOrCheckPattern(message.encodeRaw<uint8_t>(rawSize),
+                                        rawSize, true /* set */));
+    messages.emplace_back(std::move(message));
+    ASSERT_EQ(channel.sendMessages(std::move(messages)), IOResult::Success);
+
+    auto received = channel.drainPendingMessages(ClockDurationMilli(1000), 1);
+    ASSERT_EQ(received.size(), 1u);
+    ASSERT_EQ(received[0].size(), rawSize);
+    ASSERT_TRUE(MemorySetOrCheckPattern(received[0].data(), rawSize,
+                                        false /* check */));
+  }
+
+  /*
+   *  Each message was collected by the reader before the next one was sent.
+   */
+  ASSERT_EQ(pool->misses(), 1u);
+  ASSERT_EQ(pool->hits(), 3u);
+}
+
+TEST(ChannelTest, MessagesCreatedByChannelAreNotCopied) {
+  Channel channel;
+
+  auto pool = channel.arenaPool();
+  ASSERT_NE(pool, nullptr);
+
+  const size_t rawSize = 100000;
+
+  Message message = channel.createMessage();
+  ASSERT_TRUE(MemorySetOrCheckPattern(message.encodeRaw<uint8_t>(rawSize),
+                                      rawSize, true /* set */));
+  ASSERT_NE(message.arena(), nullptr);
+  ASSERT_EQ(message.arena()->data(), message.data());
+
+  const auto misses = pool->misses();
+  const auto hits = pool->hits();
+
+  Messages messages;
+  messages.emplace_back(std::move(message));
+  ASSERT_EQ(channel.sendMessages(std::move(messages)), IOResult::Success);
+
+  /*
+   *  The message was sent in its own arena. No others were leased.
+   */
+  ASSERT_EQ(pool->misses(), misses);
+  ASSERT_EQ(pool->hits(), hits);
+
+  {
+    auto received = channel.drainPendingMessages(ClockDurationMilli(1000), 1);
+    ASSERT_EQ(received.size(), 1u);
+    ASSERT_EQ(received[0].size(), rawSize);
+    ASSERT_TRUE(MemorySetOrCheckPattern(received[0].data(), rawSize,
+                                        false /* check */));
+
+    /*
+     *  The reader is still holding on to the only arena.
+     */
+    auto arena = pool->lease(rawSize);
+    ASSERT_NE(arena, nullptr);
+    ASSERT_EQ(pool->misses(), misses + 1);
+  }
+
+  auto arena = pool->lease(rawSize);
+  ASSERT_NE(arena, nullptr);
+  ASSERT_EQ(pool->hits(), hits + 1);
+}
+
+#endif  // RL_CHANNELS == RL_CHANNELS_SOCKET
+
 }  // namespace testing
 }  // namespace core
 }  // namespace rl
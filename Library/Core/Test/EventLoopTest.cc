@@ -6,6 +6,7 @@
 #include <Core/EventLoop.h>
 #include <TestRunner/TestRunner.h>
 #include <thread>
+#include <vector>
 
 namespace rl {
 namespace core {
@@ -140,6 +141,75 @@ TEST_SLOW(EventLoopTest, TrivialTriggerFiresOnces) {
   ASSERT_EQ(count, 1u);
 }
 
+TEST(EventLoopTest, DispatchesAllSignalledSources) {
+  const size_t sourceCount = 200;
+  size_t count = 0;
+
+  std::thread thread([&count, sourceCount] {
+    auto loop = EventLoop::Current();
+
+    std::vector<std::shared_ptr<EventLoopSource>> sources;
+
+    for (size_t i = 0; i < sourceCount; i++) {
+      auto source = EventLoopSource::Trivial();
+      source->setWakeFunction([&count, sourceCount, loop](IOResult) {
+        if (++count == sourceCount) {
+          loop->terminate();
+        }
+      });
+      loop->addSource(source);
+      source->writer()(source->handles().writeHandle);
+      sources.emplace_back(std::move(source));
+    }
+
+    loop->loop();
+
+    for (const auto& source : sources) {
+      loop->removeSource(source);
+    }
+  });
+
+  thread.join();
+
+  ASSERT_EQ(count, sourceCount);
+}
+
+TEST(EventLoopTest, RemovedSourcesAreNotDispatched) {
+  size_t count = 0;
+
+  std::thread thread([&count] {
+    auto loop = EventLoop::Current();
+
+    std::vector<std::shared_ptr<EventLoopSource>> sources;
+
+    for (size_t i = 0; i < 10; i++) {
+      sources.emplace_back(EventLoopSource::Trivial());
+    }
+
+    /*
+     *  All sources are signalled and harvested together. The first one to be
+     *  dispatched removes the rest.
+     */
+    for (const auto& source : sources) {
+      source->setWakeFunction([&count, &sources, loop](IOResult) {
+        count++;
+        for (const auto& other : sources) {
+          loop->removeSource(other);
+        }
+        loop->terminate();
+      });
+      loop->addSource(source);
+      source->writer()(source->handles().writeHandle);
+    }
+
+    loop->loop();
+  });
+
+  thread.join();
+
+  ASSERT_EQ(count, 1u);
+}
+
 }  // namespace testing
 }  // namespace core
 }  // namespace rl
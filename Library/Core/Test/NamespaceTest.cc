@@ -53,6 +53,17 @@ TEST(NamespaceTest, NamesWithCounterparts) {
   ASSERT_EQ(ns.mappedNamesCount(), 3u);
 }
 
+TEST(NamespaceTest, MappedNamesKnowTheirCounterparts) {
+  Namespace ns;
+
+  auto local = Name{ns};
+  auto mapped = Name{42, ns};
+
+  ASSERT_EQ(local.counterpart(), DeadHandle);
+  ASSERT_EQ(mapped.counterpart(), 42u);
+  ASSERT_EQ(Name{}.counterpart(), DeadHandle);
+}
+
 TEST(NamespaceTest, NamesWithCounterpartsWithRepeat) {
   Namespace ns;
 
@@ -6,7 +6,10 @@
 #include "Config.h"
 
 #include <Core/SharedMemory.h>
+#include <Core/SharedMemoryArenaPool.h>
 #include <TestRunner/TestRunner.h>
+#include <unistd.h>
+#include <cstring>
 
 namespace rl {
 namespace core {
@@ -21,6 +24,172 @@ TEST(SharedMemoryTest, SimpleInitialization) {
   ASSERT_EQ(memory.size(), 1024u);
 }
 
+TEST(SharedMemoryTest, SealPreservesContents) {
+  rl::core::SharedMemory memory(1024);
+  ASSERT_TRUE(memory.isReady());
+
+  memset(memory.address(), 'a', memory.size());
+
+  auto enforced = memory.seal();
+
+  ASSERT_TRUE(memory.isReady());
+  ASSERT_EQ(memory.size(), 1024u);
+  ASSERT_EQ(memory.address()[0], 'a');
+  ASSERT_EQ(memory.address()[1023], 'a');
+
+  if (enforced) {
+    /*
+     *  Other handles to the same memory may not modify it either.
+     */
+    uint8_t byte = 'b';
+    ASSERT_EQ(pwrite(memory.handle(), &byte, 1, 0), -1);
+    ASSERT_EQ(ftruncate(memory.handle(), 2048), -1);
+  }
+
+  auto handle = memory.takeHandle();
+  ASSERT_NE(handle, -1);
+  ASSERT_EQ(memory.handle(), -1);
+  ASSERT_EQ(memory.address()[512], 'a');
+  ASSERT_EQ(close(handle), 0);
+}
+
+TEST(SharedMemoryTest, ArenaReferences) {
+  SharedMemoryArena arena(1024);
+
+  ASSERT_TRUE(arena.isReady());
+  ASSERT_EQ(arena.capacity(), 1024u);
+  ASSERT_NE(arena.data(), nullptr);
+
+  ASSERT_TRUE(arena.acquire());
+  ASSERT_FALSE(arena.acquire());
+  arena.retain();
+  arena.release();
+  ASSERT_FALSE(arena.acquire());
+  arena.release();
+  ASSERT_TRUE(arena.acquire());
+  arena.release();
+
+  /*
+   *  Releasing an unreferenced arena must not wrap around.
+   */
+  arena.release();
+  ASSERT_TRUE(arena.acquire());
+}
+
+TEST(SharedMemoryTest, ArenaFromHandle) {
+  SharedMemoryArena arena(1024);
+  ASSERT_TRUE(arena.isReady());
+  memset(arena.data(), 'a', 1024);
+  arena.setLength(512);
+  ASSERT_TRUE(arena.acquire());
+  arena.retain();
+
+  auto mapped = SharedMemoryArena::Receive(::dup(arena.handle()));
+  ASSERT_TRUE(mapped->isReady());
+  ASSERT_EQ(mapped->handle(), -1);
+  ASSERT_EQ(mapped->length(), 512u);
+  ASSERT_GE(mapped->capacity(), 1024u);
+  ASSERT_EQ(mapped->data()[511], 'a');
+
+  /*
+   *  The reader releasing its reference hands the arena back once the writer
+   *  is done with it too.
+   */
+  mapped = nullptr;
+  ASSERT_FALSE(arena.acquire());
+  arena.release();
+  ASSERT_TRUE(arena.acquire());
+}
+
+TEST(SharedMemoryTest, ArenaPoolRecyclesArenas) {
+  SharedMemoryArenaPool pool(1024);
+
+  {
+    auto arena = pool.lease(10000);
+    ASSERT_NE(arena, nullptr);
+    ASSERT_GE(arena->capacity(), 10000u);
+    ASSERT_EQ(pool.hits(), 0u);
+    ASSERT_EQ(pool.misses(), 1u);
+  }
+
+  {
+    auto arena = pool.lease(9000);
+    ASSERT_NE(arena, nullptr);
+    ASSERT_EQ(pool.hits(), 1u);
+    ASSERT_EQ(pool.misses(), 1u);
+
+    /*
+     *  The first arena is still leased. This one must be new.
+     */
+    auto another = pool.lease(9000);
+    ASSERT_NE(another, nullptr);
+    ASSERT_NE(another->data(), arena->data());
+    ASSERT_EQ(pool.hits(), 1u);
+    ASSERT_EQ(pool.misses(), 2u);
+  }
+
+  /*
+   *  Leases that would waste most of the arena get a new one.
+   */
+  auto small = pool.lease(10);
+  ASSERT_NE(small, nullptr);
+  ASSERT_EQ(pool.misses(), 3u);
+}
+
+TEST(SharedMemoryTest, ArenaPoolWaitsForReaders) {
+  SharedMemoryArenaPool pool(4096);
+
+  SharedMemoryArena* leased = nullptr;
+
+  {
+    auto arena = pool.lease(8192);
+    ASSERT_NE(arena, nullptr);
+    leased = arena.get();
+    /*
+     *  Reference on behalf of a reader.
+     */
+    arena->retain();
+  }
+
+  auto arena = pool.lease(8192);
+  ASSERT_NE(arena.get(), leased);
+  ASSERT_EQ(pool.misses(), 2u);
+  arena = nullptr;
+
+  leased->release();
+
+  arena = pool.lease(8192);
+  ASSERT_EQ(pool.hits(), 1u);
+}
+
+TEST(SharedMemoryTest, ArenaPoolRespectsBudget) {
+  SharedMemoryArenaPool pool(1024, 16384);
+
+  {
+    auto arena = pool.lease(16384);
+    ASSERT_NE(arena, nullptr);
+    ASSERT_EQ(pool.pooledBytes(), 16384u);
+  }
+
+  {
+    /*
+     *  The unused arena is evicted to make space.
+     */
+    auto arena = pool.lease(1024);
+    ASSERT_NE(arena, nullptr);
+    ASSERT_EQ(pool.pooledBytes(), 1024u);
+
+    /*
+     *  Arenas larger than the budget are never pooled.
+     */
+    auto large = pool.lease(32768);
+    ASSERT_NE(large, nullptr);
+    ASSERT_EQ(pool.pooledBytes(), 1024u);
+  }
+
+  ASSERT_EQ(pool.misses(), 3u);
+}
+
 #endif  // RL_SHMEM != RL_SHMEM_DISABLED
 
 }  // namespace testing
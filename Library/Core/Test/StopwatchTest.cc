@@ -56,6 +56,21 @@ TEST_SLOW(StopwatchTest, SimpleStopwatchWithLaps) {
   ASSERT_LE(stopwatch.lastLap().count(), .15);
 }
 
+TEST(StopwatchTest, RecordLaps) {
+  rl::instrumentation::Stopwatch stopwatch(2);
+
+  stopwatch.recordLap(ClockDurationSeconds(0.5));
+  ASSERT_DOUBLE_EQ(stopwatch.lastLap().count(), 0.5);
+
+  stopwatch.recordLap(ClockDurationSeconds(0.25));
+  ASSERT_DOUBLE_EQ(stopwatch.lastLap().count(), 0.25);
+  ASSERT_DOUBLE_EQ(stopwatch.lapDuration(0).count(), 0.5);
+
+  stopwatch.recordLap(ClockDurationSeconds(0.125));
+  ASSERT_DOUBLE_EQ(stopwatch.lapDuration(0).count(), 0.125);
+  ASSERT_DOUBLE_EQ(stopwatch.lapDuration(1).count(), 0.25);
+}
+
 }  // namespace testing
 }  // namespace core
 }  // namespace rl
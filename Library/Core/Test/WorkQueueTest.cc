@@ -8,12 +8,12 @@
 #include <Core/WorkQueue.h>
 #include <TestRunner/TestRunner.h>
 
-#if RL_OS_MAC
-
 namespace rl {
 namespace core {
 namespace testing {
 
+#if RL_OS_MAC
+
 TEST(WorkQueue, SimpleInitialization) {
   WorkQueue queue;
   ASSERT_GE(queue.workerCount(), 0u);
@@ -35,8 +35,79 @@ TEST_SLOW(WorkQueue, SimpleWork) {
   ASSERT_EQ(size, count.load());
 }
 
+#endif  //  RL_OS_MAC
+
+TEST(WorkQueue, WorkStealingInitialization) {
+  WorkQueue queue(WorkQueue::Mode::WorkStealing, 3);
+  ASSERT_EQ(queue.mode(), WorkQueue::Mode::WorkStealing);
+  ASSERT_EQ(queue.workerCount(), 3u);
+}
+
+TEST_SLOW(WorkQueue, WorkStealingSimpleWork) {
+  auto size = 5000;
+  std::atomic<int> count(0);
+
+  {
+    WorkQueue queue(WorkQueue::Mode::WorkStealing, 4);
+
+    for (int i = 0; i < size; i++) {
+      ASSERT_TRUE(queue.dispatch([&count]() { count++; }));
+    }
+  }
+
+  ASSERT_EQ(size, count.load());
+}
+
+TEST_SLOW(WorkQueue, WorkStealingBatchDispatch) {
+  const size_t size = 5000;
+  std::atomic<size_t> count(0);
+  Latch latch(size);
+
+  WorkQueue queue(WorkQueue::Mode::WorkStealing, 4);
+
+  std::vector<WorkQueue::WorkItem> items(size, [&count, &latch]() {
+    count++;
+    latch.countDown();
+  });
+  ASSERT_TRUE(queue.dispatch(items.begin(), items.end()));
+
+  latch.wait();
+  ASSERT_EQ(size, count.load());
+}
+
+TEST(WorkQueue, BatchDispatchRejectsEmptyItems) {
+  WorkQueue queue(WorkQueue::Mode::WorkStealing, 1);
+  std::vector<WorkQueue::WorkItem> items = {[]() {}, nullptr};
+  ASSERT_FALSE(queue.dispatch(items.begin(), items.end()));
+}
+
+TEST_SLOW(WorkQueue, WorkStealingNestedDispatch) {
+  const size_t fanout = 64;
+  std::atomic<size_t> count(0);
+  Latch latch(fanout * fanout);
+
+  WorkQueue queue(WorkQueue::Mode::WorkStealing, 4);
+
+  for (size_t i = 0; i < fanout; i++) {
+    ASSERT_TRUE(queue.dispatch([&]() {
+      /*
+       *  Items dispatched from a worker go on its own deque and are stolen by
+       *  its peers.
+       */
+      for (size_t j = 0; j < fanout; j++) {
+        auto dispatched = queue.dispatch([&]() {
+          count++;
+          latch.countDown();
+        });
+        RL_ASSERT(dispatched);
+      }
+    }));
+  }
+
+  latch.wait();
+  ASSERT_EQ(fanout * fanout, count.load());
+}
+
 }  // namespace testing
 }  // namespace core
 }  // namespace rl
-
-#endif  //  RL_OS_MAC
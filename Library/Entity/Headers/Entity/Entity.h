@@ -223,9 +223,21 @@ class Entity : public core::ArchiveSerializable {
       Property property,
       core::Name identifier = core::Name() /* dead name */) const;
 
+  /**
+   *  Invoked after properties of the entity are updated via its setters or by
+   *  merging properties from another entity. Subclasses may use this to
+   *  invalidate state derived from those properties. The base implementation
+   *  does nothing.
+   *
+   *  @param properties the mask of the properties that were updated
+   */
+  virtual void didUpdateProperties(PropertyMaskType properties);
+
  private:
   UpdateCallback _updateCallback;
 
+  void didUpdateProperty(Property property);
+
   RL_DISALLOW_COPY_AND_ASSIGN(Entity);
 };
 
@@ -61,6 +61,10 @@ void Entity::mergeProperties(const Entity& entity, PropertyMaskType only) {
   if (only & PropertyMask::PathMask) {
     _path = entity._path;
   }
+
+  if (only != 0) {
+    didUpdateProperties(only);
+  }
 }
 
 core::Name Entity::identifier() const {
@@ -87,7 +91,7 @@ const geom::Rect& Entity::bounds() const {
 
 void Entity::setBounds(const geom::Rect& bounds) {
   _bounds = bounds;
-  notifyInterfaceIfNecessary(Property::Bounds);
+  didUpdateProperty(Property::Bounds);
 }
 
 const geom::Point& Entity::position() const {
@@ -96,7 +100,7 @@ const geom::Point& Entity::position() const {
 
 void Entity::setPosition(const geom::Point& position) {
   _position = position;
-  notifyInterfaceIfNecessary(Property::Position);
+  didUpdateProperty(Property::Position);
 }
 
 const geom::Point& Entity::anchorPoint() const {
@@ -105,7 +109,7 @@ const geom::Point& Entity::anchorPoint() const {
 
 void Entity::setAnchorPoint(const geom::Point& anchorPoint) {
   _anchorPoint = anchorPoint;
-  notifyInterfaceIfNecessary(Property::AnchorPoint);
+  didUpdateProperty(Property::AnchorPoint);
 }
 
 const geom::Matrix& Entity::transformation() const {
@@ -114,7 +118,7 @@ const geom::Matrix& Entity::transformation() const {
 
 void Entity::setTransformation(const geom::Matrix& transformation) {
   _transformation = transformation;
-  notifyInterfaceIfNecessary(Property::Transformation);
+  didUpdateProperty(Property::Transformation);
 }
 
 geom::Matrix Entity::modelMatrix() const {
@@ -151,7 +155,7 @@ const Color& Entity::backgroundColor() const {
 
 void Entity::setBackgroundColor(const Color& backgroundColor) {
   _backgroundColor = backgroundColor;
-  notifyInterfaceIfNecessary(Property::BackgroundColor);
+  didUpdateProperty(Property::BackgroundColor);
 }
 
 const double& Entity::opacity() const {
@@ -160,7 +164,7 @@ const double& Entity::opacity() const {
 
 void Entity::setOpacity(double opacity) {
   _opacity = opacity;
-  notifyInterfaceIfNecessary(Property::Opacity);
+  didUpdateProperty(Property::Opacity);
 }
 
 const Color& Entity::strokeColor() const {
@@ -169,7 +173,7 @@ const Color& Entity::strokeColor() const {
 
 void Entity::setStrokeColor(const Color& strokeColor) {
   _strokeColor = strokeColor;
-  notifyInterfaceIfNecessary(Property::StrokeColor);
+  didUpdateProperty(Property::StrokeColor);
 }
 
 double Entity::strokeSize() const {
@@ -178,7 +182,7 @@ double Entity::strokeSize() const {
 
 void Entity::setStrokeSize(double strokeSize) {
   _strokeSize = strokeSize;
-  notifyInterfaceIfNecessary(Property::StrokeSize);
+  didUpdateProperty(Property::StrokeSize);
 }
 
 const image::Image& Entity::contents() const {
@@ -187,7 +191,7 @@ const image::Image& Entity::contents() const {
 
 void Entity::setContents(image::Image image) {
   _contents = std::move(image);
-  notifyInterfaceIfNecessary(Property::Contents);
+  didUpdateProperty(Property::Contents);
 }
 
 const geom::Path& Entity::path() const {
@@ -196,7 +200,14 @@ const geom::Path& Entity::path() const {
 
 void Entity::setPath(geom::Path path) {
   _path = std::move(path);
-  notifyInterfaceIfNecessary(Property::Path);
+  didUpdateProperty(Property::Path);
+}
+
+void Entity::didUpdateProperties(PropertyMaskType) {}
+
+void Entity::didUpdateProperty(Property property) {
+  didUpdateProperties(1 << static_cast<PropertyMaskType>(property));
+  notifyInterfaceIfNecessary(property);
 }
 
 void Entity::notifyInterfaceIfNecessary(Property property,
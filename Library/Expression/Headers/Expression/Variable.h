@@ -7,6 +7,8 @@
 
 #include <Core/Utilities.h>
 #include <Entity/Entity.h>
+#include <utility>
+#include <vector>
 
 namespace rl {
 namespace expr {
@@ -62,6 +64,19 @@ class Variable : public core::ArchiveSerializable,
                           Property property,
                           double value);
 
+  /**
+   *  Set the properties of all the variables on the entity. Each entity
+   *  property is only updated once, irrespective of how many of its
+   *  components are set.
+   *
+   *  @param entity the entity whose properties are set
+   *  @param values the variables and their values. All variables must refer to
+   *                the given entity.
+   */
+  static void SetProperties(
+      entity::Entity& entity,
+      const std::vector<std::pair<Variable, double>>& values);
+
   bool serialize(core::Message& message) const override;
 
   bool deserialize(core::Message& message, core::Namespace* ns) override;
@@ -108,6 +108,70 @@ void Variable::SetProperty(entity::Entity& entity,
   }
 }
 
+void Variable::SetProperties(
+    entity::Entity& entity,
+    const std::vector<std::pair<Variable, double>>& values) {
+  auto bounds = entity.bounds();
+  auto position = entity.position();
+  auto anchor = entity.anchorPoint();
+
+  bool boundsUpdated = false;
+  bool positionUpdated = false;
+  bool anchorUpdated = false;
+
+  for (const auto& value : values) {
+    switch (value.first.property()) {
+      case Property::BoundsOriginX:
+        bounds.origin.x = value.second;
+        boundsUpdated = true;
+        break;
+      case Property::BoundsOriginY:
+        bounds.origin.y = value.second;
+        boundsUpdated = true;
+        break;
+      case Property::BoundsWidth:
+        bounds.size.width = value.second;
+        boundsUpdated = true;
+        break;
+      case Property::BoundsHeight:
+        bounds.size.height = value.second;
+        boundsUpdated = true;
+        break;
+      case Property::PositionX:
+        position.x = value.second;
+        positionUpdated = true;
+        break;
+      case Property::PositionY:
+        position.y = value.second;
+        positionUpdated = true;
+        break;
+      case Property::AnchorPointX:
+        anchor.x = value.second;
+        anchorUpdated = true;
+        break;
+      case Property::AnchorPointY:
+        anchor.y = value.second;
+        anchorUpdated = true;
+        break;
+      case Property::None:
+        RL_ASSERT(false);
+        break;
+    }
+  }
+
+  if (boundsUpdated) {
+    entity.setBounds(bounds);
+  }
+
+  if (positionUpdated) {
+    entity.setPosition(position);
+  }
+
+  if (anchorUpdated) {
+    entity.setAnchorPoint(anchor);
+  }
+}
+
 bool Variable::serialize(core::Message& message) const {
   RL_RETURN_IF_FALSE(message.encode(_identifier));
   RL_RETURN_IF_FALSE(message.encode(_property));
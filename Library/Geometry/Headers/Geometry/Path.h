@@ -67,6 +67,18 @@ class Path : public core::MessageSerializable {
 
   Rect boundingBox() const;
 
+  /**
+   *  Hashes the components of the path. Paths with the same components hash
+   *  the same regardless of how they were constructed.
+   */
+  struct Hash {
+    std::size_t operator()(const Path& path) const;
+  };
+
+  struct Equal {
+    bool operator()(const Path& lhs, const Path& rhs) const;
+  };
+
  private:
   struct ComponentIndexPair {
     ComponentType type;
@@ -59,6 +59,23 @@ struct Rect {
 
   bool isZero() const { return size.isZero(); }
 
+  /**
+   *  @return if this rect and the given rect share any area. Rects that only
+   *          touch along an edge don't intersect.
+   */
+  bool intersects(const Rect& r) const;
+
+  /**
+   *  @return the smallest rect containing both this rect and the given rect
+   */
+  Rect unionWith(const Rect& r) const;
+
+  /**
+   *  @return the area shared by this rect and the given rect. Rects that don't
+   *          intersect have a zero sized intersection.
+   */
+  Rect intersection(const Rect& r) const;
+
   Rect withPoint(const Point& p) const;
 
   Rect withPoints(const std::vector<Point>& points) const;
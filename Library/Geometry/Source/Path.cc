@@ -4,6 +4,7 @@
  */
 
 #include <Core/Message.h>
+#include <Core/Utilities.h>
 #include <Geometry/Path.h>
 
 namespace rl {
@@ -33,6 +34,54 @@ bool Path::deserialize(core::Message& message, core::Namespace* ns) {
   return true;
 }
 
+static void HashPoint(size_t& hash, const Point& point) {
+  core::HashCombine(hash, point.x);
+  core::HashCombine(hash, point.y);
+}
+
+std::size_t Path::Hash::operator()(const Path& path) const {
+  size_t hash = 0;
+
+  core::HashCombine(hash, path._components.size());
+
+  for (const auto& linear : path._linears) {
+    HashPoint(hash, linear.p1);
+    HashPoint(hash, linear.p2);
+  }
+
+  for (const auto& quad : path._quads) {
+    HashPoint(hash, quad.p1);
+    HashPoint(hash, quad.cp);
+    HashPoint(hash, quad.p2);
+  }
+
+  for (const auto& cubic : path._cubics) {
+    HashPoint(hash, cubic.p1);
+    HashPoint(hash, cubic.cp1);
+    HashPoint(hash, cubic.cp2);
+    HashPoint(hash, cubic.p2);
+  }
+
+  return hash;
+}
+
+bool Path::Equal::operator()(const Path& lhs, const Path& rhs) const {
+  if (lhs._components.size() != rhs._components.size()) {
+    return false;
+  }
+
+  for (size_t i = 0, count = lhs._components.size(); i < count; i++) {
+    const auto& left = lhs._components[i];
+    const auto& right = rhs._components[i];
+    if (left.type != right.type || left.index != right.index) {
+      return false;
+    }
+  }
+
+  return lhs._linears == rhs._linears && lhs._quads == rhs._quads &&
+         lhs._cubics == rhs._cubics;
+}
+
 Path& Path::addLinearComponent(Point p1, Point p2) {
   _linears.emplace_back(p1, p2);
   _components.emplace_back(ComponentType::Linear, _linears.size() - 1);
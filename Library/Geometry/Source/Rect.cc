@@ -4,6 +4,7 @@
  */
 
 #include <Geometry/Rect.h>
+#include <algorithm>
 #include <sstream>
 
 namespace rl {
@@ -40,6 +41,37 @@ Rect Rect::withPoints(const std::vector<Point>& points) const {
   return box;
 }
 
+bool Rect::intersects(const Rect& r) const {
+  return origin.x < r.origin.x + r.size.width &&
+         r.origin.x < origin.x + size.width &&
+         origin.y < r.origin.y + r.size.height &&
+         r.origin.y < origin.y + size.height;
+}
+
+Rect Rect::unionWith(const Rect& r) const {
+  const double minX = std::min(origin.x, r.origin.x);
+  const double minY = std::min(origin.y, r.origin.y);
+  const double maxX =
+      std::max(origin.x + size.width, r.origin.x + r.size.width);
+  const double maxY =
+      std::max(origin.y + size.height, r.origin.y + r.size.height);
+  return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
+Rect Rect::intersection(const Rect& r) const {
+  if (!intersects(r)) {
+    return Rect{};
+  }
+
+  const double minX = std::max(origin.x, r.origin.x);
+  const double minY = std::max(origin.y, r.origin.y);
+  const double maxX =
+      std::min(origin.x + size.width, r.origin.x + r.size.width);
+  const double maxY =
+      std::min(origin.y + size.height, r.origin.y + r.size.height);
+  return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
 std::string Rect::toString() const {
   std::stringstream stream;
   stream << origin.x << "," << origin.y << "," << size.width << ","
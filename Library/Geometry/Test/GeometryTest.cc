@@ -167,3 +167,24 @@ TEST(GeometryTest, RectWithPoint) {
   expected = rl::geom::Rect{-25, -25, 150, 160};
   ASSERT_RECT_NEAR(rect, expected);
 }
+
+TEST(GeometryTest, RectIntersectsAndUnion) {
+  auto rect = rl::geom::Rect{0, 0, 100, 100};
+
+  ASSERT_TRUE(rect.intersects({50, 50, 100, 100}));
+  ASSERT_TRUE(rect.intersects({-10, -10, 20, 20}));
+  ASSERT_TRUE(rect.intersects({10, 10, 10, 10}));
+  ASSERT_FALSE(rect.intersects({100, 0, 10, 10}));
+  ASSERT_FALSE(rect.intersects({0, 150, 10, 10}));
+
+  ASSERT_RECT_NEAR(rect.unionWith({50, 50, 100, 100}),
+                   rl::geom::Rect(0, 0, 150, 150));
+  ASSERT_RECT_NEAR(rect.unionWith({-10, 20, 5, 5}),
+                   rl::geom::Rect(-10, 0, 110, 100));
+
+  ASSERT_RECT_NEAR(rect.intersection({50, 50, 100, 100}),
+                   rl::geom::Rect(50, 50, 50, 50));
+  ASSERT_RECT_NEAR(rect.intersection({-10, 20, 20, 5}),
+                   rl::geom::Rect(0, 20, 10, 5));
+  ASSERT_TRUE(rect.intersection({100, 0, 10, 10}).isZero());
+}
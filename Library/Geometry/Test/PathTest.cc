@@ -112,3 +112,30 @@ TEST(PathTest, BoundingBoxOfCompositePathIsCorrect) {
   rl::geom::Rect expected(0, 0, 310, 310);
   ASSERT_RECT_NEAR(actual, expected);
 }
+
+TEST(PathTest, HashAndEqualityFollowComponents) {
+  rl::geom::PathBuilder builder;
+  builder.addRoundedRect({{10, 10}, {300, 300}}, {50, 50, 50, 50});
+
+  auto path = builder.path();
+  auto copy = builder.path();
+
+  rl::geom::Path::Hash hash;
+  rl::geom::Path::Equal equal;
+
+  ASSERT_TRUE(equal(path, copy));
+  ASSERT_EQ(hash(path), hash(copy));
+
+  size_t index = 0;
+  rl::geom::LinearPathComponent linear;
+  while (!copy.linearComponentAtIndex(index, linear)) {
+    ASSERT_LT(++index, copy.componentCount());
+  }
+  linear.p2.x += 1.0;
+  ASSERT_TRUE(copy.updateLinearComponentAtIndex(index, linear));
+
+  ASSERT_FALSE(equal(path, copy));
+  ASSERT_NE(hash(path), hash(copy));
+
+  ASSERT_FALSE(equal(path, rl::geom::Path{}));
+}
@@ -4,7 +4,12 @@
  */
 
 #include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/Channel.h>
 #include <Image/Image.h>
+#include <Image/ImageCache.h>
+#include <cstring>
+#include <string>
+#include <thread>
 
 static void BenchDecodeJPG(benchmark::State& state) {
   rl::core::FileHandle file(rl::core::URI{"file://Beachball.jpg"});
@@ -62,7 +67,171 @@ static void BenchDecodePNGFromAllocation(benchmark::State& state) {
   }
 }
 
+static void BenchDecodeJPGWithSizeHint(benchmark::State& state) {
+  rl::core::FileHandle file(rl::core::URI{"file://Beachball.jpg"});
+
+  rl::image::Image image(std::move(file));
+
+  while (state.KeepRunning()) {
+    auto res = image.decode(rl::geom::Size{64, 64});
+    RL_ASSERT(res.wasSuccessful());
+  }
+}
+
+static void BenchDecodePNGWithSizeHint(benchmark::State& state) {
+  rl::core::FileHandle file(rl::core::URI{"file://Beachball.png"});
+
+  rl::image::Image image(std::move(file));
+
+  while (state.KeepRunning()) {
+    auto res = image.decode(rl::geom::Size{64, 64});
+    RL_ASSERT(res.wasSuccessful());
+  }
+}
+
+/**
+ *  Create a square RGB image of the given size encoded as a binary PPM. The
+ *  format is cheap to decode so that the reduction dominates.
+ */
+static rl::image::Image LargeImage(size_t size) {
+  const auto header =
+      "P6\n" + std::to_string(size) + " " + std::to_string(size) + "\n255\n";
+
+  rl::core::Allocation allocation;
+  RL_ASSERT(allocation.resize(header.size() + size * size * 3));
+  memmove(allocation.data(), header.data(), header.size());
+  for (size_t i = header.size(); i < allocation.size(); i++) {
+    allocation.data()[i] = static_cast<uint8_t>(i);
+  }
+
+  return rl::image::Image{std::move(allocation)};
+}
+
+static void BenchDecodeLargeImage(benchmark::State& state) {
+  auto image = LargeImage(state.range(0));
+
+  while (state.KeepRunning()) {
+    auto res = image.decode();
+    RL_ASSERT(res.wasSuccessful());
+  }
+}
+
+static void BenchDecodeLargeImageWithSizeHint(benchmark::State& state) {
+  auto image = LargeImage(state.range(0));
+
+  while (state.KeepRunning()) {
+    auto res = image.decode(rl::geom::Size{512, 512});
+    RL_ASSERT(res.wasSuccessful());
+  }
+}
+
+/*
+ *  Each iteration decodes a separately received copy of the same image. Only
+ *  the first copy is decoded. The rest hash their contents and hit the cache.
+ */
+static void BenchDecodePNGFromCache(benchmark::State& state) {
+  rl::core::FileHandle file(rl::core::URI{"file://Beachball.png"});
+
+  rl::core::FileMapping map(file);
+
+  rl::image::ImageCache cache(rl::image::ImageCache::DefaultByteBudget);
+
+  while (state.KeepRunning()) {
+    rl::core::Allocation allocation;
+    RL_ASSERT(allocation.resize(map.size()));
+    memmove(allocation.data(), map.mapping(), map.size());
+
+    auto res = cache.decode(rl::image::Image{std::move(allocation)});
+    RL_ASSERT(res != nullptr);
+  }
+}
+
+/*
+ *  Each iteration sends an image with the given size of encoded data over a
+ *  channel and reads all its encoded bytes on the other end. The bytes are
+ *  not a valid image since only the cost of the transfer is of interest.
+ */
+static void SendImages(benchmark::State& state, bool sharedMemory) {
+  const size_t size = state.range(0) << 20;
+
+  rl::core::Channel channel;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    rl::image::Image image;
+    if (sharedMemory) {
+      auto memory = std::make_unique<rl::core::SharedMemory>(size);
+      RL_ASSERT(memory->isReady());
+      memset(memory->address(), 'a', size);
+      image = rl::image::Image{std::move(memory)};
+    } else {
+      rl::core::Allocation allocation;
+      RL_ASSERT(allocation.resize(size));
+      memset(allocation.data(), 'a', size);
+      image = rl::image::Image{std::move(allocation)};
+    }
+    state.ResumeTiming();
+
+    std::thread writer([&channel, &image]() {
+      rl::core::Message message;
+      RL_ASSERT(message.encode(image));
+      rl::core::Messages messages;
+      messages.emplace_back(std::move(message));
+      auto result = channel.sendMessages(std::move(messages));
+      RL_ASSERT(result == rl::core::IOResult::Success);
+    });
+
+    rl::core::Messages received;
+    while (received.empty()) {
+      received =
+          channel.drainPendingMessages(rl::core::ClockDurationMilli(1000), 1);
+    }
+
+    rl::image::Image decoded;
+    auto decodedImage = received.front().decode(decoded, nullptr);
+    RL_ASSERT(decodedImage);
+
+    /*
+     *  Hashing the contents touches every encoded byte like a decoder would.
+     */
+    benchmark::DoNotOptimize(rl::image::Image::Hash()(decoded));
+
+    writer.join();
+  }
+
+  state.SetBytesProcessed(state.iterations() * size);
+}
+
+static void BenchSendImageFromAllocation(benchmark::State& state) {
+  SendImages(state, false);
+}
+
+static void BenchSendImageFromSharedMemory(benchmark::State& state) {
+  SendImages(state, true);
+}
+
 BENCHMARK(BenchDecodeJPG);
 BENCHMARK(BenchDecodePNG);
 BENCHMARK(BenchDecodeJPGFromAllocation);
 BENCHMARK(BenchDecodePNGFromAllocation);
+BENCHMARK(BenchDecodePNGFromCache);
+BENCHMARK(BenchDecodeJPGWithSizeHint);
+BENCHMARK(BenchDecodePNGWithSizeHint);
+BENCHMARK(BenchDecodeLargeImage)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(2048)
+    ->Arg(4096);
+BENCHMARK(BenchDecodeLargeImageWithSizeHint)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(2048)
+    ->Arg(4096);
+BENCHMARK(BenchSendImageFromAllocation)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50);
+BENCHMARK(BenchSendImageFromSharedMemory)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50);
@@ -7,6 +7,7 @@
 
 #include <Core/File.h>
 #include <Core/MessageSerializable.h>
+#include <Core/SharedMemory.h>
 #include <Geometry/Size.h>
 #include <Image/ImageResult.h>
 
@@ -23,20 +24,69 @@ class Image : public core::MessageSerializable {
 
   Image(core::FileHandle sourceFile);
 
+  /**
+   *  Create an image from encoded bytes written into shared memory. The memory
+   *  is sealed and may no longer be written to. When the image is sent to
+   *  another process, only a handle to the memory is sent along and the bytes
+   *  are decoded directly from a read-only mapping on the other end.
+   *
+   *  Prefer this over images created from allocations for large images that
+   *  are sent to the coordinator.
+   *
+   *  @param encodedData the shared memory containing exactly the encoded image
+   */
+  Image(std::unique_ptr<core::SharedMemory> encodedData);
+
   ~Image();
 
   ImageResult decode() const;
 
+  /**
+   *  Decode the image reduced to about the size it is displayed at. The image
+   *  is reduced by the largest whole factor that keeps it at least as large
+   *  as the hint in both dimensions. Each reduced pixel is the average of the
+   *  block of pixels it covers.
+   *
+   *  The image is still decoded at full size first. It is reduced in place so
+   *  the decode needs no more memory than an unreduced one, and the result is
+   *  cheaper to hold on to and upload.
+   *
+   *  @param sizeHint the size the image is displayed at. A hint that is empty
+   *                  in either dimension does not reduce the image.
+   *
+   *  @return the result of the decode
+   */
+  ImageResult decode(const geom::Size& sizeHint) const;
+
+  /**
+   *  Find the factor by which the image is reduced when decoded with the given
+   *  size hint. Only the header of the encoded image is read, and only if the
+   *  hint is not empty.
+   *
+   *  @param sizeHint the size the image is displayed at
+   *
+   *  @return the reduction factor. Zero if the image could not be read.
+   */
+  size_t reductionFactor(const geom::Size& sizeHint) const;
+
   bool serialize(core::Message& message) const override;
 
   bool deserialize(core::Message& message, core::Namespace* ns) override;
 
   bool isValid() const;
 
+  /**
+   *  Hashes the encoded contents of the image. Images created from the same
+   *  bytes hash the same even if they were sent separately or by different
+   *  interfaces.
+   */
   struct Hash {
     std::size_t operator()(const Image& key) const;
   };
 
+  /**
+   *  Compares the encoded contents of the images.
+   */
   struct Equal {
     bool operator()(const Image& lhs, const Image& rhs) const;
   };
@@ -0,0 +1,187 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Core/Utilities.h>
+#include <Core/WorkQueue.h>
+#include <Image/Image.h>
+#include <future>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace rl {
+namespace image {
+
+/**
+ *  A process wide cache of decoded images. Images are keyed on the contents of
+ *  their encoded bytes (not the identity of their source) so the same image
+ *  sent by different interfaces, or sent again in a later transaction, is only
+ *  decoded once. Images decoded with size hints are cached separately for each
+ *  factor they are reduced by.
+ *
+ *  The cache is bounded by the size of the decoded pixel data it holds. The
+ *  least recently used images are evicted first. Decoded images still in use
+ *  stay alive after eviction till their last reference is dropped.
+ *
+ *  Concurrent requests for an image that is still being decoded wait for and
+ *  share the result of the decode already in progress.
+ *
+ *  The cache may be used on any thread.
+ */
+class ImageCache {
+ public:
+  using DecodedImage = std::shared_ptr<const ImageResult>;
+
+  /**
+   *  A snapshot of the effectiveness of the cache.
+   */
+  struct Statistics {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+
+    Statistics() : hits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+  };
+
+  static const size_t DefaultByteBudget;
+
+  /**
+   *  @return the cache shared by all textures in the process
+   */
+  static ImageCache& Shared();
+
+  /**
+   *  Create a cache bounded by the given size of decoded pixel data.
+   *
+   *  @param byteBudget the maximum size of decoded data held by the cache
+   */
+  ImageCache(size_t byteBudget);
+
+  ~ImageCache();
+
+  /**
+   *  Find the decoded image or decode it on the calling thread and cache the
+   *  result. If the same image is already being decoded, wait for that decode
+   *  instead.
+   *
+   *  @param image    the image to decode
+   *  @param sizeHint the size the image is displayed at. See `Image::decode`.
+   *
+   *  @return the decoded image. Null if the image could not be decoded.
+   */
+  DecodedImage decode(const Image& image, const geom::Size& sizeHint = {});
+
+  /**
+   *  Find the decoded image or decode it on the work queue and cache the
+   *  result. If the same image is already being decoded, the returned future
+   *  shares the result of that decode. The cache must outlive the decode.
+   *
+   *  @param image    the image to decode
+   *  @param queue    the work queue to decode the image on
+   *  @param sizeHint the size the image is displayed at. See `Image::decode`.
+   *
+   *  @return the future decoded image. Null if the image could not be decoded.
+   */
+  std::shared_future<DecodedImage> decodeAsync(
+      const Image& image,
+      core::WorkQueue& queue,
+      const geom::Size& sizeHint = {});
+
+  size_t byteBudget() const;
+
+  /**
+   *  Update the size of decoded data held by the cache. Evicts images
+   *  immediately if the cache is over the new budget.
+   *
+   *  @param byteBudget the new budget
+   */
+  void setByteBudget(size_t byteBudget);
+
+  /**
+   *  Evict all decoded images. Decodes in progress are not affected. The
+   *  counts are preserved.
+   */
+  void purge();
+
+  /**
+   *  @return a snapshot of the statistics of the cache
+   */
+  Statistics statistics() const;
+
+ private:
+  using Pending = std::shared_ptr<std::promise<DecodedImage>>;
+
+  struct Key {
+    Image image;
+    size_t factor;
+    Key(const Image& pImage, size_t pFactor)
+        : image(pImage), factor(pFactor) {}
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        size_t seed = Image::Hash()(key.image);
+        core::HashCombine(seed, static_cast<uint64_t>(key.factor));
+        return seed;
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.factor == rhs.factor &&
+               Image::Equal()(lhs.image, rhs.image);
+      }
+    };
+  };
+
+  struct Entry;
+  using EntryList = std::list<Entry>;
+  using EntryMap =
+      std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal>;
+  using PendingMap = std::unordered_map<Key,
+                                        std::shared_future<DecodedImage>,
+                                        Key::Hash,
+                                        Key::Equal>;
+
+  struct Entry {
+    EntryMap::const_iterator mapEntry;
+    DecodedImage decoded;
+  };
+
+  mutable core::Mutex _lock;
+  size_t _byteBudget RL_GUARDED_BY(_lock);
+  size_t _bytes RL_GUARDED_BY(_lock);
+  size_t _hits RL_GUARDED_BY(_lock);
+  size_t _misses RL_GUARDED_BY(_lock);
+  size_t _evictions RL_GUARDED_BY(_lock);
+  /*
+   *  Ordered from most to least recently used.
+   */
+  EntryList _entries RL_GUARDED_BY(_lock);
+  EntryMap _map RL_GUARDED_BY(_lock);
+  PendingMap _pending RL_GUARDED_BY(_lock);
+
+  /**
+   *  Find the decoded or pending image. On a miss, the image is marked as
+   *  pending and the caller must decode it and call `fulfill`.
+   */
+  std::shared_future<DecodedImage> lookup(const Key& key, Pending& pending);
+
+  void fulfill(const Key& key,
+               const geom::Size& sizeHint,
+               const Pending& pending);
+
+  void evictIfNecessary() RL_REQUIRES(_lock);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(ImageCache);
+};
+
+}  // namespace image
+}  // namespace rl
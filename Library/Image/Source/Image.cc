@@ -6,6 +6,7 @@
 #include <Core/Message.h>
 #include <Image/Image.h>
 #include <stb_image.h>
+#include "ImageReduction.h"
 #include "ImageSource.h"
 
 namespace rl {
@@ -19,6 +20,9 @@ Image::Image(core::Allocation sourceAllocation)
 Image::Image(core::FileHandle sourceFile)
     : _source(ImageSource::Create(std::move(sourceFile))) {}
 
+Image::Image(std::unique_ptr<core::SharedMemory> encodedData)
+    : _source(ImageSource::Create(std::move(encodedData))) {}
+
 Image::~Image() = default;
 
 bool Image::serialize(core::Message& message) const {
@@ -61,6 +65,10 @@ bool Image::deserialize(core::Message& message, core::Namespace* ns) {
 }
 
 ImageResult Image::decode() const {
+  return decode(geom::Size{});
+}
+
+ImageResult Image::decode(const geom::Size& sizeHint) const {
   if (_source == nullptr) {
     return {};
   }
@@ -126,6 +134,22 @@ ImageResult Image::decode() const {
     return {};
   }
 
+  /*
+   *  Reduce the image over its own pixels and give the rest of the allocation
+   *  back.
+   */
+  const auto factor = ImageReductionFactor(width, height, sizeHint);
+  if (factor > 1) {
+    ReduceImageInPlace(destinationAllocation.data(), width, height, comps,
+                       factor);
+    width /= factor;
+    height /= factor;
+    if (!destinationAllocation.resize(width * height * comps)) {
+      RL_LOG("Destination allocation for image decoding was null.");
+      return {};
+    }
+  }
+
   return ImageResult{
       geom::Size{static_cast<double>(width),
                  static_cast<double>(height)},  // size
@@ -134,16 +158,51 @@ ImageResult Image::decode() const {
   };
 }
 
+size_t Image::reductionFactor(const geom::Size& sizeHint) const {
+  if (_source == nullptr) {
+    return 0;
+  }
+
+  if (sizeHint.width < 1.0 || sizeHint.height < 1.0) {
+    return 1;
+  }
+
+  _source->prepareForUse();
+
+  int width = 0;
+  int height = 0;
+  int comps = 0;
+
+  if (!stbi_info_from_memory(_source->sourceData(),      // Source Data
+                             _source->sourceDataSize(),  // Source Data Size
+                             &width,                     // Out: Width
+                             &height,                    // Out: Height
+                             &comps                      // Out: Components
+                             )) {
+    return 0;
+  }
+
+  return ImageReductionFactor(width, height, sizeHint);
+}
+
 bool Image::isValid() const {
   return _source != nullptr;
 }
 
 std::size_t Image::Hash::operator()(const Image& key) const {
-  return std::hash<decltype(key._source)>()(key._source);
+  return key._source == nullptr ? 0 : key._source->contentHash();
 }
 
 bool Image::Equal::operator()(const Image& lhs, const Image& rhs) const {
-  return lhs._source == rhs._source;
+  if (lhs._source == rhs._source) {
+    return true;
+  }
+
+  if (lhs._source == nullptr || rhs._source == nullptr) {
+    return false;
+  }
+
+  return lhs._source->contentEquals(*rhs._source);
 }
 
 }  // namespace image
@@ -0,0 +1,176 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Image/ImageCache.h>
+
+namespace rl {
+namespace image {
+
+const size_t ImageCache::DefaultByteBudget = 64 * 1024 * 1024;
+
+ImageCache& ImageCache::Shared() {
+  static ImageCache cache(DefaultByteBudget);
+  return cache;
+}
+
+ImageCache::ImageCache(size_t byteBudget)
+    : _byteBudget(byteBudget),
+      _bytes(0),
+      _hits(0),
+      _misses(0),
+      _evictions(0) {}
+
+ImageCache::~ImageCache() = default;
+
+ImageCache::DecodedImage ImageCache::decode(const Image& image,
+                                            const geom::Size& sizeHint) {
+  Key key(image, image.reductionFactor(sizeHint));
+
+  Pending pending;
+  auto future = lookup(key, pending);
+
+  if (pending) {
+    fulfill(key, sizeHint, pending);
+  }
+
+  return future.get();
+}
+
+std::shared_future<ImageCache::DecodedImage> ImageCache::decodeAsync(
+    const Image& image,
+    core::WorkQueue& queue,
+    const geom::Size& sizeHint) {
+  Key key(image, image.reductionFactor(sizeHint));
+
+  Pending pending;
+  auto future = lookup(key, pending);
+
+  if (pending) {
+    auto dispatched = queue.dispatch([this, key, sizeHint, pending]() {
+      fulfill(key, sizeHint, pending);
+    });
+    if (!dispatched) {
+      fulfill(key, sizeHint, pending);
+    }
+  }
+
+  return future;
+}
+
+std::shared_future<ImageCache::DecodedImage> ImageCache::lookup(
+    const Key& key,
+    Pending& pending) {
+  core::MutexLocker lock(_lock);
+
+  auto found = _map.find(key);
+  if (found != _map.end()) {
+    _hits++;
+    /*
+     *  Mark the entry as the most recently used.
+     */
+    _entries.splice(_entries.begin(), _entries, found->second);
+
+    std::promise<DecodedImage> ready;
+    ready.set_value(found->second->decoded);
+    return ready.get_future().share();
+  }
+
+  auto inFlight = _pending.find(key);
+  if (inFlight != _pending.end()) {
+    /*
+     *  The image is already being decoded. No additional decode is performed
+     *  so this counts as a hit.
+     */
+    _hits++;
+    return inFlight->second;
+  }
+
+  _misses++;
+
+  pending = std::make_shared<std::promise<DecodedImage>>();
+  auto future = pending->get_future().share();
+  _pending.emplace(key, future);
+  return future;
+}
+
+void ImageCache::fulfill(const Key& key,
+                         const geom::Size& sizeHint,
+                         const Pending& pending) {
+  /*
+   *  Decoding is expensive. Don't hold up lookups of other images while it is
+   *  in progress.
+   */
+  DecodedImage decoded;
+  auto result = key.image.decode(sizeHint);
+  if (result.wasSuccessful()) {
+    decoded = std::make_shared<const ImageResult>(std::move(result));
+  }
+
+  {
+    core::MutexLocker lock(_lock);
+
+    _pending.erase(key);
+
+    /*
+     *  Failed decodes are not cached so that they may be retried.
+     */
+    if (decoded != nullptr) {
+      _entries.push_front({{}, decoded});
+      auto inserted = _map.emplace(key, _entries.begin());
+      RL_ASSERT(inserted.second);
+      _entries.front().mapEntry = inserted.first;
+      _bytes += decoded->allocation().size();
+
+      evictIfNecessary();
+    }
+  }
+
+  /*
+   *  Waiters are woken up only after the result is visible in the cache.
+   */
+  pending->set_value(decoded);
+}
+
+void ImageCache::evictIfNecessary() {
+  while (_bytes > _byteBudget && !_entries.empty()) {
+    const auto& entry = _entries.back();
+    _bytes -= entry.decoded->allocation().size();
+    _map.erase(entry.mapEntry);
+    _entries.pop_back();
+    _evictions++;
+  }
+}
+
+size_t ImageCache::byteBudget() const {
+  core::MutexLocker lock(_lock);
+  return _byteBudget;
+}
+
+void ImageCache::setByteBudget(size_t byteBudget) {
+  core::MutexLocker lock(_lock);
+  _byteBudget = byteBudget;
+  evictIfNecessary();
+}
+
+void ImageCache::purge() {
+  core::MutexLocker lock(_lock);
+  _map.clear();
+  _entries.clear();
+  _bytes = 0;
+}
+
+ImageCache::Statistics ImageCache::statistics() const {
+  core::MutexLocker lock(_lock);
+  Statistics statistics;
+  statistics.hits = _hits;
+  statistics.misses = _misses;
+  statistics.evictions = _evictions;
+  statistics.entries = _entries.size();
+  statistics.bytes = _bytes;
+  return statistics;
+}
+
+}  // namespace image
+}  // namespace rl
@@ -0,0 +1,129 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "ImageReduction.h"
+
+#if defined(__SSE2__)
+#define RL_BOX_FILTER_SSE2 1
+#include <emmintrin.h>
+#else
+#define RL_BOX_FILTER_SSE2 0
+#endif
+
+namespace rl {
+namespace image {
+
+/**
+ *  Add each byte of the source row to the corresponding running sum.
+ */
+static void AccumulateRow(const uint8_t* source, uint32_t* sums, size_t count) {
+  size_t i = 0;
+
+#if RL_BOX_FILTER_SSE2
+  const auto zero = _mm_setzero_si128();
+  for (; i + 16 <= count; i += 16) {
+    const auto bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    const auto low = _mm_unpacklo_epi8(bytes, zero);
+    const auto high = _mm_unpackhi_epi8(bytes, zero);
+
+    auto sum = reinterpret_cast<__m128i*>(sums + i);
+    _mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum),
+                                        _mm_unpacklo_epi16(low, zero)));
+    _mm_storeu_si128(sum + 1, _mm_add_epi32(_mm_loadu_si128(sum + 1),
+                                            _mm_unpackhi_epi16(low, zero)));
+    _mm_storeu_si128(sum + 2, _mm_add_epi32(_mm_loadu_si128(sum + 2),
+                                            _mm_unpacklo_epi16(high, zero)));
+    _mm_storeu_si128(sum + 3, _mm_add_epi32(_mm_loadu_si128(sum + 3),
+                                            _mm_unpackhi_epi16(high, zero)));
+  }
+#endif
+
+  for (; i < count; i++) {
+    sums[i] += source[i];
+  }
+}
+
+/**
+ *  Average the column sums of each block of pixels into a single pixel.
+ */
+static void ResolveRow(const uint32_t* sums,
+                       uint8_t* row,
+                       size_t width,
+                       size_t channels,
+                       size_t factor) {
+  const uint32_t area = static_cast<uint32_t>(factor * factor);
+  const auto blockCount = factor * channels;
+
+  for (size_t x = 0; x < width; x++, sums += blockCount, row += channels) {
+    uint32_t block[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < blockCount; i += channels) {
+      for (size_t c = 0; c < channels; c++) {
+        block[c] += sums[i + c];
+      }
+    }
+    for (size_t c = 0; c < channels; c++) {
+      row[c] = static_cast<uint8_t>((block[c] + area / 2) / area);
+    }
+  }
+}
+
+size_t ImageReductionFactor(size_t width,
+                            size_t height,
+                            const geom::Size& sizeHint) {
+  if (sizeHint.width < 1.0 || sizeHint.height < 1.0) {
+    return 1;
+  }
+
+  const auto hintWidth = static_cast<size_t>(std::ceil(sizeHint.width));
+  const auto hintHeight = static_cast<size_t>(std::ceil(sizeHint.height));
+
+  return std::max<size_t>(
+      std::min(width / hintWidth, height / hintHeight), 1);
+}
+
+void ReduceImageInPlace(uint8_t* pixels,
+                        size_t width,
+                        size_t height,
+                        size_t channels,
+                        size_t factor) {
+  if (factor <= 1) {
+    return;
+  }
+
+  const auto sourceRowBytes = width * channels;
+  const auto reducedWidth = width / factor;
+  const auto reducedHeight = height / factor;
+  const auto reducedRowBytes = reducedWidth * channels;
+
+  /*
+   *  Only the columns covered by whole blocks contribute to a row.
+   */
+  const auto count = reducedWidth * factor * channels;
+  std::vector<uint32_t> sums(count);
+
+  /*
+   *  Reduced row y ends before the block of source rows for row y + 1 starts.
+   *  Its block is summed up before the row is written. So writing the reduced
+   *  rows front to back never clobbers source rows still to be read.
+   */
+  for (size_t y = 0; y < reducedHeight; y++) {
+    const auto source = pixels + y * factor * sourceRowBytes;
+
+    std::fill(sums.begin(), sums.end(), 0);
+    for (size_t k = 0; k < factor; k++) {
+      AccumulateRow(source + k * sourceRowBytes, sums.data(), count);
+    }
+
+    ResolveRow(sums.data(), pixels + y * reducedRowBytes, reducedWidth,
+               channels, factor);
+  }
+}
+
+}  // namespace image
+}  // namespace rl
@@ -0,0 +1,51 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Geometry/Size.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace rl {
+namespace image {
+
+/**
+ *  The largest whole factor by which an image may be reduced while staying at
+ *  least as large as the size hint in both dimensions.
+ *
+ *  @param width    the width of the image
+ *  @param height   the height of the image
+ *  @param sizeHint the size the image is displayed at. A hint that is empty in
+ *                  either dimension does not reduce the image.
+ *
+ *  @return the reduction factor. At least 1.
+ */
+size_t ImageReductionFactor(size_t width,
+                            size_t height,
+                            const geom::Size& sizeHint);
+
+/**
+ *  Reduce the image by the given factor in both dimensions. Each reduced pixel
+ *  is the average of the square block of pixels it covers. Pixels in the
+ *  partial blocks at the right and bottom edges are dropped.
+ *
+ *  The reduced image is written over the start of the pixels of the original
+ *  so that no second image sized buffer is needed.
+ *
+ *  @param pixels   the tightly packed pixels of the image
+ *  @param width    the width of the image
+ *  @param height   the height of the image
+ *  @param channels the number of bytes in each pixel. At most 4.
+ *  @param factor   the reduction factor
+ */
+void ReduceImageInPlace(uint8_t* pixels,
+                        size_t width,
+                        size_t height,
+                        size_t channels,
+                        size_t factor);
+
+}  // namespace image
+}  // namespace rl
@@ -4,8 +4,10 @@
  */
 
 #include "ImageSource.h"
+#include <cstring>
 #include "DataImageSource.h"
 #include "FileImageSource.h"
+#include "SharedMemoryImageSource.h"
 
 namespace rl {
 namespace image {
@@ -18,12 +20,19 @@ std::unique_ptr<ImageSource> ImageSource::Create(core::FileHandle fileHandle) {
   return std::make_unique<FileImageSource>(std::move(fileHandle));
 }
 
+std::unique_ptr<ImageSource> ImageSource::Create(
+    std::unique_ptr<core::SharedMemory> memory) {
+  return std::make_unique<SharedMemoryImageSource>(std::move(memory));
+}
+
 std::shared_ptr<ImageSource> ImageSource::ImageSourceForType(Type type) {
   switch (type) {
     case Type::File:
       return std::make_shared<FileImageSource>();
     case Type::Data:
       return std::make_shared<DataImageSource>();
+    case Type::SharedMemory:
+      return std::make_shared<SharedMemoryImageSource>();
     default:
       return nullptr;
   }
@@ -36,6 +45,11 @@ ImageSource::ImageSource() = default;
 ImageSource::~ImageSource() = default;
 
 void ImageSource::prepareForUse() {
+  core::MutexLocker lock(_lock);
+  prepareForUseLocked();
+}
+
+void ImageSource::prepareForUseLocked() {
   if (_prepared) {
     return;
   }
@@ -46,6 +60,8 @@ void ImageSource::prepareForUse() {
 }
 
 void ImageSource::doneUsing() {
+  core::MutexLocker lock(_lock);
+
   if (!_prepared) {
     return;
   }
@@ -55,5 +71,61 @@ void ImageSource::doneUsing() {
   _prepared = false;
 }
 
+/*
+ *  Encoded images may be many megabytes in size. So the bytes are mixed in a
+ *  word at a time instead of a byte at a time.
+ */
+static size_t HashBytes(const uint8_t* data, size_t size) {
+  const uint64_t multiplier = 0xff51afd7ed558ccdULL;
+  uint64_t hash = 0x9e3779b97f4a7c15ULL ^ size;
+
+  const size_t words = size / sizeof(uint64_t);
+  for (size_t i = 0; i < words; i++) {
+    uint64_t word = 0;
+    memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * multiplier;
+    hash ^= hash >> 29;
+  }
+
+  for (size_t i = words * sizeof(uint64_t); i < size; i++) {
+    hash = (hash ^ data[i]) * multiplier;
+  }
+
+  hash ^= hash >> 32;
+  return static_cast<size_t>(hash);
+}
+
+size_t ImageSource::contentHash() {
+  core::MutexLocker lock(_lock);
+
+  if (!_hasContentHash) {
+    prepareForUseLocked();
+    _contentHash = HashBytes(sourceData(), sourceDataSize());
+    _hasContentHash = true;
+  }
+
+  return _contentHash;
+}
+
+bool ImageSource::contentEquals(ImageSource& other) {
+  if (this == &other) {
+    return true;
+  }
+
+  if (contentHash() != other.contentHash()) {
+    return false;
+  }
+
+  /*
+   *  Both sources have been prepared to compute their hashes.
+   */
+  const auto size = sourceDataSize();
+  if (size != other.sourceDataSize()) {
+    return false;
+  }
+
+  return size == 0 || memcmp(sourceData(), other.sourceData(), size) == 0;
+}
+
 }  // namespace image
 }  // namespace rl
@@ -8,6 +8,8 @@
 #include <Core/Allocation.h>
 #include <Core/File.h>
 #include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Core/SharedMemory.h>
 
 namespace rl {
 namespace image {
@@ -18,12 +20,16 @@ class ImageSource : public core::MessageSerializable {
     Unknown,
     File,
     Data,
+    SharedMemory,
   };
 
   static std::unique_ptr<ImageSource> Create(core::Allocation allocation);
 
   static std::unique_ptr<ImageSource> Create(core::FileHandle fileHandle);
 
+  static std::unique_ptr<ImageSource> Create(
+      std::unique_ptr<core::SharedMemory> memory);
+
   static std::shared_ptr<ImageSource> ImageSourceForType(Type type);
 
   ImageSource();
@@ -34,6 +40,20 @@ class ImageSource : public core::MessageSerializable {
 
   void doneUsing();
 
+  /**
+   *  A hash of the encoded bytes of the image. Sources with the same contents
+   *  have the same hash irrespective of their type. The hash is computed on
+   *  first access and is reused after that.
+   *
+   *  @return the content hash
+   */
+  size_t contentHash();
+
+  /**
+   *  @return if both sources contain the same encoded bytes
+   */
+  bool contentEquals(ImageSource& other);
+
  protected:
   bool _prepared = false;
 
@@ -48,6 +68,13 @@ class ImageSource : public core::MessageSerializable {
   virtual void onPrepareForUse() = 0;
 
   virtual void onDoneUsing() = 0;
+
+ private:
+  core::Mutex _lock;
+  bool _hasContentHash = false;
+  size_t _contentHash = 0;
+
+  void prepareForUseLocked() RL_REQUIRES(_lock);
 };
 
 }  // namespace image
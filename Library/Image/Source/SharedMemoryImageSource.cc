@@ -0,0 +1,81 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "SharedMemoryImageSource.h"
+#include <Core/Message.h>
+#include <Core/RawAttachment.h>
+
+namespace rl {
+namespace image {
+
+SharedMemoryImageSource::SharedMemoryImageSource() {}
+
+SharedMemoryImageSource::SharedMemoryImageSource(
+    std::unique_ptr<core::SharedMemory> memory) {
+  if (memory == nullptr || !memory->isReady()) {
+    return;
+  }
+
+  /*
+   *  The contents must not change after the image has been handed out. Even
+   *  where the kernel cannot enforce this, the memory is only ever mapped
+   *  read-only from here on.
+   */
+  if (!memory->seal()) {
+    RL_LOG("Shared memory for the image could not be sealed.");
+  }
+
+  /*
+   *  The writable mapping of the producer is torn down along with the shared
+   *  memory reference. The handle is all that is needed to map the contents
+   *  again.
+   */
+  _handle = std::make_shared<core::FileHandle>(memory->takeHandle());
+}
+
+uint8_t* SharedMemoryImageSource::sourceData() const {
+  return _mapping == nullptr ? nullptr : _mapping->mapping();
+}
+
+size_t SharedMemoryImageSource::sourceDataSize() const {
+  return _mapping == nullptr ? 0 : _mapping->size();
+}
+
+void SharedMemoryImageSource::onPrepareForUse() {
+  if (_handle == nullptr || !_handle->isValid()) {
+    return;
+  }
+
+  _mapping = std::make_unique<core::FileMapping>(*_handle);
+}
+
+void SharedMemoryImageSource::onDoneUsing() {
+  _mapping = nullptr;
+}
+
+bool SharedMemoryImageSource::serialize(core::Message& message) const {
+  return message.encode(_handle);
+}
+
+bool SharedMemoryImageSource::deserialize(core::Message& message,
+                                          core::Namespace* ns) {
+  core::RawAttachment attachment;
+
+  if (!message.decode(attachment)) {
+    return false;
+  }
+
+  _handle = std::make_shared<core::FileHandle>(std::move(attachment));
+  _mapping = nullptr;
+
+  return true;
+}
+
+ImageSource::Type SharedMemoryImageSource::type() const {
+  return ImageSource::Type::SharedMemory;
+}
+
+}  // namespace image
+}  // namespace rl
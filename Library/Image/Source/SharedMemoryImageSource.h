@@ -0,0 +1,51 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/FileHandle.h>
+#include <Core/FileMapping.h>
+#include <Core/Macros.h>
+#include <Core/SharedMemory.h>
+#include "ImageSource.h"
+
+namespace rl {
+namespace image {
+
+/**
+ *  An image source whose encoded bytes live in sealed shared memory. The
+ *  memory travels to other processes as a message attachment and is mapped
+ *  read-only wherever the image is decoded. The encoded bytes are never
+ *  copied into or out of messages.
+ */
+class SharedMemoryImageSource : public ImageSource {
+ public:
+  SharedMemoryImageSource();
+
+  SharedMemoryImageSource(std::unique_ptr<core::SharedMemory> memory);
+
+  bool serialize(core::Message& message) const override;
+
+  bool deserialize(core::Message& message, core::Namespace* ns) override;
+
+ private:
+  std::shared_ptr<core::FileHandle> _handle;
+  std::unique_ptr<core::FileMapping> _mapping;
+
+  ImageSource::Type type() const override;
+
+  uint8_t* sourceData() const override;
+
+  size_t sourceDataSize() const override;
+
+  void onPrepareForUse() override;
+
+  void onDoneUsing() override;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SharedMemoryImageSource);
+};
+
+}  // namespace image
+}  // namespace rl
@@ -0,0 +1,161 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/WorkQueue.h>
+#include <Image/ImageCache.h>
+#include <TestRunner/TestRunner.h>
+#include <cstring>
+
+namespace rl {
+namespace image {
+namespace testing {
+
+/**
+ *  Create an image from a copy of the bytes of the fixture. Each image gets
+ *  its own source.
+ */
+static Image ImageFromFixture(const char* fixture) {
+  core::FileHandle file(core::URI{fixture});
+  RL_ASSERT(file.isValid());
+
+  core::FileMapping map(file);
+
+  core::Allocation allocation;
+  RL_ASSERT(allocation.resize(map.size()));
+  memmove(allocation.data(), map.mapping(), map.size());
+
+  return Image{std::move(allocation)};
+}
+
+TEST(ImageCacheTest, ImagesAreComparedByContents) {
+  core::FileHandle file(core::URI{"file://Beachball.png"});
+  Image fromFile(std::move(file));
+  auto fromData = ImageFromFixture("file://Beachball.png");
+  auto other = ImageFromFixture("file://Beachball.jpg");
+
+  ASSERT_EQ(Image::Hash()(fromFile), Image::Hash()(fromData));
+  ASSERT_TRUE(Image::Equal()(fromFile, fromData));
+  ASSERT_FALSE(Image::Equal()(fromFile, other));
+  ASSERT_FALSE(Image::Equal()(fromFile, Image{}));
+}
+
+TEST(ImageCacheTest, IdenticalImagesShareDecodes) {
+  ImageCache cache(ImageCache::DefaultByteBudget);
+
+  core::FileHandle file(core::URI{"file://Beachball.png"});
+  auto first = cache.decode(Image{std::move(file)});
+  auto second = cache.decode(ImageFromFixture("file://Beachball.png"));
+
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first->components(), ImageResult::Components::RGBA);
+
+  const auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.misses, 1u);
+  ASSERT_EQ(statistics.hits, 1u);
+  ASSERT_EQ(statistics.entries, 1u);
+  ASSERT_EQ(statistics.bytes, 177u * 177u * 4u);
+}
+
+TEST(ImageCacheTest, ReducedDecodesAreCachedPerFactor) {
+  ImageCache cache(ImageCache::DefaultByteBudget);
+
+  auto full = cache.decode(ImageFromFixture("file://Beachball.png"));
+  auto reduced = cache.decode(ImageFromFixture("file://Beachball.png"),
+                              geom::Size{64, 64});
+
+  /*
+   *  Both hints reduce the image by a factor of two.
+   */
+  auto sameFactor = cache.decode(ImageFromFixture("file://Beachball.png"),
+                                 geom::Size{80, 70});
+
+  ASSERT_NE(full, reduced);
+  ASSERT_EQ(reduced, sameFactor);
+  ASSERT_EQ(reduced->size(), (geom::Size{88, 88}));
+
+  const auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.misses, 2u);
+  ASSERT_EQ(statistics.hits, 1u);
+  ASSERT_EQ(statistics.entries, 2u);
+  ASSERT_EQ(statistics.bytes, (177u * 177u + 88u * 88u) * 4u);
+}
+
+TEST(ImageCacheTest, EvictsLeastRecentlyUsedWhenOverBudget) {
+  const size_t jpgBytes = 177 * 177 * 3;
+  const size_t pngBytes = 177 * 177 * 4;
+  ImageCache cache(pngBytes + jpgBytes / 2);
+
+  auto jpg = cache.decode(ImageFromFixture("file://Beachball.jpg"));
+  ASSERT_EQ(cache.statistics().bytes, jpgBytes);
+
+  /*
+   *  Both images don't fit. The older one goes but stays alive for the
+   *  reference still held to it.
+   */
+  auto png = cache.decode(ImageFromFixture("file://Beachball.png"));
+  auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.evictions, 1u);
+  ASSERT_EQ(statistics.entries, 1u);
+  ASSERT_EQ(statistics.bytes, pngBytes);
+  ASSERT_TRUE(jpg->allocation().isReady());
+
+  ASSERT_EQ(cache.decode(ImageFromFixture("file://Beachball.png")), png);
+  ASSERT_NE(cache.decode(ImageFromFixture("file://Beachball.jpg")), jpg);
+  statistics = cache.statistics();
+  ASSERT_EQ(statistics.hits, 1u);
+  ASSERT_EQ(statistics.misses, 3u);
+  ASSERT_EQ(statistics.evictions, 2u);
+
+  cache.setByteBudget(0);
+  statistics = cache.statistics();
+  ASSERT_EQ(statistics.entries, 0u);
+  ASSERT_EQ(statistics.bytes, 0u);
+  ASSERT_EQ(statistics.evictions, 3u);
+}
+
+TEST(ImageCacheTest, ConcurrentRequestsShareOneDecode) {
+  ImageCache cache(ImageCache::DefaultByteBudget);
+  core::WorkQueue queue(core::WorkQueue::Mode::Shared, 4);
+
+  const size_t requests = 16;
+  std::vector<std::shared_future<ImageCache::DecodedImage>> futures;
+  for (size_t i = 0; i < requests; i++) {
+    futures.emplace_back(
+        cache.decodeAsync(ImageFromFixture("file://Beachball.jpg"), queue));
+  }
+
+  auto decoded = futures.front().get();
+  ASSERT_NE(decoded, nullptr);
+  for (auto& future : futures) {
+    ASSERT_EQ(future.get(), decoded);
+  }
+
+  const auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.misses, 1u);
+  ASSERT_EQ(statistics.hits, requests - 1);
+  ASSERT_EQ(statistics.entries, 1u);
+}
+
+TEST(ImageCacheTest, FailedDecodesAreNotCached) {
+  ImageCache cache(ImageCache::DefaultByteBudget);
+
+  const char garbage[] = "This is not an image";
+  core::Allocation allocation;
+  ASSERT_TRUE(allocation.resize(sizeof(garbage)));
+  memmove(allocation.data(), garbage, sizeof(garbage));
+  Image image(std::move(allocation));
+
+  ASSERT_EQ(cache.decode(image), nullptr);
+  ASSERT_EQ(cache.decode(image), nullptr);
+
+  const auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.misses, 2u);
+  ASSERT_EQ(statistics.entries, 0u);
+}
+
+}  // namespace testing
+}  // namespace image
+}  // namespace rl
@@ -0,0 +1,129 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Image/Image.h>
+#include <TestRunner/TestRunner.h>
+#include <cstring>
+#include <string>
+
+namespace rl {
+namespace image {
+namespace testing {
+
+/**
+ *  Create a grey image encoded as a binary PGM. Each pixel is the sum of its
+ *  coordinates times the given step.
+ */
+static Image GreyImage(size_t width, size_t height, uint8_t step) {
+  const auto header = "P5\n" + std::to_string(width) + " " +
+                      std::to_string(height) + "\n255\n";
+
+  core::Allocation allocation;
+  RL_ASSERT(allocation.resize(header.size() + width * height));
+  memmove(allocation.data(), header.data(), header.size());
+
+  auto pixels = allocation.data() + header.size();
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      pixels[y * width + x] = static_cast<uint8_t>((x + y) * step);
+    }
+  }
+
+  return Image{std::move(allocation)};
+}
+
+TEST(ImageReductionTest, EmptyHintDecodesFullImage) {
+  auto image = GreyImage(4, 3, 10);
+  ASSERT_EQ(image.reductionFactor({}), 1u);
+
+  auto result = image.decode(geom::Size{});
+
+  ASSERT_TRUE(result.wasSuccessful());
+  ASSERT_EQ(result.size(), (geom::Size{4, 3}));
+  ASSERT_EQ(result.components(), ImageResult::Components::Grey);
+  ASSERT_EQ(result.allocation().size(), 12u);
+  ASSERT_EQ(result.allocation().data()[4], 10);
+  ASSERT_EQ(result.allocation().data()[7], 40);
+}
+
+TEST(ImageReductionTest, BlocksAreAveraged) {
+  /*
+   *  The bottom row and rightmost column do not fill a whole block and are
+   *  dropped.
+   */
+  auto image = GreyImage(5, 5, 10);
+  ASSERT_EQ(image.reductionFactor(geom::Size{2, 2}), 2u);
+
+  auto result = image.decode(geom::Size{2, 2});
+
+  ASSERT_TRUE(result.wasSuccessful());
+  ASSERT_EQ(result.size(), (geom::Size{2, 2}));
+  ASSERT_EQ(result.allocation().size(), 4u);
+
+  const auto pixels = result.allocation().data();
+  ASSERT_EQ(pixels[0], 10);  // (0 + 10 + 10 + 20) / 4
+  ASSERT_EQ(pixels[1], 30);  // (20 + 30 + 30 + 40) / 4
+  ASSERT_EQ(pixels[2], 30);
+  ASSERT_EQ(pixels[3], 50);
+}
+
+TEST(ImageReductionTest, WideRowsMatchScalarAverages) {
+  /*
+   *  Wide enough for the vectorized accumulation of column sums.
+   */
+  const size_t width = 99;
+  const size_t factor = 3;
+  auto result = GreyImage(width, 9, 1).decode(geom::Size{33, 3});
+
+  ASSERT_EQ(result.size(), (geom::Size{33, 3}));
+
+  const auto pixels = result.allocation().data();
+  for (size_t y = 0; y < 3; y++) {
+    for (size_t x = 0; x < 33; x++) {
+      /*
+       *  The average of the block is the value at its center.
+       */
+      ASSERT_EQ(pixels[y * 33 + x], (x * factor + 1) + (y * factor + 1));
+    }
+  }
+}
+
+TEST(ImageReductionTest, DecodeWithSizeHint) {
+  core::FileHandle file(core::URI{"file://Beachball.png"});
+  Image image(std::move(file));
+
+  auto full = image.decode();
+  auto thumbnail = image.decode(geom::Size{64, 64});
+
+  ASSERT_EQ(image.reductionFactor(geom::Size{64, 64}), 2u);
+  ASSERT_TRUE(full.wasSuccessful());
+  ASSERT_TRUE(thumbnail.wasSuccessful());
+  ASSERT_EQ(thumbnail.components(), full.components());
+  ASSERT_EQ(thumbnail.size(), (geom::Size{88, 88}));
+  ASSERT_EQ(thumbnail.allocation().size(), 88u * 88u * 4u);
+
+  /*
+   *  Hints larger than the image never scale it up.
+   */
+  ASSERT_EQ(image.reductionFactor(geom::Size{1024, 1024}), 1u);
+  auto large = image.decode(geom::Size{1024, 1024});
+  ASSERT_EQ(large.size(), full.size());
+  ASSERT_EQ(memcmp(large.allocation().data(), full.allocation().data(),
+                   full.allocation().size()),
+            0);
+}
+
+TEST(ImageReductionTest, UnreadableImagesHaveNoReductionFactor) {
+  const char garbage[] = "not an image";
+  Image image{core::Allocation{reinterpret_cast<const uint8_t*>(garbage),
+                               sizeof(garbage)}};
+
+  ASSERT_EQ(image.reductionFactor(geom::Size{2, 2}), 0u);
+  ASSERT_EQ(Image{}.reductionFactor(geom::Size{2, 2}), 0u);
+}
+
+}  // namespace testing
+}  // namespace image
+}  // namespace rl
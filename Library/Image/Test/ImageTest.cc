@@ -3,6 +3,7 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <Core/Channel.h>
 #include <Image/Image.h>
 #include <TestRunner/TestRunner.h>
 
@@ -77,3 +78,47 @@ TEST(ImageTest, SimpleDecoderPNGFromAllocation) {
   ASSERT_EQ(res.size().height, 177);
   ASSERT_TRUE(res.allocation().isReady());
 }
+
+TEST(ImageTest, SharedMemoryImageSentOverChannel) {
+  rl::core::FileHandle file(rl::core::URI{"file://Beachball.png"});
+  ASSERT_TRUE(file.isValid());
+
+  rl::core::FileMapping map(file);
+
+  auto memory = std::make_unique<rl::core::SharedMemory>(map.size());
+  ASSERT_TRUE(memory->isReady());
+  memmove(memory->address(), map.mapping(), map.size());
+
+  rl::image::Image image(std::move(memory));
+
+  rl::core::Channel channel;
+
+  rl::core::Message message;
+  ASSERT_TRUE(message.encode(image));
+
+  /*
+   *  Only the handle to the shared memory is sent along.
+   */
+  ASSERT_LT(message.size(), map.size());
+
+  rl::core::Messages messages;
+  messages.emplace_back(std::move(message));
+  ASSERT_EQ(channel.sendMessages(std::move(messages)),
+            rl::core::IOResult::Success);
+
+  auto received =
+      channel.drainPendingMessages(rl::core::ClockDurationMilli(1000), 1);
+  ASSERT_EQ(received.size(), 1u);
+
+  rl::image::Image decoded;
+  ASSERT_TRUE(received[0].decode(decoded, nullptr));
+
+  ASSERT_TRUE(rl::image::Image::Equal()(image, decoded));
+
+  auto res = decoded.decode();
+
+  ASSERT_TRUE(res.wasSuccessful());
+  ASSERT_EQ(res.components(), rl::image::ImageResult::Components::RGBA);
+  ASSERT_EQ(res.size().width, 177);
+  ASSERT_EQ(res.size().height, 177);
+}
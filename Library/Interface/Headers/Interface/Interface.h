@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <Coordinator/AnimationCompletion.h>
 #include <Coordinator/CoordinatorAcquisitionProtocol.h>
 #include <Core/Macros.h>
 #include <Core/Mutex.h>
@@ -115,6 +116,26 @@ class Interface {
   void setupConstraintSuggestions(
       const std::vector<layout::Suggestion>& suggestions);
 
+  using AnimationCompletionCallback =
+      std::function<void(const coordinator::AnimationCompletion&)>;
+
+  /**
+   *  Set the callback invoked on the loop of the interface when an animation
+   *  of one of its entity properties finishes on the coordinator.
+   *
+   *  @param callback the animation completion callback. May be `nullptr`.
+   */
+  void setAnimationCompletionCallback(AnimationCompletionCallback callback);
+
+  /**
+   *  Start a physics simulation of an entity property on the coordinator. The
+   *  simulation is stepped along with the interpolations on every frame until
+   *  it is done.
+   *
+   *  @param simulation the simulation and the entity property it drives
+   */
+  void setupSimulation(const animation::SimulationDescriptor& simulation);
+
   /**
    *  Get a reference to the transaction that is currently on top of the
    *  transaction stack.
@@ -141,6 +162,8 @@ class Interface {
   std::shared_ptr<core::EventLoopObserver> _autoFlushObserver;
   std::shared_ptr<InterfaceDelegate> _delegate;
   std::shared_ptr<core::Channel> _coordinatorChannel;
+  std::shared_ptr<core::Channel> _completionsChannel;
+  AnimationCompletionCallback _animationCompletionCallback;
   std::unique_ptr<core::Archive> _spliceArchive;
   toolbox::StateMachine _state;
   coordinator::CoordinatorAcquisitionProtocol _coordinatorAcquisition;
@@ -150,6 +173,7 @@ class Interface {
   void attemptCoordinatorChannelAcquisition();
   void onCoordinatorChannelAcquisition(core::IOResult result,
                                        core::Message message);
+  void onCompletionsMessage(core::Message message);
   void scheduleChannels();
   void unscheduleChannels();
   void autoFlushObserver(core::EventLoopObserver::Activity activity);
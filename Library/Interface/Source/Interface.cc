@@ -28,6 +28,7 @@ Interface::Interface(std::shared_ptr<InterfaceDelegate> delegate,
                             std::placeholders::_3)),
       _loop(nullptr),
       _delegate(delegate),
+      _completionsChannel(std::make_shared<core::Channel>()),
       _spliceArchive(std::move(spliceArchive)),
       _state({
 // clang-format off
@@ -41,7 +42,8 @@ Interface::Interface(std::shared_ptr<InterfaceDelegate> delegate,
         LT {  Background,   NotRunning,   C(didTerminate)        },
 #undef C
           // clang-format on
-      }) {
+      }),
+      _coordinatorAcquisition(_completionsChannel) {
   /*
    *  Implicit interface transactions are flushed at the maximum available
    *  priority. This is so that loop observers setup by application code can
@@ -236,9 +238,11 @@ void Interface::flushTransactions() {
   RL_ASSERT(_coordinatorChannel != nullptr);
 
   /*
-   *  Create a message to encode all the transaction items into
+   *  Create a message to encode all the transaction items into. Large
+   *  transactions are encoded directly into shared memory leased from the
+   *  channel.
    */
-  core::Message arena;
+  auto arena = _coordinatorChannel->createMessage();
 
   core::MutexLocker lock(_transactionsMutex);
 
@@ -272,6 +276,10 @@ void Interface::scheduleChannels() {
    *  about
    */
   _loop->addSource(_coordinatorAcquisition.source());
+
+  _completionsChannel->setMessageCallback(std::bind(
+      &Interface::onCompletionsMessage, this, std::placeholders::_1));
+  _loop->addSource(_completionsChannel->source());
 }
 
 void Interface::unscheduleChannels() {
@@ -279,6 +287,29 @@ void Interface::unscheduleChannels() {
    *  The event loop is about to die, unschedule all active channels
    */
   _loop->removeSource(_coordinatorAcquisition.source());
+
+  _completionsChannel->setMessageCallback(nullptr);
+  _loop->removeSource(_completionsChannel->source());
+}
+
+void Interface::setAnimationCompletionCallback(
+    AnimationCompletionCallback callback) {
+  _animationCompletionCallback = callback;
+}
+
+void Interface::onCompletionsMessage(core::Message message) {
+  std::vector<coordinator::AnimationCompletion> completions;
+  if (!message.decodeVectorCopyable(completions, nullptr)) {
+    return;
+  }
+
+  if (!_animationCompletionCallback) {
+    return;
+  }
+
+  for (const auto& completion : completions) {
+    _animationCompletionCallback(completion);
+  }
 }
 
 Interface::State Interface::state() const {
@@ -333,5 +364,10 @@ void Interface::setupConstraintSuggestions(
   transaction().mark(suggestions);
 }
 
+void Interface::setupSimulation(
+    const animation::SimulationDescriptor& simulation) {
+  transaction().mark(simulation);
+}
+
 }  // namespace interface
 }  // namespace rl
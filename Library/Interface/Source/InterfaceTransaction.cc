@@ -41,6 +41,11 @@ void InterfaceTransaction::mark(
   }
 }
 
+void InterfaceTransaction::mark(
+    const animation::SimulationDescriptor& simulation) {
+  _simulations.emplace_back(simulation);
+}
+
 void InterfaceTransaction::mark(coordinator::TransactionPayload&& payload) {
   _extraPayloads.emplace_back(std::move(payload));
 }
@@ -49,7 +54,7 @@ bool InterfaceTransaction::commit(core::Message& arena,
                                   std::unique_ptr<core::Archive>& archive) {
   coordinator::TransactionPayload payload(
       std::move(_action), std::move(_entities), std::move(_constraints),
-      std::move(_suggestions));
+      std::move(_suggestions), std::move(_simulations));
 
   /*
    *  Write to the message arena
@@ -81,3 +81,31 @@ TEST_F(InterfaceTest, TestActivatedInterface) {
   latch.wait();
   ASSERT_TRUE(active);
 }
+
+TEST_F(InterfaceTest, FinishedAnimationsAreReported) {
+  rl::core::Latch latch(1);
+  rl::coordinator::AnimationCompletion completed = {};
+  rl::core::Name::Handle boxHandle = rl::core::DeadHandle;
+
+  RunInActivatedInterface(
+      currentShell(), [&](rl::interface::Interface& interface) {
+        auto box = interface.createEntity();
+        boxHandle = *box->identifier().handle();
+        interface.rootEntity().addChild(box);
+
+        interface.setAnimationCompletionCallback(
+            [&, box](const rl::coordinator::AnimationCompletion& completion) {
+              completed = completion;
+              latch.countDown();
+            });
+
+        rl::animation::Action action(0.05);
+        action.setPropertyMask(rl::entity::Entity::OpacityMask);
+        auto pop = interface.pushTransaction(std::move(action));
+        box->setOpacity(0.5);
+      });
+
+  latch.wait();
+  ASSERT_EQ(completed.entityHandle, boxHandle);
+  ASSERT_EQ(completed.property, rl::entity::Entity::Property::Opacity);
+}
@@ -0,0 +1,97 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/FileIOAdapter.h>
+#include <Core/TempFileHandle.h>
+#include <InterfaceBuilder/InterfaceBuilderArchive.h>
+#include <unistd.h>
+
+/**
+ *  Compile the archive in the fixture to a temporary file and return a handle
+ *  to read it back.
+ */
+static rl::core::FileHandle CompileToTemporaryFile(const char* fixture) {
+  auto archive = rl::ib::InterfaceBuilderArchive::Make(rl::core::URI{fixture});
+  if (!archive) {
+    return {};
+  }
+
+  auto scene = archive->compile();
+  auto file = rl::core::TemporaryFileCreate();
+  rl::core::FileHandle readHandle(::dup(file.handle()));
+  rl::core::FileIOAdapter adapter(std::move(file));
+  if (scene.size() == 0 || adapter.write(scene) != scene.size()) {
+    return {};
+  }
+  return readHandle;
+}
+
+/*
+ *  Measures the time taken to launch the archive in the file. That is, to
+ *  make the archive from the file and inflate all its entities.
+ */
+static void LaunchArchive(benchmark::State& state,
+                          const rl::core::FileHandle& file) {
+  if (!file.isValid()) {
+    state.SkipWithError("Could not open the archive");
+    return;
+  }
+
+  /*
+   *  Entities record their updates in the current transaction of the
+   *  interface. There is no coordinator to flush transactions to. So the
+   *  interface is not run. Each launch records into a transaction of its own
+   *  in a fresh interface instead so that transactions don't pile up.
+   */
+  std::unique_ptr<rl::interface::Interface> interface;
+  rl::ib::InterfaceBuilderArchive::EntityMap map;
+  rl::interface::ModelEntity::Ref root;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    root = nullptr;
+    map.clear();
+    interface = std::make_unique<rl::interface::Interface>(nullptr);
+    state.ResumeTiming();
+
+    auto transaction = interface->pushTransaction(rl::animation::Action{0.0});
+    auto archive = rl::ib::InterfaceBuilderArchive::Make(file);
+    root = archive ? archive->inflate(*interface, map) : nullptr;
+    if (root == nullptr) {
+      state.SkipWithError("Could not inflate the archive");
+      break;
+    }
+  }
+}
+
+static void BenchLaunchSVG(benchmark::State& state, const char* fixture) {
+  LaunchArchive(state, rl::core::FileHandle{rl::core::URI{fixture}});
+}
+
+static void BenchLaunchCompiled(benchmark::State& state, const char* fixture) {
+  LaunchArchive(state, CompileToTemporaryFile(fixture));
+}
+
+BENCHMARK_CAPTURE(BenchLaunchSVG, SketchAndroid, "file://SketchAndroid.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchCompiled,
+                  SketchAndroid,
+                  "file://SketchAndroid.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchSVG, nighthawks, "file://nighthawks.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchCompiled, nighthawks, "file://nighthawks.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchSVG, keyboard, "file://keyboard.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchCompiled, keyboard, "file://keyboard.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchSVG, shareddialog, "file://shareddialog.svg")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BenchLaunchCompiled,
+                  shareddialog,
+                  "file://shareddialog.svg")
+    ->Unit(benchmark::kMicrosecond);
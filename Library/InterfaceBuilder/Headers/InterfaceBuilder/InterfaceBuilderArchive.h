@@ -15,6 +15,10 @@ namespace ib {
 
 class InterfaceBuilderArchive {
  public:
+  /**
+   *  Make an archive from the file. Compiled scenes are read straight from a
+   *  mapping of the file.
+   */
   static std::unique_ptr<InterfaceBuilderArchive> Make(
       const core::FileHandle& handle);
 
@@ -34,6 +38,18 @@ class InterfaceBuilderArchive {
   virtual interface::ModelEntity::Ref inflate(interface::Interface& interface,
                                               EntityMap& map) const = 0;
 
+  /**
+   *  Lower the archive into a compiled scene. Compiled scenes hold the
+   *  hierarchy and the already decoded properties of the entities the archive
+   *  inflates to. This is meant to be done offline. Archives made from the
+   *  compiled scene inflate the same entities without decoding anything.
+   *
+   *  Scenes are in the byte order of the host they were compiled on.
+   *
+   *  @return the compiled scene. Empty if the archive is not valid.
+   */
+  virtual core::Allocation compile() const = 0;
+
  protected:
   InterfaceBuilderArchive();
 
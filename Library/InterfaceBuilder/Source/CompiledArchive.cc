@@ -0,0 +1,497 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "CompiledArchive.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace rl {
+namespace ib {
+
+/*
+ *  A compiled scene is a header followed by these sections, in order and
+ *  without padding:
+ *
+ *  - Nodes: A record per node, in preorder. Each record refers to its parent
+ *    by index. So parents always come before their children.
+ *  - Points: The points of the components of all paths.
+ *  - Components: The type of each component of all paths.
+ *  - Strings: The identifiers of all nodes.
+ *  - Blobs: The encoded images of all nodes.
+ *
+ *  The header and records are multiples of eight bytes. So the records and
+ *  points are aligned as long as the scene itself is.
+ */
+static const char kSceneMagic[8] = {'R', 'L', 'S', 'C', 'E', 'N', 'E', '\0'};
+static const uint32_t kSceneVersion = 1;
+static const uint32_t kSceneByteOrderMark = 0x01020304;
+
+static const uint64_t kNoParent = std::numeric_limits<uint64_t>::max();
+static const uint32_t kNodeFlagDetached = 1 << 0;
+
+struct SceneHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  uint64_t nodeCount;
+  uint64_t pointCount;
+  uint64_t componentCount;
+  uint64_t stringsSize;
+  uint64_t blobsSize;
+};
+
+struct SceneNodeRecord {
+  uint64_t parent;
+  uint64_t identifierOffset;
+  uint64_t identifierLength;
+  uint64_t firstComponent;
+  uint64_t componentCount;
+  uint64_t firstPoint;
+  uint64_t pointCount;
+  uint64_t contentsOffset;
+  uint64_t contentsLength;
+  uint32_t properties;
+  uint32_t flags;
+  double frame[4];
+  double transformation[16];
+  double backgroundColor[4];
+  double opacity;
+};
+
+struct ScenePoint {
+  double x;
+  double y;
+};
+
+static_assert(std::is_trivially_copyable<SceneNodeRecord>::value &&
+                  sizeof(SceneHeader) % 8 == 0 &&
+                  sizeof(SceneNodeRecord) % 8 == 0,
+              "Scene records must be copyable and keep the sections aligned");
+
+/**
+ *  The offsets of the sections of a scene.
+ */
+struct SceneLayout {
+  size_t nodes;
+  size_t points;
+  size_t components;
+  size_t strings;
+  size_t blobs;
+  size_t end;
+};
+
+/**
+ *  Place a section of count elements of the given size at the offset and
+ *  advance the offset past it. Sections that would end past the limit (or
+ *  overflow on the way there) are rejected.
+ */
+static bool PlaceSection(size_t& offset,
+                         uint64_t count,
+                         size_t elementSize,
+                         size_t limit) {
+  if (offset > limit || count > (limit - offset) / elementSize) {
+    return false;
+  }
+  offset += static_cast<size_t>(count) * elementSize;
+  return true;
+}
+
+static bool LayoutScene(const SceneHeader& header,
+                        size_t size,
+                        SceneLayout& layout) {
+  size_t offset = sizeof(SceneHeader);
+
+  layout.nodes = offset;
+  if (!PlaceSection(offset, header.nodeCount, sizeof(SceneNodeRecord), size)) {
+    return false;
+  }
+
+  layout.points = offset;
+  if (!PlaceSection(offset, header.pointCount, sizeof(ScenePoint), size)) {
+    return false;
+  }
+
+  layout.components = offset;
+  if (!PlaceSection(offset, header.componentCount, sizeof(uint8_t), size)) {
+    return false;
+  }
+
+  layout.strings = offset;
+  if (!PlaceSection(offset, header.stringsSize, sizeof(char), size)) {
+    return false;
+  }
+
+  layout.blobs = offset;
+  if (!PlaceSection(offset, header.blobsSize, sizeof(uint8_t), size)) {
+    return false;
+  }
+
+  layout.end = offset;
+  return true;
+}
+
+static size_t ComponentPointCount(uint8_t type) {
+  switch (static_cast<geom::Path::ComponentType>(type)) {
+    case geom::Path::ComponentType::Linear:
+      return 2;
+    case geom::Path::ComponentType::Quadratic:
+      return 3;
+    case geom::Path::ComponentType::Cubic:
+      return 4;
+  }
+  return 0;
+}
+
+/**
+ *  Checks that the range [offset, offset + length) lies within a section of
+ *  the given size.
+ */
+static bool RangeInSection(uint64_t offset, uint64_t length, uint64_t size) {
+  return offset <= size && length <= size - offset;
+}
+
+/**
+ *  Collects the sections of a scene while walking the hierarchy of nodes.
+ */
+class SceneWriter {
+ public:
+  SceneWriter() = default;
+
+  void append(const SceneNode& node, uint64_t parent) {
+    SceneNodeRecord record = {};
+
+    record.parent = parent;
+    record.properties = node.properties();
+    record.flags = node.isDetached() ? kNodeFlagDetached : 0;
+
+    const auto& identifier = node.identifier();
+    record.identifierOffset = _strings.size();
+    record.identifierLength = identifier.size();
+    _strings.append(identifier);
+
+    record.firstComponent = _components.size();
+    record.firstPoint = _points.size();
+    node.path().enumerateComponents(
+        [&](size_t, const geom::LinearPathComponent& linear) {
+          appendComponent(geom::Path::ComponentType::Linear,
+                          {linear.p1, linear.p2});
+        },
+        [&](size_t, const geom::QuadraticPathComponent& quad) {
+          appendComponent(geom::Path::ComponentType::Quadratic,
+                          {quad.p1, quad.cp, quad.p2});
+        },
+        [&](size_t, const geom::CubicPathComponent& cubic) {
+          appendComponent(geom::Path::ComponentType::Cubic,
+                          {cubic.p1, cubic.cp1, cubic.cp2, cubic.p2});
+        });
+    record.componentCount = _components.size() - record.firstComponent;
+    record.pointCount = _points.size() - record.firstPoint;
+
+    const auto& contents = node.contents();
+    record.contentsOffset = _blobs.size();
+    record.contentsLength = contents.size();
+    _blobs.insert(_blobs.end(), contents.data(),
+                  contents.data() + contents.size());
+
+    const auto& frame = node.frame();
+    record.frame[0] = frame.origin.x;
+    record.frame[1] = frame.origin.y;
+    record.frame[2] = frame.size.width;
+    record.frame[3] = frame.size.height;
+
+    memcpy(record.transformation, node.transformation().m,
+           sizeof(record.transformation));
+
+    const auto& color = node.backgroundColor();
+    record.backgroundColor[0] = color.red;
+    record.backgroundColor[1] = color.green;
+    record.backgroundColor[2] = color.blue;
+    record.backgroundColor[3] = color.alpha;
+
+    record.opacity = node.opacity();
+
+    const uint64_t index = _nodes.size();
+    _nodes.push_back(record);
+
+    for (const auto& child : node.children()) {
+      append(*child, index);
+    }
+  }
+
+  core::Allocation allocation() const {
+    SceneHeader header = {};
+    memcpy(header.magic, kSceneMagic, sizeof(kSceneMagic));
+    header.version = kSceneVersion;
+    header.byteOrderMark = kSceneByteOrderMark;
+    header.nodeCount = _nodes.size();
+    header.pointCount = _points.size();
+    header.componentCount = _components.size();
+    header.stringsSize = _strings.size();
+    header.blobsSize = _blobs.size();
+
+    SceneLayout layout;
+    if (!LayoutScene(header, std::numeric_limits<size_t>::max(), layout)) {
+      return {};
+    }
+
+    core::Allocation allocation;
+    if (!allocation.resize(layout.end)) {
+      return {};
+    }
+
+    auto data = allocation.data();
+    memcpy(data, &header, sizeof(header));
+    Write(data + layout.nodes, _nodes);
+    Write(data + layout.points, _points);
+    Write(data + layout.components, _components);
+    Write(data + layout.strings, _strings);
+    Write(data + layout.blobs, _blobs);
+
+    return allocation;
+  }
+
+ private:
+  std::vector<SceneNodeRecord> _nodes;
+  std::vector<ScenePoint> _points;
+  std::vector<uint8_t> _components;
+  std::string _strings;
+  std::vector<uint8_t> _blobs;
+
+  void appendComponent(geom::Path::ComponentType type,
+                       std::initializer_list<geom::Point> points) {
+    _components.push_back(static_cast<uint8_t>(type));
+    for (const auto& point : points) {
+      _points.push_back({point.x, point.y});
+    }
+  }
+
+  template <class T>
+  static void Write(uint8_t* destination, const T& section) {
+    if (section.size() == 0) {
+      return;
+    }
+    memcpy(destination, section.data(),
+           section.size() * sizeof(typename T::value_type));
+  }
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SceneWriter);
+};
+
+core::Allocation CompiledArchive::Compile(const SceneNode& root) {
+  SceneWriter writer;
+  writer.append(root, kNoParent);
+  return writer.allocation();
+}
+
+bool CompiledArchive::IsCompiledScene(const uint8_t* data, size_t size) {
+  if (data == nullptr || size < sizeof(SceneHeader)) {
+    return false;
+  }
+  return memcmp(data, kSceneMagic, sizeof(kSceneMagic)) == 0;
+}
+
+CompiledArchive::CompiledArchive(core::FileMapping mapping)
+    : _mapping(std::move(mapping)),
+      _data(_mapping.mapping()),
+      _size(_mapping.size()),
+      _valid(validate()) {}
+
+CompiledArchive::CompiledArchive(const uint8_t* data, size_t size)
+    : _allocation(data, size),
+      _data(_allocation.data()),
+      _size(_allocation.size()),
+      _valid(validate()) {}
+
+CompiledArchive::~CompiledArchive() = default;
+
+bool CompiledArchive::isValid() const {
+  return _valid;
+}
+
+bool CompiledArchive::validate() const {
+  if (!IsCompiledScene(_data, _size)) {
+    return false;
+  }
+
+  SceneHeader header;
+  memcpy(&header, _data, sizeof(header));
+
+  if (header.version != kSceneVersion ||
+      header.byteOrderMark != kSceneByteOrderMark) {
+    return false;
+  }
+
+  SceneLayout layout;
+  if (!LayoutScene(header, _size, layout) || layout.end != _size ||
+      header.nodeCount == 0) {
+    return false;
+  }
+
+  /*
+   *  Records are read in place. Check all references once here so that
+   *  inflation can trust them.
+   */
+  auto nodes = reinterpret_cast<const SceneNodeRecord*>(_data + layout.nodes);
+  auto components = _data + layout.components;
+
+  for (uint64_t i = 0; i < header.nodeCount; i++) {
+    const auto& node = nodes[i];
+
+    if (i == 0 ? node.parent != kNoParent
+               : (node.parent >= i ||
+                  (nodes[node.parent].flags & kNodeFlagDetached))) {
+      return false;
+    }
+
+    if (!RangeInSection(node.identifierOffset, node.identifierLength,
+                        header.stringsSize) ||
+        !RangeInSection(node.contentsOffset, node.contentsLength,
+                        header.blobsSize) ||
+        !RangeInSection(node.firstComponent, node.componentCount,
+                        header.componentCount) ||
+        !RangeInSection(node.firstPoint, node.pointCount, header.pointCount)) {
+      return false;
+    }
+
+    uint64_t pointCount = 0;
+    for (uint64_t j = 0; j < node.componentCount; j++) {
+      const auto count =
+          ComponentPointCount(components[node.firstComponent + j]);
+      if (count == 0) {
+        return false;
+      }
+      pointCount += count;
+    }
+
+    if (pointCount != node.pointCount) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static geom::Path ReadPath(const SceneNodeRecord& node,
+                           const ScenePoint* points,
+                           const uint8_t* components) {
+  geom::Path path;
+  auto point = [&](size_t index) {
+    return geom::Point{points[index].x, points[index].y};
+  };
+
+  size_t index = node.firstPoint;
+  for (uint64_t i = 0; i < node.componentCount; i++) {
+    const auto type = static_cast<geom::Path::ComponentType>(
+        components[node.firstComponent + i]);
+    switch (type) {
+      case geom::Path::ComponentType::Linear:
+        path.addLinearComponent(point(index), point(index + 1));
+        index += 2;
+        break;
+      case geom::Path::ComponentType::Quadratic:
+        path.addQuadraticComponent(point(index), point(index + 1),
+                                   point(index + 2));
+        index += 3;
+        break;
+      case geom::Path::ComponentType::Cubic:
+        path.addCubicComponent(point(index), point(index + 1),
+                               point(index + 2), point(index + 3));
+        index += 4;
+        break;
+    }
+  }
+  return path;
+}
+
+interface::ModelEntity::Ref CompiledArchive::inflate(
+    interface::Interface& interface,
+    EntityMap& map) const {
+  if (!_valid) {
+    return nullptr;
+  }
+
+  SceneHeader header;
+  memcpy(&header, _data, sizeof(header));
+
+  SceneLayout layout;
+  LayoutScene(header, _size, layout);
+
+  auto nodes = reinterpret_cast<const SceneNodeRecord*>(_data + layout.nodes);
+  auto points = reinterpret_cast<const ScenePoint*>(_data + layout.points);
+  auto components = _data + layout.components;
+  auto strings = reinterpret_cast<const char*>(_data + layout.strings);
+  auto blobs = _data + layout.blobs;
+
+  /*
+   *  Parents come before their children. So each entity can be attached as
+   *  soon as it is created.
+   */
+  std::vector<interface::ModelEntity::Ref> entities(header.nodeCount);
+
+  for (uint64_t i = 0; i < header.nodeCount; i++) {
+    const auto& node = nodes[i];
+
+    auto entity = interface.createEntity();
+
+    if (node.identifierLength > 0) {
+      map[std::string{strings + node.identifierOffset,
+                      static_cast<size_t>(node.identifierLength)}] = entity;
+    }
+
+    if (node.flags & kNodeFlagDetached) {
+      continue;
+    }
+
+    if (node.properties & entity::Entity::BoundsMask) {
+      entity->setFrame({node.frame[0], node.frame[1], node.frame[2],
+                        node.frame[3]});
+    }
+
+    if (node.properties & entity::Entity::TransformationMask) {
+      geom::Matrix transformation;
+      memcpy(transformation.m, node.transformation, sizeof(transformation.m));
+      entity->setTransformation(transformation);
+    }
+
+    if (node.properties & entity::Entity::BackgroundColorMask) {
+      entity->setBackgroundColor(
+          {node.backgroundColor[0], node.backgroundColor[1],
+           node.backgroundColor[2], node.backgroundColor[3]});
+    }
+
+    if (node.properties & entity::Entity::OpacityMask) {
+      entity->setOpacity(node.opacity);
+    }
+
+    if (node.properties & entity::Entity::PathMask) {
+      entity->setPath(ReadPath(node, points, components));
+    }
+
+    if (node.properties & entity::Entity::ContentsMask) {
+      entity->setContents(image::Image{core::Allocation{
+          blobs + node.contentsOffset,
+          static_cast<size_t>(node.contentsLength)}});
+    }
+
+    if (node.parent != kNoParent) {
+      entities[node.parent]->addChild(entity);
+    }
+
+    entities[i] = std::move(entity);
+  }
+
+  return entities[0];
+}
+
+core::Allocation CompiledArchive::compile() const {
+  if (!_valid) {
+    return {};
+  }
+  return {_data, _size};
+}
+
+}  // namespace ib
+}  // namespace rl
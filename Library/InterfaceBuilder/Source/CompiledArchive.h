@@ -0,0 +1,74 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Allocation.h>
+#include <Core/FileMapping.h>
+#include <Core/Macros.h>
+#include <InterfaceBuilder/InterfaceBuilderArchive.h>
+#include "SceneNode.h"
+
+namespace rl {
+namespace ib {
+
+/**
+ *  An archive that has already been lowered to a flat scene. The scene holds
+ *  the hierarchy and the decoded properties of its entities in a form that
+ *  can be used straight from a mapping of the file. Scenes are written in the
+ *  byte order of the host that compiled them and are rejected on hosts with a
+ *  different one.
+ */
+class CompiledArchive : public InterfaceBuilderArchive {
+ public:
+  /**
+   *  Flatten the hierarchy below the given node into a compiled scene.
+   *
+   *  @param root the root of the hierarchy to compile
+   *
+   *  @return the compiled scene
+   */
+  static core::Allocation Compile(const SceneNode& root);
+
+  /**
+   *  @return if the data starts like a compiled scene. The rest of it is only
+   *          checked when an archive is created from it.
+   */
+  static bool IsCompiledScene(const uint8_t* data, size_t size);
+
+  /**
+   *  Create an archive that reads the scene from the mapping without copying
+   *  it.
+   */
+  CompiledArchive(core::FileMapping mapping);
+
+  /**
+   *  Create an archive from a copy of the scene in the data.
+   */
+  CompiledArchive(const uint8_t* data, size_t size);
+
+  ~CompiledArchive() override;
+
+  bool isValid() const override;
+
+  interface::ModelEntity::Ref inflate(interface::Interface& interface,
+                                      EntityMap& map) const override;
+
+  core::Allocation compile() const override;
+
+ private:
+  core::FileMapping _mapping;
+  core::Allocation _allocation;
+  const uint8_t* _data;
+  size_t _size;
+  bool _valid;
+
+  bool validate() const;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(CompiledArchive);
+};
+
+}  // namespace ib
+}  // namespace rl
@@ -5,6 +5,7 @@
 
 #include <Core/Utilities.h>
 #include <InterfaceBuilder/InterfaceBuilderArchive.h>
+#include "CompiledArchive.h"
 #include "SVGArchive.h"
 
 namespace rl {
@@ -20,6 +21,16 @@ std::unique_ptr<InterfaceBuilderArchive> InterfaceBuilderArchive::Make(
   /*
    *  In fallback order, check for recognized archive formats.
    */
+  if (CompiledArchive::IsCompiledScene(data, size)) {
+    auto compiledArchive = std::make_unique<CompiledArchive>(data, size);
+
+    if (!compiledArchive->isValid()) {
+      return nullptr;
+    }
+
+    return compiledArchive;
+  }
+
   auto svgArchive = std::make_unique<SVGArchive>(data, size);
 
   if (svgArchive->isValid()) {
@@ -44,6 +55,20 @@ std::unique_ptr<InterfaceBuilderArchive> InterfaceBuilderArchive::Make(
     return nullptr;
   }
 
+  /*
+   *  Compiled scenes are used in place. So they keep the mapping.
+   */
+  if (CompiledArchive::IsCompiledScene(mapping.mapping(), mapping.size())) {
+    auto compiledArchive =
+        std::make_unique<CompiledArchive>(std::move(mapping));
+
+    if (!compiledArchive->isValid()) {
+      return nullptr;
+    }
+
+    return compiledArchive;
+  }
+
   return Make(mapping.mapping(), mapping.size());
 }
 
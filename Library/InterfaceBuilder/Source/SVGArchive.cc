@@ -6,6 +6,7 @@
 #include "SVGArchive.h"
 #include <Geometry/PathBuilder.h>
 #include <sstream>
+#include "CompiledArchive.h"
 #include "SVGDecoder.h"
 #include "SVGPathParser/SVGPathString.h"
 
@@ -36,22 +37,6 @@ bool SVGArchive::isValid() const {
   return _document != nullptr;
 }
 
-static interface::ModelEntity::Ref CreateRegisteredEntity(
-    interface::Interface& interface,
-    SVGArchive::EntityMap& map,
-    const pugi::xml_node& node) {
-  auto entity = interface.createEntity();
-
-  auto attribute = node.attribute("id");
-
-  if (attribute.empty()) {
-    return entity;
-  }
-
-  map[attribute.value()] = entity;
-  return entity;
-}
-
 void SVGArchive::findDefinitions(const pugi::xml_node& node) {
   if (node.empty()) {
     return;
@@ -68,23 +53,39 @@ void SVGArchive::findDefinitions(const pugi::xml_node& node) {
   }
 }
 
+SceneNode::Ref SVGArchive::lower() const {
+  if (!isValid()) {
+    return nullptr;
+  }
+  return visitNodeChildren(_document->child("svg"));
+}
+
 interface::ModelEntity::Ref SVGArchive::inflate(interface::Interface& interface,
                                                 EntityMap& map) const {
-  if (!isValid()) {
+  auto root = lower();
+  if (root == nullptr) {
     return nullptr;
   }
-  return visitNodeChildren(_document->child("svg"), interface, map);
+  return root->inflate(interface, map);
+}
+
+core::Allocation SVGArchive::compile() const {
+  auto root = lower();
+  if (root == nullptr) {
+    return {};
+  }
+  return CompiledArchive::Compile(*root);
 }
 
-static void FixupTransformation(interface::ModelEntity& entity) {
+static void FixupTransformation(SceneNode& node) {
   geom::Matrix identity;
-  if (entity.transformation() == identity) {
+  if (node.transformation() == identity) {
     return;
   }
 
   bool result = false;
   geom::Matrix::Decomposition decomposition;
-  std::tie(result, decomposition) = entity.transformation().decompose();
+  std::tie(result, decomposition) = node.transformation().decompose();
 
   if (!result) {
     return;
@@ -101,41 +102,47 @@ static void FixupTransformation(interface::ModelEntity& entity) {
     return;
   }
 
-  auto frame = entity.frame();
+  auto frame = node.frame();
   frame.origin.x += decomposition.translation.x;
   frame.origin.y += decomposition.translation.y;
-  entity.setFrame(frame);
-  entity.setTransformation(identity);
+  node.setFrame(frame);
+  node.setTransformation(identity);
 }
 
-static void FixupBounds(interface::ModelEntity& entity) {}
+static void FixupBounds(SceneNode& node) {}
 
-static void FixupHierarchy(interface::ModelEntity& entity) {
+static void FixupHierarchy(SceneNode& node) {
   /*
    *  If the node has a transform that can be expressed as a frame offset, apply
    *  it to the frame and modify the transform accordingly.
    */
-  FixupTransformation(entity);
+  FixupTransformation(node);
 
   /*
    *  Make the bounds large enough for this node to encapsulate its children.
    */
-  FixupBounds(entity);
+  FixupBounds(node);
 }
 
-interface::ModelEntity::Ref SVGArchive::visitNodeChildren(
-    const pugi::xml_node& node,
-    interface::Interface& interface,
-    InterfaceBuilderArchive::EntityMap& map) const {
-  if (node.empty()) {
+SceneNode::Ref SVGArchive::visitNodeChildren(
+    const pugi::xml_node& element) const {
+  if (element.empty()) {
     return nullptr;
   }
 
-  auto entity =
-      configureNode(CreateRegisteredEntity(interface, map, node), node);
+  auto node = std::make_unique<SceneNode>(element.attribute("id").value());
 
-  if (entity == nullptr) {
-    return nullptr;
+  if (!configureNode(*node, element)) {
+    if (node->identifier().size() == 0) {
+      return nullptr;
+    }
+
+    /*
+     *  Elements that are not drawn may still be looked up by identifier.
+     */
+    auto detached = std::make_unique<SceneNode>(node->identifier());
+    detached->setDetached(true);
+    return detached;
   }
 
   bool present = false;
@@ -143,245 +150,234 @@ interface::ModelEntity::Ref SVGArchive::visitNodeChildren(
   /*
    *  Fill
    */
-  auto fill = Decode<entity::Color>(node, "fill", &present);
+  auto fill = Decode<entity::Color>(element, "fill", &present);
   if (present) {
-    entity->setBackgroundColor(fill);
+    node->setBackgroundColor(fill);
   }
 
   /*
    *  Fill Opacity
    */
-  auto fillOpacity = Decode<double>(node, "fill-opacity", &present);
+  auto fillOpacity = Decode<double>(element, "fill-opacity", &present);
   if (present) {
-    entity->setOpacity(fillOpacity);
+    node->setOpacity(fillOpacity);
   }
 
   /*
    *  Transform
    */
-  auto transfrom = Decode<geom::Matrix>(node, "transform", &present);
+  auto transfrom = Decode<geom::Matrix>(element, "transform", &present);
   if (present) {
-    entity->setTransformation(transfrom);
+    node->setTransformation(transfrom);
   }
 
   /*
    *  Children
    */
-  for (const auto& childNode : node.children()) {
-    entity->addChild(visitNodeChildren(childNode, interface, map));
+  for (const auto& childElement : element.children()) {
+    node->addChild(visitNodeChildren(childElement));
   }
 
   /*
-   *  We are done inflating this sub-hierarchy. Make the hierarchy consistent.
+   *  We are done lowering this sub-hierarchy. Make the hierarchy consistent.
    */
-  FixupHierarchy(*entity);
+  FixupHierarchy(*node);
 
-  return entity;
+  return node;
 }
 
-interface::ModelEntity::Ref SVGArchive::configureNode(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  if (entity == nullptr) {
-    return nullptr;
-  }
-
-  if (::strncmp(node.name(), "rect", sizeof("rect")) == 0) {
-    return configureRect(entity, node);
+bool SVGArchive::configureNode(SceneNode& node,
+                               const pugi::xml_node& element) const {
+  if (::strncmp(element.name(), "rect", sizeof("rect")) == 0) {
+    return configureRect(node, element);
   }
 
-  if (::strncmp(node.name(), "ellipse", sizeof("ellipse")) == 0) {
-    return configureEllipse(entity, node);
+  if (::strncmp(element.name(), "ellipse", sizeof("ellipse")) == 0) {
+    return configureEllipse(node, element);
   }
 
-  if (::strncmp(node.name(), "g", sizeof("g")) == 0) {
-    return configureG(entity, node);
+  if (::strncmp(element.name(), "g", sizeof("g")) == 0) {
+    return configureG(node, element);
   }
 
-  if (::strncmp(node.name(), "circle", sizeof("circle")) == 0) {
-    return configureCircle(entity, node);
+  if (::strncmp(element.name(), "circle", sizeof("circle")) == 0) {
+    return configureCircle(node, element);
   }
 
-  if (::strncmp(node.name(), "polygon", sizeof("polygon")) == 0) {
-    return configurePolygon(entity, node);
+  if (::strncmp(element.name(), "polygon", sizeof("polygon")) == 0) {
+    return configurePolygon(node, element);
   }
 
-  if (::strncmp(node.name(), "polyline", sizeof("polyline")) == 0) {
+  if (::strncmp(element.name(), "polyline", sizeof("polyline")) == 0) {
     /*
      *  A polyline is just a polygon without a fill.
      */
-    return configurePolygon(entity, node);
+    return configurePolygon(node, element);
   }
 
-  if (::strncmp(node.name(), "line", sizeof("line")) == 0) {
-    return configureLine(entity, node);
+  if (::strncmp(element.name(), "line", sizeof("line")) == 0) {
+    return configureLine(node, element);
   }
 
-  if (::strncmp(node.name(), "use", sizeof("use")) == 0) {
-    return configureUse(entity, node);
+  if (::strncmp(element.name(), "use", sizeof("use")) == 0) {
+    return configureUse(node, element);
   }
 
-  if (::strncmp(node.name(), "text", sizeof("text")) == 0) {
-    return configureText(entity, node);
+  if (::strncmp(element.name(), "text", sizeof("text")) == 0) {
+    return configureText(node, element);
   }
 
-  if (::strncmp(node.name(), "path", sizeof("path")) == 0) {
-    return configurePath(entity, node);
+  if (::strncmp(element.name(), "path", sizeof("path")) == 0) {
+    return configurePath(node, element);
   }
 
-  if (::strncmp(node.name(), "image", sizeof("image")) == 0) {
-    return configureImage(entity, node);
+  if (::strncmp(element.name(), "image", sizeof("image")) == 0) {
+    return configureImage(node, element);
   }
 
-  if (::strncmp(node.name(), "mask", sizeof("mask")) == 0) {
-    return configureMask(entity, node);
+  if (::strncmp(element.name(), "mask", sizeof("mask")) == 0) {
+    return configureMask(node, element);
   }
 
-  if (::strncmp(node.name(), "svg", sizeof("svg")) == 0) {
-    return configureSVG(entity, node);
+  if (::strncmp(element.name(), "svg", sizeof("svg")) == 0) {
+    return configureSVG(node, element);
   }
 
-  if (::strncmp(node.name(), "desc", sizeof("desc")) == 0) {
-    return nullptr;
+  if (::strncmp(element.name(), "desc", sizeof("desc")) == 0) {
+    return false;
   }
 
-  if (::strncmp(node.name(), "title", sizeof("title")) == 0) {
-    return nullptr;
+  if (::strncmp(element.name(), "title", sizeof("title")) == 0) {
+    return false;
   }
 
-  if (::strncmp(node.name(), "defs", sizeof("defs")) == 0) {
+  if (::strncmp(element.name(), "defs", sizeof("defs")) == 0) {
     /*
      *  Definitions have been parsed ahead of time.
      */
-    return nullptr;
+    return false;
   }
 
-  RL_LOG("Unknown: %s", node.name());
-  return nullptr;
+  RL_LOG("Unknown: %s", element.name());
+  return false;
 }
 
-interface::ModelEntity::Ref SVGArchive::configureSVG(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  entity->setFrame(Decode<geom::Rect>(node, "viewBox"));
-  return entity;
+bool SVGArchive::configureSVG(SceneNode& node,
+                              const pugi::xml_node& element) const {
+  node.setFrame(Decode<geom::Rect>(element, "viewBox"));
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/shapes.html#RectElement
  */
-interface::ModelEntity::Ref SVGArchive::configureRect(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configureRect(SceneNode& node,
+                               const pugi::xml_node& element) const {
   const geom::Rect frame = {
-      Decode<double>(node, "x"),       //
-      Decode<double>(node, "y"),       //
-      Decode<double>(node, "width"),   //
-      Decode<double>(node, "height"),  //
+      Decode<double>(element, "x"),       //
+      Decode<double>(element, "y"),       //
+      Decode<double>(element, "width"),   //
+      Decode<double>(element, "height"),  //
   };
 
   if (frame.size.width <= 0.0 || frame.size.height <= 0.0) {
     /*
      *  A value of zero disables rendering of the element.
      */
-    return nullptr;
+    return false;
   }
 
-  entity->setFrame(frame);
+  node.setFrame(frame);
 
   /*
    *  TODO: Radii are not handled here.
    */
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/shapes.html#EllipseElement
  */
-interface::ModelEntity::Ref SVGArchive::configureEllipse(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configureEllipse(SceneNode& node,
+                                  const pugi::xml_node& element) const {
   const geom::Size size = {
-      Decode<double>(node, "rx") * 2.0,  //
-      Decode<double>(node, "ry") * 2.0,  //
+      Decode<double>(element, "rx") * 2.0,  //
+      Decode<double>(element, "ry") * 2.0,  //
   };
 
   if (size.width <= 0.0 && size.height <= 0.0) {
     /*
      *  A value of zero disables rendering of the element.
      */
-    return nullptr;
+    return false;
   }
 
   const geom::Point center = {
-      Decode<double>(node, "cx"),  //
-      Decode<double>(node, "cy"),  //
+      Decode<double>(element, "cx"),  //
+      Decode<double>(element, "cy"),  //
   };
 
   geom::PathBuilder builder;
 
   builder.addEllipse(center, size);
 
-  entity->setPath(builder.path());
+  node.setPath(builder.path());
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/struct.html#GElement
  */
-interface::ModelEntity::Ref SVGArchive::configureG(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  return entity;
+bool SVGArchive::configureG(SceneNode& node,
+                            const pugi::xml_node& element) const {
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/shapes.html#CircleElement
  */
-interface::ModelEntity::Ref SVGArchive::configureCircle(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  double radius = Decode<double>(node, "r");
+bool SVGArchive::configureCircle(SceneNode& node,
+                                 const pugi::xml_node& element) const {
+  double radius = Decode<double>(element, "r");
 
   if (radius <= 0.0) {
     /*
      *  A value of zero disables rendering of the element.
      */
-    return nullptr;
+    return false;
   }
 
   const geom::Point center = {
-      Decode<double>(node, "cx"),  //
-      Decode<double>(node, "cy"),  //
+      Decode<double>(element, "cx"),  //
+      Decode<double>(element, "cy"),  //
   };
 
   geom::PathBuilder builder;
 
   builder.addCircle(center, radius);
 
-  entity->setPath(builder.path());
+  node.setPath(builder.path());
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/shapes.html#PolygonElement
  */
-interface::ModelEntity::Ref SVGArchive::configurePolygon(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configurePolygon(SceneNode& node,
+                                  const pugi::xml_node& element) const {
   /*
    *  Treat the path value as an SVG path without the preceding absolute line
    *  declaration "L".
    *  https://www.w3.org/TR/SVG11/paths.html#PathDataLinetoCommands
    */
 
-  const auto& attribute = node.attribute("points");
+  const auto& attribute = element.attribute("points");
 
   if (attribute.empty()) {
-    return nullptr;
+    return false;
   }
 
   std::stringstream stream;
@@ -389,7 +385,7 @@ interface::ModelEntity::Ref SVGArchive::configurePolygon(
   auto path = svg::SVGPathStringParse(stream.str());
 
   if (path.componentCount() == 0) {
-    return nullptr;
+    return false;
   }
 
   /*
@@ -402,175 +398,167 @@ interface::ModelEntity::Ref SVGArchive::configurePolygon(
     path.updateLinearComponentAtIndex(0, linear);
   }
 
-  entity->setPath(std::move(path));
+  node.setPath(std::move(path));
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/shapes.html#LineElement
  */
-interface::ModelEntity::Ref SVGArchive::configureLine(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configureLine(SceneNode& node,
+                               const pugi::xml_node& element) const {
   geom::PathBuilder builder;
 
   builder.moveTo({
-      Decode<double>(node, "x1"),  //
-      Decode<double>(node, "y1"),  //
+      Decode<double>(element, "x1"),  //
+      Decode<double>(element, "y1"),  //
   });
 
   builder.lineTo({
-      Decode<double>(node, "x2"),  //
-      Decode<double>(node, "y2"),  //
+      Decode<double>(element, "x2"),  //
+      Decode<double>(element, "y2"),  //
   });
 
-  entity->setPath(builder.path());
+  node.setPath(builder.path());
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG11/struct.html#UseElement
  */
-interface::ModelEntity::Ref SVGArchive::configureUse(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  auto link = Decode<core::URI>(node, "xlink:href");
+bool SVGArchive::configureUse(SceneNode& node,
+                              const pugi::xml_node& element) const {
+  auto link = Decode<core::URI>(element, "xlink:href");
 
   if (!link.isValid()) {
-    return nullptr;
+    return false;
   }
 
   auto fragment = link.fragment();
 
   if (fragment.size() == 0) {
-    return nullptr;
+    return false;
   }
 
   auto found = _definitions.find(fragment);
 
   if (found == _definitions.end()) {
-    return nullptr;
+    return false;
   }
 
-  entity = configureNode(entity, found->second);
-
-  if (entity == nullptr) {
-    return nullptr;
+  if (!configureNode(node, found->second)) {
+    return false;
   }
 
   /*
    *  The ‘use’ element has optional attributes ‘x’, ‘y’, ‘width’ and ‘height’.
-   *  If on configureing this node, we inflated a model entity, attach these
+   *  If on configuring this node, we lowered a drawn element, attach these
    *  attributes *if present* on the same.
    */
 
-  geom::Rect frame = entity->frame();
+  geom::Rect frame = node.frame();
 
   bool present = false;
 
-  auto x = Decode<double>(node, "x", &present);
+  auto x = Decode<double>(element, "x", &present);
   if (present) {
     frame.origin.x = x;
   }
 
-  auto y = Decode<double>(node, "y", &present);
+  auto y = Decode<double>(element, "y", &present);
   if (present) {
     frame.origin.y = y;
   }
 
-  auto width = Decode<double>(node, "width", &present);
+  auto width = Decode<double>(element, "width", &present);
   if (present) {
     frame.size.width = width;
   }
 
-  auto height = Decode<double>(node, "height", &present);
+  auto height = Decode<double>(element, "height", &present);
   if (present) {
     frame.size.height = height;
   }
 
-  entity->setFrame(frame);
+  node.setFrame(frame);
 
-  return entity;
+  return true;
 }
 
 /**
  *  https://www.w3.org/TR/SVG/paths.html#PathElement
  */
-interface::ModelEntity::Ref SVGArchive::configurePath(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  auto pathString = Decode<std::string>(node, "d");
+bool SVGArchive::configurePath(SceneNode& node,
+                               const pugi::xml_node& element) const {
+  auto pathString = Decode<std::string>(element, "d");
 
   if (pathString.size() == 0) {
-    return nullptr;
+    return false;
   }
 
   geom::Path path = svg::SVGPathStringParse(pathString);
 
   if (path.componentCount() == 0) {
-    return nullptr;
+    return false;
   }
 
-  entity->setPath(std::move(path));
+  node.setPath(std::move(path));
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG/struct.html#ImageElement
  */
-interface::ModelEntity::Ref SVGArchive::configureImage(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
-  auto width = Decode<double>(node, "width");
+bool SVGArchive::configureImage(SceneNode& node,
+                                const pugi::xml_node& element) const {
+  auto width = Decode<double>(element, "width");
 
   if (width <= 0) {
-    return nullptr;
+    return false;
   }
 
-  auto height = Decode<double>(node, "height");
+  auto height = Decode<double>(element, "height");
 
   if (height <= 0) {
-    return nullptr;
+    return false;
   }
 
-  auto image = Decode<image::Image>(node, "xlink:href");
+  auto image = Decode<core::Allocation>(element, "xlink:href");
 
-  if (!image.isValid()) {
-    return nullptr;
+  if (image.size() == 0) {
+    return false;
   }
 
-  entity->setFrame(
-      {Decode<double>(node, "x"), Decode<double>(node, "y"), width, height});
-  entity->setContents(std::move(image));
+  node.setFrame({Decode<double>(element, "x"), Decode<double>(element, "y"),
+                 width, height});
+  node.setContents(std::move(image));
 
-  return entity;
+  return true;
 }
 
 /*
  *  https://www.w3.org/TR/SVG/masking.html#MaskElement
  */
-interface::ModelEntity::Ref SVGArchive::configureMask(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configureMask(SceneNode& node,
+                               const pugi::xml_node& element) const {
   /*
    *  TODO: Wire up mask elements when the clip stack work is done.
    */
-  return nullptr;
+  return false;
 }
 
 /*
  *  https://www.w3.org/TR/SVG/text.html#TextElement
  */
-interface::ModelEntity::Ref SVGArchive::configureText(
-    interface::ModelEntity::Ref entity,
-    const pugi::xml_node& node) const {
+bool SVGArchive::configureText(SceneNode& node,
+                               const pugi::xml_node& element) const {
   /*
    *  TODO: Wire up text elements when libTypography work items are completed.
    */
-  return nullptr;
+  return false;
 }
 
 }  // namespace ib
@@ -12,6 +12,8 @@
 
 #include <pugixml.hpp>
 
+#include "SceneNode.h"
+
 namespace rl {
 namespace ib {
 
@@ -26,57 +28,49 @@ class SVGArchive : public InterfaceBuilderArchive {
   interface::ModelEntity::Ref inflate(interface::Interface& interface,
                                       EntityMap& map) const override;
 
+  core::Allocation compile() const override;
+
+  /**
+   *  Decode the document into the hierarchy of entity properties it inflates
+   *  to.
+   *
+   *  @return the root of the hierarchy. Null if the archive is not valid.
+   */
+  SceneNode::Ref lower() const;
+
  private:
   std::unique_ptr<pugi::xml_document> _document;
   std::unordered_map<std::string, pugi::xml_node> _definitions;
 
   void findDefinitions(const pugi::xml_node& node);
 
-  interface::ModelEntity::Ref visitNodeChildren(const pugi::xml_node& node,
-                                                interface::Interface& interface,
-                                                EntityMap& map) const;
+  SceneNode::Ref visitNodeChildren(const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureNode(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configureNode(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureSVG(interface::ModelEntity::Ref entity,
-                                           const pugi::xml_node& node) const;
+  bool configureSVG(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureRect(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configureRect(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureEllipse(
-      interface::ModelEntity::Ref entity,
-      const pugi::xml_node& node) const;
+  bool configureEllipse(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureG(interface::ModelEntity::Ref entity,
-                                         const pugi::xml_node& node) const;
+  bool configureG(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureCircle(
-      interface::ModelEntity::Ref entity,
-      const pugi::xml_node& node) const;
+  bool configureCircle(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configurePolygon(
-      interface::ModelEntity::Ref entity,
-      const pugi::xml_node& node) const;
+  bool configurePolygon(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureLine(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configureLine(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureUse(interface::ModelEntity::Ref entity,
-                                           const pugi::xml_node& node) const;
+  bool configureUse(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureText(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configureText(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configurePath(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configurePath(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureImage(interface::ModelEntity::Ref entity,
-                                             const pugi::xml_node& node) const;
+  bool configureImage(SceneNode& node, const pugi::xml_node& element) const;
 
-  interface::ModelEntity::Ref configureMask(interface::ModelEntity::Ref entity,
-                                            const pugi::xml_node& node) const;
+  bool configureMask(SceneNode& node, const pugi::xml_node& element) const;
 
   RL_DISALLOW_COPY_AND_ASSIGN(SVGArchive);
 };
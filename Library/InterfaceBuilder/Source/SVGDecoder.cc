@@ -130,9 +130,9 @@ core::URI Decode<>(const pugi::xml_node& node,
 }
 
 template <>
-image::Image Decode<>(const pugi::xml_node& node,
-                      const char* name,
-                      bool* present) {
+core::Allocation Decode<>(const pugi::xml_node& node,
+                          const char* name,
+                          bool* present) {
   auto attribute = node.attribute(name);
 
   if (present != nullptr) {
@@ -155,14 +155,8 @@ image::Image Decode<>(const pugi::xml_node& node,
     return {};
   }
 
-  auto allocation = core::Base64Decode(
+  return core::Base64Decode(
       reinterpret_cast<const uint8_t*>(found + strlen(base64Marker)));
-
-  if (allocation.size() == 0) {
-    return {};
-  }
-
-  return {std::move(allocation)};
 }
 
 }  // namespace ib
@@ -0,0 +1,147 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "SceneNode.h"
+
+namespace rl {
+namespace ib {
+
+SceneNode::SceneNode(std::string identifier)
+    : _identifier(std::move(identifier)),
+      _detached(false),
+      _properties(0),
+      _opacity(1.0) {}
+
+SceneNode::~SceneNode() = default;
+
+const std::string& SceneNode::identifier() const {
+  return _identifier;
+}
+
+bool SceneNode::isDetached() const {
+  return _detached;
+}
+
+void SceneNode::setDetached(bool detached) {
+  _detached = detached;
+}
+
+entity::Entity::PropertyMaskType SceneNode::properties() const {
+  return _properties;
+}
+
+const geom::Rect& SceneNode::frame() const {
+  return _frame;
+}
+
+void SceneNode::setFrame(const geom::Rect& frame) {
+  _frame = frame;
+  _properties |= entity::Entity::BoundsMask | entity::Entity::PositionMask;
+}
+
+const geom::Matrix& SceneNode::transformation() const {
+  return _transformation;
+}
+
+void SceneNode::setTransformation(const geom::Matrix& transformation) {
+  _transformation = transformation;
+  _properties |= entity::Entity::TransformationMask;
+}
+
+const entity::Color& SceneNode::backgroundColor() const {
+  return _backgroundColor;
+}
+
+void SceneNode::setBackgroundColor(const entity::Color& backgroundColor) {
+  _backgroundColor = backgroundColor;
+  _properties |= entity::Entity::BackgroundColorMask;
+}
+
+double SceneNode::opacity() const {
+  return _opacity;
+}
+
+void SceneNode::setOpacity(double opacity) {
+  _opacity = opacity;
+  _properties |= entity::Entity::OpacityMask;
+}
+
+const geom::Path& SceneNode::path() const {
+  return _path;
+}
+
+void SceneNode::setPath(geom::Path path) {
+  _path = std::move(path);
+  _properties |= entity::Entity::PathMask;
+}
+
+const core::Allocation& SceneNode::contents() const {
+  return _contents;
+}
+
+void SceneNode::setContents(core::Allocation contents) {
+  _contents = std::move(contents);
+  _properties |= entity::Entity::ContentsMask;
+}
+
+const std::vector<SceneNode::Ref>& SceneNode::children() const {
+  return _children;
+}
+
+void SceneNode::addChild(Ref child) {
+  if (child == nullptr) {
+    return;
+  }
+  _children.emplace_back(std::move(child));
+}
+
+interface::ModelEntity::Ref SceneNode::inflate(
+    interface::Interface& interface,
+    InterfaceBuilderArchive::EntityMap& map) const {
+  auto entity = interface.createEntity();
+
+  if (_identifier.size() > 0) {
+    map[_identifier] = entity;
+  }
+
+  if (_detached) {
+    return nullptr;
+  }
+
+  if (_properties & entity::Entity::BoundsMask) {
+    entity->setFrame(_frame);
+  }
+
+  if (_properties & entity::Entity::TransformationMask) {
+    entity->setTransformation(_transformation);
+  }
+
+  if (_properties & entity::Entity::BackgroundColorMask) {
+    entity->setBackgroundColor(_backgroundColor);
+  }
+
+  if (_properties & entity::Entity::OpacityMask) {
+    entity->setOpacity(_opacity);
+  }
+
+  if (_properties & entity::Entity::PathMask) {
+    entity->setPath(_path);
+  }
+
+  if (_properties & entity::Entity::ContentsMask) {
+    const uint8_t* contents = _contents.data();
+    entity->setContents(
+        image::Image{core::Allocation{contents, _contents.size()}});
+  }
+
+  for (const auto& child : _children) {
+    entity->addChild(child->inflate(interface, map));
+  }
+
+  return entity;
+}
+
+}  // namespace ib
+}  // namespace rl
@@ -0,0 +1,115 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Allocation.h>
+#include <Core/Macros.h>
+#include <Entity/Entity.h>
+#include <InterfaceBuilder/InterfaceBuilderArchive.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rl {
+namespace ib {
+
+/**
+ *  An element of an archive lowered to the properties of the entity it
+ *  inflates to. Everything that is expensive to decode (paths, matrices,
+ *  colors and images) is already decoded. So scene nodes may be inflated or
+ *  compiled without looking at the archive again.
+ */
+class SceneNode {
+ public:
+  using Ref = std::unique_ptr<SceneNode>;
+
+  /**
+   *  Create a node for an element.
+   *
+   *  @param identifier the identifier entities inflated from the node are
+   *                    registered under. May be empty.
+   */
+  SceneNode(std::string identifier);
+
+  ~SceneNode();
+
+  const std::string& identifier() const;
+
+  /**
+   *  Elements that are not drawn still inflate to entities so that their
+   *  identifiers resolve. But those entities are not added to the hierarchy.
+   *
+   *  @return if entities inflated from the node are detached from their parent
+   */
+  bool isDetached() const;
+
+  void setDetached(bool detached);
+
+  /**
+   *  @return the mask of the entity properties set on the node
+   */
+  entity::Entity::PropertyMaskType properties() const;
+
+  const geom::Rect& frame() const;
+
+  void setFrame(const geom::Rect& frame);
+
+  const geom::Matrix& transformation() const;
+
+  void setTransformation(const geom::Matrix& transformation);
+
+  const entity::Color& backgroundColor() const;
+
+  void setBackgroundColor(const entity::Color& backgroundColor);
+
+  double opacity() const;
+
+  void setOpacity(double opacity);
+
+  const geom::Path& path() const;
+
+  void setPath(geom::Path path);
+
+  /**
+   *  @return the encoded image the entity draws
+   */
+  const core::Allocation& contents() const;
+
+  void setContents(core::Allocation contents);
+
+  const std::vector<Ref>& children() const;
+
+  void addChild(Ref child);
+
+  /**
+   *  Inflate entities for the node and all nodes below it.
+   *
+   *  @param interface the interface to create entities in
+   *  @param map       the map to register entities with identifiers in
+   *
+   *  @return the entity inflated from the node. Null if it is detached.
+   */
+  interface::ModelEntity::Ref inflate(
+      interface::Interface& interface,
+      InterfaceBuilderArchive::EntityMap& map) const;
+
+ private:
+  std::string _identifier;
+  bool _detached;
+  entity::Entity::PropertyMaskType _properties;
+  geom::Rect _frame;
+  geom::Matrix _transformation;
+  entity::Color _backgroundColor;
+  double _opacity;
+  geom::Path _path;
+  core::Allocation _contents;
+  std::vector<Ref> _children;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(SceneNode);
+};
+
+}  // namespace ib
+}  // namespace rl
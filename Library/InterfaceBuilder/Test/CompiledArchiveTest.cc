@@ -0,0 +1,130 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/FileIOAdapter.h>
+#include <Core/TempFileHandle.h>
+#include <InterfaceBuilder/InterfaceBuilderArchive.h>
+#include <TestRunner/InterfaceTest.h>
+#include <TestRunner/TestRunner.h>
+#include <unistd.h>
+#include <cstring>
+
+static rl::core::Allocation CompileFixture(const char* fixture) {
+  auto archive =
+      rl::ib::InterfaceBuilderArchive::Make(rl::core::URI{fixture});
+  if (!archive) {
+    return {};
+  }
+  return archive->compile();
+}
+
+/**
+ *  Write the scene to a temporary file and return a handle to read it back.
+ */
+static rl::core::FileHandle WriteScene(const rl::core::Allocation& scene) {
+  auto file = rl::core::TemporaryFileCreate();
+  rl::core::FileHandle readHandle(::dup(file.handle()));
+  rl::core::FileIOAdapter adapter(std::move(file));
+  if (adapter.write(scene) != scene.size()) {
+    return {};
+  }
+  return readHandle;
+}
+
+static void ExpectSameHierarchy(const rl::interface::ModelEntity& expected,
+                                const rl::interface::ModelEntity& actual) {
+  ASSERT_EQ(expected.frame(), actual.frame());
+  ASSERT_EQ(expected.transformation(), actual.transformation());
+  ASSERT_EQ(expected.backgroundColor(), actual.backgroundColor());
+  ASSERT_EQ(expected.opacity(), actual.opacity());
+  ASSERT_TRUE(rl::geom::Path::Equal{}(expected.path(), actual.path()));
+  ASSERT_EQ(rl::image::Image::Hash{}(expected.contents()),
+            rl::image::Image::Hash{}(actual.contents()));
+
+  ASSERT_EQ(expected.children().size(), actual.children().size());
+  for (size_t i = 0; i < expected.children().size(); i++) {
+    ExpectSameHierarchy(*expected.children()[i], *actual.children()[i]);
+  }
+}
+
+TEST_F(InterfaceTest, CompiledScenesInflateLikeTheirSVGs) {
+  testOnActive([](rl::interface::Interface& interface) {
+    for (auto fixture :
+         {"file://use01.svg", "file://polyline01.svg", "file://transform.svg",
+          "file://SketchAndroid.svg", "file://nighthawks.svg"}) {
+      auto archive =
+          rl::ib::InterfaceBuilderArchive::Make(rl::core::URI{fixture});
+      ASSERT_TRUE(archive);
+
+      auto scene = archive->compile();
+      ASSERT_NE(scene.size(), 0u);
+
+      auto compiled = rl::ib::InterfaceBuilderArchive::Make(WriteScene(scene));
+      ASSERT_TRUE(compiled);
+      ASSERT_TRUE(compiled->isValid());
+
+      rl::ib::InterfaceBuilderArchive::EntityMap expectedMap;
+      auto expected = archive->inflate(interface, expectedMap);
+      ASSERT_TRUE(expected != nullptr);
+
+      rl::ib::InterfaceBuilderArchive::EntityMap actualMap;
+      auto actual = compiled->inflate(interface, actualMap);
+      ASSERT_TRUE(actual != nullptr);
+
+      ExpectSameHierarchy(*expected, *actual);
+
+      ASSERT_EQ(expectedMap.size(), actualMap.size());
+      for (const auto& entry : expectedMap) {
+        ASSERT_EQ(actualMap.count(entry.first), 1u);
+        ASSERT_EQ(entry.second->children().size(),
+                  actualMap.at(entry.first)->children().size());
+      }
+    }
+  });
+}
+
+TEST(CompiledArchiveTest, CompiledScenesAreRecognizedInMemory) {
+  auto scene = CompileFixture("file://SketchAndroid.svg");
+  ASSERT_NE(scene.size(), 0u);
+
+  auto archive = rl::ib::InterfaceBuilderArchive::Make(scene);
+  ASSERT_TRUE(archive);
+  ASSERT_TRUE(archive->isValid());
+
+  /*
+   *  Compiling a compiled scene gives back the same scene.
+   */
+  auto recompiled = archive->compile();
+  ASSERT_EQ(recompiled.size(), scene.size());
+  ASSERT_EQ(memcmp(recompiled.data(), scene.data(), scene.size()), 0);
+}
+
+TEST(CompiledArchiveTest, MalformedScenesAreRejected) {
+  auto scene = CompileFixture("file://use01.svg");
+  ASSERT_NE(scene.size(), 0u);
+
+  /*
+   *  Truncated.
+   */
+  ASSERT_FALSE(rl::ib::InterfaceBuilderArchive::Make(scene.data(),
+                                                     scene.size() - 1));
+  ASSERT_FALSE(rl::ib::InterfaceBuilderArchive::Make(scene.data(), 16));
+
+  /*
+   *  Trailing garbage.
+   */
+  rl::core::Allocation extended;
+  ASSERT_TRUE(extended.resize(scene.size() + 1));
+  memcpy(extended.data(), scene.data(), scene.size());
+  ASSERT_FALSE(rl::ib::InterfaceBuilderArchive::Make(extended));
+
+  /*
+   *  An unknown version. The version follows the eight byte magic.
+   */
+  rl::core::Allocation versioned{
+      static_cast<const uint8_t*>(scene.data()), scene.size()};
+  versioned.data()[8]++;
+  ASSERT_FALSE(rl::ib::InterfaceBuilderArchive::Make(versioned));
+}
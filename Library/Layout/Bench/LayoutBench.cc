@@ -128,3 +128,419 @@ BENCHMARK(SolverAddSingleToMany)
     ->RangeMultiplier(10)
     ->Range(1, 10000)
     ->Complexity();
+
+/**
+ *  The variables of an item positioned by the layout.
+ */
+struct LayoutItem {
+  rl::expr::Variable left;
+  rl::expr::Variable top;
+  rl::expr::Variable width;
+  rl::expr::Variable height;
+
+  LayoutItem(rl::core::Namespace& ns)
+      : LayoutItem(rl::core::Name{ns}) {}
+
+  LayoutItem(rl::core::Name name)
+      : left(name, rl::expr::Variable::Property::PositionX),
+        top(name, rl::expr::Variable::Property::PositionY),
+        width(name, rl::expr::Variable::Property::BoundsWidth),
+        height(name, rl::expr::Variable::Property::BoundsHeight) {}
+};
+
+static const double kSpacing = 8.0;
+
+/**
+ *  A grid of equally sized cells that fill the container. Each cell prefers
+ *  a square aspect ratio but must be at least a minimum size.
+ */
+static std::vector<rl::layout::Constraint> GridLayout(
+    rl::core::Namespace& ns,
+    const LayoutItem& container,
+    size_t columns,
+    size_t rows) {
+  using namespace rl::layout;
+  std::vector<Constraint> constraints;
+
+  std::vector<LayoutItem> cells;
+  cells.reserve(columns * rows);
+  for (size_t i = 0; i < columns * rows; i++) {
+    cells.emplace_back(ns);
+  }
+
+  for (size_t row = 0; row < rows; row++) {
+    for (size_t column = 0; column < columns; column++) {
+      const auto& cell = cells[row * columns + column];
+
+      if (column == 0) {
+        constraints.push_back(cell.left == container.left + kSpacing);
+      } else {
+        const auto& previous = cells[row * columns + column - 1];
+        constraints.push_back(cell.left ==
+                              previous.left + previous.width + kSpacing);
+        constraints.push_back(cell.width == previous.width);
+      }
+
+      if (row == 0) {
+        constraints.push_back(cell.top == container.top + kSpacing);
+      } else {
+        const auto& above = cells[(row - 1) * columns + column];
+        constraints.push_back(cell.top == above.top + above.height + kSpacing);
+        constraints.push_back(cell.height == above.height);
+      }
+
+      if (column == columns - 1) {
+        constraints.push_back(cell.left + cell.width + kSpacing ==
+                              container.left + container.width);
+      }
+
+      constraints.push_back(cell.width >= 20.0);
+      constraints.push_back(cell.height >= 20.0);
+      constraints.push_back((cell.height == cell.width) | priority::Weak());
+    }
+  }
+
+  return constraints;
+}
+
+/**
+ *  A vertical stack of items as wide as the container. Each item prefers a
+ *  fixed height and must fit within the container.
+ */
+static std::vector<rl::layout::Constraint> StackLayout(
+    rl::core::Namespace& ns,
+    const LayoutItem& container,
+    size_t count) {
+  using namespace rl::layout;
+  std::vector<Constraint> constraints;
+
+  std::vector<LayoutItem> items;
+  items.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    items.emplace_back(ns);
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const auto& item = items[i];
+
+    if (i == 0) {
+      constraints.push_back(item.top == container.top);
+    } else {
+      const auto& previous = items[i - 1];
+      constraints.push_back(item.top ==
+                            previous.top + previous.height + kSpacing);
+    }
+
+    constraints.push_back(item.left == container.left);
+    constraints.push_back(item.width == container.width);
+    constraints.push_back(item.height >= 10.0);
+    constraints.push_back((item.height == 44.0) | priority::Medium());
+    constraints.push_back(item.top + item.height <=
+                          container.top + container.height);
+  }
+
+  return constraints;
+}
+
+/**
+ *  Pin the origin of the container and make its size editable.
+ */
+static void AddContainer(rl::layout::Solver& solver,
+                         const LayoutItem& container) {
+  auto result = solver.addConstraints({container.left == 0.0,  //
+                                       container.top == 0.0});
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  result = solver.addEditVariables({container.width, container.height},
+                                   rl::layout::priority::Strong());
+  RL_ASSERT(result == rl::layout::Result::Success);
+}
+
+static void SolverGridLayout(benchmark::State& state) {
+  const size_t side = state.range(0);
+  state.SetComplexityN(side * side);
+
+  rl::core::Namespace ns;
+  LayoutItem container(ns);
+  auto constraints = GridLayout(ns, container, side, side);
+
+  while (state.KeepRunning()) {
+    rl::layout::Solver solver(ns);
+    AddContainer(solver, container);
+    auto result = solver.addConstraints(constraints);
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+}
+
+BENCHMARK(SolverGridLayout)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(4, 16)
+    ->Complexity();
+
+static void SolverGridResize(benchmark::State& state) {
+  const size_t side = state.range(0);
+  state.SetComplexityN(side * side);
+
+  rl::core::Namespace ns;
+  LayoutItem container(ns);
+  rl::layout::Solver solver(ns);
+  AddContainer(solver, container);
+  auto result = solver.addConstraints(GridLayout(ns, container, side, side));
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  double width = 4000.0;
+
+  while (state.KeepRunning()) {
+    width = width == 4000.0 ? 5000.0 : 4000.0;
+    result = solver.suggestValueForVariable(container.width, width);
+    RL_ASSERT(result == rl::layout::Result::Success);
+    result = solver.suggestValueForVariable(container.height, width);
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+}
+
+BENCHMARK(SolverGridResize)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(4, 16)
+    ->Complexity();
+
+static void SolverStackLayout(benchmark::State& state) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  LayoutItem container(ns);
+  auto constraints = StackLayout(ns, container, count);
+
+  while (state.KeepRunning()) {
+    rl::layout::Solver solver(ns);
+    AddContainer(solver, container);
+    auto result = solver.addConstraints(constraints);
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+}
+
+BENCHMARK(SolverStackLayout)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->RangeMultiplier(4)
+    ->Range(16, 256)
+    ->Complexity();
+
+static void SolverFlushUpdates(benchmark::State& state) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  rl::layout::Solver solver(ns);
+
+  /*
+   *  Only one of the many variables in the solver is updated on each flush.
+   */
+  std::vector<rl::layout::Constraint> constraints;
+  for (size_t i = 0; i < count; i++) {
+    LayoutItem item(ns);
+    constraints.push_back(item.left == 10.0 * i);
+  }
+  auto result = solver.addConstraints(constraints);
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  LayoutItem edited(ns);
+  result = solver.addEditVariable(edited.left, rl::layout::priority::Strong());
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  solver.flushUpdates([](const rl::expr::Variable&, double) {
+    return rl::layout::Solver::FlushResult::Updated;
+  });
+
+  double value = 0.0;
+
+  while (state.KeepRunning()) {
+    result = solver.suggestValueForVariable(edited.left, ++value);
+    RL_ASSERT(result == rl::layout::Result::Success);
+    auto updates =
+        solver.flushUpdates([](const rl::expr::Variable&, double) {
+          return rl::layout::Solver::FlushResult::Updated;
+        });
+    RL_ASSERT(updates == 1);
+  }
+}
+
+BENCHMARK(SolverFlushUpdates)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Complexity();
+
+/**
+ *  A row of items each of which is dragged by an edit variable on its left
+ *  edge. Items may not overlap so suggestions that bunch the items up push
+ *  them apart.
+ */
+static std::vector<LayoutItem> DraggedRow(rl::layout::Solver& solver,
+                                          rl::core::Namespace& ns,
+                                          size_t count) {
+  std::vector<LayoutItem> items;
+  std::vector<rl::layout::Constraint> constraints;
+
+  for (size_t i = 0; i < count; i++) {
+    items.emplace_back(ns);
+    const auto& item = items.back();
+    constraints.push_back(item.width == 50.0);
+    if (i > 0) {
+      const auto& previous = items[i - 1];
+      constraints.push_back(item.left >=
+                            previous.left + previous.width + kSpacing);
+    }
+  }
+
+  auto result = solver.addConstraints(constraints);
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  for (const auto& item : items) {
+    result = solver.addEditVariable(item.left, rl::layout::priority::Strong());
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+
+  return items;
+}
+
+static std::vector<rl::layout::Suggestion> DragSuggestions(
+    const std::vector<LayoutItem>& items,
+    double stride) {
+  std::vector<rl::layout::Suggestion> suggestions;
+  for (size_t i = 0; i < items.size(); i++) {
+    suggestions.emplace_back(items[i].left, i * stride,
+                             rl::layout::priority::Strong());
+  }
+  return suggestions;
+}
+
+static void SolverSuggestEach(benchmark::State& state) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  rl::layout::Solver solver(ns);
+  const auto items = DraggedRow(solver, ns, count);
+  const auto spread = DragSuggestions(items, 100.0);
+  const auto bunched = DragSuggestions(items, 20.0);
+
+  bool spreadOut = false;
+
+  while (state.KeepRunning()) {
+    spreadOut = !spreadOut;
+    for (const auto& suggestion : spreadOut ? spread : bunched) {
+      auto result = solver.applySuggestion(suggestion);
+      RL_ASSERT(result == rl::layout::Result::Success);
+    }
+  }
+}
+
+BENCHMARK(SolverSuggestEach)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(4, 128)
+    ->Complexity();
+
+static void SolverSuggestBatch(benchmark::State& state) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  rl::layout::Solver solver(ns);
+  const auto items = DraggedRow(solver, ns, count);
+  const auto spread = DragSuggestions(items, 100.0);
+  const auto bunched = DragSuggestions(items, 20.0);
+
+  bool spreadOut = false;
+
+  while (state.KeepRunning()) {
+    spreadOut = !spreadOut;
+    auto result = solver.applySuggestions(spreadOut ? spread : bunched);
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+}
+
+BENCHMARK(SolverSuggestBatch)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(4, 128)
+    ->Complexity();
+
+static void SolverFailedBatch(benchmark::State& state) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  LayoutItem container(ns);
+  rl::layout::Solver solver(ns);
+  AddContainer(solver, container);
+  auto result = solver.addConstraints(StackLayout(ns, container, 64));
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  /*
+   *  The last constraint in the batch conflicts with the pinned origin of the
+   *  container. So the entire batch is rolled back.
+   */
+  auto batch = StackLayout(ns, container, count);
+  batch.push_back(container.left == 10.0);
+
+  while (state.KeepRunning()) {
+    result = solver.addConstraints(batch);
+    RL_ASSERT(result == rl::layout::Result::UnsatisfiableConstraint);
+  }
+}
+
+BENCHMARK(SolverFailedBatch)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(4, 64)
+    ->Complexity();
+
+/**
+ *  Add and remove a group of constraints on top of a larger layout like the
+ *  constraints tied to touches are.
+ */
+static void ToggleConstraintGroup(benchmark::State& state,
+                                  size_t warmStartCapacity) {
+  const size_t count = state.range(0);
+  state.SetComplexityN(count);
+
+  rl::core::Namespace ns;
+  LayoutItem container(ns);
+  rl::layout::Solver solver(ns);
+  solver.setWarmStartCapacity(warmStartCapacity);
+  AddContainer(solver, container);
+  auto result = solver.addConstraints(StackLayout(ns, container, 64));
+  RL_ASSERT(result == rl::layout::Result::Success);
+
+  const auto group = StackLayout(ns, container, count);
+
+  while (state.KeepRunning()) {
+    result = solver.addConstraints(group);
+    RL_ASSERT(result == rl::layout::Result::Success);
+    result = solver.removeConstraints(group);
+    RL_ASSERT(result == rl::layout::Result::Success);
+  }
+}
+
+static void SolverToggleConstraintGroup(benchmark::State& state) {
+  ToggleConstraintGroup(state, 0);
+}
+
+BENCHMARK(SolverToggleConstraintGroup)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(4, 64)
+    ->Complexity();
+
+static void SolverToggleConstraintGroupWarmStart(benchmark::State& state) {
+  ToggleConstraintGroup(state, 4);
+}
+
+BENCHMARK(SolverToggleConstraintGroupWarmStart)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->RangeMultiplier(4)
+    ->Range(4, 64)
+    ->Complexity();
@@ -23,8 +23,7 @@ class ProxyResolver {
       std::function<void(const expr::Variable& /* variable */,
                          bool /* addOrRemove */)>;
   using ProxyEditSuggestCallback =
-      std::function<void(const expr::Variable& /* variable */,
-                         double /* value */)>;
+      std::function<void(const std::vector<Suggestion>& /* suggestions */)>;
 
   ProxyResolver(
       core::Namespace& localNS,
@@ -59,6 +58,7 @@ class ProxyResolver {
   std::vector<event::TouchEvent::Identifier> _indexedTouches;
   ConstraintConditionsMap _conditionsByConstraint;
   ConditionConstraintsMap _activeConstraintsByCondition;
+  std::vector<Suggestion> _pendingSuggestions;
 
   bool addTouches(const std::vector<event::TouchEvent>& touches);
   bool updateTouches(const std::vector<event::TouchEvent>& touches);
@@ -69,6 +69,7 @@ class ProxyResolver {
 
   void updateEntityPosition(entity::Entity& entity,
                             const geom::Point& position);
+  void flushPendingSuggestions();
   void performOperationOnProxiesSatisfyingCurrentCondition(
       ConstraintOperation operation);
 
@@ -23,6 +23,7 @@ namespace rl {
 namespace layout {
 
 class Row;
+class OccurrenceIndex;
 
 class Solver {
  public:
@@ -53,6 +54,19 @@ class Solver {
 
   Result applySuggestion(const Suggestion& suggestion);
 
+  /**
+   *  Apply all suggestions and then re-optimize the solver once. This is
+   *  cheaper than applying each suggestion individually. If the edit variable
+   *  for any one of the suggestions is unknown, none of the suggestions are
+   *  applied.
+   *
+   *  @param suggestions the suggestions to apply. Later suggestions for the
+   *                     same variable override earlier ones.
+   *
+   *  @return the result of the operation
+   */
+  Result applySuggestions(const std::vector<Suggestion>& suggestions);
+
   Result suggestValueForVariable(const expr::Variable& variable, double value);
 
   size_t constraintsCount() const;
@@ -66,25 +80,100 @@ class Solver {
 
   using SolverUpdateCallback =
       std::function<FlushResult(const expr::Variable&, double value)>;
-  size_t flushUpdates(SolverUpdateCallback callback) const;
+
+  /**
+   *  Invoke the callback for each variable whose value has been updated since
+   *  the last flush. Only the variables that have been updated are visited.
+   *
+   *  @return the number of updates the callback applied
+   */
+  size_t flushUpdates(SolverUpdateCallback callback);
+
+  using VariableUpdates = std::vector<std::pair<expr::Variable, double>>;
+
+  using SolverGroupedUpdateCallback =
+      std::function<FlushResult(const VariableUpdates& updates)>;
+
+  /**
+   *  Like flushUpdates but the updates of all variables with the same
+   *  identifier are delivered in a single invocation of the callback. This
+   *  allows the updates of an entity to be applied at once.
+   *
+   *  @return the number of updates the callback applied
+   */
+  size_t flushGroupedUpdates(SolverGroupedUpdateCallback callback);
+
+  /**
+   *  Take a snapshot of the solver. The changes made to the solver from now on
+   *  are recorded so that they may be undone by restoring the snapshot. Only
+   *  the rows of the tableau touched by the changes are saved. Snapshots may be
+   *  nested.
+   */
+  void snapshot();
+
+  /**
+   *  Undo the changes made since the most recent snapshot and discard it. The
+   *  variables whose values are restored are reported on the next flush.
+   */
+  void restoreSnapshot();
+
+  /**
+   *  Keep the changes made since the most recent snapshot and discard it.
+   */
+  void discardSnapshot();
+
+  /**
+   *  Cache the tableau before and after the most recent batches of constraint
+   *  additions and removals. When such a batch is undone (by removing the
+   *  constraints just added or adding back the constraints just removed) or
+   *  redone while the solver is otherwise unchanged, the cached tableau is
+   *  restored instead of being solved for again.
+   *
+   *  @param capacity the number of batches to cache. Zero (the default)
+   *                  disables warm starts.
+   */
+  void setWarmStartCapacity(size_t capacity);
 
  private:
+  struct Journal;
+  struct WarmStart;
+
+  using Rows = std::unordered_map<Symbol, std::unique_ptr<Row>, Symbol::Hash>;
+
   core::Namespace& _localNS;
   std::map<Constraint, Tag, Constraint::Compare> _constraints;
-  std::map<Symbol, std::unique_ptr<Row>, Symbol::Compare> _rows;
+  std::unique_ptr<OccurrenceIndex> _occurrences;
+  Rows _rows;
+  std::vector<std::unique_ptr<Row>> _rowPool;
   std::unordered_map<expr::Variable,
                      Symbol,
                      expr::Variable::Hash,
                      expr::Variable::Equal>
       _vars;
+  std::unordered_map<Symbol, expr::Variable, Symbol::Hash> _externals;
   std::unordered_map<expr::Variable,
                      EditInfo,
                      expr::Variable::Hash,
                      expr::Variable::Equal>
       _edits;
   std::list<Symbol> _infeasibleRows;
+  std::vector<Symbol> _updatedRows;
+  VariableUpdates _flushedUpdates;
   std::unique_ptr<Row> _objective;
   std::unique_ptr<Row> _artificial;
+  std::vector<std::unique_ptr<Journal>> _journals;
+  /*
+   *  Ordered from most to least recently used.
+   */
+  std::vector<std::unique_ptr<WarmStart>> _warmStarts;
+  size_t _warmStartCapacity;
+  /*
+   *  Identifies the state of the solver. Every change gets a new version and
+   *  restoring a snapshot brings back the version it was taken at.
+   */
+  size_t _version;
+  size_t _lastVersion;
+  size_t _lastJournal;
 
   template <class T>
   using UpdateCallback = std::function<Result(const T&)>;
@@ -92,10 +181,51 @@ class Solver {
   template <class T>
   Result bulkEdit(const std::vector<T>& items,
                   UpdateCallback<T> applier,
-                  UpdateCallback<T> undoer);
+                  std::unique_ptr<Journal>* changes = nullptr);
+
+  Result bulkEditConstraints(const std::vector<Constraint>& constraints,
+                             bool adding);
+
+  bool warmStart(const std::vector<Constraint>& constraints, bool adding);
+
+  void addWarmStart(const std::vector<Constraint>& constraints,
+                    bool adding,
+                    std::unique_ptr<Journal> before);
+
+  void recordRow(const Symbol& basic);
+
+  void recordRow(Row& row);
+
+  void recordObjective();
+
+  void recordConstraint(const Constraint& constraint);
+
+  void recordEdit(const expr::Variable& variable);
+
+  Journal* recordingJournal();
+
+  std::unique_ptr<Journal> takeJournal();
+
+  std::unique_ptr<Journal> journalOfCurrentState(const Journal& changes) const;
+
+  void applyJournal(const Journal& journal);
 
   Symbol symbolForVariable(const expr::Variable& variable);
 
+  std::unique_ptr<Row> makeRow(double constant);
+
+  void recycleRow(std::unique_ptr<Row> row);
+
+  void addRow(const Symbol& basic, std::unique_ptr<Row> row);
+
+  std::unique_ptr<Row> takeRow(Rows::iterator found);
+
+  void addInfeasibleRows(std::vector<Symbol>& rows);
+
+  void addUpdatedRow(const Symbol& basic, const Row& row, bool hadUpdate);
+
+  void resolveUpdatedRows();
+
   std::unique_ptr<Row> createRow(const Constraint& constraint, Tag& tag);
 
   Symbol chooseSubjectForRow(const Row& row, const Tag& tag) const;
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 
 namespace rl {
 namespace layout {
@@ -36,6 +37,12 @@ class Symbol {
     }
   };
 
+  struct Hash {
+    std::size_t operator()(const Symbol& symbol) const {
+      return std::hash<Identifier>()(symbol._identifier);
+    }
+  };
+
  private:
   Type _type;
   Identifier _identifier;
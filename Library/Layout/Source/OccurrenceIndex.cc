@@ -0,0 +1,78 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include "OccurrenceIndex.h"
+#include "Row.h"
+
+namespace rl {
+namespace layout {
+
+OccurrenceIndex::OccurrenceIndex() : _unusedSymbols(0) {}
+
+OccurrenceIndex::~OccurrenceIndex() = default;
+
+OccurrenceIndex::Occurrence OccurrenceIndex::insert(const Symbol& symbol,
+                                                    Row* row) {
+  auto& rows = _occurrences[symbol];
+  if (rows.empty() && _unusedSymbols > 0) {
+    /*
+     *  May be a new symbol. That's fine since the count is only a heuristic.
+     */
+    _unusedSymbols--;
+  }
+  rows.push_back(row);
+
+  Occurrence occurrence;
+  occurrence.rows = &rows;
+  occurrence.slot = rows.size() - 1;
+  return occurrence;
+}
+
+void OccurrenceIndex::erase(const Symbol& symbol,
+                            const Occurrence& occurrence) {
+  auto& rows = *occurrence.rows;
+  const auto slot = occurrence.slot;
+  RL_ASSERT(slot < rows.size());
+
+  /*
+   *  The order of rows is not significant. Move the last row into the vacated
+   *  slot instead of shifting the remaining rows.
+   */
+  if (slot != rows.size() - 1) {
+    rows[slot] = rows.back();
+    rows[slot]->relocateOccurrence(symbol, occurrence);
+  }
+  rows.pop_back();
+
+  /*
+   *  Symbols move in and out of rows constantly as the tableau is pivoted.
+   *  Symbols no longer in any row are kept around till they make up most of
+   *  the index to avoid churning through allocations.
+   */
+  if (rows.empty() && ++_unusedSymbols > _occurrences.size() / 2) {
+    removeUnusedSymbols();
+  }
+}
+
+void OccurrenceIndex::removeUnusedSymbols() {
+  for (auto i = _occurrences.begin(); i != _occurrences.end();) {
+    if (i->second.empty()) {
+      i = _occurrences.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  _unusedSymbols = 0;
+}
+
+const OccurrenceIndex::Rows& OccurrenceIndex::rowsForSymbol(
+    const Symbol& symbol) const {
+  static const Rows kNoRows;
+  auto found = _occurrences.find(symbol);
+  return found == _occurrences.end() ? kNoRows : found->second;
+}
+
+}  // namespace layout
+}  // namespace rl
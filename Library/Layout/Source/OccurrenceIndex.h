@@ -0,0 +1,71 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Layout/Symbol.h>
+#include <unordered_map>
+#include <vector>
+
+namespace rl {
+namespace layout {
+
+class Row;
+
+/**
+ *  Tracks the rows of the tableau each symbol occurs in. This allows the
+ *  solver to only visit the rows containing a symbol instead of scanning the
+ *  entire tableau on each pivot.
+ *
+ *  Rows are updated by the index as they are modified. Each cell of a row
+ *  remembers its slot in the occurrences of its symbol so that the row can be
+ *  removed from those occurrences in constant time.
+ */
+class OccurrenceIndex {
+ public:
+  using Rows = std::vector<Row*>;
+
+  OccurrenceIndex();
+
+  ~OccurrenceIndex();
+
+  /**
+   *  The position of a row in the occurrences of a symbol.
+   */
+  struct Occurrence {
+    Rows* rows = nullptr;
+    size_t slot = 0;
+  };
+
+  /**
+   *  Record that the symbol now occurs in the given row.
+   *
+   *  @return the position of the row in the occurrences of the symbol
+   */
+  Occurrence insert(const Symbol& symbol, Row* row);
+
+  /**
+   *  Record that the symbol no longer occurs in the row at the given
+   *  position. Does not need to look up the symbol.
+   */
+  void erase(const Symbol& symbol, const Occurrence& occurrence);
+
+  /**
+   *  @return the rows the symbol occurs in. The order is unspecified.
+   */
+  const Rows& rowsForSymbol(const Symbol& symbol) const;
+
+ private:
+  std::unordered_map<Symbol, Rows, Symbol::Hash> _occurrences;
+  size_t _unusedSymbols;
+
+  void removeUnusedSymbols();
+
+  RL_DISALLOW_COPY_AND_ASSIGN(OccurrenceIndex);
+};
+
+}  // namespace layout
+}  // namespace rl
@@ -191,8 +191,21 @@ void ProxyResolver::updateEntityPosition(entity::Entity& entity,
   expr::Variable positionY = {entity.identifier(),
                               expr::Variable::Property::PositionY};
 
-  _editSuggestCallback(positionX, position.x);
-  _editSuggestCallback(positionY, position.y);
+  /*
+   *  Suggestions are accumulated and applied to the solver at once when the
+   *  touch map has been processed.
+   */
+  _pendingSuggestions.emplace_back(positionX, position.x, priority::Strong());
+  _pendingSuggestions.emplace_back(positionY, position.y, priority::Strong());
+}
+
+void ProxyResolver::flushPendingSuggestions() {
+  if (_pendingSuggestions.size() == 0) {
+    return;
+  }
+
+  _editSuggestCallback(_pendingSuggestions);
+  _pendingSuggestions.clear();
 }
 
 entity::Entity* ProxyResolver::touchEntityForProxy(
@@ -360,6 +373,12 @@ bool ProxyResolver::applyTouchMap(const event::TouchEvent::PhaseMap& map) {
     updated |= updateTouches(found->second);
   }
 
+  /*
+   *  The edit variables of ended touches are about to be removed. Apply the
+   *  suggestions made for them so far.
+   */
+  flushPendingSuggestions();
+
   /*
    *  Phase::Ended
    */
@@ -378,6 +397,8 @@ bool ProxyResolver::applyTouchMap(const event::TouchEvent::PhaseMap& map) {
     updated |= clearTouches(found->second);
   }
 
+  flushPendingSuggestions();
+
   return updated;
 }
 
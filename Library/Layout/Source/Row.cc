@@ -3,13 +3,33 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
-#include "Row.h"
+#include <algorithm>
 #include "LayoutUtilities.h"
+#include "Row.h"
 
 namespace rl {
 namespace layout {
 
-Row::Row(double constant) : _constant(constant), _constantHasUpdate(false) {}
+struct CellPrecedesSymbol {
+  bool operator()(const Row::Cell& cell, const Symbol& symbol) const {
+    return Symbol::Compare()(cell.symbol, symbol);
+  }
+};
+
+Row::Row(double constant)
+    : _constant(constant),
+      _constantHasUpdate(false),
+      _index(nullptr),
+      _journal(0) {}
+
+Row::Row(const Row& row)
+    : _cells(row._cells),
+      _constant(row._constant),
+      _constantHasUpdate(row._constantHasUpdate),
+      _index(nullptr),
+      _journal(0) {}
+
+Row::~Row() = default;
 
 double Row::constant() const {
   return _constant;
@@ -19,6 +39,38 @@ const Row::Cells& Row::cells() const {
   return _cells;
 }
 
+Row::Cells::iterator Row::findCell(const Symbol& symbol) {
+  auto found = std::lower_bound(_cells.begin(), _cells.end(), symbol,
+                                CellPrecedesSymbol());
+  if (found != _cells.end() && found->symbol == symbol) {
+    return found;
+  }
+  return _cells.end();
+}
+
+Row::Cells::const_iterator Row::findCell(const Symbol& symbol) const {
+  auto found = std::lower_bound(_cells.begin(), _cells.end(), symbol,
+                                CellPrecedesSymbol());
+  if (found != _cells.end() && found->symbol == symbol) {
+    return found;
+  }
+  return _cells.end();
+}
+
+void Row::eraseCell(Cells::iterator cell) {
+  if (_index != nullptr) {
+    _index->erase(cell->symbol, cell->occurrence);
+  }
+  _cells.erase(cell);
+}
+
+void Row::relocateOccurrence(const Symbol& symbol,
+                             const OccurrenceIndex::Occurrence& occurrence) {
+  auto cell = findCell(symbol);
+  RL_ASSERT(cell != _cells.end());
+  cell->occurrence = occurrence;
+}
+
 double Row::add(double value) {
   setConstantUpdated(!NearZero(value));
   _constant += value;
@@ -26,12 +78,25 @@ double Row::add(double value) {
 }
 
 void Row::insertSymbol(const Symbol& symbol, double coefficient) {
-  double val = _cells[symbol];
+  auto cell = std::lower_bound(_cells.begin(), _cells.end(), symbol,
+                               CellPrecedesSymbol());
 
-  if (NearZero(val + coefficient)) {
-    _cells.erase(symbol);
-  } else {
-    _cells[symbol] = val + coefficient;
+  if (cell != _cells.end() && cell->symbol == symbol) {
+    if (NearZero(cell->coefficient + coefficient)) {
+      eraseCell(cell);
+    } else {
+      cell->coefficient += coefficient;
+    }
+    return;
+  }
+
+  if (NearZero(coefficient)) {
+    return;
+  }
+
+  cell = _cells.emplace(cell, symbol, coefficient);
+  if (_index != nullptr) {
+    cell->occurrence = _index->insert(symbol, this);
   }
 }
 
@@ -39,36 +104,113 @@ void Row::insertRow(const Row& other, double coefficient) {
   auto delta = other.constant() * coefficient;
   _constant += delta;
   setConstantUpdated(!NearZero(delta));
-  for (auto const& cell : other.cells()) {
-    insertSymbol(cell.first, cell.second * coefficient);
+
+  const auto& otherCells = other._cells;
+
+  if (otherCells.empty()) {
+    return;
+  }
+
+  /*
+   *  Count the symbols not already in this row so that the merge can be
+   *  performed in place, back to front, after growing the cells once.
+   */
+  size_t added = 0;
+  {
+    auto cell = _cells.cbegin();
+    for (const auto& otherCell : otherCells) {
+      while (cell != _cells.cend() &&
+             Symbol::Compare()(cell->symbol, otherCell.symbol)) {
+        ++cell;
+      }
+      if (cell == _cells.cend() || cell->symbol != otherCell.symbol) {
+        added++;
+      }
+    }
+  }
+
+  const size_t count = _cells.size();
+  _cells.resize(count + added, {Symbol{}, 0.0});
+
+  /*
+   *  Cells that cancel out or have negligible coefficients are skipped. That
+   *  leaves a gap at the front of the cells that is erased after the merge.
+   */
+  size_t read = count;
+  size_t readOther = otherCells.size();
+  size_t write = _cells.size();
+
+  while (readOther > 0) {
+    const auto& otherCell = otherCells[readOther - 1];
+
+    if (read > 0 &&
+        Symbol::Compare()(otherCell.symbol, _cells[read - 1].symbol)) {
+      _cells[--write] = _cells[--read];
+      continue;
+    }
+
+    auto value = otherCell.coefficient * coefficient;
+    readOther--;
+
+    if (read > 0 && _cells[read - 1].symbol == otherCell.symbol) {
+      const auto cell = _cells[--read];
+      if (NearZero(cell.coefficient + value)) {
+        if (_index != nullptr) {
+          _index->erase(cell.symbol, cell.occurrence);
+        }
+      } else {
+        _cells[--write] = cell;
+        _cells[write].coefficient += value;
+      }
+    } else if (!NearZero(value)) {
+      _cells[--write] = {otherCell.symbol, value};
+      if (_index != nullptr) {
+        _cells[write].occurrence = _index->insert(otherCell.symbol, this);
+      }
+    }
+  }
+
+  /*
+   *  The remaining cells of this row are already in place if nothing was
+   *  skipped. Otherwise, shift them up against the merged cells.
+   */
+  if (write != read) {
+    while (read > 0) {
+      _cells[--write] = _cells[--read];
+    }
+    _cells.erase(_cells.begin(), _cells.begin() + write);
   }
 }
 
 void Row::removeSymbol(const Symbol& symbol) {
-  _cells.erase(symbol);
+  auto cell = findCell(symbol);
+  if (cell != _cells.end()) {
+    eraseCell(cell);
+  }
 }
 
 void Row::reverseSign() {
   _constant = -_constant;
   setConstantUpdated(!NearZero(_constant));
   for (auto& cell : _cells) {
-    cell.second = -cell.second;
+    cell.coefficient = -cell.coefficient;
   }
 }
 
 void Row::solve(const Symbol& symbol) {
-  RL_ASSERT(_cells.find(symbol) != _cells.end());
+  auto found = findCell(symbol);
+  RL_ASSERT(found != _cells.end());
 
-  double coefficient = -1.0 / _cells[symbol];
+  double coefficient = -1.0 / found->coefficient;
 
-  _cells.erase(symbol);
+  eraseCell(found);
 
   setConstantUpdated(coefficient != 1.0 && !NearZero(_constant));
 
   _constant *= coefficient;
 
   for (auto& cell : _cells) {
-    cell.second = cell.second * coefficient;
+    cell.coefficient = cell.coefficient * coefficient;
   }
 }
 
@@ -78,23 +220,23 @@ void Row::solve(const Symbol& lhs, const Symbol& rhs) {
 }
 
 double Row::coefficientForSymbol(const Symbol& symbol) const {
-  auto found = _cells.find(symbol);
+  auto found = findCell(symbol);
   if (found == _cells.end()) {
     return 0.0;
   } else {
-    return found->second /* coefficient */;
+    return found->coefficient;
   }
 }
 
 void Row::substitute(const Symbol& symbol, const Row& row) {
-  auto cell = _cells.find(symbol);
+  auto cell = findCell(symbol);
 
   if (cell == _cells.end()) {
     return;
   }
 
-  auto coefficient = cell->second;
-  _cells.erase(cell);
+  auto coefficient = cell->coefficient;
+  eraseCell(cell);
   insertRow(row, coefficient);
 }
 
@@ -106,6 +248,49 @@ void Row::resolveConstantUpdate() {
   _constantHasUpdate = false;
 }
 
+void Row::markConstantUpdated() {
+  _constantHasUpdate = true;
+}
+
+void Row::reset(double constant) {
+  RL_ASSERT(_index == nullptr);
+  _cells.clear();
+  _constant = constant;
+  _constantHasUpdate = false;
+}
+
+void Row::attach(OccurrenceIndex& index, const Symbol& subject) {
+  RL_ASSERT(_index == nullptr);
+  _index = &index;
+  _subject = subject;
+  for (auto& cell : _cells) {
+    cell.occurrence = _index->insert(cell.symbol, this);
+  }
+}
+
+void Row::detach() {
+  if (_index == nullptr) {
+    return;
+  }
+  for (const auto& cell : _cells) {
+    _index->erase(cell.symbol, cell.occurrence);
+  }
+  _index = nullptr;
+  _subject = Symbol{};
+}
+
+const Symbol& Row::subject() const {
+  return _subject;
+}
+
+size_t Row::journal() const {
+  return _journal;
+}
+
+void Row::setJournal(size_t journal) {
+  _journal = journal;
+}
+
 void Row::setConstantUpdated(bool updated) {
   _constantHasUpdate = _constantHasUpdate || updated;
 }
@@ -7,18 +7,39 @@
 
 #include <Core/Macros.h>
 #include <Layout/Symbol.h>
-#include <map>
+#include "OccurrenceIndex.h"
+#include <vector>
 
 namespace rl {
 namespace layout {
 
 class Row {
  public:
-  using Cells = std::map<Symbol, double, Symbol::Compare>;
+  /*
+   *  Rows are sparse and usually hold only a handful of cells. The cells are
+   *  kept in a flat vector sorted by symbol so that lookups are a binary
+   *  search over contiguous memory and rows are combined by a linear merge.
+   */
+  struct Cell {
+    Symbol symbol;
+    double coefficient;
+    /*
+     *  The position of this row in the occurrences of the symbol. Only valid
+     *  while the row is attached to an index.
+     */
+    OccurrenceIndex::Occurrence occurrence;
+
+    Cell(const Symbol& aSymbol, double aCoefficient)
+        : symbol(aSymbol), coefficient(aCoefficient) {}
+  };
+
+  using Cells = std::vector<Cell>;
 
   Row(double constant);
 
-  Row(const Row& row) = default;
+  Row(const Row& row);
+
+  ~Row();
 
   double constant() const;
 
@@ -46,10 +67,61 @@ class Row {
 
   void resolveConstantUpdate();
 
+  /**
+   *  Flag the constant as updated even though it has not changed. Used when
+   *  the row is restored from a snapshot.
+   */
+  void markConstantUpdated();
+
+  /**
+   *  Clear the cells of the row so that it may be reused. The storage for the
+   *  cells is retained.
+   */
+  void reset(double constant);
+
+  /**
+   *  Keep the index updated with the symbols in this row as the row is
+   *  modified. The row must be detached before it stops being the row of
+   *  the given basic symbol.
+   *
+   *  @param index   the index to update
+   *  @param subject the basic symbol of the row in the tableau
+   */
+  void attach(OccurrenceIndex& index, const Symbol& subject);
+
+  void detach();
+
+  /**
+   *  @return the basic symbol of the row if attached to an index
+   */
+  const Symbol& subject() const;
+
+  /**
+   *  The snapshot journal that last saved the state of this row. Lets the
+   *  solver skip looking up rows it has already saved. Not copied.
+   */
+  size_t journal() const;
+
+  void setJournal(size_t journal);
+
  private:
+  friend class OccurrenceIndex;
+
   Cells _cells;
   double _constant;
   bool _constantHasUpdate;
+  OccurrenceIndex* _index;
+  Symbol _subject;
+  size_t _journal;
+
+  Cells::iterator findCell(const Symbol& symbol);
+
+  Cells::const_iterator findCell(const Symbol& symbol) const;
+
+  void eraseCell(Cells::iterator cell);
+
+  void relocateOccurrence(const Symbol& symbol,
+                          const OccurrenceIndex::Occurrence& occurrence);
 
   void setConstantUpdated(bool updated);
 
@@ -5,7 +5,9 @@
 
 #include <Layout/Priority.h>
 #include <Layout/Solver.h>
+#include <algorithm>
 #include "LayoutUtilities.h"
+#include "OccurrenceIndex.h"
 #include "Row.h"
 
 namespace rl {
@@ -13,8 +15,13 @@ namespace layout {
 
 Solver::Solver(core::Namespace& localNS)
     : _localNS(localNS),
+      _occurrences(std::make_unique<OccurrenceIndex>()),
       _objective(std::make_unique<Row>(0.0)),
-      _artificial(std::make_unique<Row>(0.0)) {}
+      _artificial(std::make_unique<Row>(0.0)),
+      _warmStartCapacity(0),
+      _version(0),
+      _lastVersion(0),
+      _lastJournal(0) {}
 
 Solver::~Solver() {}
 
@@ -39,6 +46,7 @@ Result Solver::addConstraint(const Constraint& constraint) {
 
   if (subject.type() == Symbol::Type::Invalid && allDummiesInRow(*row)) {
     if (!NearZero(row->constant())) {
+      recycleRow(std::move(row));
       return Result::UnsatisfiableConstraint;
     } else {
       subject = tag.marker();
@@ -46,15 +54,18 @@ Result Solver::addConstraint(const Constraint& constraint) {
   }
 
   if (subject.type() == Symbol::Type::Invalid) {
-    if (!addWithArtificialVariableOnRow(*row)) {
+    auto added = addWithArtificialVariableOnRow(*row);
+    recycleRow(std::move(row));
+    if (!added) {
       return Result::UnsatisfiableConstraint;
     }
   } else {
     row->solve(subject);
     substitute(subject, *row);
-    _rows[subject] = std::move(row);
+    addRow(subject, std::move(row));
   }
 
+  recordConstraint(constraint);
   _constraints.insert({constraint, tag});
 
   return optimizeObjectiveRow(*_objective);
@@ -67,13 +78,14 @@ Result Solver::removeConstraint(const Constraint& constraint) {
   }
 
   Tag tag = foundConstraint->second;
+  recordConstraint(constraint);
   _constraints.erase(foundConstraint);
 
   removeConstraintEffects(constraint, tag);
 
   auto foundRow = _rows.find(tag.marker());
   if (foundRow != _rows.end()) {
-    _rows.erase(foundRow);
+    recycleRow(takeRow(foundRow));
   } else {
     auto leavingSymbol = leavingSymbolForMarker(tag.marker());
 
@@ -84,12 +96,13 @@ Result Solver::removeConstraint(const Constraint& constraint) {
 
     auto leaving = leavingRow->first;
 
-    std::unique_ptr<Row> row(std::move(leavingRow->second));
-    _rows.erase(leavingRow);
+    auto row = takeRow(leavingRow);
 
     row->solve(leaving, tag.marker());
 
     substitute(tag.marker(), *row);
+
+    recycleRow(std::move(row));
   }
 
   return optimizeObjectiveRow(*_objective);
@@ -122,6 +135,7 @@ Result Solver::addEditVariable(const expr::Variable& variable,
     return Result::InternalSolverError;
   }
 
+  recordEdit(variable);
   _edits.emplace(
       std::piecewise_construct, std::forward_as_tuple(variable),
       std::forward_as_tuple(_constraints.at(constraint), constraint, 0.0));
@@ -140,6 +154,7 @@ Result Solver::removeEditVariable(const expr::Variable& variable) {
     return Result::InternalSolverError;
   }
 
+  recordEdit(variable);
   _edits.erase(foundEdit);
   return Result::Success;
 }
@@ -152,6 +167,29 @@ Result Solver::applySuggestion(const Suggestion& suggestion) {
   return suggestValueForVariable(suggestion.variable(), suggestion.value());
 }
 
+Result Solver::applySuggestions(const std::vector<Suggestion>& suggestions) {
+  std::vector<EditInfo*> edits;
+  edits.reserve(suggestions.size());
+
+  for (const auto& suggestion : suggestions) {
+    auto foundEdit = _edits.find(suggestion.variable());
+
+    if (foundEdit == _edits.end()) {
+      return Result::UnknownEditVariable;
+    }
+
+    edits.push_back(&foundEdit->second);
+  }
+
+  for (size_t i = 0, count = edits.size(); i < count; i++) {
+    recordEdit(suggestions[i].variable());
+    suggestValueForEditInfoWithoutDualOptimization(*edits[i],
+                                                   suggestions[i].value());
+  }
+
+  return dualOptimize();
+}
+
 Result Solver::suggestValueForVariable(const expr::Variable& variable,
                                        double value) {
   auto foundEdit = _edits.find(variable);
@@ -160,32 +198,98 @@ Result Solver::suggestValueForVariable(const expr::Variable& variable,
     return Result::UnknownEditVariable;
   }
 
+  recordEdit(variable);
   suggestValueForEditInfoWithoutDualOptimization(foundEdit->second, value);
 
   return dualOptimize();
 }
 
-size_t Solver::flushUpdates(SolverUpdateCallback callback) const {
+size_t Solver::flushUpdates(SolverUpdateCallback callback) {
+  resolveUpdatedRows();
+
+  size_t updateCount = 0;
+
+  for (const auto& update : _flushedUpdates) {
+    if (callback(update.first, update.second) == FlushResult::Updated) {
+      updateCount++;
+    }
+  }
+
+  _flushedUpdates.clear();
+  return updateCount;
+}
+
+size_t Solver::flushGroupedUpdates(SolverGroupedUpdateCallback callback) {
+  resolveUpdatedRows();
+
+  std::stable_sort(_flushedUpdates.begin(), _flushedUpdates.end(),
+                   [](const VariableUpdates::value_type& lhs,
+                      const VariableUpdates::value_type& rhs) {
+                     return lhs.first.identifier() < rhs.first.identifier();
+                   });
+
   size_t updateCount = 0;
 
-  for (auto& i : _vars) {
-    auto foundRow = _rows.find(i.second);
+  VariableUpdates group;
+  for (const auto& update : _flushedUpdates) {
+    if (!group.empty() &&
+        group.front().first.identifier() != update.first.identifier()) {
+      if (callback(group) == FlushResult::Updated) {
+        updateCount += group.size();
+      }
+      group.clear();
+    }
+    group.emplace_back(update);
+  }
 
+  if (!group.empty() && callback(group) == FlushResult::Updated) {
+    updateCount += group.size();
+  }
+
+  _flushedUpdates.clear();
+  return updateCount;
+}
+
+void Solver::addUpdatedRow(const Symbol& basic,
+                           const Row& row,
+                           bool hadUpdate) {
+  /*
+   *  Only the values of external variables are flushed. Rows are only added
+   *  when their constants are first updated so that rows updated repeatedly
+   *  between flushes are not added more than once.
+   */
+  if (basic.type() == Symbol::Type::External && !hadUpdate &&
+      row.constantHasUpdate()) {
+    _updatedRows.push_back(basic);
+  }
+}
+
+void Solver::resolveUpdatedRows() {
+  for (const auto& symbol : _updatedRows) {
+    auto foundRow = _rows.find(symbol);
+
+    /*
+     *  The variable may have left the basis since its row was updated.
+     */
     if (foundRow == _rows.end()) {
       continue;
     }
 
     auto& row = foundRow->second;
 
-    if (row->constantHasUpdate()) {
-      if (callback(i.first, row->constant()) == FlushResult::Updated) {
-        updateCount++;
-      }
-      row->resolveConstantUpdate();
+    /*
+     *  A row may be added again if its symbol left the basis and came back.
+     *  Its update has already been resolved in that case.
+     */
+    if (!row->constantHasUpdate()) {
+      continue;
     }
+
+    _flushedUpdates.emplace_back(_externals.at(symbol), row->constant());
+    row->resolveConstantUpdate();
   }
 
-  return updateCount;
+  _updatedRows.clear();
 }
 
 Symbol Solver::symbolForVariable(const expr::Variable& variable) {
@@ -197,12 +301,64 @@ Symbol Solver::symbolForVariable(const expr::Variable& variable) {
 
   auto symbol = Symbol{Symbol::Type::External};
   _vars[variable] = symbol;
+  _externals.emplace(symbol, variable);
   return symbol;
 }
 
+/*
+ *  The tableau churns through rows as constraints are added and removed.
+ *  Rows that are no longer in use are kept around (along with the storage for
+ *  their cells) so that they may be reused for new constraints.
+ */
+static const size_t kMaxPooledRows = 256;
+
+std::unique_ptr<Row> Solver::makeRow(double constant) {
+  if (_rowPool.empty()) {
+    return std::make_unique<Row>(constant);
+  }
+
+  auto row = std::move(_rowPool.back());
+  _rowPool.pop_back();
+  row->reset(constant);
+  return row;
+}
+
+void Solver::recycleRow(std::unique_ptr<Row> row) {
+  if (row == nullptr || _rowPool.size() >= kMaxPooledRows) {
+    return;
+  }
+
+  _rowPool.emplace_back(std::move(row));
+}
+
+void Solver::addRow(const Symbol& basic, std::unique_ptr<Row> row) {
+  recordRow(basic);
+  row->attach(*_occurrences, basic);
+  addUpdatedRow(basic, *row, false);
+  _rows[basic] = std::move(row);
+}
+
+std::unique_ptr<Row> Solver::takeRow(Rows::iterator found) {
+  recordRow(*found->second);
+  std::unique_ptr<Row> row(std::move(found->second));
+  _rows.erase(found);
+  row->detach();
+  return row;
+}
+
+void Solver::addInfeasibleRows(std::vector<Symbol>& rows) {
+  /*
+   *  Rows are found via the index which is unordered. Sort them so that the
+   *  order in which they are made feasible (and hence the solution) does not
+   *  depend on the order of the index.
+   */
+  std::sort(rows.begin(), rows.end(), Symbol::Compare());
+  _infeasibleRows.insert(_infeasibleRows.end(), rows.begin(), rows.end());
+}
+
 std::unique_ptr<Row> Solver::createRow(const Constraint& constraint, Tag& tag) {
   auto const& expression = constraint.expression();
-  auto row = std::make_unique<Row>(expression.constant());
+  auto row = makeRow(expression.constant());
 
   for (const auto& term : expression.terms()) {
     if (NearZero(term.coefficient())) {
@@ -238,6 +394,7 @@ std::unique_ptr<Row> Solver::createRow(const Constraint& constraint, Tag& tag) {
 
         row->insertSymbol(error, -coeffcient);
 
+        recordObjective();
         _objective->insertSymbol(error, constraint.priority());
       }
     } break;
@@ -252,6 +409,7 @@ std::unique_ptr<Row> Solver::createRow(const Constraint& constraint, Tag& tag) {
         row->insertSymbol(errPlus, -1.0);
         row->insertSymbol(errMinus, 1.0);
 
+        recordObjective();
         _objective->insertSymbol(errPlus, constraint.priority());
         _objective->insertSymbol(errMinus, constraint.priority());
       } else {
@@ -271,8 +429,8 @@ std::unique_ptr<Row> Solver::createRow(const Constraint& constraint, Tag& tag) {
 
 Symbol Solver::chooseSubjectForRow(const Row& row, const Tag& tag) const {
   for (const auto& cell : row.cells()) {
-    if (cell.first.type() == Symbol::Type::External) {
-      return cell.first;
+    if (cell.symbol.type() == Symbol::Type::External) {
+      return cell.symbol;
     }
   }
 
@@ -303,7 +461,7 @@ Symbol Solver::chooseSubjectForRow(const Row& row, const Tag& tag) const {
 
 bool Solver::allDummiesInRow(const Row& row) const {
   for (const auto& cell : row.cells()) {
-    if (cell.first.type() != Symbol::Type::Dummy) {
+    if (cell.symbol.type() != Symbol::Type::Dummy) {
       return false;
     }
   }
@@ -312,7 +470,7 @@ bool Solver::allDummiesInRow(const Row& row) const {
 
 bool Solver::addWithArtificialVariableOnRow(const Row& row) {
   auto artificial = Symbol{Symbol::Type::Slack};
-  _rows.emplace(artificial, std::make_unique<Row>(row));
+  addRow(artificial, std::make_unique<Row>(row));
   _artificial = std::make_unique<Row>(row);
 
   const auto& result = optimizeObjectiveRow(*_artificial);
@@ -326,8 +484,7 @@ bool Solver::addWithArtificialVariableOnRow(const Row& row) {
 
   auto foundRowIterator = _rows.find(artificial);
   if (foundRowIterator != _rows.end()) {
-    std::unique_ptr<Row> foundRow(std::move(foundRowIterator->second));
-    _rows.erase(foundRowIterator);
+    auto foundRow = takeRow(foundRowIterator);
 
     if (foundRow->cells().size() == 0) {
       return success;
@@ -340,13 +497,19 @@ bool Solver::addWithArtificialVariableOnRow(const Row& row) {
 
     foundRow->solve(artificial, entering);
     substitute(entering, *foundRow);
-    _rows[entering].swap(foundRow);
+    addRow(entering, std::move(foundRow));
   }
 
-  for (const auto& row : _rows) {
-    row.second->removeSymbol(artificial);
+  /*
+   *  Removing the symbol updates the index. So iterate over a copy.
+   */
+  auto rows = _occurrences->rowsForSymbol(artificial);
+  for (auto row : rows) {
+    recordRow(*row);
+    row->removeSymbol(artificial);
   }
 
+  recordObjective();
   _objective->removeSymbol(artificial);
   return success;
 }
@@ -365,15 +528,12 @@ Result Solver::optimizeObjectiveRow(const Row& objective) {
 
     auto leaving = Symbol{foundRow->first};
 
-    std::unique_ptr<Row> row(std::move(foundRow->second));
-    RL_ASSERT(foundRow->second == nullptr);
-
-    _rows.erase(foundRow);
+    auto row = takeRow(foundRow);
 
     row->solve(leaving, entering);
     substitute(entering, *row);
 
-    _rows[entering].swap(row);
+    addRow(entering, std::move(row));
   }
 }
 
@@ -381,8 +541,8 @@ Symbol Solver::enteringSymbolForObjectiveRow(const Row& objective) {
   const auto& cells = objective.cells();
 
   for (const auto& cell : cells) {
-    if (cell.first.type() != Symbol::Type::Dummy && cell.second < 0.0) {
-      return cell.first;
+    if (cell.symbol.type() != Symbol::Type::Dummy && cell.coefficient < 0.0) {
+      return cell.symbol;
     }
   }
 
@@ -392,14 +552,20 @@ Symbol Solver::enteringSymbolForObjectiveRow(const Row& objective) {
 Symbol Solver::leavingSymbolForEntering(const Symbol& entering) const {
   auto ratio = std::numeric_limits<double>::max();
   Symbol found;
-  for (const auto& row : _rows) {
-    if (row.first.type() != Symbol::Type::External) {
-      auto temp = row.second->coefficientForSymbol(entering);
+  for (const auto row : _occurrences->rowsForSymbol(entering)) {
+    const auto& basic = row->subject();
+    if (basic.type() != Symbol::Type::External) {
+      auto temp = row->coefficientForSymbol(entering);
       if (temp < 0.0) {
-        auto temp_ratio = -row.second->constant() / temp;
-        if (temp_ratio < ratio) {
+        auto temp_ratio = -row->constant() / temp;
+        /*
+         *  Break ties on the symbol so the choice does not depend on the
+         *  order of the index.
+         */
+        if (temp_ratio < ratio ||
+            (temp_ratio == ratio && Symbol::Compare()(basic, found))) {
           ratio = temp_ratio;
-          found = row.first;
+          found = basic;
         }
       }
     }
@@ -408,14 +574,27 @@ Symbol Solver::leavingSymbolForEntering(const Symbol& entering) const {
 }
 
 void Solver::substitute(const Symbol& symbol, const Row& row) {
-  for (const auto& i : _rows) {
-    i.second->substitute(symbol, row);
-    if (i.first.type() != Symbol::Type::External &&
-        i.second->constant() < 0.0) {
-      _infeasibleRows.push_back(i.first);
+  std::vector<Symbol> infeasibleRows;
+
+  /*
+   *  Substitution updates the index. So iterate over a copy.
+   */
+  auto rows = _occurrences->rowsForSymbol(symbol);
+  for (auto basicRow : rows) {
+    recordRow(*basicRow);
+    const auto hadUpdate = basicRow->constantHasUpdate();
+    basicRow->substitute(symbol, row);
+    const auto& basic = basicRow->subject();
+    addUpdatedRow(basic, *basicRow, hadUpdate);
+    if (basic.type() != Symbol::Type::External &&
+        basicRow->constant() < 0.0) {
+      infeasibleRows.push_back(basic);
     }
   }
 
+  addInfeasibleRows(infeasibleRows);
+
+  recordObjective();
   _objective->substitute(symbol, row);
 
   if (_artificial) {
@@ -424,11 +603,11 @@ void Solver::substitute(const Symbol& symbol, const Row& row) {
 }
 
 Symbol Solver::pivotableSymbol(const Row& row) const {
-  for (const auto& symbol : row.cells()) {
-    switch (symbol.first.type()) {
+  for (const auto& cell : row.cells()) {
+    switch (cell.symbol.type()) {
       case Symbol::Type::Slack:
       case Symbol::Type::Error:
-        return symbol.first;
+        return cell.symbol;
         break;
       default:
         break;
@@ -449,6 +628,7 @@ void Solver::removeConstraintEffects(const Constraint& constraint,
 }
 
 void Solver::removeMarkerEffects(const Symbol& marker, double strength) {
+  recordObjective();
   auto foundRow = _rows.find(marker);
   if (foundRow != _rows.end()) {
     _objective->insertRow(*(foundRow->second), -strength);
@@ -463,24 +643,33 @@ Symbol Solver::leavingSymbolForMarker(const Symbol& marker) const {
 
   Symbol first, second, third;
 
-  for (const auto& i : _rows) {
-    double c = i.second->coefficientForSymbol(marker);
+  /*
+   *  Ties are broken on the symbol so the choice does not depend on the order
+   *  of the index.
+   */
+  Symbol::Compare precedes;
+
+  for (const auto row : _occurrences->rowsForSymbol(marker)) {
+    const auto& basic = row->subject();
+    double c = row->coefficientForSymbol(marker);
     if (c == 0.0) {
       continue;
     }
-    if (i.first.type() == Symbol::Type::External) {
-      third = i.first;
+    if (basic.type() == Symbol::Type::External) {
+      if (third.type() == Symbol::Type::Invalid || precedes(third, basic)) {
+        third = basic;
+      }
     } else if (c < 0.0) {
-      auto r = -i.second->constant() / c;
-      if (r < r1) {
+      auto r = -row->constant() / c;
+      if (r < r1 || (r == r1 && precedes(basic, first))) {
         r1 = r;
-        first = i.first;
+        first = basic;
       }
     } else {
-      auto r = i.second->constant() / c;
-      if (r < r2) {
+      auto r = row->constant() / c;
+      if (r < r2 || (r == r2 && precedes(basic, second))) {
         r2 = r;
-        second = i.first;
+        second = basic;
       }
     }
   }
@@ -504,6 +693,7 @@ void Solver::suggestValueForEditInfoWithoutDualOptimization(EditInfo& info,
   {
     auto foundRow = _rows.find(info.tag().marker());
     if (foundRow != _rows.end()) {
+      recordRow(*foundRow->second);
       if (foundRow->second->add(-delta) < 0.0) {
         _infeasibleRows.push_back(foundRow->first);
       }
@@ -514,6 +704,7 @@ void Solver::suggestValueForEditInfoWithoutDualOptimization(EditInfo& info,
   {
     auto foundRow = _rows.find(info.tag().other());
     if (foundRow != _rows.end()) {
+      recordRow(*foundRow->second);
       if (foundRow->second->add(delta) < 0.0) {
         _infeasibleRows.push_back(foundRow->first);
       }
@@ -522,13 +713,24 @@ void Solver::suggestValueForEditInfoWithoutDualOptimization(EditInfo& info,
   }
 
   {
-    for (const auto& i : _rows) {
-      double coeff = i.second->coefficientForSymbol(info.tag().marker());
-      if (coeff != 0.0 && i.second->add(delta * coeff) < 0.0 &&
-          i.first.type() != Symbol::Type::External) {
-        _infeasibleRows.push_back(i.first);
+    std::vector<Symbol> infeasibleRows;
+
+    for (auto row : _occurrences->rowsForSymbol(info.tag().marker())) {
+      const auto& basic = row->subject();
+      double coeff = row->coefficientForSymbol(info.tag().marker());
+      if (coeff == 0.0) {
+        continue;
+      }
+      recordRow(*row);
+      const auto hadUpdate = row->constantHasUpdate();
+      auto constant = row->add(delta * coeff);
+      addUpdatedRow(basic, *row, hadUpdate);
+      if (constant < 0.0 && basic.type() != Symbol::Type::External) {
+        infeasibleRows.push_back(basic);
       }
     }
+
+    addInfeasibleRows(infeasibleRows);
   }
 }
 
@@ -545,12 +747,11 @@ Result Solver::dualOptimize() {
         return Result::InternalSolverError;
       }
 
-      std::unique_ptr<Row> row(std::move(foundRow->second));
-      _rows.erase(foundRow);
+      auto row = takeRow(foundRow);
 
       row->solve(leaving, entering);
       substitute(entering, *row);
-      _rows[entering].swap(row);
+      addRow(entering, std::move(row));
     }
   }
   return Result::Success;
@@ -560,15 +761,15 @@ Symbol Solver::dualEnteringSymbolForRow(const Row& row) {
   Symbol entering;
   auto ratio = std::numeric_limits<double>::max();
 
-  for (const auto& symbol : row.cells()) {
-    auto value = symbol.second;
-    if (value > 0.0 && symbol.first.type() != Symbol::Type::Dummy) {
-      auto coeff = _objective->coefficientForSymbol(symbol.first);
+  for (const auto& cell : row.cells()) {
+    auto value = cell.coefficient;
+    if (value > 0.0 && cell.symbol.type() != Symbol::Type::Dummy) {
+      auto coeff = _objective->coefficientForSymbol(cell.symbol);
       auto r = coeff / value;
 
       if (r < ratio) {
         ratio = r;
-        entering = symbol.first;
+        entering = cell.symbol;
       }
     }
   }
@@ -583,47 +784,66 @@ Symbol Solver::dualEnteringSymbolForRow(const Row& row) {
 template <class T>
 Result Solver::bulkEdit(const std::vector<T>& items,
                         UpdateCallback<T> applier,
-                        UpdateCallback<T> undoer) {
-  std::vector<std::reference_wrapper<const T>> applied;
-  auto needsCleanup = false;
+                        std::unique_ptr<Journal>* changes) {
+  /*
+   *  Failed batches are rolled back by restoring a snapshot. This only undoes
+   *  the rows touched by the batch instead of replaying the inverse of each
+   *  edit.
+   */
+  snapshot();
+
+  for (const auto& item : items) {
+    auto result = applier(item);
+    if (result != Result::Success) {
+      restoreSnapshot();
+      return result;
+    }
+  }
 
-  Result result = Result::Success;
+  if (changes != nullptr) {
+    *changes = takeJournal();
+  } else {
+    discardSnapshot();
+  }
 
-  for (auto& item : items) {
-    result = applier(item);
-    if (result == Result::Success) {
-      applied.push_back(std::cref(item));
-    } else {
-      needsCleanup = true;
-      break;
-    }
+  return Result::Success;
+}
+
+Result Solver::bulkEditConstraints(const std::vector<Constraint>& constraints,
+                                   bool adding) {
+  namespace P = std::placeholders;
+  UpdateCallback<Constraint> applier =
+      adding ? std::bind(&Solver::addConstraint, this, P::_1)
+             : std::bind(&Solver::removeConstraint, this, P::_1);
+
+  /*
+   *  Warm starts are only attempted for the outermost batches. Batches within
+   *  a snapshot are undone along with the snapshot.
+   */
+  if (_warmStartCapacity == 0 || !_journals.empty()) {
+    return bulkEdit(constraints, applier);
   }
 
-  if (needsCleanup) {
-    for (auto i = applied.rbegin(); i != applied.rend(); ++i) {
-      undoer(*i);
-    }
+  if (warmStart(constraints, adding)) {
+    return Result::Success;
+  }
+
+  std::unique_ptr<Journal> before;
+  auto result = bulkEdit(constraints, applier, &before);
+
+  if (result == Result::Success) {
+    addWarmStart(constraints, adding, std::move(before));
   }
 
   return result;
 }
 
 Result Solver::addConstraints(const std::vector<Constraint>& constraints) {
-  UpdateCallback<Constraint> applier =
-      std::bind(&Solver::addConstraint, this, std::placeholders::_1);
-  UpdateCallback<Constraint> undoer =
-      std::bind(&Solver::removeConstraint, this, std::placeholders::_1);
-
-  return bulkEdit(constraints, applier, undoer);
+  return bulkEditConstraints(constraints, true);
 }
 
 Result Solver::removeConstraints(const std::vector<Constraint>& constraints) {
-  UpdateCallback<Constraint> applier =
-      std::bind(&Solver::removeConstraint, this, std::placeholders::_1);
-  UpdateCallback<Constraint> undoer =
-      std::bind(&Solver::addConstraint, this, std::placeholders::_1);
-
-  return bulkEdit(constraints, applier, undoer);
+  return bulkEditConstraints(constraints, false);
 }
 
 Result Solver::addEditVariables(const std::vector<expr::Variable> variables,
@@ -632,22 +852,360 @@ Result Solver::addEditVariables(const std::vector<expr::Variable> variables,
       [&, priority](const expr::Variable& variable) {
         return addEditVariable(variable, priority);
       };
-  UpdateCallback<expr::Variable> undoer =
-      std::bind(&Solver::removeEditVariable, this, std::placeholders::_1);
 
-  return bulkEdit(variables, applier, undoer);
+  return bulkEdit(variables, applier);
 }
 
 Result Solver::removeEditVariables(
     const std::vector<expr::Variable> variables) {
   UpdateCallback<expr::Variable> applier =
       std::bind(&Solver::removeEditVariable, this, std::placeholders::_1);
-  UpdateCallback<expr::Variable> undoer = [&](const expr::Variable& variable) {
-    return addEditVariable(variable,
-                           _edits.at(variable).constraint().priority());
-  };
 
-  return bulkEdit(variables, applier, undoer);
+  return bulkEdit(variables, applier);
+}
+
+/*
+ *  Snapshots
+ */
+
+/*
+ *  The state of the solver saved by a snapshot. Only the rows, constraints and
+ *  edits touched since the snapshot was taken are saved. Null entries are for
+ *  ones that did not exist at the time.
+ */
+struct Solver::Journal {
+  size_t identifier;
+  size_t version;
+  std::unordered_map<Symbol, std::unique_ptr<Row>, Symbol::Hash> rows;
+  std::unique_ptr<Row> objective;
+  std::map<Constraint, std::unique_ptr<Tag>, Constraint::Compare> constraints;
+  std::unordered_map<expr::Variable,
+                     std::unique_ptr<EditInfo>,
+                     expr::Variable::Hash,
+                     expr::Variable::Equal>
+      edits;
+  std::list<Symbol> infeasibleRows;
+
+  Journal(size_t aIdentifier, size_t aVersion)
+      : identifier(aIdentifier), version(aVersion) {}
+};
+
+/*
+ *  A batch of constraint edits that took the solver from one version to
+ *  another along with the solver state on either side of the batch.
+ */
+struct Solver::WarmStart {
+  std::vector<Constraint> constraints;
+  bool adding;
+  std::unique_ptr<Journal> before;
+  std::unique_ptr<Journal> after;
+
+  WarmStart(const std::vector<Constraint>& aConstraints,
+            bool aAdding,
+            std::unique_ptr<Journal> aBefore,
+            std::unique_ptr<Journal> aAfter)
+      : constraints(aConstraints),
+        adding(aAdding),
+        before(std::move(aBefore)),
+        after(std::move(aAfter)) {}
+};
+
+static std::unique_ptr<EditInfo> CopyEditInfo(const EditInfo& info) {
+  return std::make_unique<EditInfo>(info.tag(), info.constraint(),
+                                    info.constant());
+}
+
+void Solver::snapshot() {
+  auto journal = std::make_unique<Journal>(++_lastJournal, _version);
+  journal->infeasibleRows = _infeasibleRows;
+  _journals.emplace_back(std::move(journal));
+}
+
+void Solver::restoreSnapshot() {
+  /*
+   *  The restoration itself is not recorded in an enclosing snapshot. Anything
+   *  touched since this snapshot that the enclosing one has not recorded was
+   *  unchanged when this snapshot was taken.
+   */
+  auto journal = takeJournal();
+  applyJournal(*journal);
+}
+
+void Solver::discardSnapshot() {
+  auto journal = takeJournal();
+
+  if (_journals.empty()) {
+    return;
+  }
+
+  /*
+   *  The enclosing snapshot needs to be able to undo the changes made since
+   *  this one was taken as well.
+   */
+  auto& enclosing = *_journals.back();
+
+  for (auto& row : journal->rows) {
+    enclosing.rows.emplace(row.first, std::move(row.second));
+  }
+
+  if (enclosing.objective == nullptr) {
+    enclosing.objective = std::move(journal->objective);
+  }
+
+  for (auto& constraint : journal->constraints) {
+    enclosing.constraints.emplace(constraint.first,
+                                  std::move(constraint.second));
+  }
+
+  for (auto& edit : journal->edits) {
+    enclosing.edits.emplace(edit.first, std::move(edit.second));
+  }
+}
+
+std::unique_ptr<Solver::Journal> Solver::takeJournal() {
+  RL_ASSERT_MSG(!_journals.empty(), "There must be a snapshot to take");
+  auto journal = std::move(_journals.back());
+  _journals.pop_back();
+  return journal;
+}
+
+Solver::Journal* Solver::recordingJournal() {
+  /*
+   *  All changes to the solver are recorded. So this is also where the solver
+   *  gets a new version.
+   */
+  _version = ++_lastVersion;
+  return _journals.empty() ? nullptr : _journals.back().get();
+}
+
+void Solver::recordRow(const Symbol& basic) {
+  auto journal = recordingJournal();
+  if (journal == nullptr) {
+    return;
+  }
+
+  if (journal->rows.find(basic) != journal->rows.end()) {
+    return;
+  }
+
+  auto found = _rows.find(basic);
+  journal->rows.emplace(basic, found == _rows.end()
+                                   ? std::unique_ptr<Row>()
+                                   : std::make_unique<Row>(*found->second));
+}
+
+void Solver::recordRow(Row& row) {
+  auto journal = recordingJournal();
+  if (journal == nullptr || row.journal() == journal->identifier) {
+    return;
+  }
+
+  if (journal->rows.find(row.subject()) == journal->rows.end()) {
+    journal->rows.emplace(row.subject(), std::make_unique<Row>(row));
+  }
+
+  row.setJournal(journal->identifier);
+}
+
+void Solver::recordObjective() {
+  auto journal = recordingJournal();
+  if (journal == nullptr || journal->objective != nullptr) {
+    return;
+  }
+
+  journal->objective = std::make_unique<Row>(*_objective);
+}
+
+void Solver::recordConstraint(const Constraint& constraint) {
+  auto journal = recordingJournal();
+  if (journal == nullptr || journal->constraints.count(constraint) != 0) {
+    return;
+  }
+
+  auto found = _constraints.find(constraint);
+  journal->constraints.emplace(constraint,
+                               found == _constraints.end()
+                                   ? std::unique_ptr<Tag>()
+                                   : std::make_unique<Tag>(found->second));
+}
+
+void Solver::recordEdit(const expr::Variable& variable) {
+  auto journal = recordingJournal();
+  if (journal == nullptr || journal->edits.count(variable) != 0) {
+    return;
+  }
+
+  auto found = _edits.find(variable);
+  journal->edits.emplace(variable, found == _edits.end()
+                                       ? std::unique_ptr<EditInfo>()
+                                       : CopyEditInfo(found->second));
+}
+
+std::unique_ptr<Solver::Journal> Solver::journalOfCurrentState(
+    const Journal& changes) const {
+  auto journal = std::make_unique<Journal>(0, _version);
+  journal->infeasibleRows = _infeasibleRows;
+
+  for (const auto& row : changes.rows) {
+    auto found = _rows.find(row.first);
+    journal->rows.emplace(row.first,
+                          found == _rows.end()
+                              ? std::unique_ptr<Row>()
+                              : std::make_unique<Row>(*found->second));
+  }
+
+  if (changes.objective != nullptr) {
+    journal->objective = std::make_unique<Row>(*_objective);
+  }
+
+  for (const auto& constraint : changes.constraints) {
+    auto found = _constraints.find(constraint.first);
+    journal->constraints.emplace(
+        constraint.first, found == _constraints.end()
+                              ? std::unique_ptr<Tag>()
+                              : std::make_unique<Tag>(found->second));
+  }
+
+  for (const auto& edit : changes.edits) {
+    auto found = _edits.find(edit.first);
+    journal->edits.emplace(edit.first, found == _edits.end()
+                                           ? std::unique_ptr<EditInfo>()
+                                           : CopyEditInfo(found->second));
+  }
+
+  return journal;
+}
+
+void Solver::applyJournal(const Journal& journal) {
+  /*
+   *  Take out all rows first so that the index never sees two rows for the
+   *  same basic symbol.
+   */
+  for (const auto& row : journal.rows) {
+    auto found = _rows.find(row.first);
+    if (found != _rows.end()) {
+      found->second->detach();
+      recycleRow(std::move(found->second));
+      _rows.erase(found);
+    }
+  }
+
+  for (const auto& row : journal.rows) {
+    if (row.second == nullptr) {
+      continue;
+    }
+
+    auto restored = std::make_unique<Row>(*row.second);
+    restored->attach(*_occurrences, row.first);
+
+    /*
+     *  The value of the variable may differ from the one last flushed.
+     */
+    if (row.first.type() == Symbol::Type::External) {
+      restored->markConstantUpdated();
+      _updatedRows.push_back(row.first);
+    }
+
+    _rows.emplace(row.first, std::move(restored));
+  }
+
+  if (journal.objective != nullptr) {
+    _objective = std::make_unique<Row>(*journal.objective);
+  }
+
+  for (const auto& constraint : journal.constraints) {
+    _constraints.erase(constraint.first);
+    if (constraint.second != nullptr) {
+      _constraints.emplace(constraint.first, *constraint.second);
+    }
+  }
+
+  for (const auto& edit : journal.edits) {
+    _edits.erase(edit.first);
+    if (edit.second != nullptr) {
+      const auto& info = *edit.second;
+      _edits.emplace(std::piecewise_construct,
+                     std::forward_as_tuple(edit.first),
+                     std::forward_as_tuple(info.tag(), info.constraint(),
+                                           info.constant()));
+    }
+  }
+
+  _infeasibleRows = journal.infeasibleRows;
+  _version = journal.version;
+}
+
+/*
+ *  Warm Starts
+ */
+
+static bool SameConstraints(const std::vector<Constraint>& lhs,
+                            const std::vector<Constraint>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  Constraint::Compare compare;
+  for (size_t i = 0, count = lhs.size(); i < count; i++) {
+    if (compare(lhs[i], rhs[i]) || compare(rhs[i], lhs[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Solver::setWarmStartCapacity(size_t capacity) {
+  _warmStartCapacity = capacity;
+  if (_warmStarts.size() > capacity) {
+    _warmStarts.resize(capacity);
+  }
+}
+
+bool Solver::warmStart(const std::vector<Constraint>& constraints,
+                       bool adding) {
+  for (auto i = _warmStarts.begin(); i != _warmStarts.end(); ++i) {
+    auto& warmStart = **i;
+
+    /*
+     *  The cached state is only valid if the solver is in the exact state the
+     *  batch was originally applied to (to redo it) or left behind (to undo
+     *  it).
+     */
+    const Journal* target = nullptr;
+    if (warmStart.adding == adding &&
+        warmStart.before->version == _version) {
+      target = warmStart.after.get();
+    } else if (warmStart.adding != adding &&
+               warmStart.after->version == _version) {
+      target = warmStart.before.get();
+    }
+
+    if (target == nullptr ||
+        !SameConstraints(warmStart.constraints, constraints)) {
+      continue;
+    }
+
+    applyJournal(*target);
+
+    std::rotate(_warmStarts.begin(), i, i + 1);
+    return true;
+  }
+
+  return false;
+}
+
+void Solver::addWarmStart(const std::vector<Constraint>& constraints,
+                          bool adding,
+                          std::unique_ptr<Journal> before) {
+  auto after = journalOfCurrentState(*before);
+  _warmStarts.emplace(_warmStarts.begin(),
+                      std::make_unique<WarmStart>(constraints, adding,
+                                                  std::move(before),
+                                                  std::move(after)));
+  if (_warmStarts.size() > _warmStartCapacity) {
+    _warmStarts.pop_back();
+  }
 }
 
 }  // namespace layout
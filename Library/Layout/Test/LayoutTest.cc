@@ -9,6 +9,7 @@
 #include <Layout/ConstraintCreation.h>
 #include <Layout/Solver.h>
 #include <TestRunner/TestRunner.h>
+#include "Row.h"
 
 TEST(LayoutTest, SimpleOperatorOverloadedConstruction) {
   rl::expr::Expression expr({}, 1.0);
@@ -346,6 +347,94 @@ TEST(LayoutTest, EditConstraintFlush) {
   ASSERT_EQ(updates[three], 300.0);
 }
 
+TEST(LayoutTest, BatchedSuggestionsMatchIndividualSuggestions) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns}),
+      three(rl::core::Name{ns});
+
+  rl::expr::Variable left(one), right(two), mid(three);
+
+  const auto strong = rl::layout::priority::Strong();
+
+  auto solve = [&](bool batched) {
+    rl::layout::Solver solver(ns);
+
+    auto res = solver.addConstraints({
+        right - left >= 100.0,                 //
+        (right + left == 2.0 * mid) | strong,  //
+        left >= 0.0,                           //
+    });
+    EXPECT_EQ(res, rl::layout::Result::Success);
+
+    EXPECT_EQ(solver.addEditVariable(left, strong),
+              rl::layout::Result::Success);
+    EXPECT_EQ(solver.addEditVariable(right, strong),
+              rl::layout::Result::Success);
+
+    std::vector<rl::layout::Suggestion> suggestions = {
+        {left, 50.0, strong},   //
+        {right, 60.0, strong},  //
+        {left, 20.0, strong},   //
+    };
+
+    if (batched) {
+      EXPECT_EQ(solver.applySuggestions(suggestions),
+                rl::layout::Result::Success);
+    } else {
+      for (const auto& suggestion : suggestions) {
+        EXPECT_EQ(solver.applySuggestion(suggestion),
+                  rl::layout::Result::Success);
+      }
+    }
+
+    std::map<rl::core::Name, double> updates;
+    solver.flushUpdates([&](const rl::expr::Variable& var, double value) {
+      updates[var.identifier()] = value;
+      return rl::layout::Solver::FlushResult::Updated;
+    });
+    return updates;
+  };
+
+  auto individual = solve(false);
+  auto batched = solve(true);
+
+  ASSERT_EQ(batched.size(), 3u);
+  ASSERT_EQ(individual, batched);
+  ASSERT_EQ(batched[two] - batched[one], 100.0);
+}
+
+TEST(LayoutTest, BatchedSuggestionsWithUnknownVariableAreNotApplied) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns});
+
+  rl::expr::Variable edited(one), unknown(two);
+
+  const auto strong = rl::layout::priority::Strong();
+
+  rl::layout::Solver solver(ns);
+  ASSERT_EQ(solver.addEditVariable(edited, strong),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.applySuggestion({edited, 10.0, strong}),
+            rl::layout::Result::Success);
+
+  ASSERT_EQ(solver.applySuggestions({
+                {edited, 20.0, strong},   //
+                {unknown, 30.0, strong},  //
+            }),
+            rl::layout::Result::UnknownEditVariable);
+
+  std::map<rl::core::Name, double> updates;
+  solver.flushUpdates([&](const rl::expr::Variable& var, double value) {
+    updates[var.identifier()] = value;
+    return rl::layout::Solver::FlushResult::Updated;
+  });
+
+  ASSERT_EQ(updates.size(), 1u);
+  ASSERT_EQ(updates[one], 10.0);
+}
+
 TEST(LayoutTest, SolverSolutionWithOptimize) {
   rl::core::Namespace ns;
 
@@ -386,6 +475,363 @@ TEST(LayoutTest, SolverSolutionWithOptimize) {
   ASSERT_EQ(updates[three], 10.0);
 }
 
+TEST(LayoutTest, FlushOnlyReportsUpdatedVariables) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns});
+  rl::expr::Variable edited(one), fixed(two);
+
+  rl::layout::Solver solver(ns);
+
+  ASSERT_EQ(solver.addConstraint(fixed == 100.0), rl::layout::Result::Success);
+  ASSERT_EQ(solver.addEditVariable(edited, rl::layout::priority::Strong()),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.suggestValueForVariable(edited, 10.0),
+            rl::layout::Result::Success);
+
+  std::map<rl::core::Name, double> updates;
+  auto flush = [&]() {
+    updates.clear();
+    return solver.flushUpdates(
+        [&](const rl::expr::Variable& var, double value) {
+          updates[var.identifier()] = value;
+          return rl::layout::Solver::FlushResult::Updated;
+        });
+  };
+
+  ASSERT_EQ(flush(), 2u);
+  ASSERT_EQ(updates[one], 10.0);
+  ASSERT_EQ(updates[two], 100.0);
+
+  ASSERT_EQ(flush(), 0u);
+
+  ASSERT_EQ(solver.suggestValueForVariable(edited, 20.0),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.suggestValueForVariable(edited, 30.0),
+            rl::layout::Result::Success);
+
+  ASSERT_EQ(flush(), 1u);
+  ASSERT_EQ(updates.size(), 1u);
+  ASSERT_EQ(updates[one], 30.0);
+}
+
+TEST(LayoutTest, GroupedFlushDeliversUpdatesPerIdentifier) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns});
+
+  using Property = rl::expr::Variable::Property;
+
+  rl::layout::Solver solver(ns);
+  auto res = solver.addConstraints({
+      rl::expr::Variable{one, Property::PositionX} == 10.0,    //
+      rl::expr::Variable{two, Property::PositionX} == 20.0,    //
+      rl::expr::Variable{one, Property::PositionY} == 30.0,    //
+      rl::expr::Variable{one, Property::BoundsWidth} == 40.0,  //
+  });
+  ASSERT_EQ(res, rl::layout::Result::Success);
+
+  std::map<rl::core::Name, rl::layout::Solver::VariableUpdates> groups;
+  auto count = solver.flushGroupedUpdates(
+      [&](const rl::layout::Solver::VariableUpdates& updates) {
+        const auto identifier = updates.front().first.identifier();
+        EXPECT_EQ(groups.count(identifier), 0u);
+        for (const auto& update : updates) {
+          EXPECT_EQ(update.first.identifier(), identifier);
+        }
+        groups[identifier] = updates;
+        return rl::layout::Solver::FlushResult::Updated;
+      });
+
+  ASSERT_EQ(count, 4u);
+  ASSERT_EQ(groups.size(), 2u);
+  ASSERT_EQ(groups[one].size(), 3u);
+  ASSERT_EQ(groups[two].size(), 1u);
+  ASSERT_EQ(groups[two][0].second, 20.0);
+
+  /*
+   *  Apply the updates to an entity at once.
+   */
+  rl::entity::Entity entity(one, nullptr);
+  rl::expr::Variable::SetProperties(entity, groups[one]);
+  ASSERT_EQ(entity.position(), rl::geom::Point(10.0, 30.0));
+  ASSERT_EQ(entity.bounds().size.width, 40.0);
+}
+
+/**
+ *  Flush the solver updates into the values of the variables seen so far.
+ */
+static void Flush(rl::layout::Solver& solver,
+                  std::map<rl::core::Name, double>& values) {
+  solver.flushUpdates([&](const rl::expr::Variable& var, double value) {
+    values[var.identifier()] = value;
+    return rl::layout::Solver::FlushResult::Updated;
+  });
+}
+
+TEST(LayoutTest, FailedBatchIsRolledBack) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns}),
+      three(rl::core::Name{ns});
+
+  rl::expr::Variable x(one), y(two), z(three);
+
+  rl::layout::Solver solver(ns);
+
+  ASSERT_EQ(solver.addConstraints({x == 10.0, y == x + 20.0}),
+            rl::layout::Result::Success);
+
+  std::map<rl::core::Name, double> values;
+  Flush(solver, values);
+
+  const auto sum = z == x + y;
+  auto res = solver.addConstraints({
+      sum,          //
+      y >= 50.0,    //
+  });
+  ASSERT_EQ(res, rl::layout::Result::UnsatisfiableConstraint);
+  ASSERT_EQ(solver.constraintsCount(), 2u);
+  ASSERT_FALSE(solver.hasConstraint(sum));
+
+  Flush(solver, values);
+  ASSERT_EQ(values[one], 10.0);
+  ASSERT_EQ(values[two], 30.0);
+
+  /*
+   *  The solver is still usable after the rollback.
+   */
+  ASSERT_EQ(solver.addConstraint(sum), rl::layout::Result::Success);
+  Flush(solver, values);
+  ASSERT_EQ(values[three], 40.0);
+}
+
+TEST(LayoutTest, SnapshotsRestoreSolutions) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns});
+
+  rl::expr::Variable left(one), right(two);
+
+  const auto strong = rl::layout::priority::Strong();
+
+  rl::layout::Solver solver(ns);
+  ASSERT_EQ(solver.addConstraint(right == left + 100.0),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.addEditVariable(left, strong),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.applySuggestion({left, 10.0, strong}),
+            rl::layout::Result::Success);
+
+  std::map<rl::core::Name, double> values;
+  Flush(solver, values);
+
+  solver.snapshot();
+
+  ASSERT_EQ(solver.applySuggestion({left, 20.0, strong}),
+            rl::layout::Result::Success);
+
+  solver.snapshot();
+
+  const auto limit = right <= 50.0;
+  ASSERT_EQ(solver.addConstraint(limit), rl::layout::Result::Success);
+  Flush(solver, values);
+  ASSERT_EQ(values[one], -50.0);
+
+  /*
+   *  Keep the changes of the inner snapshot. Restoring the outer one still
+   *  undoes them.
+   */
+  solver.discardSnapshot();
+  ASSERT_TRUE(solver.hasConstraint(limit));
+
+  solver.restoreSnapshot();
+  ASSERT_FALSE(solver.hasConstraint(limit));
+  ASSERT_EQ(solver.constraintsCount(), 2u);
+
+  Flush(solver, values);
+  ASSERT_EQ(values[one], 10.0);
+  ASSERT_EQ(values[two], 110.0);
+
+  /*
+   *  The edit variable is back at its old value too.
+   */
+  ASSERT_EQ(solver.applySuggestion({left, 30.0, strong}),
+            rl::layout::Result::Success);
+  Flush(solver, values);
+  ASSERT_EQ(values[one], 30.0);
+  ASSERT_EQ(values[two], 130.0);
+}
+
+TEST(LayoutTest, WarmStartsMatchColdSolutions) {
+  rl::core::Namespace ns;
+
+  rl::core::Name one(rl::core::Name{ns}), two(rl::core::Name{ns}),
+      three(rl::core::Name{ns});
+
+  rl::expr::Variable left(one), right(two), mid(three);
+
+  const auto strong = rl::layout::priority::Strong();
+  const std::vector<rl::layout::Constraint> group = {
+      mid == (left + right) / 2.0,  //
+      right >= left + 100.0,        //
+  };
+
+  auto solve = [&](size_t warmStartCapacity) {
+    rl::layout::Solver solver(ns);
+    solver.setWarmStartCapacity(warmStartCapacity);
+    EXPECT_EQ(solver.addEditVariable(left, strong),
+              rl::layout::Result::Success);
+    EXPECT_EQ(solver.applySuggestion({left, 10.0, strong}),
+              rl::layout::Result::Success);
+
+    std::map<rl::core::Name, double> values;
+    std::vector<std::map<rl::core::Name, double>> solutions;
+    for (size_t i = 0; i < 3; i++) {
+      EXPECT_EQ(solver.addConstraints(group), rl::layout::Result::Success);
+      Flush(solver, values);
+      solutions.emplace_back(values);
+      EXPECT_EQ(solver.removeConstraints(group), rl::layout::Result::Success);
+      Flush(solver, values);
+      solutions.emplace_back(values);
+    }
+
+    /*
+     *  Changing the solver in between invalidates the cached tableau.
+     */
+    EXPECT_EQ(solver.applySuggestion({left, 20.0, strong}),
+              rl::layout::Result::Success);
+    EXPECT_EQ(solver.addConstraints(group), rl::layout::Result::Success);
+    Flush(solver, values);
+    solutions.emplace_back(values);
+    return solutions;
+  };
+
+  auto cold = solve(0);
+  auto warm = solve(4);
+
+  ASSERT_EQ(cold.size(), 7u);
+  ASSERT_EQ(cold, warm);
+  ASSERT_EQ(warm[2][two], 110.0);
+  ASSERT_EQ(warm[2][three], 60.0);
+  ASSERT_EQ(warm[6][two], 120.0);
+  ASSERT_EQ(warm[6][three], 70.0);
+}
+
+TEST(LayoutTest, RowInsertionKeepsCellsSorted) {
+  using Symbol = rl::layout::Symbol;
+
+  Symbol s1(Symbol::Type::External), s2(Symbol::Type::External),
+      s3(Symbol::Type::Slack), s4(Symbol::Type::Error);
+
+  rl::layout::Row row(1.0);
+  row.insertSymbol(s3, 2.0);
+  row.insertSymbol(s1, 1.0);
+
+  rl::layout::Row other(2.0);
+  other.insertSymbol(s4, 0.5);
+  other.insertSymbol(s1, -0.5);
+  other.insertSymbol(s2, 2.0);
+
+  /*
+   *  The first symbol cancels out.
+   */
+  row.insertRow(other, 2.0);
+
+  ASSERT_EQ(row.constant(), 5.0);
+  ASSERT_EQ(row.cells().size(), 3u);
+  ASSERT_EQ(row.cells()[0].symbol, s2);
+  ASSERT_EQ(row.cells()[0].coefficient, 4.0);
+  ASSERT_EQ(row.cells()[1].symbol, s3);
+  ASSERT_EQ(row.cells()[1].coefficient, 2.0);
+  ASSERT_EQ(row.cells()[2].symbol, s4);
+  ASSERT_EQ(row.cells()[2].coefficient, 1.0);
+
+  row.substitute(s3, other);
+  ASSERT_EQ(row.constant(), 9.0);
+  ASSERT_EQ(row.cells().size(), 3u);
+  ASSERT_EQ(row.cells()[0].symbol, s1);
+  ASSERT_EQ(row.cells()[0].coefficient, -1.0);
+  ASSERT_EQ(row.cells()[1].symbol, s2);
+  ASSERT_EQ(row.cells()[1].coefficient, 8.0);
+  ASSERT_EQ(row.cells()[2].symbol, s4);
+  ASSERT_EQ(row.cells()[2].coefficient, 2.0);
+}
+
+TEST(LayoutTest, SolverSolutionAfterRemovingConstraints) {
+  rl::core::Namespace ns;
+
+  const size_t count = 20;
+  rl::expr::Variable container(rl::core::Name{ns});
+  std::vector<rl::expr::Variable> tops, heights;
+  std::vector<std::vector<rl::layout::Constraint>> constraints;
+
+  for (size_t i = 0; i < count; i++) {
+    tops.emplace_back(rl::core::Name{ns});
+    heights.emplace_back(rl::core::Name{ns});
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    constraints.push_back({
+        i == 0 ? tops[i] == 0.0
+               : tops[i] == tops[i - 1] + heights[i - 1] + 8.0,  //
+        heights[i] >= 10.0,                                      //
+        (heights[i] == 44.0) | rl::layout::priority::Medium(),   //
+        tops[i] + heights[i] <= container,                       //
+    });
+  }
+
+  rl::layout::Solver solver(ns);
+  ASSERT_EQ(solver.addEditVariable(container, rl::layout::priority::Strong()),
+            rl::layout::Result::Success);
+  ASSERT_EQ(solver.suggestValueForVariable(container, 2000.0),
+            rl::layout::Result::Success);
+
+  for (const auto& itemConstraints : constraints) {
+    ASSERT_EQ(solver.addConstraints(itemConstraints),
+              rl::layout::Result::Success);
+  }
+
+  /*
+   *  Remove the constraints of every other item and add them back.
+   */
+  for (size_t i = 0; i < count; i += 2) {
+    ASSERT_EQ(solver.removeConstraints(constraints[i]),
+              rl::layout::Result::Success);
+  }
+
+  for (size_t i = 0; i < count; i += 2) {
+    ASSERT_EQ(solver.addConstraints(constraints[i]),
+              rl::layout::Result::Success);
+  }
+
+  std::map<rl::core::Name, double> updates;
+  auto flush = [&]() {
+    solver.flushUpdates([&](const rl::expr::Variable& var, double value) {
+      updates[var.identifier()] = value;
+      return rl::layout::Solver::FlushResult::Updated;
+    });
+  };
+
+  flush();
+  for (size_t i = 0; i < count; i++) {
+    ASSERT_DOUBLE_EQ(updates[tops[i].identifier()], i * 52.0);
+    ASSERT_DOUBLE_EQ(updates[heights[i].identifier()], 44.0);
+  }
+
+  /*
+   *  Shrinking the container squashes the items to their minimum height.
+   */
+  ASSERT_EQ(solver.suggestValueForVariable(container, count * 18.0 - 8.0),
+            rl::layout::Result::Success);
+
+  flush();
+  for (size_t i = 0; i < count; i++) {
+    ASSERT_DOUBLE_EQ(updates[tops[i].identifier()], i * 18.0);
+    ASSERT_DOUBLE_EQ(updates[heights[i].identifier()], 10.0);
+  }
+}
+
 TEST(LayoutTest, VariableCreationViaOverloading) {
   rl::core::Namespace ns;
 
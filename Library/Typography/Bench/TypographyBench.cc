@@ -0,0 +1,263 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <BenchmarkRunner/BenchmarkRunner.h>
+#include <Core/Latch.h>
+#include <Typography/AttributedStringBuilder.h>
+#include <Typography/ShapedTextRun.h>
+#include <Typography/TypeFrame.h>
+#include <Typography/Typesetter.h>
+#include <Typography/TypographyContext.h>
+#include <random>
+#include "WordRuns.h"
+
+static const size_t kDocumentWords = 10000;
+
+/**
+ *  A document of words picked from a small vocabulary with a skewed
+ *  distribution, like words in natural text.
+ */
+static std::string DocumentText() {
+  static const char* const kVocabulary[] = {
+      "the",         "of",         "and",        "to",         "in",
+      "is",          "that",       "for",        "it",         "as",
+      "with",        "was",        "on",         "be",         "by",
+      "at",          "this",       "from",       "or",         "an",
+      "layout",      "entity",     "interface",  "animation",  "texture",
+      "transaction", "compositor", "constraint", "typography", "paragraph",
+      "glyph",       "shaping",    "rendering",  "performance", "coordinator",
+  };
+
+  const size_t vocabularySize = sizeof(kVocabulary) / sizeof(kVocabulary[0]);
+
+  std::mt19937 generator(42);
+  std::geometric_distribution<size_t> distribution(0.15);
+
+  std::string text;
+  for (size_t i = 0; i < kDocumentWords; i++) {
+    text += kVocabulary[distribution(generator) % vocabularySize];
+    text += i % 12 == 11 ? ". " : " ";
+  }
+  return text;
+}
+
+enum class CacheState {
+  /*
+   *  Every run is shaped.
+   */
+  Disabled,
+  /*
+   *  The cache starts out empty. Only the first occurrence of each word is
+   *  shaped.
+   */
+  Cold,
+  /*
+   *  All words are already in the cache.
+   */
+  Warm,
+};
+
+static void ShapeDocument(benchmark::State& state, CacheState cacheState) {
+  rl::type::FontLibrary library;
+  RL_ASSERT(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const auto text = DocumentText();
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0}).appendText(text);
+  auto document = builder.attributedString();
+  auto runs = rl::type::testing::WordRuns(document, text);
+  RL_ASSERT(runs.runs().size() == kDocumentWords);
+
+  auto& cache = rl::type::TypographyContext::SharedContext().shapingCache();
+  const auto byteBudget = cache.byteBudget();
+  cache.purge();
+  if (cacheState == CacheState::Disabled) {
+    cache.setByteBudget(0);
+  }
+
+  while (state.KeepRunning()) {
+    if (cacheState == CacheState::Cold) {
+      state.PauseTiming();
+      cache.purge();
+      state.ResumeTiming();
+    }
+
+    for (const auto& run : runs.runs()) {
+      rl::type::ShapedTextRun shaped(document.string(), run, library);
+      RL_ASSERT(shaped.isValid());
+      benchmark::DoNotOptimize(shaped.glyphCount());
+    }
+  }
+
+  cache.setByteBudget(byteBudget);
+
+  state.SetItemsProcessed(state.iterations() * kDocumentWords);
+}
+
+static void BenchShapeDocumentUncached(benchmark::State& state) {
+  ShapeDocument(state, CacheState::Disabled);
+}
+
+static void BenchShapeDocumentCold(benchmark::State& state) {
+  ShapeDocument(state, CacheState::Cold);
+}
+
+static void BenchShapeDocumentWarm(benchmark::State& state) {
+  ShapeDocument(state, CacheState::Warm);
+}
+
+BENCHMARK(BenchShapeDocumentUncached)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchShapeDocumentCold)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchShapeDocumentWarm)->Unit(benchmark::kMillisecond);
+
+/**
+ *  Shape the words of the document with the cache disabled, splitting them
+ *  between the workers of a work queue and the calling thread. Unlike the
+ *  typesetter benchmarks, this does not need the ICU data file.
+ */
+static void BenchShapeDocumentUncachedConcurrent(benchmark::State& state) {
+  rl::type::FontLibrary library;
+  RL_ASSERT(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const auto text = DocumentText();
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0}).appendText(text);
+  auto document = builder.attributedString();
+  auto runs = rl::type::testing::WordRuns(document, text);
+  const auto& words = runs.runs();
+  RL_ASSERT(words.size() == kDocumentWords);
+
+  auto& cache = rl::type::TypographyContext::SharedContext().shapingCache();
+  const auto byteBudget = cache.byteBudget();
+  cache.purge();
+  cache.setByteBudget(0);
+
+  rl::core::WorkQueue workQueue(rl::core::WorkQueue::Mode::WorkStealing);
+  const size_t chunkCount = workQueue.workerCount() + 1;
+
+  auto shapeChunk = [&](size_t chunk) {
+    const size_t first = words.size() * chunk / chunkCount;
+    const size_t last = words.size() * (chunk + 1) / chunkCount;
+    for (size_t i = first; i < last; i++) {
+      rl::type::ShapedTextRun shaped(document.string(), words[i], library);
+      RL_ASSERT(shaped.isValid());
+      benchmark::DoNotOptimize(shaped.glyphCount());
+    }
+  };
+
+  while (state.KeepRunning()) {
+    rl::core::Latch latch(chunkCount - 1);
+    for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+      RL_ASSERT(workQueue.dispatch([chunk, &shapeChunk, &latch]() {
+        shapeChunk(chunk);
+        latch.countDown();
+      }));
+    }
+    shapeChunk(0);
+    latch.wait();
+  }
+
+  cache.setByteBudget(byteBudget);
+
+  state.SetItemsProcessed(state.iterations() * kDocumentWords);
+}
+
+BENCHMARK(BenchShapeDocumentUncachedConcurrent)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static const size_t kLayoutWidths = 100;
+
+/**
+ *  Lay out the shaped document at many widths like a window being resized.
+ *  The runs are shaped once up front.
+ */
+static void LayoutDocument(
+    benchmark::State& state,
+    rl::type::ParagraphStyle::LineBreakStrategy strategy) {
+  rl::type::FontLibrary library;
+  RL_ASSERT(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const auto text = DocumentText();
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0}).appendText(text);
+  auto document = builder.attributedString();
+  auto runs = rl::type::testing::WordRuns(document, text);
+
+  std::vector<rl::type::ShapedTextRun> shaped;
+  for (const auto& run : runs.runs()) {
+    shaped.emplace_back(document.string(), run, library);
+  }
+
+  const rl::type::ParagraphStyle style(
+      rl::type::ParagraphStyle::Alignment::Justified, strategy);
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kLayoutWidths; i++) {
+      rl::type::TypeFrame frame(shaped, style, 200.0 + i * 8.0);
+      RL_ASSERT(frame.isValid());
+      benchmark::DoNotOptimize(frame.lines().size());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kLayoutWidths);
+}
+
+static void BenchLayoutDocumentGreedy(benchmark::State& state) {
+  LayoutDocument(state, rl::type::ParagraphStyle::LineBreakStrategy::Greedy);
+}
+
+static void BenchLayoutDocumentOptimal(benchmark::State& state) {
+  LayoutDocument(state, rl::type::ParagraphStyle::LineBreakStrategy::Optimal);
+}
+
+BENCHMARK(BenchLayoutDocumentGreedy)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchLayoutDocumentOptimal)->Unit(benchmark::kMillisecond);
+
+/**
+ *  Shape the whole document through the typesetter with the cache disabled,
+ *  optionally spreading the runs over a work queue.
+ */
+static void TypesetDocument(benchmark::State& state,
+                            rl::core::WorkQueue* workQueue) {
+  rl::type::FontLibrary library;
+  RL_ASSERT(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0})
+      .appendText(DocumentText());
+  rl::type::Typesetter typesetter(builder.attributedString());
+  if (!typesetter.isValid()) {
+    state.SkipWithError("The typesetter needs the ICU data file.");
+    return;
+  }
+
+  auto& cache = rl::type::TypographyContext::SharedContext().shapingCache();
+  const auto byteBudget = cache.byteBudget();
+  cache.setByteBudget(0);
+
+  while (state.KeepRunning()) {
+    auto shaped = typesetter.createShapedRuns(library, workQueue);
+    RL_ASSERT(shaped.size() == typesetter.runs().runs().size());
+    benchmark::DoNotOptimize(shaped.data());
+  }
+
+  cache.setByteBudget(byteBudget);
+
+  state.SetItemsProcessed(state.iterations() *
+                          typesetter.runs().runs().size());
+}
+
+static void BenchTypesetDocumentSerial(benchmark::State& state) {
+  TypesetDocument(state, nullptr);
+}
+
+static void BenchTypesetDocumentConcurrent(benchmark::State& state) {
+  rl::core::WorkQueue workQueue(rl::core::WorkQueue::Mode::WorkStealing);
+  TypesetDocument(state, &workQueue);
+}
+
+BENCHMARK(BenchTypesetDocumentSerial)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchTypesetDocumentConcurrent)->Unit(benchmark::kMillisecond);
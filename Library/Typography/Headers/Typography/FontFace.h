@@ -26,8 +26,20 @@ class FontFace {
 
   hb_face_t* handle() const;
 
+  /**
+   *  @return the path on the filesystem of the font file backing the face
+   */
+  const std::string& filePath() const;
+
+  /**
+   *  @return the index of the face in its font file
+   */
+  size_t index() const;
+
  private:
   HBRef<hb_face_t> _face;
+  std::string _filePath;
+  size_t _index;
 
   RL_DISALLOW_COPY_AND_ASSIGN(FontFace);
 };
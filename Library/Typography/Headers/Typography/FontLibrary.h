@@ -6,12 +6,15 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Core/Mutex.h>
 #include <Core/URI.h>
 #include <Typography/Font.h>
 #include <Typography/FontDescriptor.h>
 #include <Typography/FontFace.h>
 #include <map>
 #include <memory>
+#include <thread>
+#include <tuple>
 
 namespace rl {
 namespace type {
@@ -26,6 +29,19 @@ class FontLibrary {
 
   Font fontForDescriptor(const FontDescriptor& descriptor) const;
 
+  /**
+   *  Fonts may not be used on multiple threads at once. Each thread that asks
+   *  for a descriptor gets its own font, created on first use and owned by the
+   *  library after that.
+   *
+   *  @param descriptor the descriptor of the font.
+   *
+   *  @return the font of the calling thread for the descriptor or null if no
+   *          registered font matches the descriptor. The font lives as long as
+   *          the library.
+   */
+  const Font* fontForDescriptorOnThread(const FontDescriptor& descriptor) const;
+
   const FontFace* faceForDescriptor(const FontDescriptor& descriptor) const;
 
   bool registerFont(const core::URI& fontFileName, size_t index);
@@ -33,7 +49,12 @@ class FontLibrary {
   size_t registeredFonts() const;
 
  private:
+  using ThreadFontKey = std::tuple<std::thread::id, std::string, double>;
+
   std::map<std::string, std::unique_ptr<FontFace>> _registeredFonts;
+  mutable core::Mutex _threadFontsLock;
+  mutable std::map<ThreadFontKey, std::unique_ptr<Font>> _threadFonts
+      RL_GUARDED_BY(_threadFontsLock);
 
   RL_DISALLOW_COPY_AND_ASSIGN(FontLibrary);
 };
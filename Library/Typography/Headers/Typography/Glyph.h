@@ -6,18 +6,35 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Geometry/Rect.h>
 
 namespace rl {
 namespace type {
 
+/**
+ *  A glyph of a run placed in a glyph atlas.
+ */
 class Glyph {
  public:
   Glyph();
 
+  /**
+   *  @param bounds      the bounds of the glyph in the coordinate space of its
+   *                     run in pixels
+   *  @param atlasBounds the bounds of the coverage of the glyph in its atlas
+   *                     in pixels
+   */
+  Glyph(const geom::Rect& bounds, const geom::Rect& atlasBounds);
+
   ~Glyph();
 
+  const geom::Rect& bounds() const;
+
+  const geom::Rect& atlasBounds() const;
+
  private:
-  RL_DISALLOW_COPY_AND_ASSIGN(Glyph);
+  geom::Rect _bounds;
+  geom::Rect _atlasBounds;
 };
 
 }  // namespace type
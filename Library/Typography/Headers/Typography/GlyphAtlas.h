@@ -0,0 +1,175 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Geometry/Rect.h>
+#include <Geometry/Size.h>
+#include <Image/ImageResult.h>
+#include <Typography/Glyph.h>
+#include <Typography/GlyphRun.h>
+#include <Typography/Types.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace rl {
+namespace type {
+
+/**
+ *  Rasterizes the glyphs of runs into a single greyscale coverage image so
+ *  that all text may be drawn by sampling from one texture.
+ *
+ *  Glyphs are packed into shelves. A shelf is a row of the atlas as tall as
+ *  the glyphs in it. When the atlas is full, all glyphs in the least recently
+ *  used shelf are evicted to make room.
+ *
+ *  Glyphs are rasterized at a fraction of a pixel offset from the pixel grid
+ *  so that text spaced at fractional advances keeps its spacing. The offsets
+ *  are bucketed to bound the number of copies of each glyph.
+ *
+ *  The atlas must be used on a single thread.
+ */
+class GlyphAtlas {
+ public:
+  /**
+   *  The number of horizontal offsets each glyph may be rasterized at.
+   */
+  static const size_t SubpixelPositions;
+
+  /**
+   *  A snapshot of the effectiveness of the atlas.
+   */
+  struct Statistics {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t shelves;
+
+    Statistics()
+        : hits(0), misses(0), evictions(0), entries(0), shelves(0) {}
+  };
+
+  /**
+   *  Create an empty atlas.
+   *
+   *  @param size the size of the atlas in pixels
+   */
+  GlyphAtlas(const geom::Size& size);
+
+  ~GlyphAtlas();
+
+  bool isValid() const;
+
+  const geom::Size& size() const;
+
+  /**
+   *  Start a new pass over the runs to draw (usually a frame). Glyphs placed
+   *  for runs since the start of the current pass are never evicted to make
+   *  room for others. So all runs placed in a pass may be drawn together.
+   */
+  void beginPass();
+
+  /**
+   *  Find the glyphs of the run in the atlas, rasterizing the ones that are
+   *  not already in it. Glyphs that cover no pixels (like spaces) are
+   *  skipped.
+   *
+   *  @param run    the run to place
+   *  @param glyphs the vector to append the glyphs of the run to
+   *
+   *  @return if all glyphs of the run could be placed in the atlas
+   */
+  RL_WARN_UNUSED_RESULT
+  bool placeRun(const GlyphRun& run, std::vector<Glyph>& glyphs);
+
+  /**
+   *  @return the greyscale coverage of all glyphs in the atlas
+   */
+  const image::ImageResult& image() const;
+
+  /**
+   *  @return the area of the image changed since damage was last cleared
+   */
+  const geom::Rect& damage() const;
+
+  void clearDamage();
+
+  /**
+   *  Evict all glyphs. The counts are preserved.
+   */
+  void purge();
+
+  /**
+   *  @return a snapshot of the statistics of the atlas
+   */
+  Statistics statistics() const;
+
+ private:
+  class Rasterizer;
+
+  struct Key {
+    size_t face;
+    int32_t size;
+    Codepoint glyph;
+    size_t subpixel;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    /*
+     *  The shelf containing the glyph. Glyphs without coverage are in none.
+     */
+    size_t shelf;
+    geom::Rect atlasBounds;
+    /*
+     *  The offset of the top left of the coverage from the glyph origin.
+     */
+    geom::Point bearing;
+  };
+
+  struct Shelf {
+    size_t top;
+    size_t height;
+    size_t cursor;
+    size_t lastUsed;
+    std::vector<Key> keys;
+  };
+
+  std::unique_ptr<Rasterizer> _rasterizer;
+  geom::Size _size;
+  image::ImageResult _image;
+  geom::Rect _damage;
+  std::unordered_map<Key, Entry, KeyHash> _entries;
+  std::vector<Shelf> _shelves;
+  size_t _shelvesHeight;
+  size_t _clock;
+  size_t _passStart;
+  size_t _hits;
+  size_t _misses;
+  size_t _evictions;
+
+  bool findOrPlaceGlyph(const Key& key, Entry& entry);
+
+  bool allocate(size_t width, size_t height, size_t& shelf, size_t& left);
+
+  void evictShelf(size_t shelf);
+
+  void clearPixels(const geom::Rect& rect);
+
+  void addDamage(const geom::Rect& rect);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(GlyphAtlas);
+};
+
+}  // namespace type
+}  // namespace rl
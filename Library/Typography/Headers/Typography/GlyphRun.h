@@ -6,17 +6,90 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Geometry/Point.h>
+#include <Geometry/Size.h>
+#include <Typography/FontDescriptor.h>
+#include <Typography/FontLibrary.h>
+#include <Typography/String.h>
+#include <Typography/TextRun.h>
+#include <Typography/Types.h>
+#include <string>
+#include <vector>
 
 namespace rl {
 namespace type {
 
+/**
+ *  The glyphs of a shaped run positioned in pixels. Unlike the fonts it was
+ *  shaped with, a glyph run only refers to its font by the file backing it.
+ *  So it may be handed to other threads to be rasterized and drawn there.
+ */
 class GlyphRun {
  public:
+  struct Position {
+    Codepoint glyph;
+    /*
+     *  The origin of the glyph on the baseline in the coordinate space of the
+     *  run. The top left of the run is the origin and y grows downwards.
+     */
+    geom::Point origin;
+  };
+
   GlyphRun();
 
+  /**
+   *  Shape the run of the string and position its glyphs.
+   *
+   *  @param string  the string containing the run
+   *  @param run     the run to shape
+   *  @param library the library to resolve the font of the run in
+   */
+  GlyphRun(const String& string,
+           const TextRun& run,
+           const FontLibrary& library);
+
+  GlyphRun(GlyphRun&&);
+
+  GlyphRun& operator=(GlyphRun&&);
+
   ~GlyphRun();
 
+  bool isValid() const;
+
+  const FontDescriptor& descriptor() const;
+
+  /**
+   *  @return the path of the font file the run was shaped with
+   */
+  const std::string& fontFilePath() const;
+
+  /**
+   *  @return the index of the face in the font file
+   */
+  size_t fontIndex() const;
+
+  const std::vector<Position>& positions() const;
+
+  /**
+   *  @return the distance from the top of the run to the baseline
+   */
+  double ascent() const;
+
+  /**
+   *  @return the advance of the run and the distance from the top of the run
+   *          to the lowest descender of its font
+   */
+  geom::Size size() const;
+
  private:
+  FontDescriptor _descriptor;
+  std::string _fontFilePath;
+  size_t _fontIndex;
+  std::vector<Position> _positions;
+  double _ascent;
+  geom::Size _size;
+  bool _valid;
+
   RL_DISALLOW_COPY_AND_ASSIGN(GlyphRun);
 };
 
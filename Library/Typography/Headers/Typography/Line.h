@@ -6,18 +6,68 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Geometry/Rect.h>
+#include <Typography/Types.h>
 
 namespace rl {
 namespace type {
 
+/**
+ *  A line of a type frame. Lines refer to the shaped runs the frame was laid
+ *  out from by index.
+ */
 class Line {
  public:
   Line();
 
+  /**
+   *  @param firstRun   the index of the first run on the line
+   *  @param runCount   the number of runs on the line
+   *  @param range      the range of the string covered by the runs
+   *  @param bounds     the bounds of the line in the frame. Whitespace hanging
+   *                    past the end of the line is not included.
+   *  @param ascent     the distance from the top of the line to its baseline
+   *  @param descent    the distance from the baseline to the bottom of the
+   *                    line
+   *  @param runSpacing the space added between runs to justify the line
+   */
+  Line(size_t firstRun,
+       size_t runCount,
+       TextRange range,
+       const geom::Rect& bounds,
+       double ascent,
+       double descent,
+       double runSpacing);
+
   ~Line();
 
+  size_t firstRun() const;
+
+  size_t runCount() const;
+
+  TextRange range() const;
+
+  const geom::Rect& bounds() const;
+
+  /**
+   *  @return the vertical position of the baseline in the frame
+   */
+  double baseline() const;
+
+  double ascent() const;
+
+  double descent() const;
+
+  double runSpacing() const;
+
  private:
-  RL_DISALLOW_COPY_AND_ASSIGN(Line);
+  size_t _firstRun;
+  size_t _runCount;
+  TextRange _range;
+  geom::Rect _bounds;
+  double _ascent;
+  double _descent;
+  double _runSpacing;
 };
 
 }  // namespace type
@@ -12,12 +12,51 @@ namespace type {
 
 class ParagraphStyle {
  public:
+  enum class Alignment {
+    Left,
+    Right,
+    Center,
+    /*
+     *  Lines are stretched to the width of the frame by widening the gaps
+     *  between their runs. The last line of a paragraph is left aligned.
+     */
+    Justified,
+  };
+
+  enum class LineBreakStrategy {
+    /*
+     *  Fit as many runs on each line as possible. Fast, but may leave lines
+     *  much shorter than the ones around them.
+     */
+    Greedy,
+    /*
+     *  Pick the breaks that minimize the unevenness of the lines of the whole
+     *  paragraph (Knuth and Plass).
+     */
+    Optimal,
+  };
+
   ParagraphStyle();
 
+  ParagraphStyle(Alignment alignment,
+                 LineBreakStrategy lineBreakStrategy,
+                 double lineHeightMultiple = 1.0);
+
   ~ParagraphStyle();
 
+  Alignment alignment() const;
+
+  LineBreakStrategy lineBreakStrategy() const;
+
+  /**
+   *  @return the factor the natural height of each line is scaled by
+   */
+  double lineHeightMultiple() const;
+
  private:
-  RL_DISALLOW_COPY_AND_ASSIGN(ParagraphStyle);
+  Alignment _alignment;
+  LineBreakStrategy _lineBreakStrategy;
+  double _lineHeightMultiple;
 };
 
 }  // namespace type
@@ -10,6 +10,7 @@
 #include <Typography/AttributedString.h>
 #include <Typography/Font.h>
 #include <Typography/FontLibrary.h>
+#include <Typography/ShapingCache.h>
 #include <Typography/TextRun.h>
 #include <Typography/Types.h>
 
@@ -20,6 +21,16 @@ class ShapedTextRun {
  public:
   ShapedTextRun();
 
+  /**
+   *  Shape the run of the string. Runs already shaped with the same text,
+   *  font descriptor and direction are looked up in the shaping cache of the
+   *  typography context instead. The metrics used to lay the run out in
+   *  lines are measured once here.
+   *
+   *  @param string  the string containing the run
+   *  @param run     the run to shape
+   *  @param library the library to resolve the font of the run in
+   */
   ShapedTextRun(const String& string,
                 const TextRun& run,
                 const FontLibrary& library);
@@ -34,10 +45,43 @@ class ShapedTextRun {
 
   size_t glyphCount() const;
 
+  /**
+   *  @return the range of the string the run was shaped from
+   */
+  TextRange range() const;
+
+  /**
+   *  @return the horizontal advance of the run in pixels
+   */
+  double advance() const;
+
+  /**
+   *  @return the advance of the whitespace at the end of the run. It hangs
+   *          past the edge of a line when the run ends the line.
+   */
+  double trailingWhitespaceAdvance() const;
+
+  /**
+   *  @return the extent of the font of the run above the baseline
+   */
+  double ascent() const;
+
+  /**
+   *  @return the extent of the font of the run below the baseline
+   */
+  double descent() const;
+
+  /**
+   *  @return if the run ends with a character that forces a line break
+   */
+  bool endsWithMandatoryBreak() const;
+
  private:
-  HBRef<hb_buffer_t> _buffer = {nullptr, HBRefDeleterNull};
-  Font _font;
-  bool _valid = false;
+  ShapingCache::Glyphs _glyphs;
+  TextRange _range;
+  double _advance = 0.0;
+  double _trailingWhitespaceAdvance = 0.0;
+  bool _endsWithMandatoryBreak = false;
 
   RL_DISALLOW_COPY_AND_ASSIGN(ShapedTextRun);
 };
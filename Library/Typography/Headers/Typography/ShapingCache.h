@@ -0,0 +1,163 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Core/Macros.h>
+#include <Core/Mutex.h>
+#include <Typography/FontDescriptor.h>
+#include <Typography/FontLibrary.h>
+#include <Typography/String.h>
+#include <Typography/TextRun.h>
+#include <Typography/Types.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rl {
+namespace type {
+
+/**
+ *  The glyphs of a shaped run of text. Positions are in 26.6 fixed point pixels
+ *  at the size of the font the run was shaped with. Clusters are relative to
+ *  the start of the run.
+ */
+struct ShapedGlyphs {
+  std::vector<Codepoint> glyphs;
+  std::vector<uint32_t> clusters;
+  std::vector<int32_t> xAdvances;
+  std::vector<int32_t> yAdvances;
+  std::vector<int32_t> xOffsets;
+  std::vector<int32_t> yOffsets;
+  /*
+   *  The extents of the font above and below the baseline. The descender is
+   *  negative below the baseline.
+   */
+  int32_t ascender = 0;
+  int32_t descender = 0;
+
+  size_t size() const { return glyphs.size(); }
+};
+
+/**
+ *  A cache of shaped runs of text. Runs are usually single words since the
+ *  typesetter splits runs at line break opportunities, so the same runs are
+ *  shaped over and over when labels re-layout or repeat.
+ *
+ *  Runs are keyed on their text, font descriptor and direction. Shaping may
+ *  depend on the text surrounding a run. Only the first occurrence of a run
+ *  is shaped in its context. Later occurrences reuse that result.
+ *
+ *  The cache is bounded by the memory held by its entries. The least recently
+ *  used runs are evicted first.
+ *
+ *  The cache may be used on any thread.
+ */
+class ShapingCache {
+ public:
+  using Glyphs = std::shared_ptr<const ShapedGlyphs>;
+
+  /**
+   *  A snapshot of the effectiveness of the cache.
+   */
+  struct Statistics {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+
+    Statistics() : hits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+  };
+
+  static const size_t DefaultByteBudget;
+
+  /**
+   *  Create a cache bounded by the given size of memory held by its entries.
+   *
+   *  @param byteBudget the maximum size of memory held by the cache
+   */
+  ShapingCache(size_t byteBudget);
+
+  ~ShapingCache();
+
+  /**
+   *  Find the shaped run or shape it on the calling thread and cache the
+   *  result.
+   *
+   *  @param string  the string containing the run
+   *  @param run     the run to shape
+   *  @param library the library to resolve the font of the run in
+   *
+   *  @return the shaped run. Null if the run could not be shaped.
+   */
+  Glyphs shape(const String& string,
+               const TextRun& run,
+               const FontLibrary& library);
+
+  size_t byteBudget() const;
+
+  /**
+   *  Update the size of memory held by the cache. Evicts runs immediately if
+   *  the cache is over the new budget.
+   *
+   *  @param byteBudget the new budget
+   */
+  void setByteBudget(size_t byteBudget);
+
+  /**
+   *  Evict all runs. The counts are preserved.
+   */
+  void purge();
+
+  /**
+   *  @return a snapshot of the statistics of the cache
+   */
+  Statistics statistics() const;
+
+ private:
+  struct Key {
+    std::u16string text;
+    FontDescriptor descriptor;
+    TextRun::Direction direction;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry;
+  using EntryList = std::list<Entry>;
+  using EntryMap = std::unordered_map<Key, EntryList::iterator, KeyHash>;
+
+  struct Entry {
+    EntryMap::const_iterator mapEntry;
+    Glyphs glyphs;
+    size_t bytes;
+  };
+
+  mutable core::Mutex _lock;
+  size_t _byteBudget RL_GUARDED_BY(_lock);
+  size_t _bytes RL_GUARDED_BY(_lock);
+  size_t _hits RL_GUARDED_BY(_lock);
+  size_t _misses RL_GUARDED_BY(_lock);
+  size_t _evictions RL_GUARDED_BY(_lock);
+  /*
+   *  Ordered from most to least recently used.
+   */
+  EntryList _entries RL_GUARDED_BY(_lock);
+  EntryMap _map RL_GUARDED_BY(_lock);
+
+  void evictIfNecessary() RL_REQUIRES(_lock);
+
+  RL_DISALLOW_COPY_AND_ASSIGN(ShapingCache);
+};
+
+}  // namespace type
+}  // namespace rl
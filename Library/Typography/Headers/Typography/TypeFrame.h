@@ -6,21 +6,77 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Geometry/Point.h>
+#include <Geometry/Size.h>
+#include <Typography/Line.h>
+#include <Typography/ParagraphStyle.h>
+#include <Typography/ShapedTextRun.h>
+#include <vector>
 
 namespace rl {
 namespace type {
 
+/**
+ *  Shaped runs laid out in lines that fit a width. Runs are never broken, so
+ *  they must already be split at line break opportunities (like the runs of
+ *  the typesetter).
+ *
+ *  Laying out the same runs at another width only picks new line boundaries
+ *  from the metrics measured when the runs were shaped. Nothing is reshaped.
+ */
 class TypeFrame {
  public:
   TypeFrame();
 
+  /**
+   *  Lay out the runs in lines.
+   *
+   *  @param runs  the shaped runs of the text in logical order
+   *  @param style the style of the paragraphs of the text
+   *  @param width the width to fit lines in. Runs wider than it are placed on
+   *               lines of their own.
+   */
+  TypeFrame(const std::vector<ShapedTextRun>& runs,
+            const ParagraphStyle& style,
+            double width);
+
   TypeFrame(TypeFrame&&);
 
+  TypeFrame& operator=(TypeFrame&&);
+
   ~TypeFrame();
 
   bool isValid() const;
 
+  const std::vector<Line>& lines() const;
+
+  /**
+   *  @return the size of the area covered by the lines of the frame
+   */
+  geom::Size size() const;
+
+  /**
+   *  Find the line at a point in the frame in logarithmic time. Points above
+   *  or below all lines resolve to the first or last line.
+   *
+   *  @param point the point in the coordinate space of the frame
+   *
+   *  @return the index of the line. The line count if there are no lines.
+   */
+  size_t lineIndexForPoint(const geom::Point& point) const;
+
+  /**
+   *  Find the line containing an index into the string in logarithmic time.
+   *
+   *  @param index the index into the string the runs were shaped from
+   *
+   *  @return the index of the line. The line count if there are no lines.
+   */
+  size_t lineIndexForTextIndex(size_t index) const;
+
  private:
+  std::vector<Line> _lines;
+  geom::Size _size;
   bool _valid;
 
   RL_DISALLOW_COPY_AND_ASSIGN(TypeFrame);
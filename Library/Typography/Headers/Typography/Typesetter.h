@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Core/Macros.h>
+#include <Core/WorkQueue.h>
 #include <Geometry/Size.h>
 #include <Typography/AttributedString.h>
 #include <Typography/FontLibrary.h>
@@ -27,6 +28,21 @@ class Typesetter {
 
   std::vector<ShapedTextRun> createShapedRuns(const FontLibrary& library) const;
 
+  /**
+   *  Shape the runs in chunks concurrently on the work queue and the calling
+   *  thread. The shaped runs are in the same order as the runs and identical
+   *  to the ones shaped on a single thread.
+   *
+   *  @param library   the library to resolve the fonts of the runs from. It
+   *                   must not be modified while runs are being shaped.
+   *  @param workQueue the work queue to shape runs on. If null, runs are
+   *                   shaped on the calling thread.
+   *
+   *  @return the shaped runs. Empty if any run could not be shaped.
+   */
+  std::vector<ShapedTextRun> createShapedRuns(const FontLibrary& library,
+                                              core::WorkQueue* workQueue) const;
+
   const TextRuns& runs() const;
 
  private:
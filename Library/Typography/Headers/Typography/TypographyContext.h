@@ -7,6 +7,7 @@
 
 #include <Core/FileMapping.h>
 #include <Core/Macros.h>
+#include <Typography/ShapingCache.h>
 #include <Typography/Types.h>
 #include <atomic>
 
@@ -21,9 +22,22 @@ class TypographyContext {
 
   icu::BreakIterator* breakIteratorForThread();
 
+  /**
+   *  @return the buffer runs are shaped in on the calling thread. It is
+   *          reused for all runs shaped on the thread so that its storage
+   *          is only allocated once.
+   */
+  hb_buffer_t* shapingBufferForThread();
+
+  /**
+   *  @return the cache of shaped runs shared by all typesetters in the process
+   */
+  ShapingCache& shapingCache();
+
  private:
   core::FileMapping _icuDataMapping;
   std::atomic_bool _valid;
+  ShapingCache _shapingCache;
 
   TypographyContext();
 
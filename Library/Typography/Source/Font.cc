@@ -3,12 +3,29 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <Core/Mutex.h>
 #include <Typography/Font.h>
 #include <Typography/FontFace.h>
+#include <cmath>
 
 namespace rl {
 namespace type {
 
+/*
+ *  Each font opens its own FreeType face from the data of the font face. Those
+ *  faces come from a FreeType library shared by the process that may not open
+ *  or close faces on multiple threads at once.
+ */
+static core::Mutex& FreeTypeFacesMutex() {
+  static core::Mutex gMutex;
+  return gMutex;
+}
+
+static void DestroyFont(hb_font_t* font) {
+  core::MutexLocker lock(FreeTypeFacesMutex());
+  hb_font_destroy(font);
+}
+
 Font::Font() = default;
 
 Font::Font(const FontFace& fontFace, double size) {
@@ -16,13 +33,21 @@ Font::Font(const FontFace& fontFace, double size) {
     return;
   }
 
-  HBRef<hb_font_t> font(hb_font_create(fontFace.handle()), hb_font_destroy);
+  core::MutexLocker lock(FreeTypeFacesMutex());
+
+  HBRef<hb_font_t> font(hb_font_create(fontFace.handle()), DestroyFont);
 
   if (font == nullptr) {
     return;
   }
 
-  hb_font_set_scale(font.get(), size, size);
+  /*
+   *  The scale is also the character size of the FreeType face backing the
+   *  font. Scaling by the 26.6 fixed point unit makes the face rasterize at
+   *  the requested pixel size and positions come out in 26.6 pixels.
+   */
+  const int scale = static_cast<int>(std::round(size * 64.0));
+  hb_font_set_scale(font.get(), scale, scale);
 
   hb_ft_font_set_funcs(font.get());
 
@@ -60,7 +85,7 @@ double Font::size() const {
   if (_handle != nullptr) {
     hb_font_get_scale(_handle.get(), &xScale, nullptr);
   }
-  return xScale;
+  return xScale / 64.0;
 }
 
 hb_font_t* Font::handle() const {
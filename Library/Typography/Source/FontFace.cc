@@ -20,18 +20,26 @@ static HBRef<hb_blob_t> CreateFontFileBlob(const core::URI& uri) {
     delete reinterpret_cast<core::FileMapping*>(userData);
   };
 
-  return {
-      hb_blob_create(reinterpret_cast<const char*>(mapping->mapping()),  // data
-                     mapping->size(),          // length
-                     HB_MEMORY_MODE_READONLY,  // memory mode
-                     mapping.release(),        // user data
-                     onBlobDelete              // destroy func
-                     ),
-      hb_blob_destroy};
+  /*
+   *  The order in which arguments are evaluated is unspecified. Read the
+   *  mapping before ownership of it is handed to the blob.
+   */
+  const auto data = reinterpret_cast<const char*>(mapping->mapping());
+  const auto size = mapping->size();
+
+  return {hb_blob_create(data,                     // data
+                         size,                     // length
+                         HB_MEMORY_MODE_READONLY,  // memory mode
+                         mapping.release(),        // user data
+                         onBlobDelete              // destroy func
+                         ),
+          hb_blob_destroy};
 }
 
 FontFace::FontFace(const core::URI& uri, size_t index)
-    : _face(nullptr, hb_face_destroy) {
+    : _face(nullptr, hb_face_destroy),
+      _filePath(uri.filesystemRepresentation()),
+      _index(index) {
   auto blob = CreateFontFileBlob(uri);
 
   if (blob == nullptr) {
@@ -61,5 +69,13 @@ size_t FontFace::glyphCount() const {
   return _face != nullptr ? hb_face_get_glyph_count(_face.get()) : 0;
 }
 
+const std::string& FontFace::filePath() const {
+  return _filePath;
+}
+
+size_t FontFace::index() const {
+  return _index;
+}
+
 }  // namespace type
 }  // namespace rl
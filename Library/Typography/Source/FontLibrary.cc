@@ -64,6 +64,34 @@ Font FontLibrary::fontForDescriptor(const FontDescriptor& descriptor) const {
   return Font{*face, descriptor.pointSize()};
 }
 
+const Font* FontLibrary::fontForDescriptorOnThread(
+    const FontDescriptor& descriptor) const {
+  ThreadFontKey key(std::this_thread::get_id(), descriptor.postscriptName(),
+                    descriptor.pointSize());
+
+  {
+    core::MutexLocker lock(_threadFontsLock);
+    auto found = _threadFonts.find(key);
+    if (found != _threadFonts.end()) {
+      return found->second.get();
+    }
+  }
+
+  /*
+   *  Only the calling thread inserts fonts for its own keys. So the font can
+   *  be created outside the lock without another thread racing to insert it.
+   */
+  auto font = std::make_unique<Font>(fontForDescriptor(descriptor));
+  if (!font->isValid()) {
+    return nullptr;
+  }
+
+  const Font* result = font.get();
+  core::MutexLocker lock(_threadFontsLock);
+  _threadFonts[std::move(key)] = std::move(font);
+  return result;
+}
+
 const FontFace* FontLibrary::faceForDescriptor(
     const FontDescriptor& descriptor) const {
   if (descriptor.pointSize() <= 0.0) {
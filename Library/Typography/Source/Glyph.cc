@@ -8,7 +8,20 @@
 namespace rl {
 namespace type {
 
-//
+Glyph::Glyph() = default;
+
+Glyph::Glyph(const geom::Rect& bounds, const geom::Rect& atlasBounds)
+    : _bounds(bounds), _atlasBounds(atlasBounds) {}
+
+Glyph::~Glyph() = default;
+
+const geom::Rect& Glyph::bounds() const {
+  return _bounds;
+}
+
+const geom::Rect& Glyph::atlasBounds() const {
+  return _atlasBounds;
+}
 
 }  // namespace type
 }  // namespace rl
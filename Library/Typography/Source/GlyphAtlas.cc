@@ -0,0 +1,445 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/Utilities.h>
+#include <Typography/GlyphAtlas.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace rl {
+namespace type {
+
+const size_t GlyphAtlas::SubpixelPositions = 4;
+
+/*
+ *  Empty pixels to the right of and below each glyph. Keeps neighbouring
+ *  glyphs from bleeding into each other when sampled with filtering.
+ */
+static const size_t GlyphPadding = 1;
+
+/*
+ *  Shelf heights are rounded up to a multiple of this so that glyphs of
+ *  similar heights share shelves.
+ */
+static const size_t ShelfGranularity = 4;
+
+static const size_t NoShelf = std::numeric_limits<size_t>::max();
+
+/**
+ *  Owns the FreeType library and the faces opened from the font files of the
+ *  runs placed in the atlas.
+ */
+class GlyphAtlas::Rasterizer {
+ public:
+  struct Bitmap {
+    size_t width = 0;
+    size_t rows = 0;
+    int pitch = 0;
+    const uint8_t* buffer = nullptr;
+    int left = 0;
+    int top = 0;
+  };
+
+  Rasterizer() : _library(nullptr) {
+    if (FT_Init_FreeType(&_library) != 0) {
+      _library = nullptr;
+    }
+  }
+
+  ~Rasterizer() {
+    for (auto& face : _faces) {
+      FT_Done_Face(face.face);
+    }
+    if (_library != nullptr) {
+      FT_Done_FreeType(_library);
+    }
+  }
+
+  bool isValid() const { return _library != nullptr; }
+
+  bool faceForFile(const std::string& path, size_t index, size_t& face) {
+    for (size_t i = 0; i < _faces.size(); i++) {
+      if (_faces[i].path == path && _faces[i].index == index) {
+        face = i;
+        return true;
+      }
+    }
+
+    FT_Face handle = nullptr;
+    if (_library == nullptr ||
+        FT_New_Face(_library, path.c_str(), index, &handle) != 0) {
+      return false;
+    }
+
+    _faces.push_back({path, index, handle, 0});
+    face = _faces.size() - 1;
+    return true;
+  }
+
+  /**
+   *  Rasterize the glyph offset horizontally by the given fraction of a
+   *  pixel. The bitmap is only valid till the next glyph is rasterized.
+   */
+  bool rasterize(size_t face,
+                 int32_t size,
+                 Codepoint glyph,
+                 size_t subpixel,
+                 Bitmap& bitmap) {
+    auto& entry = _faces[face];
+
+    if (entry.size != size) {
+      if (FT_Set_Char_Size(entry.face, 0, size, 72, 72) != 0) {
+        return false;
+      }
+      entry.size = size;
+    }
+
+    /*
+     *  Hinting would snap outlines back to the pixel grid and undo the
+     *  subpixel offset.
+     */
+    if (FT_Load_Glyph(entry.face, glyph,
+                      FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP) != 0) {
+      return false;
+    }
+
+    auto slot = entry.face->glyph;
+
+    if (slot->format == FT_GLYPH_FORMAT_OUTLINE) {
+      FT_Outline_Translate(&slot->outline,
+                           static_cast<FT_Pos>(subpixel * 64 /
+                                               GlyphAtlas::SubpixelPositions),
+                           0);
+    }
+
+    if (FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL) != 0) {
+      return false;
+    }
+
+    bitmap.width = slot->bitmap.width;
+    bitmap.rows = slot->bitmap.rows;
+    bitmap.pitch = slot->bitmap.pitch;
+    bitmap.buffer = slot->bitmap.buffer;
+    bitmap.left = slot->bitmap_left;
+    bitmap.top = slot->bitmap_top;
+    return true;
+  }
+
+ private:
+  struct Face {
+    std::string path;
+    size_t index;
+    FT_Face face;
+    int32_t size;
+  };
+
+  FT_Library _library;
+  std::vector<Face> _faces;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(Rasterizer);
+};
+
+bool GlyphAtlas::Key::operator==(const Key& other) const {
+  return glyph == other.glyph && subpixel == other.subpixel &&
+         size == other.size && face == other.face;
+}
+
+std::size_t GlyphAtlas::KeyHash::operator()(const Key& key) const {
+  size_t seed = std::hash<Codepoint>()(key.glyph);
+  core::HashCombine(seed, key.size);
+  core::HashCombine(seed, key.face);
+  core::HashCombine(seed, key.subpixel);
+  return seed;
+}
+
+static image::ImageResult CreateImage(const geom::Size& size) {
+  core::Allocation allocation;
+  if (!allocation.resize(size.width * size.height)) {
+    return {};
+  }
+  allocation.makeZero();
+  return {size, image::ImageResult::Components::Grey, std::move(allocation)};
+}
+
+GlyphAtlas::GlyphAtlas(const geom::Size& size)
+    : _rasterizer(std::make_unique<Rasterizer>()),
+      _size(std::floor(size.width), std::floor(size.height)),
+      _image(CreateImage(_size)),
+      _shelvesHeight(0),
+      _clock(0),
+      _passStart(1),
+      _hits(0),
+      _misses(0),
+      _evictions(0) {}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+bool GlyphAtlas::isValid() const {
+  return _rasterizer->isValid() && _image.wasSuccessful();
+}
+
+const geom::Size& GlyphAtlas::size() const {
+  return _size;
+}
+
+const image::ImageResult& GlyphAtlas::image() const {
+  return _image;
+}
+
+void GlyphAtlas::beginPass() {
+  _passStart = _clock + 1;
+}
+
+bool GlyphAtlas::placeRun(const GlyphRun& run, std::vector<Glyph>& glyphs) {
+  if (!isValid() || !run.isValid()) {
+    return false;
+  }
+
+  Key key = {};
+
+  if (!_rasterizer->faceForFile(run.fontFilePath(), run.fontIndex(),
+                                key.face)) {
+    return false;
+  }
+
+  key.size =
+      static_cast<int32_t>(std::round(run.descriptor().pointSize() * 64.0));
+
+  for (const auto& position : run.positions()) {
+    /*
+     *  Snap the origin to the nearest subpixel position. The integral part
+     *  positions the glyph in the run. The fractional part selects the copy
+     *  of the glyph in the atlas.
+     */
+    const double x =
+        std::round(position.origin.x * SubpixelPositions) / SubpixelPositions;
+    const double left = std::floor(x);
+    const double baseline = std::round(position.origin.y);
+
+    key.glyph = position.glyph;
+    key.subpixel = static_cast<size_t>((x - left) * SubpixelPositions);
+
+    Entry entry;
+    if (!findOrPlaceGlyph(key, entry)) {
+      return false;
+    }
+
+    if (entry.shelf == NoShelf) {
+      continue;
+    }
+
+    glyphs.emplace_back(
+        geom::Rect{left + entry.bearing.x, baseline + entry.bearing.y,
+                   entry.atlasBounds.size.width,
+                   entry.atlasBounds.size.height},
+        entry.atlasBounds);
+  }
+
+  return true;
+}
+
+bool GlyphAtlas::findOrPlaceGlyph(const Key& key, Entry& entry) {
+  const auto now = ++_clock;
+
+  auto found = _entries.find(key);
+  if (found != _entries.end()) {
+    _hits++;
+    if (found->second.shelf != NoShelf) {
+      _shelves[found->second.shelf].lastUsed = now;
+    }
+    entry = found->second;
+    return true;
+  }
+
+  _misses++;
+
+  Rasterizer::Bitmap bitmap;
+  if (!_rasterizer->rasterize(key.face, key.size, key.glyph, key.subpixel,
+                              bitmap)) {
+    return false;
+  }
+
+  entry.shelf = NoShelf;
+  entry.bearing = {static_cast<double>(bitmap.left),
+                   -static_cast<double>(bitmap.top)};
+
+  if (bitmap.width == 0 || bitmap.rows == 0) {
+    _entries.emplace(key, entry);
+    return true;
+  }
+
+  size_t left = 0;
+  if (!allocate(bitmap.width + GlyphPadding, bitmap.rows + GlyphPadding,
+                entry.shelf, left)) {
+    return false;
+  }
+
+  auto& shelf = _shelves[entry.shelf];
+  shelf.lastUsed = now;
+  shelf.keys.push_back(key);
+
+  entry.atlasBounds = {static_cast<double>(left),
+                       static_cast<double>(shelf.top),
+                       static_cast<double>(bitmap.width),
+                       static_cast<double>(bitmap.rows)};
+
+  /*
+   *  Copy the coverage into the atlas.
+   */
+  const size_t stride = _size.width;
+  auto pixels = _image.allocation().data();
+  for (size_t row = 0; row < bitmap.rows; row++) {
+    memcpy(pixels + (shelf.top + row) * stride + left,
+           bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch,
+           bitmap.width);
+  }
+
+  addDamage(entry.atlasBounds);
+  _entries.emplace(key, entry);
+  return true;
+}
+
+bool GlyphAtlas::allocate(size_t width,
+                          size_t height,
+                          size_t& shelf,
+                          size_t& left) {
+  const size_t atlasWidth = _size.width;
+  const size_t atlasHeight = _size.height;
+
+  if (width > atlasWidth || height > atlasHeight) {
+    return false;
+  }
+
+  height = (height + ShelfGranularity - 1) / ShelfGranularity *
+           ShelfGranularity;
+
+  /*
+   *  Prefer the shortest shelf with room that is at least as tall as the
+   *  glyph.
+   */
+  shelf = NoShelf;
+  for (size_t i = 0; i < _shelves.size(); i++) {
+    const auto& candidate = _shelves[i];
+    if (candidate.height < height || atlasWidth - candidate.cursor < width) {
+      continue;
+    }
+    if (shelf == NoShelf || candidate.height < _shelves[shelf].height) {
+      shelf = i;
+    }
+  }
+
+  /*
+   *  Open a new shelf if the best existing one would waste too much space.
+   */
+  const bool wasteful =
+      shelf == NoShelf || _shelves[shelf].height > height * 3 / 2;
+  if (wasteful && atlasHeight - _shelvesHeight >= height) {
+    _shelves.push_back({_shelvesHeight, height, 0, 0, {}});
+    _shelvesHeight += height;
+    shelf = _shelves.size() - 1;
+  }
+
+  /*
+   *  The atlas is full. Evict the least recently used shelf tall enough for
+   *  the glyph. Shelves used in the current pass are off limits.
+   */
+  if (shelf == NoShelf) {
+    for (size_t i = 0; i < _shelves.size(); i++) {
+      const auto& candidate = _shelves[i];
+      if (candidate.height < height || candidate.lastUsed >= _passStart) {
+        continue;
+      }
+      if (shelf == NoShelf || candidate.lastUsed < _shelves[shelf].lastUsed) {
+        shelf = i;
+      }
+    }
+
+    if (shelf == NoShelf) {
+      return false;
+    }
+
+    evictShelf(shelf);
+  }
+
+  left = _shelves[shelf].cursor;
+  _shelves[shelf].cursor += width;
+  return true;
+}
+
+void GlyphAtlas::evictShelf(size_t index) {
+  auto& shelf = _shelves[index];
+
+  for (const auto& key : shelf.keys) {
+    _entries.erase(key);
+  }
+
+  _evictions += shelf.keys.size();
+  shelf.keys.clear();
+  shelf.cursor = 0;
+
+  clearPixels({0.0, static_cast<double>(shelf.top), _size.width,
+               static_cast<double>(shelf.height)});
+}
+
+void GlyphAtlas::clearPixels(const geom::Rect& rect) {
+  const size_t stride = _size.width;
+  const size_t left = rect.origin.x;
+  const size_t top = rect.origin.y;
+  const size_t width = rect.size.width;
+  const size_t height = rect.size.height;
+
+  auto pixels = _image.allocation().data();
+  for (size_t row = top; row < top + height; row++) {
+    memset(pixels + row * stride + left, 0, width);
+  }
+
+  addDamage(rect);
+}
+
+void GlyphAtlas::addDamage(const geom::Rect& rect) {
+  if (_damage.size.width <= 0.0 || _damage.size.height <= 0.0) {
+    _damage = rect;
+  } else {
+    _damage = _damage.unionWith(rect);
+  }
+}
+
+const geom::Rect& GlyphAtlas::damage() const {
+  return _damage;
+}
+
+void GlyphAtlas::clearDamage() {
+  _damage = {};
+}
+
+void GlyphAtlas::purge() {
+  _entries.clear();
+  _shelves.clear();
+  _shelvesHeight = 0;
+
+  if (_image.wasSuccessful()) {
+    clearPixels({0.0, 0.0, _size.width, _size.height});
+  }
+}
+
+GlyphAtlas::Statistics GlyphAtlas::statistics() const {
+  Statistics statistics;
+  statistics.hits = _hits;
+  statistics.misses = _misses;
+  statistics.evictions = _evictions;
+  statistics.entries = _entries.size();
+  statistics.shelves = _shelves.size();
+  return statistics;
+}
+
+}  // namespace type
+}  // namespace rl
@@ -4,11 +4,97 @@
  */
 
 #include <Typography/GlyphRun.h>
+#include <Typography/TypographyContext.h>
 
 namespace rl {
 namespace type {
 
-//
+/*
+ *  Shaped positions and font extents are in 26.6 fixed point pixels.
+ */
+static double PixelsFromFixed(hb_position_t position) {
+  return position / 64.0;
+}
+
+GlyphRun::GlyphRun() : _fontIndex(0), _ascent(0.0), _valid(false) {}
+
+GlyphRun::GlyphRun(const String& string,
+                   const TextRun& run,
+                   const FontLibrary& library)
+    : _descriptor(run.descriptor()),
+      _fontIndex(0),
+      _ascent(0.0),
+      _valid(false) {
+  auto face = library.faceForDescriptor(run.descriptor());
+
+  if (face == nullptr) {
+    return;
+  }
+
+  auto glyphs = TypographyContext::SharedContext().shapingCache().shape(
+      string, run, library);
+
+  if (glyphs == nullptr) {
+    return;
+  }
+
+  _fontFilePath = face->filePath();
+  _fontIndex = face->index();
+  _ascent = PixelsFromFixed(glyphs->ascender);
+
+  /*
+   *  HarfBuzz positions are y up from the baseline. The glyphs of right to
+   *  left runs are already in visual order.
+   */
+  hb_position_t x = 0;
+  hb_position_t y = 0;
+  _positions.reserve(glyphs->size());
+  for (size_t i = 0, length = glyphs->size(); i < length; i++) {
+    _positions.push_back(
+        {glyphs->glyphs[i],
+         {PixelsFromFixed(x + glyphs->xOffsets[i]),
+          _ascent - PixelsFromFixed(y + glyphs->yOffsets[i])}});
+    x += glyphs->xAdvances[i];
+    y += glyphs->yAdvances[i];
+  }
+
+  _size = {PixelsFromFixed(x), _ascent - PixelsFromFixed(glyphs->descender)};
+  _valid = true;
+}
+
+GlyphRun::GlyphRun(GlyphRun&&) = default;
+
+GlyphRun& GlyphRun::operator=(GlyphRun&&) = default;
+
+GlyphRun::~GlyphRun() = default;
+
+bool GlyphRun::isValid() const {
+  return _valid;
+}
+
+const FontDescriptor& GlyphRun::descriptor() const {
+  return _descriptor;
+}
+
+const std::string& GlyphRun::fontFilePath() const {
+  return _fontFilePath;
+}
+
+size_t GlyphRun::fontIndex() const {
+  return _fontIndex;
+}
+
+const std::vector<GlyphRun::Position>& GlyphRun::positions() const {
+  return _positions;
+}
+
+double GlyphRun::ascent() const {
+  return _ascent;
+}
+
+geom::Size GlyphRun::size() const {
+  return _size;
+}
 
 }  // namespace type
 }  // namespace rl
@@ -8,7 +8,56 @@
 namespace rl {
 namespace type {
 
-//
+Line::Line() : Line(0, 0, {}, {}, 0.0, 0.0, 0.0) {}
+
+Line::Line(size_t firstRun,
+           size_t runCount,
+           TextRange range,
+           const geom::Rect& bounds,
+           double ascent,
+           double descent,
+           double runSpacing)
+    : _firstRun(firstRun),
+      _runCount(runCount),
+      _range(range),
+      _bounds(bounds),
+      _ascent(ascent),
+      _descent(descent),
+      _runSpacing(runSpacing) {}
+
+Line::~Line() = default;
+
+size_t Line::firstRun() const {
+  return _firstRun;
+}
+
+size_t Line::runCount() const {
+  return _runCount;
+}
+
+TextRange Line::range() const {
+  return _range;
+}
+
+const geom::Rect& Line::bounds() const {
+  return _bounds;
+}
+
+double Line::baseline() const {
+  return _bounds.origin.y + _ascent;
+}
+
+double Line::ascent() const {
+  return _ascent;
+}
+
+double Line::descent() const {
+  return _descent;
+}
+
+double Line::runSpacing() const {
+  return _runSpacing;
+}
 
 }  // namespace type
 }  // namespace rl
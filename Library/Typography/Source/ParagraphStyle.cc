@@ -8,7 +8,29 @@
 namespace rl {
 namespace type {
 
-//
+ParagraphStyle::ParagraphStyle()
+    : ParagraphStyle(Alignment::Left, LineBreakStrategy::Greedy) {}
+
+ParagraphStyle::ParagraphStyle(Alignment alignment,
+                               LineBreakStrategy lineBreakStrategy,
+                               double lineHeightMultiple)
+    : _alignment(alignment),
+      _lineBreakStrategy(lineBreakStrategy),
+      _lineHeightMultiple(lineHeightMultiple) {}
+
+ParagraphStyle::~ParagraphStyle() = default;
+
+ParagraphStyle::Alignment ParagraphStyle::alignment() const {
+  return _alignment;
+}
+
+ParagraphStyle::LineBreakStrategy ParagraphStyle::lineBreakStrategy() const {
+  return _lineBreakStrategy;
+}
+
+double ParagraphStyle::lineHeightMultiple() const {
+  return _lineHeightMultiple;
+}
 
 }  // namespace type
 }  // namespace rl
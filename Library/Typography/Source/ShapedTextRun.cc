@@ -4,135 +4,135 @@
  */
 
 #include <Typography/ShapedTextRun.h>
+#include <Typography/TypographyContext.h>
 #include <unicode/unistr.h>
 
 namespace rl {
 namespace type {
 
-static hb_direction_t ToHBDirection(TextRun::Direction direction) {
-  switch (direction) {
-    case TextRun::Direction::LeftToRight:
-      return HB_DIRECTION_LTR;
-    case TextRun::Direction::RightToLeft:
-      return HB_DIRECTION_RTL;
+/*
+ *  Shaped positions and font extents are in 26.6 fixed point pixels.
+ */
+static double PixelsFromFixed(int32_t position) {
+  return position / 64.0;
+}
+
+static bool IsMandatoryBreak(UChar character) {
+  switch (character) {
+    case 0x000A:  // Line Feed
+    case 0x000B:  // Line Tabulation
+    case 0x000C:  // Form Feed
+    case 0x000D:  // Carriage Return
+    case 0x0085:  // Next Line
+    case 0x2028:  // Line Separator
+    case 0x2029:  // Paragraph Separator
+      return true;
     default:
-      return HB_DIRECTION_INVALID;
+      return false;
   }
-  return HB_DIRECTION_INVALID;
+}
+
+static bool IsHangingWhitespace(UChar character) {
+  return character == 0x0020 || character == 0x0009 ||
+         IsMandatoryBreak(character);
 }
 
 ShapedTextRun::ShapedTextRun() = default;
 
 ShapedTextRun::ShapedTextRun(const String& string,
                              const TextRun& run,
-                             const FontLibrary& library) {
-  if (!TextRange{0, string.size()}.containsRange(run.range())) {
+                             const FontLibrary& library)
+    : _glyphs(TypographyContext::SharedContext().shapingCache().shape(
+          string,
+          run,
+          library)),
+      _range(run.range()) {
+  if (_glyphs == nullptr) {
     return;
   }
 
-  /*
-   *  Resolve the font. This is what we are going to use the shape the buffer.
-   */
-  _font = library.fontForDescriptor(run.descriptor());
-
-  if (!_font.isValid()) {
-    return;
-  }
+  const auto& text = string.unicodeString();
 
   /*
-   *  Create the buffer to shape.
+   *  Find the whitespace at the end of the run. Clusters are relative to the
+   *  start of the run. So glyphs at or past the first trailing whitespace
+   *  character draw the whitespace, whatever the direction of the run.
    */
-  _buffer = {hb_buffer_create(), hb_buffer_destroy};
-
-  if (_buffer == nullptr) {
-    return;
+  size_t trailingStart = _range.length;
+  while (trailingStart > 0 &&
+         IsHangingWhitespace(text.charAt(_range.start + trailingStart - 1))) {
+    trailingStart--;
   }
 
-  /*
-   *  Populate the buffer to shape.
-   */
-  hb_buffer_add_utf16(_buffer.get(),  // buffer
-                      reinterpret_cast<const uint16_t*>(
-                          string.unicodeString().getBuffer()),  // text
-                      string.unicodeString().length(),          // text length
-                      run.range().start,                        // item offset
-                      run.range().length                        // item length
-  );
-
-  /*
-   *  Set the buffer direction. We already detected this when we setup runs.
-   */
-  hb_buffer_set_direction(_buffer.get(), ToHBDirection(run.direction()));
-
-  /*
-   *  TODO: Set the script of the buffer.
-   */
-
-  /*
-   *  TODO: Set the language of the buffer.
-   */
-
-  /*
-   *  This is a fallback.
-   */
-  hb_buffer_guess_segment_properties(_buffer.get());
-
-  /*
-   *  Finally, shape the thing!
-   */
-  hb_shape(reinterpret_cast<hb_font_t*>(_font.handle()),  // font
-           _buffer.get(),                                 // buffer
-           nullptr,                                       // features
-           0                                              // features count
-  );
+  _endsWithMandatoryBreak =
+      _range.length > 0 &&
+      IsMandatoryBreak(text.charAt(_range.start + _range.length - 1));
+
+  int32_t advance = 0;
+  int32_t trailingAdvance = 0;
+  for (size_t i = 0, length = _glyphs->size(); i < length; i++) {
+    advance += _glyphs->xAdvances[i];
+    if (_glyphs->clusters[i] >= trailingStart) {
+      trailingAdvance += _glyphs->xAdvances[i];
+    }
+  }
 
-  /*
-   *  After successful shaping, the buffer will contain glyphs.
-   */
-  _valid = hb_buffer_get_content_type(_buffer.get()) ==
-           HB_BUFFER_CONTENT_TYPE_GLYPHS;
+  _advance = PixelsFromFixed(advance);
+  _trailingWhitespaceAdvance = PixelsFromFixed(trailingAdvance);
 }
 
-ShapedTextRun::ShapedTextRun(ShapedTextRun&& o)
-    : _buffer(std::move(o._buffer)),
-      _font(std::move(o._font)),
-      _valid(o._valid) {
-  o._valid = false;
-}
+ShapedTextRun::ShapedTextRun(ShapedTextRun&& o) = default;
 
 ShapedTextRun::~ShapedTextRun() = default;
 
 bool ShapedTextRun::isValid() const {
-  return _valid;
+  return _glyphs != nullptr;
 }
 
 geom::Size ShapedTextRun::size() const {
-  if (!_valid) {
+  if (_glyphs == nullptr) {
     return {};
   }
 
-  uint32_t length = 0;
-  hb_glyph_position_t* position =
-      hb_buffer_get_glyph_positions(_buffer.get(), &length);
-
   geom::Size size;
 
-  for (uint32_t i = 0; i < length; i++) {
-    size.width += position[i].x_advance;
-    size.height += position[i].y_advance;
+  for (size_t i = 0, length = _glyphs->size(); i < length; i++) {
+    size.width += _glyphs->xAdvances[i];
+    size.height += _glyphs->yAdvances[i];
   }
 
-  return size;
+  /*
+   *  Advances are in 26.6 fixed point pixels.
+   */
+  return {size.width / 64.0, size.height / 64.0};
 }
 
 size_t ShapedTextRun::glyphCount() const {
-  if (!_valid) {
-    return 0;
-  }
+  return _glyphs == nullptr ? 0 : _glyphs->size();
+}
+
+TextRange ShapedTextRun::range() const {
+  return _range;
+}
+
+double ShapedTextRun::advance() const {
+  return _advance;
+}
+
+double ShapedTextRun::trailingWhitespaceAdvance() const {
+  return _trailingWhitespaceAdvance;
+}
+
+double ShapedTextRun::ascent() const {
+  return _glyphs == nullptr ? 0.0 : PixelsFromFixed(_glyphs->ascender);
+}
+
+double ShapedTextRun::descent() const {
+  return _glyphs == nullptr ? 0.0 : -PixelsFromFixed(_glyphs->descender);
+}
 
-  uint32_t length = 0;
-  hb_buffer_get_glyph_positions(_buffer.get(), &length);
-  return length;
+bool ShapedTextRun::endsWithMandatoryBreak() const {
+  return _endsWithMandatoryBreak;
 }
 
 }  // namespace type
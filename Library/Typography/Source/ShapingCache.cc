@@ -0,0 +1,274 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/Utilities.h>
+#include <Typography/ShapingCache.h>
+#include <Typography/TypographyContext.h>
+#include <unicode/unistr.h>
+
+namespace rl {
+namespace type {
+
+const size_t ShapingCache::DefaultByteBudget = 4 * 1024 * 1024;
+
+static hb_direction_t ToHBDirection(TextRun::Direction direction) {
+  switch (direction) {
+    case TextRun::Direction::LeftToRight:
+      return HB_DIRECTION_LTR;
+    case TextRun::Direction::RightToLeft:
+      return HB_DIRECTION_RTL;
+    default:
+      return HB_DIRECTION_INVALID;
+  }
+  return HB_DIRECTION_INVALID;
+}
+
+static ShapingCache::Glyphs ShapeRun(const String& string,
+                                     const TextRun& run,
+                                     const FontLibrary& library) {
+  /*
+   *  Resolve the font. This is what we are going to use the shape the buffer.
+   *  Fonts are reused by the thread that created them so that cache misses do
+   *  not open a new face under the lock shared by the process.
+   */
+  auto font = library.fontForDescriptorOnThread(run.descriptor());
+
+  if (font == nullptr) {
+    return nullptr;
+  }
+
+  /*
+   *  Reuse the buffer of the thread. Its storage only ever grows to fit the
+   *  longest run shaped on the thread.
+   */
+  auto buffer = TypographyContext::SharedContext().shapingBufferForThread();
+
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+
+  hb_buffer_clear_contents(buffer);
+
+  /*
+   *  Populate the buffer to shape.
+   */
+  hb_buffer_add_utf16(buffer,  // buffer
+                      reinterpret_cast<const uint16_t*>(
+                          string.unicodeString().getBuffer()),  // text
+                      string.unicodeString().length(),          // text length
+                      run.range().start,                        // item offset
+                      run.range().length                        // item length
+  );
+
+  /*
+   *  Set the buffer direction. We already detected this when we setup runs.
+   */
+  hb_buffer_set_direction(buffer, ToHBDirection(run.direction()));
+
+  /*
+   *  TODO: Set the script of the buffer.
+   */
+
+  /*
+   *  TODO: Set the language of the buffer.
+   */
+
+  /*
+   *  This is a fallback.
+   */
+  hb_buffer_guess_segment_properties(buffer);
+
+  /*
+   *  Finally, shape the thing!
+   */
+  hb_shape(font->handle(),  // font
+           buffer,         // buffer
+           nullptr,        // features
+           0               // features count
+  );
+
+  /*
+   *  After successful shaping, the buffer will contain glyphs.
+   */
+  if (hb_buffer_get_content_type(buffer) !=
+      HB_BUFFER_CONTENT_TYPE_GLYPHS) {
+    return nullptr;
+  }
+
+  /*
+   *  Keep only the glyphs and their positions. The buffer is much larger and
+   *  tied to the font it was shaped with.
+   */
+  uint32_t length = 0;
+  const auto infos = hb_buffer_get_glyph_infos(buffer, &length);
+  const auto positions = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+  auto glyphs = std::make_shared<ShapedGlyphs>();
+  glyphs->glyphs.resize(length);
+  glyphs->clusters.resize(length);
+  glyphs->xAdvances.resize(length);
+  glyphs->yAdvances.resize(length);
+  glyphs->xOffsets.resize(length);
+  glyphs->yOffsets.resize(length);
+
+  hb_font_extents_t extents = {};
+  hb_font_get_h_extents(font->handle(), &extents);
+  glyphs->ascender = extents.ascender;
+  glyphs->descender = extents.descender;
+
+  for (uint32_t i = 0; i < length; i++) {
+    glyphs->glyphs[i] = infos[i].codepoint;
+    glyphs->clusters[i] =
+        infos[i].cluster - static_cast<uint32_t>(run.range().start);
+    glyphs->xAdvances[i] = positions[i].x_advance;
+    glyphs->yAdvances[i] = positions[i].y_advance;
+    glyphs->xOffsets[i] = positions[i].x_offset;
+    glyphs->yOffsets[i] = positions[i].y_offset;
+  }
+
+  return glyphs;
+}
+
+/**
+ *  An estimate of the memory held by an entry for the given run.
+ */
+static size_t EntryBytes(const std::u16string& text,
+                         const ShapedGlyphs& glyphs) {
+  const size_t glyphBytes = sizeof(Codepoint) + sizeof(uint32_t) +
+                            4 * sizeof(int32_t);
+  return sizeof(ShapedGlyphs) + text.size() * sizeof(char16_t) +
+         glyphs.size() * glyphBytes;
+}
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+  return direction == other.direction && descriptor == other.descriptor &&
+         text == other.text;
+}
+
+std::size_t ShapingCache::KeyHash::operator()(const Key& key) const {
+  size_t seed = std::hash<std::u16string>()(key.text);
+  core::HashCombine(seed, key.descriptor.postscriptName());
+  core::HashCombine(seed, key.descriptor.pointSize());
+  core::HashCombine(seed, static_cast<int>(key.direction));
+  return seed;
+}
+
+ShapingCache::ShapingCache(size_t byteBudget)
+    : _byteBudget(byteBudget),
+      _bytes(0),
+      _hits(0),
+      _misses(0),
+      _evictions(0) {}
+
+ShapingCache::~ShapingCache() = default;
+
+ShapingCache::Glyphs ShapingCache::shape(const String& string,
+                                         const TextRun& run,
+                                         const FontLibrary& library) {
+  if (!TextRange{0, string.size()}.containsRange(run.range())) {
+    return nullptr;
+  }
+
+  const auto text = reinterpret_cast<const char16_t*>(
+      string.unicodeString().getBuffer() + run.range().start);
+
+  Key key = {
+      std::u16string{text, run.range().length},  // text
+      run.descriptor(),                          // descriptor
+      run.direction(),                           // direction
+  };
+
+  {
+    core::MutexLocker lock(_lock);
+
+    auto found = _map.find(key);
+    if (found != _map.end()) {
+      _hits++;
+      /*
+       *  Mark the entry as the most recently used.
+       */
+      _entries.splice(_entries.begin(), _entries, found->second);
+      return found->second->glyphs;
+    }
+
+    _misses++;
+  }
+
+  /*
+   *  Shaping is expensive. Don't hold up lookups on other threads while it is
+   *  in progress. If another thread shapes the same run concurrently, the
+   *  first result to be inserted is kept.
+   */
+  auto glyphs = ShapeRun(string, run, library);
+
+  /*
+   *  Runs that could not be shaped are not cached so that they may be retried
+   *  once the font is available.
+   */
+  if (glyphs == nullptr) {
+    return nullptr;
+  }
+
+  const auto bytes = EntryBytes(key.text, *glyphs);
+
+  core::MutexLocker lock(_lock);
+
+  auto found = _map.find(key);
+  if (found != _map.end()) {
+    return found->second->glyphs;
+  }
+
+  _entries.push_front({{}, glyphs, bytes});
+  auto inserted = _map.emplace(std::move(key), _entries.begin());
+  RL_ASSERT(inserted.second);
+  _entries.front().mapEntry = inserted.first;
+  _bytes += bytes;
+
+  evictIfNecessary();
+
+  return glyphs;
+}
+
+void ShapingCache::evictIfNecessary() {
+  while (_bytes > _byteBudget && !_entries.empty()) {
+    const auto& entry = _entries.back();
+    _bytes -= entry.bytes;
+    _map.erase(entry.mapEntry);
+    _entries.pop_back();
+    _evictions++;
+  }
+}
+
+size_t ShapingCache::byteBudget() const {
+  core::MutexLocker lock(_lock);
+  return _byteBudget;
+}
+
+void ShapingCache::setByteBudget(size_t byteBudget) {
+  core::MutexLocker lock(_lock);
+  _byteBudget = byteBudget;
+  evictIfNecessary();
+}
+
+void ShapingCache::purge() {
+  core::MutexLocker lock(_lock);
+  _map.clear();
+  _entries.clear();
+  _bytes = 0;
+}
+
+ShapingCache::Statistics ShapingCache::statistics() const {
+  core::MutexLocker lock(_lock);
+  Statistics statistics;
+  statistics.hits = _hits;
+  statistics.misses = _misses;
+  statistics.evictions = _evictions;
+  statistics.entries = _entries.size();
+  statistics.bytes = _bytes;
+  return statistics;
+}
+
+}  // namespace type
+}  // namespace rl
@@ -4,21 +4,322 @@
  */
 
 #include <Typography/TypeFrame.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace rl {
 namespace type {
 
-TypeFrame::TypeFrame() = default;
+/**
+ *  The widths of the runs of a frame in a form that makes the width of any
+ *  sequence of runs a constant time lookup.
+ */
+class RunWidths {
+ public:
+  RunWidths(const std::vector<ShapedTextRun>& runs) : _runs(runs) {
+    _offsets.reserve(runs.size() + 1);
+    _offsets.push_back(0.0);
+    for (const auto& run : runs) {
+      _offsets.push_back(_offsets.back() + run.advance());
+    }
+  }
+
+  /**
+   *  The width of the runs in [first, end) on a line. Whitespace at the end
+   *  of the last run hangs past the edge of the line.
+   */
+  double lineWidth(size_t first, size_t end) const {
+    return _offsets[end] - _offsets[first] -
+           _runs[end - 1].trailingWhitespaceAdvance();
+  }
+
+ private:
+  const std::vector<ShapedTextRun>& _runs;
+  std::vector<double> _offsets;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(RunWidths);
+};
+
+/**
+ *  Append the end of each line of the paragraph in [first, end) fitting as
+ *  many runs on each line as possible.
+ */
+static void BreakGreedy(const RunWidths& widths,
+                        size_t first,
+                        size_t end,
+                        double width,
+                        std::vector<size_t>& breaks) {
+  while (first < end) {
+    size_t last = first + 1;
+    while (last < end && widths.lineWidth(first, last + 1) <= width) {
+      last++;
+    }
+    breaks.push_back(last);
+    first = last;
+  }
+}
+
+/**
+ *  The penalty for ending a line with the given width. Uneven lines are
+ *  penalized much more than a few lines that are all a little short. The last
+ *  line of a paragraph may be as short as it likes.
+ */
+static double LineDemerits(double lineWidth, double width, bool lastLine) {
+  if (lineWidth > width) {
+    /*
+     *  Only runs that don't fit on a line of their own end up here.
+     */
+    return 1e6;
+  }
+
+  if (lastLine) {
+    return 0.0;
+  }
+
+  const double slack = (width - lineWidth) / width;
+  const double badness = 100.0 * slack * slack * slack;
+  return (1.0 + badness) * (1.0 + badness);
+}
+
+/**
+ *  Append the end of each line of the paragraph in [first, end) picking the
+ *  breaks that minimize the total demerits of its lines. Only the lines ending
+ *  at each run that fit the width are considered. So this takes time linear in
+ *  the number of runs times the number of runs on a line.
+ */
+static void BreakOptimal(const RunWidths& widths,
+                         size_t first,
+                         size_t end,
+                         double width,
+                         std::vector<size_t>& breaks) {
+  const size_t count = end - first;
+
+  /*
+   *  The least total demerits of the lines up to each break and the break
+   *  before the last of those lines. Indices are relative to the first run.
+   */
+  std::vector<double> demerits(count + 1,
+                               std::numeric_limits<double>::infinity());
+  std::vector<size_t> previous(count + 1, 0);
+  demerits[0] = 0.0;
+
+  for (size_t lineEnd = 1; lineEnd <= count; lineEnd++) {
+    const bool lastLine = lineEnd == count;
+    for (size_t lineStart = lineEnd; lineStart-- > 0;) {
+      const double lineWidth =
+          widths.lineWidth(first + lineStart, first + lineEnd);
+
+      /*
+       *  Lines only get wider as they start earlier.
+       */
+      if (lineWidth > width && lineStart + 1 < lineEnd) {
+        break;
+      }
+
+      const double total =
+          demerits[lineStart] + LineDemerits(lineWidth, width, lastLine);
+      if (total < demerits[lineEnd]) {
+        demerits[lineEnd] = total;
+        previous[lineEnd] = lineStart;
+      }
+    }
+  }
+
+  const size_t firstBreak = breaks.size();
+  for (size_t lineEnd = count; lineEnd > 0; lineEnd = previous[lineEnd]) {
+    breaks.push_back(first + lineEnd);
+  }
+  std::reverse(breaks.begin() + firstBreak, breaks.end());
+}
+
+TypeFrame::TypeFrame() : _valid(false) {}
+
+TypeFrame::TypeFrame(const std::vector<ShapedTextRun>& runs,
+                     const ParagraphStyle& style,
+                     double width)
+    : _valid(false) {
+  for (const auto& run : runs) {
+    if (!run.isValid()) {
+      return;
+    }
+  }
+
+  RunWidths widths(runs);
+
+  /*
+   *  Break each paragraph into lines. Paragraphs end at mandatory breaks.
+   */
+  std::vector<size_t> breaks;
+  for (size_t first = 0; first < runs.size();) {
+    size_t end = first + 1;
+    while (end < runs.size() && !runs[end - 1].endsWithMandatoryBreak()) {
+      end++;
+    }
+
+    /*
+     *  Each paragraph is a single line at an unbounded width. There is nothing
+     *  to optimize there, and optimal breaking would try every line of the
+     *  paragraph since none of them is too wide.
+     */
+    auto strategy = style.lineBreakStrategy();
+    if (!std::isfinite(width)) {
+      strategy = ParagraphStyle::LineBreakStrategy::Greedy;
+    }
+
+    switch (strategy) {
+      case ParagraphStyle::LineBreakStrategy::Greedy:
+        BreakGreedy(widths, first, end, width, breaks);
+        break;
+      case ParagraphStyle::LineBreakStrategy::Optimal:
+        BreakOptimal(widths, first, end, width, breaks);
+        break;
+    }
+
+    first = end;
+  }
+
+  /*
+   *  Text laid out in an unbounded width is aligned within its widest line.
+   */
+  double alignmentWidth = width;
+  if (!std::isfinite(alignmentWidth)) {
+    alignmentWidth = 0.0;
+    for (size_t i = 0, first = 0; i < breaks.size(); first = breaks[i++]) {
+      alignmentWidth =
+          std::max(alignmentWidth, widths.lineWidth(first, breaks[i]));
+    }
+  }
 
-TypeFrame::TypeFrame(TypeFrame&& o) : _valid(o._valid) {
+  /*
+   *  Place the lines one below the other.
+   */
+  _lines.reserve(breaks.size());
+  double top = 0.0;
+  for (size_t i = 0, first = 0; i < breaks.size(); first = breaks[i++]) {
+    const size_t end = breaks[i];
+    const size_t runCount = end - first;
+
+    double ascent = 0.0;
+    double descent = 0.0;
+    for (size_t j = first; j < end; j++) {
+      ascent = std::max(ascent, runs[j].ascent());
+      descent = std::max(descent, runs[j].descent());
+    }
+
+    double lineWidth = widths.lineWidth(first, end);
+    const double slack = std::max(alignmentWidth - lineWidth, 0.0);
+    const bool endsParagraph =
+        end == runs.size() || runs[end - 1].endsWithMandatoryBreak();
+
+    double x = 0.0;
+    double runSpacing = 0.0;
+    switch (style.alignment()) {
+      case ParagraphStyle::Alignment::Left:
+        break;
+      case ParagraphStyle::Alignment::Right:
+        x = slack;
+        break;
+      case ParagraphStyle::Alignment::Center:
+        x = slack / 2.0;
+        break;
+      case ParagraphStyle::Alignment::Justified:
+        if (!endsParagraph && runCount > 1) {
+          runSpacing = slack / (runCount - 1);
+          lineWidth += slack;
+        }
+        break;
+    }
+
+    const double height = (ascent + descent) * style.lineHeightMultiple();
+
+    const TextRange range(
+        runs[first].range().start,
+        runs[end - 1].range().start + runs[end - 1].range().length -
+            runs[first].range().start);
+
+    _lines.emplace_back(first, runCount, range,
+                        geom::Rect{x, top, lineWidth, height}, ascent,
+                        descent, runSpacing);
+
+    _size.width = std::max(_size.width, x + lineWidth);
+    top += height;
+  }
+
+  _size.height = top;
+  _valid = true;
+}
+
+TypeFrame::TypeFrame(TypeFrame&& o)
+    : _lines(std::move(o._lines)), _size(o._size), _valid(o._valid) {
   o._valid = false;
 }
 
+TypeFrame& TypeFrame::operator=(TypeFrame&& o) {
+  _lines = std::move(o._lines);
+  _size = o._size;
+  _valid = o._valid;
+  o._valid = false;
+  return *this;
+}
+
 TypeFrame::~TypeFrame() = default;
 
 bool TypeFrame::isValid() const {
   return _valid;
 }
 
+const std::vector<Line>& TypeFrame::lines() const {
+  return _lines;
+}
+
+geom::Size TypeFrame::size() const {
+  return _size;
+}
+
+size_t TypeFrame::lineIndexForPoint(const geom::Point& point) const {
+  if (_lines.empty()) {
+    return 0;
+  }
+
+  /*
+   *  Lines are ordered top to bottom. Find the first line whose bottom is
+   *  below the point.
+   */
+  auto found = std::upper_bound(
+      _lines.begin(), _lines.end(), point.y,
+      [](double y, const Line& line) {
+        return y < line.bounds().origin.y + line.bounds().size.height;
+      });
+
+  if (found == _lines.end()) {
+    return _lines.size() - 1;
+  }
+
+  return found - _lines.begin();
+}
+
+size_t TypeFrame::lineIndexForTextIndex(size_t index) const {
+  if (_lines.empty()) {
+    return 0;
+  }
+
+  /*
+   *  Lines are ordered by the ranges they cover. Find the last line starting
+   *  at or before the index.
+   */
+  auto found = std::upper_bound(
+      _lines.begin(), _lines.end(), index,
+      [](size_t index, const Line& line) {
+        return index < line.range().start;
+      });
+
+  if (found == _lines.begin()) {
+    return 0;
+  }
+
+  return (found - _lines.begin()) - 1;
+}
+
 }  // namespace type
 }  // namespace rl
@@ -3,16 +3,24 @@
  *  Licensed under the MIT License. See LICENSE file for details.
  */
 
+#include <Core/Latch.h>
 #include <Typography/TextRun.h>
 #include <Typography/Typesetter.h>
 #include <Typography/TypographyContext.h>
 #include <unicode/brkiter.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 namespace rl {
 namespace type {
 
+/*
+ *  Shaping a handful of runs takes less time than handing them to another
+ *  thread. So chunks are never smaller than this.
+ */
+static const size_t kMinimumRunsPerChunk = 32;
+
 Typesetter::Typesetter(AttributedString pString) : _string(std::move(pString)) {
   /*
    *  Break the attributed string into runs based on content and styling.
@@ -74,5 +82,82 @@ std::vector<ShapedTextRun> Typesetter::createShapedRuns(
   return shapedRuns;
 }
 
+std::vector<ShapedTextRun> Typesetter::createShapedRuns(
+    const FontLibrary& library,
+    core::WorkQueue* workQueue) const {
+  const auto& runs = _runs.runs();
+
+  /*
+   *  One chunk for each worker and one for the calling thread.
+   */
+  const size_t chunkCount =
+      workQueue == nullptr
+          ? 1
+          : std::min(workQueue->workerCount() + 1,
+                     runs.size() / kMinimumRunsPerChunk);
+
+  if (chunkCount < 2) {
+    return createShapedRuns(library);
+  }
+
+  /*
+   *  Each chunk is shaped into its own slot. So no synchronization is
+   *  necessary and the order of the runs does not depend on the order the
+   *  chunks are shaped in.
+   */
+  std::vector<std::vector<ShapedTextRun>> chunks(chunkCount);
+  std::vector<uint8_t> shaped(chunkCount, false);
+
+  auto shapeChunk = [&](size_t chunk) {
+    const size_t first = runs.size() * chunk / chunkCount;
+    const size_t last = runs.size() * (chunk + 1) / chunkCount;
+    auto& shapedRuns = chunks[chunk];
+    shapedRuns.reserve(last - first);
+    for (size_t i = first; i < last; i++) {
+      ShapedTextRun shapedRun(_string.string(), runs[i], library);
+      if (!shapedRun.isValid()) {
+        return;
+      }
+      shapedRuns.emplace_back(std::move(shapedRun));
+    }
+    shaped[chunk] = true;
+  };
+
+  core::Latch latch(chunkCount - 1);
+
+  std::vector<core::WorkQueue::WorkItem> items;
+  items.reserve(chunkCount - 1);
+  for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+    items.emplace_back([chunk, &shapeChunk, &latch]() {
+      shapeChunk(chunk);
+      latch.countDown();
+    });
+  }
+
+  if (!workQueue->dispatch(items.begin(), items.end())) {
+    for (const auto& item : items) {
+      item();
+    }
+  }
+
+  shapeChunk(0);
+
+  latch.wait();
+
+  if (std::find(shaped.begin(), shaped.end(), false) != shaped.end()) {
+    RL_LOG("Could not create shaped run.");
+    return {};
+  }
+
+  std::vector<ShapedTextRun> shapedRuns;
+  shapedRuns.reserve(runs.size());
+  for (auto& chunk : chunks) {
+    for (auto& shapedRun : chunk) {
+      shapedRuns.emplace_back(std::move(shapedRun));
+    }
+  }
+  return shapedRuns;
+}
+
 }  // namespace type
 }  // namespace rl
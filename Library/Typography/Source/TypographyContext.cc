@@ -16,7 +16,9 @@ namespace type {
 static constexpr const char* kICUDataFileName = U_ICUDATA_NAME ".dat";
 
 TypographyContext::TypographyContext()
-    : _icuDataMapping(core::URI{kICUDataFileName}) {
+    : _icuDataMapping(core::URI{kICUDataFileName}),
+      _valid(false),
+      _shapingCache(ShapingCache::DefaultByteBudget) {
   if (_icuDataMapping.size() == 0) {
     RL_LOG("Could not map ICU data file '%s' into memory.", kICUDataFileName);
     return;
@@ -78,5 +80,27 @@ icu::BreakIterator* TypographyContext::breakIteratorForThread() {
   return iterator;
 }
 
+hb_buffer_t* TypographyContext::shapingBufferForThread() {
+  RL_THREAD_LOCAL core::ThreadLocal tCurrentBuffer([](uintptr_t value) {
+    hb_buffer_destroy(reinterpret_cast<hb_buffer_t*>(value));
+  });
+  hb_buffer_t* buffer = reinterpret_cast<hb_buffer_t*>(tCurrentBuffer.get());
+  if (buffer != nullptr) {
+    return buffer;
+  }
+  buffer = hb_buffer_create();
+  if (!hb_buffer_allocation_successful(buffer)) {
+    RL_LOG("Could not create the shaping buffer for thread.");
+    hb_buffer_destroy(buffer);
+    return nullptr;
+  }
+  tCurrentBuffer.set(reinterpret_cast<uintptr_t>(buffer));
+  return buffer;
+}
+
+ShapingCache& TypographyContext::shapingCache() {
+  return _shapingCache;
+}
+
 }  // namespace type
 }  // namespace rl
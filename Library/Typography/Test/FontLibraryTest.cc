@@ -5,6 +5,7 @@
 
 #include <TestRunner/TestRunner.h>
 #include <Typography/FontLibrary.h>
+#include <thread>
 
 TEST(FontLibraryTest, SimpleFontRegistration) {
   rl::type::FontLibrary library;
@@ -38,3 +39,36 @@ TEST(FontLibraryTest, FaceHasGlyphs) {
   ASSERT_NE(face, nullptr);
   ASSERT_EQ(face->glyphCount(), 1250u);
 }
+
+TEST(FontLibraryTest, FontsAreReusedOnTheSameThread) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+  auto font = library.fontForDescriptorOnThread({"Roboto-Regular", 14.0});
+  ASSERT_NE(font, nullptr);
+  ASSERT_TRUE(font->isValid());
+  ASSERT_DOUBLE_EQ(font->size(), 14.0);
+  ASSERT_EQ(library.fontForDescriptorOnThread({"Roboto-Regular", 14.0}), font);
+  ASSERT_NE(library.fontForDescriptorOnThread({"Roboto-Regular", 16.0}), font);
+}
+
+TEST(FontLibraryTest, FontsAreNotSharedAcrossThreads) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+  auto font = library.fontForDescriptorOnThread({"Roboto-Regular", 14.0});
+  ASSERT_NE(font, nullptr);
+  const rl::type::Font* otherFont = nullptr;
+  std::thread thread([&]() {
+    otherFont = library.fontForDescriptorOnThread({"Roboto-Regular", 14.0});
+  });
+  thread.join();
+  ASSERT_NE(otherFont, nullptr);
+  ASSERT_NE(otherFont, font);
+}
+
+TEST(FontLibraryTest, NoThreadFontForUnknownDescriptor) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+  ASSERT_EQ(library.fontForDescriptorOnThread({"Roboto-Bold", 14.0}), nullptr);
+  ASSERT_EQ(library.fontForDescriptorOnThread({"Roboto-Regular", 0.0}),
+            nullptr);
+}
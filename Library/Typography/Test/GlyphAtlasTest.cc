@@ -0,0 +1,200 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <Core/FileHandle.h>
+#include <Core/FileMapping.h>
+#include <TestRunner/TestRunner.h>
+#include <Typography/AttributedStringBuilder.h>
+#include <Typography/GlyphAtlas.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+static rl::type::GlyphRun RobotoRun(const rl::type::FontLibrary& library,
+                                    const std::string& text) {
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 16.0}).appendText(text);
+  auto string = builder.attributedString();
+  rl::type::TextRuns runs{string};
+  return {string.string(), runs.runs()[0], library};
+}
+
+/**
+ *  Count the pixels of the atlas that differ from the binary PGM fixture.
+ */
+static size_t DifferencesFromGolden(const rl::type::GlyphAtlas& atlas,
+                                    const std::string& fixture) {
+  rl::core::FileHandle file(rl::core::URI{"file://" + fixture});
+  rl::core::FileMapping mapping(file);
+
+  const auto width = static_cast<size_t>(atlas.size().width);
+  const auto height = static_cast<size_t>(atlas.size().height);
+  const auto header = "P5\n" + std::to_string(width) + " " +
+                      std::to_string(height) + "\n255\n";
+
+  if (mapping.size() != header.size() + width * height ||
+      memcmp(mapping.mapping(), header.data(), header.size()) != 0) {
+    return width * height;
+  }
+
+  const auto expected = mapping.mapping() + header.size();
+  const auto actual = atlas.image().allocation().data();
+
+  size_t differences = 0;
+  for (size_t i = 0; i < width * height; i++) {
+    if (expected[i] != actual[i]) {
+      differences++;
+    }
+  }
+  return differences;
+}
+
+TEST(GlyphAtlasTest, RasterizesRunsLikeTheGolden) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  auto run = RobotoRun(library, "Radar ga");
+  ASSERT_TRUE(run.isValid());
+
+  rl::type::GlyphAtlas atlas({64.0, 32.0});
+  ASSERT_TRUE(atlas.isValid());
+
+  std::vector<rl::type::Glyph> glyphs;
+  ASSERT_TRUE(atlas.placeRun(run, glyphs));
+
+  /*
+   *  The space covers no pixels.
+   */
+  ASSERT_EQ(glyphs.size(), 7u);
+  ASSERT_EQ(DifferencesFromGolden(atlas, "GlyphAtlasGolden.pgm"), 0u);
+
+  const rl::geom::Rect atlasBounds{atlas.size()};
+  for (size_t i = 0; i < glyphs.size(); i++) {
+    const auto& glyph = glyphs[i];
+
+    ASSERT_EQ(glyph.bounds().size, glyph.atlasBounds().size);
+    ASSERT_EQ(atlasBounds.unionWith(glyph.atlasBounds()), atlasBounds);
+
+    /*
+     *  The fractional part of the position is baked into the coverage.
+     */
+    ASSERT_EQ(glyph.bounds().origin.x, std::floor(glyph.bounds().origin.x));
+
+    for (size_t j = 0; j < i; j++) {
+      if (glyph.atlasBounds() == glyphs[j].atlasBounds()) {
+        continue;
+      }
+      ASSERT_FALSE(glyph.atlasBounds().intersects(glyphs[j].atlasBounds()));
+    }
+  }
+
+  ASSERT_EQ(atlas.damage(), rl::geom::Rect(0.0, 0.0, 51.0, 13.0));
+  atlas.clearDamage();
+  ASSERT_EQ(atlas.damage().size, rl::geom::Size());
+}
+
+TEST(GlyphAtlasTest, SubpixelPositionsAreBucketed) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  /*
+   *  The second and last "a" are a quarter of a pixel off the grid. The one in
+   *  between is half way.
+   */
+  auto run = RobotoRun(library, "Radar ga");
+  ASSERT_EQ(run.positions().size(), 8u);
+  ASSERT_DOUBLE_EQ(run.positions()[1].origin.x, 9.859375);
+  ASSERT_DOUBLE_EQ(run.positions()[3].origin.x, 27.59375);
+  ASSERT_DOUBLE_EQ(run.positions()[7].origin.x, 54.671875);
+
+  rl::type::GlyphAtlas atlas({64.0, 32.0});
+  std::vector<rl::type::Glyph> glyphs;
+  ASSERT_TRUE(atlas.placeRun(run, glyphs));
+
+  ASSERT_EQ(glyphs[1].atlasBounds(), glyphs[6].atlasBounds());
+  ASSERT_FALSE(glyphs[1].atlasBounds() == glyphs[3].atlasBounds());
+
+  auto statistics = atlas.statistics();
+  ASSERT_EQ(statistics.hits, 1u);
+  ASSERT_EQ(statistics.misses, 7u);
+  ASSERT_EQ(statistics.entries, 7u);
+  ASSERT_EQ(statistics.shelves, 1u);
+
+  /*
+   *  Placing the run again rasterizes nothing.
+   */
+  glyphs.clear();
+  ASSERT_TRUE(atlas.placeRun(run, glyphs));
+  ASSERT_EQ(atlas.statistics().misses, 7u);
+  ASSERT_EQ(atlas.statistics().hits, 9u);
+}
+
+TEST(GlyphAtlasTest, LeastRecentlyUsedShelvesAreEvicted) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  /*
+   *  Room for two shelves of two capitals each.
+   */
+  rl::type::GlyphAtlas atlas({24.0, 32.0});
+  std::vector<rl::type::Glyph> glyphs;
+
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "AB"), glyphs));
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "DE"), glyphs));
+  ASSERT_EQ(atlas.statistics().shelves, 2u);
+
+  /*
+   *  Touch the first shelf so the second becomes the least recently used.
+   */
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "AB"), glyphs));
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "H"), glyphs));
+
+  auto statistics = atlas.statistics();
+  ASSERT_EQ(statistics.evictions, 2u);
+  ASSERT_EQ(statistics.entries, 3u);
+  ASSERT_EQ(statistics.shelves, 2u);
+
+  const auto misses = statistics.misses;
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "A"), glyphs));
+  ASSERT_EQ(atlas.statistics().misses, misses);
+
+  atlas.purge();
+  ASSERT_EQ(atlas.statistics().entries, 0u);
+  ASSERT_EQ(atlas.statistics().shelves, 0u);
+}
+
+TEST(GlyphAtlasTest, GlyphsPlacedInThePassAreNotEvicted) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  /*
+   *  Room for a single shelf of two capitals.
+   */
+  rl::type::GlyphAtlas atlas({24.0, 16.0});
+  std::vector<rl::type::Glyph> glyphs;
+
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "AB"), glyphs));
+  ASSERT_FALSE(atlas.placeRun(RobotoRun(library, "D"), glyphs));
+  ASSERT_EQ(atlas.statistics().evictions, 0u);
+
+  atlas.beginPass();
+  ASSERT_TRUE(atlas.placeRun(RobotoRun(library, "D"), glyphs));
+  ASSERT_EQ(atlas.statistics().evictions, 2u);
+}
+
+TEST(GlyphAtlasTest, GlyphsTooLargeForTheAtlasAreNotPlaced) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  rl::type::GlyphAtlas atlas({8.0, 8.0});
+  std::vector<rl::type::Glyph> glyphs;
+  ASSERT_FALSE(atlas.placeRun(RobotoRun(library, "W"), glyphs));
+  ASSERT_TRUE(glyphs.empty());
+}
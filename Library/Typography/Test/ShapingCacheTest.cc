@@ -0,0 +1,227 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <TestRunner/TestRunner.h>
+#include <Typography/AttributedStringBuilder.h>
+#include <Typography/ShapedTextRun.h>
+#include <Typography/ShapingCache.h>
+#include <thread>
+#include "WordRuns.h"
+
+static rl::type::AttributedString RobotoString(const std::string& text,
+                                               double size = 22.0) {
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", size}).appendText(text);
+  return builder.attributedString();
+}
+
+TEST(ShapingCacheTest, RepeatedWordsAreShapedOnce) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const std::string text = "Hello Hello World";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+  ASSERT_EQ(runs.runs().size(), 3u);
+
+  rl::type::ShapingCache cache(rl::type::ShapingCache::DefaultByteBudget);
+
+  auto first = cache.shape(string.string(), runs.runs()[0], library);
+  auto second = cache.shape(string.string(), runs.runs()[1], library);
+  auto third = cache.shape(string.string(), runs.runs()[2], library);
+
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, third);
+  ASSERT_EQ(first->size(), 6u);
+  ASSERT_EQ(third->size(), 5u);
+
+  /*
+   *  Clusters are relative to the start of the run so that they are valid
+   *  wherever the word occurs.
+   */
+  ASSERT_EQ(first->clusters.front(), 0u);
+  ASSERT_EQ(first->clusters.back(), 5u);
+  ASSERT_GT(first->xAdvances.front(), 0);
+
+  auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.hits, 1u);
+  ASSERT_EQ(statistics.misses, 2u);
+  ASSERT_EQ(statistics.entries, 2u);
+  ASSERT_GT(statistics.bytes, 0u);
+}
+
+TEST(ShapingCacheTest, SizeAndDirectionArePartOfTheKey) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const std::string text = "Hello";
+  auto small = RobotoString(text, 12.0);
+  auto large = RobotoString(text, 44.0);
+
+  rl::type::ShapingCache cache(rl::type::ShapingCache::DefaultByteBudget);
+
+  auto smallRuns = rl::type::testing::WordRuns(small, text);
+  const auto& smallRun = smallRuns.runs()[0];
+  auto smallGlyphs = cache.shape(small.string(), smallRun, library);
+  auto largeRuns = rl::type::testing::WordRuns(large, text);
+  auto largeGlyphs = cache.shape(large.string(), largeRuns.runs()[0], library);
+
+  ASSERT_NE(smallGlyphs, largeGlyphs);
+  ASSERT_EQ(smallGlyphs->glyphs, largeGlyphs->glyphs);
+  ASSERT_LT(smallGlyphs->xAdvances.front(), largeGlyphs->xAdvances.front());
+
+  rl::type::TextRun reversed(smallRun.descriptor(),
+                             rl::type::TextRun::Direction::RightToLeft,
+                             smallRun.range());
+  auto reversedGlyphs = cache.shape(small.string(), reversed, library);
+  ASSERT_NE(reversedGlyphs, smallGlyphs);
+  ASSERT_EQ(reversedGlyphs->glyphs.front(), smallGlyphs->glyphs.back());
+
+  ASSERT_EQ(cache.statistics().misses, 3u);
+  ASSERT_EQ(cache.statistics().hits, 0u);
+}
+
+TEST(ShapingCacheTest, UnresolvedFontsAreNotCached) {
+  rl::type::FontLibrary library;
+
+  const std::string text = "Hello";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+  rl::type::ShapingCache cache(rl::type::ShapingCache::DefaultByteBudget);
+
+  ASSERT_EQ(cache.shape(string.string(), runs.runs()[0], library), nullptr);
+  ASSERT_EQ(cache.statistics().entries, 0u);
+
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+  ASSERT_NE(cache.shape(string.string(), runs.runs()[0], library), nullptr);
+}
+
+TEST(ShapingCacheTest, LeastRecentlyUsedRunsAreEvicted) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const std::string text = "one two three";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+  ASSERT_EQ(runs.runs().size(), 3u);
+
+  rl::type::ShapingCache cache(rl::type::ShapingCache::DefaultByteBudget);
+
+  cache.shape(string.string(), runs.runs()[0], library);
+  cache.shape(string.string(), runs.runs()[1], library);
+  const auto twoEntries = cache.statistics().bytes;
+
+  /*
+   *  Touch the first run so the second becomes the least recently used.
+   */
+  cache.shape(string.string(), runs.runs()[0], library);
+  cache.setByteBudget(twoEntries);
+  cache.shape(string.string(), runs.runs()[2], library);
+
+  auto statistics = cache.statistics();
+  ASSERT_GE(statistics.evictions, 1u);
+  ASSERT_LE(statistics.bytes, twoEntries);
+
+  const auto misses = statistics.misses;
+  cache.shape(string.string(), runs.runs()[1], library);
+  ASSERT_EQ(cache.statistics().misses, misses + 1);
+
+  cache.purge();
+  ASSERT_EQ(cache.statistics().entries, 0u);
+  ASSERT_EQ(cache.statistics().bytes, 0u);
+}
+
+TEST(ShapingCacheTest, ConcurrentLookupsShareResults) {
+  const std::string text = "the quick brown fox jumps over the lazy dog";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+  ASSERT_EQ(runs.runs().size(), 9u);
+
+  rl::type::ShapingCache cache(rl::type::ShapingCache::DefaultByteBudget);
+
+  /*
+   *  The font library and the faces in it are shared by all threads.
+   */
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 100; j++) {
+        for (const auto& run : runs.runs()) {
+          RL_ASSERT(cache.shape(string.string(), run, library) != nullptr);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.entries, 8u);
+  ASSERT_EQ(statistics.hits + statistics.misses, 4u * 100u * 9u);
+}
+
+TEST(ShapingCacheTest, RunsAreShapedConcurrentlyWithSharedFonts) {
+  const std::string text = "the quick brown fox jumps over the lazy dog";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+
+  /*
+   *  Nothing is cached. So every lookup shapes the run.
+   */
+  rl::type::ShapingCache cache(0);
+
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  std::vector<size_t> expected;
+  for (const auto& run : runs.runs()) {
+    auto glyphs = cache.shape(string.string(), run, library);
+    ASSERT_NE(glyphs, nullptr);
+    expected.push_back(glyphs->size());
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 50; j++) {
+        for (size_t k = 0; k < runs.runs().size(); k++) {
+          auto glyphs = cache.shape(string.string(), runs.runs()[k], library);
+          RL_ASSERT(glyphs != nullptr && glyphs->size() == expected[k]);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(cache.statistics().misses, 9u + 4u * 50u * 9u);
+}
+
+TEST(ShapingCacheTest, ShapedRunsUseTheSharedCache) {
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  const std::string text = "Hello World";
+  auto string = RobotoString(text);
+  auto runs = rl::type::testing::WordRuns(string, text);
+  ASSERT_EQ(runs.runs().size(), 2u);
+
+  rl::type::ShapedTextRun hello(string.string(), runs.runs()[0], library);
+  rl::type::ShapedTextRun world(string.string(), runs.runs()[1], library);
+
+  ASSERT_TRUE(hello.isValid());
+  ASSERT_TRUE(world.isValid());
+  ASSERT_EQ(hello.glyphCount(), 6u);
+  ASSERT_EQ(world.glyphCount(), 5u);
+  ASSERT_GT(hello.size().width, 0.0);
+}
@@ -0,0 +1,290 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#include <TestRunner/TestRunner.h>
+#include <Typography/AttributedStringBuilder.h>
+#include <Typography/TypeFrame.h>
+#include <Typography/TypographyContext.h>
+#include <limits>
+#include "WordRuns.h"
+
+/**
+ *  Shaped runs of Roboto text split at the given indices or else at the start
+ *  of each word.
+ */
+class ShapedText {
+ public:
+  ShapedText(const std::string& text)
+      : ShapedText(text, rl::type::testing::WordBreaks(text)) {}
+
+  ShapedText(const std::string& text, const std::vector<size_t>& breaks) {
+    _library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0);
+
+    rl::type::AttributedStringBuilder builder;
+    builder.pushFontDescriptor({"Roboto-Regular", 20.0}).appendText(text);
+    auto string = builder.attributedString();
+
+    auto runs = rl::type::TextRuns{string}.splitAtBreaks(breaks);
+    for (const auto& run : runs.runs()) {
+      _runs.emplace_back(string.string(), run, _library);
+    }
+  }
+
+  const std::vector<rl::type::ShapedTextRun>& runs() const { return _runs; }
+
+ private:
+  rl::type::FontLibrary _library;
+  std::vector<rl::type::ShapedTextRun> _runs;
+
+  RL_DISALLOW_COPY_AND_ASSIGN(ShapedText);
+};
+
+static double Advance(const ShapedText& text, size_t first, size_t end) {
+  double advance = 0.0;
+  for (size_t i = first; i < end; i++) {
+    advance += text.runs()[i].advance();
+  }
+  return advance;
+}
+
+TEST(TypeFrameTest, UnboundedWidthIsASingleLine) {
+  ShapedText text("one two three");
+  ASSERT_EQ(text.runs().size(), 3u);
+
+  rl::type::TypeFrame frame(text.runs(), {},
+                            std::numeric_limits<double>::infinity());
+  ASSERT_TRUE(frame.isValid());
+  ASSERT_EQ(frame.lines().size(), 1u);
+
+  const auto& line = frame.lines()[0];
+  ASSERT_EQ(line.firstRun(), 0u);
+  ASSERT_EQ(line.runCount(), 3u);
+  ASSERT_EQ(line.range().start, 0u);
+  ASSERT_EQ(line.range().length, 13u);
+  ASSERT_DOUBLE_EQ(line.bounds().size.width, Advance(text, 0, 3));
+  ASSERT_GT(line.ascent(), 0.0);
+  ASSERT_GT(line.descent(), 0.0);
+  ASSERT_DOUBLE_EQ(line.baseline(), line.ascent());
+  ASSERT_DOUBLE_EQ(line.bounds().size.height, line.ascent() + line.descent());
+  ASSERT_EQ(frame.size(), line.bounds().size);
+}
+
+TEST(TypeFrameTest, GreedyBreakingFitsAsManyRunsAsPossible) {
+  ShapedText text("aaaa bbbb cccc dddd eeee");
+  ASSERT_EQ(text.runs().size(), 5u);
+
+  /*
+   *  The space after the second word hangs past the edge of the line.
+   */
+  const auto width = Advance(text, 0, 2) -
+                     text.runs()[1].trailingWhitespaceAdvance();
+  ASSERT_GT(text.runs()[1].trailingWhitespaceAdvance(), 0.0);
+
+  rl::type::TypeFrame frame(text.runs(), {}, width);
+  ASSERT_TRUE(frame.isValid());
+  ASSERT_EQ(frame.lines().size(), 3u);
+
+  ASSERT_EQ(frame.lines()[0].runCount(), 2u);
+  ASSERT_EQ(frame.lines()[1].firstRun(), 2u);
+  ASSERT_EQ(frame.lines()[1].runCount(), 2u);
+  ASSERT_EQ(frame.lines()[2].firstRun(), 4u);
+  ASSERT_EQ(frame.lines()[2].runCount(), 1u);
+  ASSERT_EQ(frame.lines()[1].range().start, 10u);
+
+  ASSERT_DOUBLE_EQ(frame.lines()[0].bounds().size.width, width);
+
+  double top = 0.0;
+  for (const auto& line : frame.lines()) {
+    ASSERT_DOUBLE_EQ(line.bounds().origin.y, top);
+    top += line.bounds().size.height;
+  }
+  ASSERT_DOUBLE_EQ(frame.size().height, top);
+  ASSERT_DOUBLE_EQ(frame.size().width, width);
+}
+
+TEST(TypeFrameTest, RunsWiderThanTheWidthGetTheirOwnLines) {
+  ShapedText text("a incomprehensibilities b");
+  ASSERT_EQ(text.runs().size(), 3u);
+
+  rl::type::TypeFrame frame(text.runs(), {}, 30.0);
+  ASSERT_TRUE(frame.isValid());
+  ASSERT_EQ(frame.lines().size(), 3u);
+  ASSERT_EQ(frame.lines()[1].runCount(), 1u);
+  ASSERT_GT(frame.lines()[1].bounds().size.width, 30.0);
+  ASSERT_GT(frame.size().width, 30.0);
+}
+
+TEST(TypeFrameTest, MandatoryBreaksEndLines) {
+  ShapedText text("one\ntwo three", {0, 4, 8});
+  ASSERT_EQ(text.runs().size(), 3u);
+  ASSERT_TRUE(text.runs()[0].endsWithMandatoryBreak());
+  ASSERT_FALSE(text.runs()[1].endsWithMandatoryBreak());
+
+  for (auto strategy : {rl::type::ParagraphStyle::LineBreakStrategy::Greedy,
+                        rl::type::ParagraphStyle::LineBreakStrategy::Optimal}) {
+    rl::type::ParagraphStyle style(rl::type::ParagraphStyle::Alignment::Left,
+                                   strategy);
+    rl::type::TypeFrame frame(text.runs(), style, 1000.0);
+    ASSERT_EQ(frame.lines().size(), 2u);
+    ASSERT_EQ(frame.lines()[0].runCount(), 1u);
+    ASSERT_EQ(frame.lines()[1].runCount(), 2u);
+  }
+}
+
+TEST(TypeFrameTest, LinesAreAligned) {
+  ShapedText text("aaaa bbbb cccc dddd eeee");
+  const double width = 200.0;
+
+  using Alignment = rl::type::ParagraphStyle::Alignment;
+
+  rl::type::TypeFrame left(text.runs(), {Alignment::Left, {}}, width);
+  rl::type::TypeFrame right(text.runs(), {Alignment::Right, {}}, width);
+  rl::type::TypeFrame center(text.runs(), {Alignment::Center, {}}, width);
+  rl::type::TypeFrame justified(text.runs(), {Alignment::Justified, {}},
+                                width);
+
+  ASSERT_GT(left.lines().size(), 1u);
+  ASSERT_EQ(right.lines().size(), left.lines().size());
+  ASSERT_EQ(center.lines().size(), left.lines().size());
+  ASSERT_EQ(justified.lines().size(), left.lines().size());
+
+  for (size_t i = 0; i < left.lines().size(); i++) {
+    const auto& bounds = left.lines()[i].bounds();
+    const auto slack = width - bounds.size.width;
+    ASSERT_EQ(bounds.origin.x, 0.0);
+    ASSERT_DOUBLE_EQ(right.lines()[i].bounds().origin.x, slack);
+    ASSERT_DOUBLE_EQ(center.lines()[i].bounds().origin.x, slack / 2.0);
+    ASSERT_EQ(justified.lines()[i].bounds().origin.x, 0.0);
+
+    /*
+     *  The last line is not justified.
+     */
+    const auto& line = justified.lines()[i];
+    if (i + 1 == left.lines().size()) {
+      ASSERT_EQ(line.runSpacing(), 0.0);
+      ASSERT_DOUBLE_EQ(line.bounds().size.width, bounds.size.width);
+    } else {
+      ASSERT_GT(line.runSpacing(), 0.0);
+      ASSERT_DOUBLE_EQ(line.bounds().size.width, width);
+      ASSERT_DOUBLE_EQ(line.runSpacing() * (line.runCount() - 1), slack);
+    }
+  }
+}
+
+TEST(TypeFrameTest, LineHeightMultipleScalesLines) {
+  ShapedText text("aaaa bbbb cccc dddd eeee");
+
+  rl::type::TypeFrame single(text.runs(), {}, 100.0);
+  rl::type::TypeFrame doubled(
+      text.runs(),
+      {rl::type::ParagraphStyle::Alignment::Left,
+       rl::type::ParagraphStyle::LineBreakStrategy::Greedy, 2.0},
+      100.0);
+
+  ASSERT_EQ(single.lines().size(), doubled.lines().size());
+  ASSERT_DOUBLE_EQ(doubled.size().height, single.size().height * 2.0);
+}
+
+TEST(TypeFrameTest, OptimalBreakingEvensOutLines) {
+  /*
+   *  Filling the first line leaves the second nearly empty. Moving a word down
+   *  evens them out.
+   */
+  ShapedText text("aaa bb cc ddddd");
+  const double width = Advance(text, 0, 2) -
+                       text.runs()[1].trailingWhitespaceAdvance();
+
+  using Strategy = rl::type::ParagraphStyle::LineBreakStrategy;
+  rl::type::TypeFrame greedy(text.runs(), {{}, Strategy::Greedy}, width);
+  rl::type::TypeFrame optimal(text.runs(), {{}, Strategy::Optimal}, width);
+
+  /*
+   *  Compare the cubes of the slack of all but the last lines.
+   */
+  auto raggedness = [width](const rl::type::TypeFrame& frame) {
+    double raggedness = 0.0;
+    for (size_t i = 0; i + 1 < frame.lines().size(); i++) {
+      const auto slack = width - frame.lines()[i].bounds().size.width;
+      raggedness += slack * slack * slack;
+    }
+    return raggedness;
+  };
+
+  ASSERT_EQ(greedy.lines().size(), optimal.lines().size());
+  ASSERT_LE(raggedness(optimal), raggedness(greedy));
+  ASSERT_NE(greedy.lines()[0].runCount(), optimal.lines()[0].runCount());
+
+  for (const auto& line : optimal.lines()) {
+    ASSERT_LE(line.bounds().size.width, width);
+  }
+}
+
+TEST(TypeFrameTest, OptimalBreakingAtUnboundedWidthIsASingleLine) {
+  /*
+   *  Enough runs that trying every line of the paragraph would take a while.
+   */
+  std::string words;
+  for (size_t i = 0; i < 5000; i++) {
+    words += i % 2 == 0 ? "aa " : "bbb ";
+  }
+
+  ShapedText text(words);
+  ASSERT_EQ(text.runs().size(), 5000u);
+
+  using Strategy = rl::type::ParagraphStyle::LineBreakStrategy;
+  rl::type::TypeFrame frame(text.runs(), {{}, Strategy::Optimal},
+                            std::numeric_limits<double>::infinity());
+  ASSERT_TRUE(frame.isValid());
+  ASSERT_EQ(frame.lines().size(), 1u);
+  ASSERT_EQ(frame.lines()[0].runCount(), 5000u);
+  ASSERT_DOUBLE_EQ(frame.size().width,
+                   Advance(text, 0, 5000) -
+                       text.runs()[4999].trailingWhitespaceAdvance());
+}
+
+TEST(TypeFrameTest, HitTestsFindLines) {
+  ShapedText text("aaaa bbbb cccc dddd eeee");
+  rl::type::TypeFrame frame(text.runs(), {}, 60.0);
+  ASSERT_EQ(frame.lines().size(), 5u);
+
+  for (size_t i = 0; i < frame.lines().size(); i++) {
+    const auto& line = frame.lines()[i];
+    const auto& bounds = line.bounds();
+    ASSERT_EQ(frame.lineIndexForPoint(
+                  {0.0, bounds.origin.y + bounds.size.height / 2.0}),
+              i);
+    ASSERT_EQ(frame.lineIndexForPoint({0.0, bounds.origin.y}), i);
+    ASSERT_EQ(frame.lineIndexForTextIndex(line.range().start), i);
+    ASSERT_EQ(frame.lineIndexForTextIndex(line.range().start +
+                                          line.range().length - 1),
+              i);
+  }
+
+  ASSERT_EQ(frame.lineIndexForPoint({0.0, -10.0}), 0u);
+  ASSERT_EQ(frame.lineIndexForPoint({0.0, frame.size().height + 10.0}), 4u);
+  ASSERT_EQ(frame.lineIndexForTextIndex(1000), 4u);
+
+  rl::type::TypeFrame empty({}, {}, 60.0);
+  ASSERT_TRUE(empty.isValid());
+  ASSERT_EQ(empty.lineIndexForPoint({0.0, 0.0}), 0u);
+  ASSERT_EQ(empty.lineIndexForTextIndex(0), 0u);
+}
+
+TEST(TypeFrameTest, RelayoutDoesNotReshape) {
+  auto& cache = rl::type::TypographyContext::SharedContext().shapingCache();
+
+  ShapedText text("aaaa bbbb cccc dddd eeee");
+  const auto statistics = cache.statistics();
+
+  for (double width = 20.0; width < 400.0; width += 10.0) {
+    rl::type::TypeFrame frame(
+        text.runs(),
+        {{}, rl::type::ParagraphStyle::LineBreakStrategy::Optimal}, width);
+    ASSERT_TRUE(frame.isValid());
+  }
+
+  ASSERT_EQ(cache.statistics().misses, statistics.misses);
+  ASSERT_EQ(cache.statistics().hits, statistics.hits);
+}
@@ -8,7 +8,20 @@
 #include <Typography/Typesetter.h>
 #include <Typography/TypographyContext.h>
 
-TEST(TypesetterTest, SimpleTypesetter) {
+class TypesetterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    /*
+     *  Finding line break opportunities needs the ICU data file. Without it,
+     *  no typesetter is valid and there is nothing to check.
+     */
+    if (!rl::type::TypographyContext::SharedContext().isValid()) {
+      GTEST_SKIP();
+    }
+  }
+};
+
+TEST_F(TypesetterTest, SimpleTypesetter) {
   rl::type::AttributedStringBuilder builder;
   std::string hello("Hello");
   builder.appendText(hello);
@@ -21,7 +34,7 @@ TEST(TypesetterTest, SimpleTypesetter) {
             rl::type::TextRun::Direction::LeftToRight);
 }
 
-TEST(TypesetterTest, SimpleHebrewTypesetter) {
+TEST_F(TypesetterTest, SimpleHebrewTypesetter) {
   rl::type::AttributedStringBuilder builder;
   std::string hello("ציור עסקים מדע מה. צ'ט בקלות הבאים מאמרשיחהצפה של.");
   builder.appendText(hello);
@@ -50,7 +63,7 @@ TEST(TypesetterTest, SimpleHebrewTypesetter) {
             rl::type::TextRun::Direction::RightToLeft);
 }
 
-TEST(TypesetterTest, MixedTypesetter) {
+TEST_F(TypesetterTest, MixedTypesetter) {
   rl::type::AttributedStringBuilder builder;
   std::string hello(
       "World ציור עסקים מדע מה. צ'ט בקלות הבאים Hello מאמרשיחהצפה של");
@@ -87,7 +100,7 @@ TEST(TypesetterTest, MixedTypesetter) {
             rl::type::TextRun::Direction::RightToLeft);
 }
 
-TEST(TypesetterTest, EmojiTypesetter) {
+TEST_F(TypesetterTest, EmojiTypesetter) {
   rl::type::AttributedStringBuilder builder;
   std::string hello("With 😀 😃 😄 😁 😆 😅 😂 🤣 Emoji");
   builder.appendText(hello);
@@ -118,7 +131,7 @@ TEST(TypesetterTest, EmojiTypesetter) {
             rl::type::TextRun::Direction::LeftToRight);
 }
 
-TEST(TypesetterTest, TestRunLengths) {
+TEST_F(TypesetterTest, TestRunLengths) {
   rl::type::AttributedStringBuilder builder;
   std::string hello("😄");
   builder.appendText(hello);
@@ -133,7 +146,7 @@ TEST(TypesetterTest, TestRunLengths) {
   ASSERT_EQ(typesetter.runs().runs()[0].range().length, 2u);
 }
 
-TEST(TypesetterTest, SimpleTypesetterCreateShapedRuns) {
+TEST_F(TypesetterTest, SimpleTypesetterCreateShapedRuns) {
   rl::type::AttributedStringBuilder builder;
   std::string hello("Hello World");
   builder.pushFontDescriptor({"Roboto-Regular", 22.0}).appendText(hello);
@@ -148,3 +161,37 @@ TEST(TypesetterTest, SimpleTypesetterCreateShapedRuns) {
   ASSERT_EQ(shapedRuns[0].glyphCount(), 6u);
   ASSERT_EQ(shapedRuns[1].glyphCount(), 5u);
 }
+
+TEST_F(TypesetterTest, ConcurrentlyShapedRunsMatchSerial) {
+  std::string text;
+  for (size_t i = 0; i < 500; i++) {
+    text += i % 3 == 0 ? "Hello " : i % 3 == 1 ? "typesetting " : "world. ";
+  }
+
+  rl::type::AttributedStringBuilder builder;
+  builder.pushFontDescriptor({"Roboto-Regular", 22.0}).appendText(text);
+  rl::type::Typesetter typesetter(builder.attributedString());
+  ASSERT_TRUE(typesetter.isValid());
+  ASSERT_EQ(typesetter.runs().runs().size(), 500u);
+
+  rl::type::FontLibrary library;
+  ASSERT_TRUE(library.registerFont(rl::core::URI{"Roboto-Regular.ttf"}, 0));
+
+  auto& cache = rl::type::TypographyContext::SharedContext().shapingCache();
+  const auto byteBudget = cache.byteBudget();
+  cache.setByteBudget(0);
+
+  rl::core::WorkQueue workQueue(rl::core::WorkQueue::Mode::WorkStealing, 4);
+  auto serial = typesetter.createShapedRuns(library);
+  auto concurrent = typesetter.createShapedRuns(library, &workQueue);
+
+  cache.setByteBudget(byteBudget);
+
+  ASSERT_EQ(serial.size(), 500u);
+  ASSERT_EQ(concurrent.size(), serial.size());
+  for (size_t i = 0; i < serial.size(); i++) {
+    ASSERT_EQ(concurrent[i].range(), serial[i].range());
+    ASSERT_EQ(concurrent[i].glyphCount(), serial[i].glyphCount());
+    ASSERT_EQ(concurrent[i].advance(), serial[i].advance());
+  }
+}
@@ -0,0 +1,44 @@
+/*
+ *  This source file is part of the Radar project.
+ *  Licensed under the MIT License. See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <Typography/AttributedString.h>
+#include <Typography/TextRun.h>
+#include <string>
+#include <vector>
+
+namespace rl {
+namespace type {
+namespace testing {
+
+/**
+ *  The indices of the start of each word of the text. Unlike the typesetter,
+ *  this does not need the ICU break iterator data.
+ */
+inline std::vector<size_t> WordBreaks(const std::string& text) {
+  /*
+   *  The text is ASCII so indices into it are also UTF-16 indices.
+   */
+  std::vector<size_t> breaks = {0};
+  for (size_t i = 1; i < text.size(); i++) {
+    if (text[i - 1] == ' ' && text[i] != ' ') {
+      breaks.emplace_back(i);
+    }
+  }
+  return breaks;
+}
+
+/**
+ *  Split the string of the text into runs at the start of each word.
+ */
+inline TextRuns WordRuns(const AttributedString& string,
+                         const std::string& text) {
+  return TextRuns{string}.splitAtBreaks(WordBreaks(text));
+}
+
+}  // namespace testing
+}  // namespace type
+}  // namespace rl
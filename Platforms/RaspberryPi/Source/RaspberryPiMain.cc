@@ -24,7 +24,12 @@
 class PlatformEngine : public rl::coordinator::RenderSurface {
  public:
   PlatformEngine()
-      : screen_width(0), screen_height(0), display(0), surface(0), context(0) {
+      : screen_width(0),
+        screen_height(0),
+        display(0),
+        surface(0),
+        context(0),
+        preserved(false) {
     bcm_host_init();
 
     int32_t success = 0;
@@ -112,6 +117,14 @@ class PlatformEngine : public rl::coordinator::RenderSurface {
     surface = eglCreateWindowSurface(display, config, &nativewindow, nullptr);
     RL_ASSERT(surface != EGL_NO_SURFACE);
 
+    /*
+     *  Fill rate is scarce. If the contents of the surface are preserved
+     *  across swaps, only the damaged regions of frames need to be redrawn.
+     *  Not all configurations support this.
+     */
+    preserved = eglSurfaceAttrib(display, surface, EGL_SWAP_BEHAVIOR,
+                                 EGL_BUFFER_PRESERVED) == EGL_TRUE;
+
     attemptMouseConnection();
   }
 
@@ -150,6 +163,8 @@ class PlatformEngine : public rl::coordinator::RenderSurface {
 
   bool present() { return eglSwapBuffers(display, surface) == EGL_TRUE; }
 
+  size_t bufferAge() { return preserved ? 1 : 0; }
+
   int run(std::shared_ptr<rl::shell::Shell> shell) {
     surfaceWasCreated();
 
@@ -183,6 +198,7 @@ class PlatformEngine : public rl::coordinator::RenderSurface {
   EGLDisplay display;
   EGLSurface surface;
   EGLContext context;
+  bool preserved;
 
   void waitEvents(int descriptor) {
     const int width = screen_width, height = screen_height;